@@ -1335,18 +1335,11 @@ Marshalls *Marshalls::get_singleton() {
 }
 
 String Marshalls::variant_to_base64(const Variant &p_var, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
+	LocalVector<uint8_t> buff;
+	Error err = encode_variant_append(p_var, buff, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, "", "Error when trying to encode Variant.");
 
-	Vector<uint8_t> buff;
-	buff.resize(len);
-	uint8_t *w = buff.ptrw();
-
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, "", "Error when trying to encode Variant.");
-
-	String ret = CryptoCore::b64_encode_str(&w[0], len);
+	String ret = CryptoCore::b64_encode_str(buff.ptr(), buff.size());
 	ERR_FAIL_COND_V(ret.is_empty(), ret);
 
 	return ret;
@@ -71,19 +71,19 @@ void FileAccess::_set_access_type(AccessType p_access) {
 	_access_type = p_access;
 }
 
-Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
-	Ref<FileAccess> ret;
+FileAccess::AccessType FileAccess::_get_access_type_for_path(const String &p_path) {
 	if (p_path.begins_with("res://") || p_path.begins_with("uid://")) {
-		ret = create(ACCESS_RESOURCES);
+		return ACCESS_RESOURCES;
 	} else if (p_path.begins_with("user://")) {
-		ret = create(ACCESS_USERDATA);
+		return ACCESS_USERDATA;
 	} else if (p_path.begins_with("pipe://")) {
-		ret = create(ACCESS_PIPE);
-	} else {
-		ret = create(ACCESS_FILESYSTEM);
+		return ACCESS_PIPE;
 	}
+	return ACCESS_FILESYSTEM;
+}
 
-	return ret;
+Ref<FileAccess> FileAccess::create_for_path(const String &p_path) {
+	return create(_get_access_type_for_path(p_path));
 }
 
 Ref<FileAccess> FileAccess::create_temp(int p_mode_flags, const String &p_prefix, const String &p_extension, bool p_keep, Error *r_error) {
@@ -190,6 +190,26 @@ Ref<FileAccess> FileAccess::open(const String &p_path, int p_mode_flags, Error *
 	return ret;
 }
 
+Ref<FileAccess> FileAccess::open_mapped(const String &p_path, Error *r_error) {
+	const AccessType access = _get_access_type_for_path(p_path);
+	if (!create_mapped_func || access == ACCESS_PIPE) {
+		return open(p_path, READ | SKIP_PACK, r_error);
+	}
+
+	Ref<FileAccess> ret = create_mapped_func();
+	ret->_set_access_type(access);
+	Error err = ret->open_internal(p_path, READ);
+	if (err != OK) {
+		// Mapping can fail where regular reads don't, e.g. on some virtual file systems.
+		return open(p_path, READ | SKIP_PACK, r_error);
+	}
+
+	if (r_error) {
+		*r_error = OK;
+	}
+	return ret;
+}
+
 Ref<FileAccess> FileAccess::_open(const String &p_path, ModeFlags p_mode_flags) {
 	Error err = OK;
 	Ref<FileAccess> fa = open(p_path, p_mode_flags, &err);
@@ -833,18 +853,11 @@ bool FileAccess::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 }
 
 bool FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
-
-	Vector<uint8_t> buff;
-	buff.resize(len);
-
-	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	LocalVector<uint8_t> buff;
+	Error err = encode_variant_append(p_var, buff, p_full_objects);
 	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
 
-	return store_32(uint32_t(len)) && store_buffer(buff);
+	return store_32(buff.size()) && store_buffer(buff.ptr(), buff.size());
 }
 
 Vector<uint8_t> FileAccess::get_file_as_bytes(const String &p_path, Error *r_error) {
@@ -150,11 +150,13 @@ private:
 
 	AccessType _access_type = ACCESS_FILESYSTEM;
 	static inline CreateFunc create_func[ACCESS_MAX]; /** default file access creation function for a platform */
+	static inline CreateFunc create_mapped_func = nullptr; /** read-only memory mapped file access, if the platform has one */
 	template <typename T>
 	static Ref<FileAccess> _create_builtin() {
 		return memnew(T);
 	}
 
+	static AccessType _get_access_type_for_path(const String &p_path);
 	static Ref<FileAccess> _open(const String &p_path, ModeFlags p_mode_flags);
 
 	bool _is_temp_file = false;
@@ -195,6 +197,9 @@ public:
 	Variant get_var(bool p_allow_objects = false) const;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
+	/// Returns a pointer to `p_length` bytes at `p_position` that stays valid while the file is open,
+	/// without changing the position, or `nullptr` if the backend can't provide one for this range.
+	virtual const uint8_t *get_buffer_view(uint64_t p_position, uint64_t p_length) const { return nullptr; }
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
 	virtual String get_line() const;
 	virtual String get_token() const;
@@ -249,6 +254,7 @@ public:
 
 	static Ref<FileAccess> open_encrypted(const String &p_path, ModeFlags p_mode_flags, const Vector<uint8_t> &p_key, const Vector<uint8_t> &p_iv = Vector<uint8_t>());
 	static Ref<FileAccess> open_encrypted_pass(const String &p_path, ModeFlags p_mode_flags, const String &p_pass);
+	static Ref<FileAccess> open_mapped(const String &p_path, Error *r_error = nullptr); ///< Open a file read-only, memory mapped when the platform supports it. Doesn't look into packs.
 	static Ref<FileAccess> open_compressed(const String &p_path, ModeFlags p_mode_flags, CompressionMode p_compress_mode = COMPRESSION_FASTLZ);
 	static Error get_open_error();
 
@@ -283,6 +289,11 @@ public:
 		create_func[p_access] = _create_builtin<T>;
 	}
 
+	template <typename T>
+	static void make_mapped_default() {
+		create_mapped_func = _create_builtin<T>;
+	}
+
 public:
 	FileAccess() {}
 	virtual ~FileAccess();
@@ -43,6 +43,8 @@
 #include "core/os/os.h"
 #include "core/version.h"
 
+#include <zstd.h>
+
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
 	for (int i = 0; i < sources.size(); i++) {
 		if (sources[i]->try_open_pack(p_path, p_replace_files, p_offset)) {
@@ -53,7 +55,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, uint32_t p_block_size, const Vector<uint32_t> &p_blocks) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -69,6 +71,8 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 		pf.md5[i] = p_md5[i];
 	}
 	pf.src = p_src;
+	pf.block_size = p_block_size;
+	pf.blocks = p_blocks;
 
 	if (!exists || p_replace_files) {
 		files[pmd5] = pf;
@@ -200,6 +204,12 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		return false;
 	}
 
+	{
+		// The pack may have been rewritten since it was mapped, files already open keep the old mapping.
+		MutexLock lock(mapped_packs_mutex);
+		mapped_packs.erase(p_path);
+	}
+
 	bool pck_header_found = false;
 
 	// Search for the header at the start offset - standalone PCK file.
@@ -271,21 +281,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > REDOT_VERSION_MAJOR || (ver_major == REDOT_VERSION_MAJOR && ver_minor > REDOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3 and V4.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
-		// V3: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3 and V4: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -327,17 +337,52 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f->get_buffer(md5, 16);
 		uint32_t flags = f->get_32();
 
+		uint32_t block_size = 0;
+		Vector<uint32_t> blocks;
+		if (flags & PACK_FILE_COMPRESSED) {
+			ERR_FAIL_COND_V_MSG(version < PACK_FORMAT_VERSION_V4, false, vformat("Compressed file '%s' in a pack older than version %d.", path, PACK_FORMAT_VERSION_V4));
+			block_size = f->get_32();
+			uint32_t block_count = f->get_32();
+			ERR_FAIL_COND_V_MSG(block_size == 0 || block_count != (size + block_size - 1) / block_size, false, vformat("Invalid block index for compressed file '%s' in pack.", path));
+			ERR_FAIL_COND_V_MSG(flags & PACK_FILE_ENCRYPTED, false, vformat("Compressed file '%s' in pack can't be encrypted.", path));
+			blocks.resize(block_count);
+			uint32_t *w = blocks.ptrw();
+			for (uint32_t j = 0; j < block_count; j++) {
+				w[j] = f->get_32();
+			}
+		}
+
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle);
+			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, block_size, blocks);
 		}
 	}
 
 	return true;
 }
 
+Ref<FileAccess> PackedSourcePCK::_get_mapped_pack(const String &p_pack) {
+	MutexLock lock(mapped_packs_mutex);
+
+	Ref<FileAccess> *mapped = mapped_packs.getptr(p_pack);
+	if (mapped) {
+		return *mapped;
+	}
+
+	Ref<FileAccess> f = FileAccess::open_mapped(p_pack);
+	if (f.is_valid() && !f->get_buffer_view(0, f->get_length())) {
+		// Not memory mapped, files keep opening the pack themselves.
+		f.unref();
+	}
+	mapped_packs.insert(p_pack, f);
+	return f;
+}
+
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
+	if (!p_file->bundle && !p_file->encrypted) {
+		return memnew(FileAccessPack(p_path, *p_file, _get_mapped_pack(p_file->pack)));
+	}
 	return memnew(FileAccessPack(p_path, *p_file));
 }
 
@@ -403,7 +448,9 @@ void FileAccessPack::seek(uint64_t p_position) {
 		eof = false;
 	}
 
-	f->seek(off + p_position);
+	if (!mapped && pf.block_size == 0) {
+		f->seek(off + p_position);
+	}
 	pos = p_position;
 }
 
@@ -442,16 +489,110 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	if (to_read <= 0) {
 		return 0;
 	}
-	f->get_buffer(p_dst, to_read);
+	if (pf.block_size) {
+		uint64_t read_pos = pos - to_read;
+		uint64_t left = to_read;
+		while (left > 0) {
+			const uint64_t block = read_pos / pf.block_size;
+			if (!_load_block(block)) {
+				pos = read_pos;
+				eof = true;
+				return to_read - left;
+			}
+			const uint64_t block_pos = read_pos - block * pf.block_size;
+			const uint64_t n = MIN(left, block_data.size() - block_pos);
+			memcpy(p_dst + to_read - left, block_data.ptr() + block_pos, n);
+			read_pos += n;
+			left -= n;
+		}
+	} else if (mapped) {
+		memcpy(p_dst, mapped + pos - to_read, to_read);
+	} else {
+		f->get_buffer(p_dst, to_read);
+	}
 
 	return to_read;
 }
 
+const uint8_t *FileAccessPack::get_buffer_view(uint64_t p_position, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(f.is_null(), nullptr, "File must be opened before use.");
+
+	if (p_position > pf.size || p_length > pf.size - p_position) {
+		return nullptr;
+	}
+	if (pf.block_size) {
+		return nullptr;
+	}
+	if (mapped) {
+		return mapped + p_position;
+	}
+	if (pf.encrypted) {
+		return nullptr;
+	}
+	return f->get_buffer_view(off + p_position, p_length);
+}
+
+// Each thread decompresses with its own context, Compression::decompress() shares a single one
+// behind a lock, which would make threaded loads from a compressed pack wait for each other.
+// Blocks are at most 16 MiB, within the default window size limit of the context.
+static int64_t _decompress_block(uint8_t *p_dst, uint64_t p_dst_size, const uint8_t *p_src, uint64_t p_src_size) {
+	struct Context {
+		ZSTD_DCtx *ctx = nullptr;
+		~Context() {
+			if (ctx) {
+				ZSTD_freeDCtx(ctx);
+			}
+		}
+	};
+	static thread_local Context context;
+
+	if (!context.ctx) {
+		context.ctx = ZSTD_createDCtx();
+		ERR_FAIL_NULL_V(context.ctx, -1);
+	}
+	const size_t ret = ZSTD_decompressDCtx(context.ctx, p_dst, p_dst_size, p_src, p_src_size);
+	return ZSTD_isError(ret) ? -1 : (int64_t)ret;
+}
+
+bool FileAccessPack::_load_block(uint64_t p_block) const {
+	if (current_block == (int64_t)p_block) {
+		return true;
+	}
+	ERR_FAIL_UNSIGNED_INDEX_V(p_block, (uint64_t)pf.blocks.size(), false);
+
+	const uint32_t stored = pf.blocks[p_block];
+	const uint32_t stored_size = stored & ~PACK_BLOCK_UNCOMPRESSED;
+	const uint64_t size = MIN((uint64_t)pf.block_size, pf.size - p_block * pf.block_size);
+
+	const uint8_t *src = nullptr;
+	if (mapped) {
+		src = mapped + block_offsets[p_block];
+	} else {
+		block_source.resize(stored_size);
+		f->seek(off + block_offsets[p_block]);
+		ERR_FAIL_COND_V_MSG(f->get_buffer(block_source.ptr(), stored_size) != stored_size, false, vformat("Can't read block of compressed pack-referenced file '%s'.", String(pf.pack)));
+		src = block_source.ptr();
+	}
+
+	block_data.resize(size);
+	if (stored & PACK_BLOCK_UNCOMPRESSED) {
+		ERR_FAIL_COND_V(stored_size != size, false);
+		memcpy(block_data.ptr(), src, size);
+	} else {
+		const int64_t ret = _decompress_block(block_data.ptr(), size, src, stored_size);
+		ERR_FAIL_COND_V_MSG(ret != (int64_t)size, false, vformat("Can't decompress block of pack-referenced file '%s'.", String(pf.pack)));
+	}
+	current_block = p_block;
+	return true;
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
 	FileAccess::set_big_endian(p_big_endian);
-	f->set_big_endian(p_big_endian);
+	if (!mapped) {
+		f->set_big_endian(p_big_endian);
+	}
 }
 
 Error FileAccessPack::get_error() const {
@@ -475,10 +616,34 @@ bool FileAccessPack::file_exists(const String &p_name) {
 
 void FileAccessPack::close() {
 	f = Ref<FileAccess>();
+	mapped = nullptr;
 }
 
-FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file) {
+FileAccessPack::FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack) {
 	pf = p_file;
+	pos = 0;
+	eof = false;
+
+	uint64_t stored_size = pf.size;
+	if (pf.block_size) {
+		block_offsets.resize(pf.blocks.size() + 1);
+		block_offsets[0] = 0;
+		for (int i = 0; i < pf.blocks.size(); i++) {
+			block_offsets[i + 1] = block_offsets[i] + (pf.blocks[i] & ~PACK_BLOCK_UNCOMPRESSED);
+		}
+		stored_size = block_offsets[pf.blocks.size()];
+	}
+
+	if (p_mapped_pack.is_valid() && !pf.encrypted) {
+		mapped = p_mapped_pack->get_buffer_view(pf.offset, stored_size);
+		if (mapped) {
+			// Reads go straight to the mapping, the shared file's position is never used.
+			f = p_mapped_pack;
+			off = pf.offset;
+			return;
+		}
+	}
+
 	if (pf.bundle) {
 		String simplified_path = p_path.simplify_path();
 		f = FileAccess::open(simplified_path, FileAccess::READ | FileAccess::SKIP_PACK);
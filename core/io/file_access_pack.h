@@ -40,15 +40,19 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 
 /// Redot's packed file magic header ("GDPC" in ASCII).
 #define PACK_HEADER_MAGIC 0x43504447
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+/// V3 with PACK_FILE_COMPRESSED files, only written when a pack has some so older readers reject it.
+#define PACK_FORMAT_VERSION_V4 4
 
 /// The current packed file format version number.
 #define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
@@ -62,8 +66,12 @@ enum PackFlags {
 enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
+	PACK_FILE_COMPRESSED = 1 << 2, ///< Split in blocks compressed with Zstandard, followed by a block index in the directory.
 };
 
+/// Set on the stored size of a block in the index when it didn't compress and is stored as is.
+#define PACK_BLOCK_UNCOMPRESSED 0x80000000
+
 class PackSource;
 
 class PackedData {
@@ -80,6 +88,8 @@ public:
 		PackSource *src = nullptr;
 		bool encrypted;
 		bool bundle;
+		uint32_t block_size = 0; ///< Non-zero for compressed files, `size` is then the uncompressed size.
+		Vector<uint32_t> blocks; ///< Stored size of each block of a compressed file.
 	};
 
 private:
@@ -125,7 +135,7 @@ private:
 public:
 	void add_pack_source(PackSource *p_source);
 	/// For PackSource
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false);
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, uint32_t p_block_size = 0, const Vector<uint32_t> &p_blocks = Vector<uint32_t>());
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	HashSet<String> get_file_paths() const;
@@ -158,6 +168,15 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Each pack is mapped once, and files read from it share the mapping.
+	// Mappings are kept for the lifetime of the source, even once every file of a pack has been
+	// replaced by a later pack, since nothing tracks which packs still serve files. A mapping costs
+	// address space and a file handle, its pages are only resident while read.
+	Mutex mapped_packs_mutex;
+	HashMap<String, Ref<FileAccess>> mapped_packs; ///< Null for packs that can't be mapped.
+
+	Ref<FileAccess> _get_mapped_pack(const String &p_pack);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -180,6 +199,15 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	const uint8_t *mapped = nullptr; ///< The file's data when `f` is a mapped pack shared with other files.
+
+	// Compressed files are decompressed one block at a time.
+	LocalVector<uint64_t> block_offsets; ///< Start of each block from `off`, followed by the end of the last one.
+	mutable LocalVector<uint8_t> block_data;
+	mutable LocalVector<uint8_t> block_source; ///< Compressed data of the block, when not mapped.
+	mutable int64_t current_block = -1;
+
+	bool _load_block(uint64_t p_block) const;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual uint64_t _get_access_time(const String &p_file) override { return 0; }
@@ -203,6 +231,7 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_position, uint64_t p_length) const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -216,7 +245,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>());
 };
 
 int64_t PackedData::get_size(const String &p_path) {
@@ -55,13 +55,15 @@ const char *JSON::tk_name[TK_MAX] = {
 	"EOF",
 };
 
-void JSON::_add_indent(String &r_result, const String &p_indent, int p_size) {
+template <typename T>
+void JSON::_add_indent(T &r_result, const String &p_indent, int p_size) {
 	for (int i = 0; i < p_size; i++) {
 		r_result += p_indent;
 	}
 }
 
-void JSON::_stringify(String &r_result, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
+template <typename T>
+void JSON::_stringify(T &r_result, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision) {
 	if (p_cur_indent > Variant::MAX_RECURSION_DEPTH) {
 		r_result += "...";
 		ERR_FAIL_MSG("JSON structure is too deep. Bailing.");
@@ -594,6 +596,86 @@ Error JSON::parse(const String &p_json_string, bool p_keep_text) {
 	return err;
 }
 
+// Builds the same `Variant` as `JSON::_parse_string()` from parser events.
+class JSONVariantBuilder : public JSONStreamHandler {
+	LocalVector<Variant> containers;
+	LocalVector<String> keys;
+
+	Error _add(const Variant &p_value) {
+		if (containers.is_empty()) {
+			result = p_value;
+		} else if (containers[containers.size() - 1].get_type() == Variant::ARRAY) {
+			Array array = containers[containers.size() - 1];
+			array.push_back(p_value);
+		} else {
+			Dictionary object = containers[containers.size() - 1];
+			object[keys[keys.size() - 1]] = p_value;
+		}
+		return OK;
+	}
+
+	Error _end() {
+		const Variant container = containers[containers.size() - 1];
+		containers.resize(containers.size() - 1);
+		keys.resize(keys.size() - 1);
+		return _add(container);
+	}
+
+public:
+	Variant result;
+
+	virtual Error begin_object() override {
+		containers.push_back(Dictionary());
+		keys.push_back(String());
+		return OK;
+	}
+	virtual Error end_object() override { return _end(); }
+	virtual Error begin_array() override {
+		containers.push_back(Array());
+		keys.push_back(String());
+		return OK;
+	}
+	virtual Error end_array() override { return _end(); }
+	virtual Error key(const String &p_key) override {
+		keys[keys.size() - 1] = p_key;
+		return OK;
+	}
+	virtual Error value(const Variant &p_value) override { return _add(p_value); }
+};
+
+Error JSON::parse_utf8(const Vector<uint8_t> &p_json_utf8) {
+	JSONVariantBuilder builder;
+	JSONStreamParser parser;
+	Error err = parser.parse(p_json_utf8, &builder);
+	text.clear();
+	if (err == OK) {
+		data = builder.result;
+		err_line = 0;
+		err_str.clear();
+	} else {
+		err_line = parser.get_error_line();
+		err_str = parser.get_error_message();
+	}
+	return err;
+}
+
+Error JSON::parse_file(const Ref<FileAccess> &p_file) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	JSONVariantBuilder builder;
+	JSONStreamParser parser;
+	Error err = parser.parse(p_file, &builder);
+	text.clear();
+	if (err == OK) {
+		data = builder.result;
+		err_line = 0;
+		err_str.clear();
+	} else {
+		err_line = parser.get_error_line();
+		err_str = parser.get_error_message();
+	}
+	return err;
+}
+
 String JSON::get_parsed_text() const {
 	return text;
 }
@@ -605,6 +687,13 @@ String JSON::stringify(const Variant &p_var, const String &p_indent, bool p_sort
 	return result;
 }
 
+Error JSON::stringify_to_file(const Ref<FileAccess> &p_file, const Variant &p_var, const String &p_indent, bool p_sort_keys, bool p_full_precision) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	JSONStreamWriter writer(p_file, p_indent, p_sort_keys, p_full_precision);
+	writer.value(p_var);
+	return writer.flush();
+}
+
 Variant JSON::parse_string(const String &p_json_string) {
 	Ref<JSON> json;
 	json.instantiate();
@@ -630,6 +719,639 @@ void JSON::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::NIL, "data", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_NIL_IS_VARIANT), "set_data", "get_data"); // Ensures that it can be serialized as binary.
 }
 
+bool JSONStreamParser::_refill() {
+	if (file.is_null()) {
+		return false;
+	}
+	size = file->get_buffer(chunk.ptr(), chunk.size());
+	data = chunk.ptr();
+	pos = 0;
+	return size > 0;
+}
+
+void JSONStreamParser::_append_utf8(char32_t p_char) {
+	if (p_char < 0x80) {
+		string_buffer.push_back(char(p_char));
+	} else if (p_char < 0x800) {
+		string_buffer.push_back(char(0xc0 | (p_char >> 6)));
+		string_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	} else if (p_char < 0x10000) {
+		string_buffer.push_back(char(0xe0 | (p_char >> 12)));
+		string_buffer.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		string_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	} else {
+		string_buffer.push_back(char(0xf0 | (p_char >> 18)));
+		string_buffer.push_back(char(0x80 | ((p_char >> 12) & 0x3f)));
+		string_buffer.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		string_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	}
+}
+
+Error JSONStreamParser::_read_hex(char32_t &r_value) {
+	r_value = 0;
+	for (int j = 0; j < 4; j++) {
+		const uint8_t c = _next();
+		if (c == 0) {
+			err_str = "Unterminated string";
+			return ERR_PARSE_ERROR;
+		}
+		if (!is_hex_digit(c)) {
+			err_str = "Malformed hex constant in string";
+			return ERR_PARSE_ERROR;
+		}
+		r_value <<= 4;
+		if (is_digit(c)) {
+			r_value |= c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			r_value |= c - 'a' + 10;
+		} else {
+			r_value |= c - 'A' + 10;
+		}
+	}
+	return OK;
+}
+
+Error JSONStreamParser::_read_string() {
+	string_buffer.clear();
+	while (true) {
+		if (pos == size && !_refill()) {
+			err_str = "Unterminated string";
+			return ERR_PARSE_ERROR;
+		}
+
+		// Copy everything up to the next character that needs attention at once.
+		const uint8_t *begin = data + pos;
+		const uint8_t *end = data + size;
+		const uint8_t *ptr = begin;
+		while (ptr < end && *ptr != '"' && *ptr != '\\' && *ptr != '\n' && *ptr != 0) {
+			ptr++;
+		}
+		if (ptr > begin) {
+			const uint32_t offset = string_buffer.size();
+			string_buffer.resize(offset + (ptr - begin));
+			memcpy(string_buffer.ptr() + offset, begin, ptr - begin);
+		}
+		pos = ptr - data;
+		if (ptr == end) {
+			continue;
+		}
+
+		const uint8_t c = *ptr;
+		if (c == 0) {
+			err_str = "Unterminated string";
+			return ERR_PARSE_ERROR;
+		}
+		pos++;
+		if (c == '"') {
+			break;
+		}
+		if (c == '\n') {
+			line++;
+			string_buffer.push_back('\n');
+			continue;
+		}
+
+		// Escaped characters.
+		const uint8_t next = _next();
+		switch (next) {
+			case 0: {
+				err_str = "Unterminated string";
+				return ERR_PARSE_ERROR;
+			}
+			case 'b': {
+				string_buffer.push_back(8);
+			} break;
+			case 't': {
+				string_buffer.push_back(9);
+			} break;
+			case 'n': {
+				string_buffer.push_back(10);
+			} break;
+			case 'f': {
+				string_buffer.push_back(12);
+			} break;
+			case 'r': {
+				string_buffer.push_back(13);
+			} break;
+			case '"':
+			case '\\':
+			case '/': {
+				string_buffer.push_back(next);
+			} break;
+			case 'u': {
+				char32_t res;
+				Error err = _read_hex(res);
+				if (err != OK) {
+					return err;
+				}
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (_peek() != '\\') {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					pos++;
+					if (_peek() != 'u') {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					pos++;
+					char32_t trail;
+					err = _read_hex(trail);
+					if (err != OK) {
+						return err;
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				_append_utf8(res);
+			} break;
+			default: {
+				err_str = "Invalid escape sequence";
+				return ERR_PARSE_ERROR;
+			}
+		}
+	}
+
+	token_string = String();
+	const char *utf8 = string_buffer.ptr();
+	int len = string_buffer.size();
+	// `append_utf8()` skips a byte order mark, which is content here.
+	while (len >= 3 && uint8_t(utf8[0]) == 0xef && uint8_t(utf8[1]) == 0xbb && uint8_t(utf8[2]) == 0xbf) {
+		token_string += char32_t(0xfeff);
+		utf8 += 3;
+		len -= 3;
+	}
+	if (len > 0) {
+		token_string.append_utf8(utf8, len);
+	}
+	return OK;
+}
+
+Error JSONStreamParser::_read_number() {
+	number_buffer.clear();
+	while (true) {
+		const uint8_t c = _peek();
+		if (!is_digit(c) && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') {
+			break;
+		}
+		number_buffer.push_back(c);
+		pos++;
+	}
+	number_buffer.push_back(0);
+
+	const char32_t *end = nullptr;
+	token_number = String::to_float(number_buffer.ptr(), &end);
+	if (end != number_buffer.ptr() + number_buffer.size() - 1) {
+		err_str = "Malformed number";
+		return ERR_PARSE_ERROR;
+	}
+	return OK;
+}
+
+Error JSONStreamParser::_get_token() {
+	while (true) {
+		const uint8_t c = _peek();
+		switch (c) {
+			case 0: {
+				token = JSON::TK_EOF;
+				return OK;
+			}
+			case '\n': {
+				line++;
+				pos++;
+			} break;
+			case '{': {
+				token = JSON::TK_CURLY_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case '}': {
+				token = JSON::TK_CURLY_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case '[': {
+				token = JSON::TK_BRACKET_OPEN;
+				pos++;
+				return OK;
+			}
+			case ']': {
+				token = JSON::TK_BRACKET_CLOSE;
+				pos++;
+				return OK;
+			}
+			case ':': {
+				token = JSON::TK_COLON;
+				pos++;
+				return OK;
+			}
+			case ',': {
+				token = JSON::TK_COMMA;
+				pos++;
+				return OK;
+			}
+			case '"': {
+				token = JSON::TK_STRING;
+				pos++;
+				return _read_string();
+			}
+			default: {
+				if (c <= 32) {
+					pos++;
+					break;
+				}
+
+				if (c == '-' || is_digit(c)) {
+					token = JSON::TK_NUMBER;
+					return _read_number();
+				}
+
+				if (is_ascii_alphabet_char(c)) {
+					string_buffer.clear();
+					while (is_ascii_alphabet_char(_peek())) {
+						string_buffer.push_back(data[pos++]);
+					}
+					token = JSON::TK_IDENTIFIER;
+					token_string = String::utf8(string_buffer.ptr(), string_buffer.size());
+					return OK;
+				}
+
+				err_str = "Unexpected character";
+				return ERR_PARSE_ERROR;
+			}
+		}
+	}
+}
+
+Error JSONStreamParser::_parse_value(int p_depth) {
+	if (p_depth > Variant::MAX_RECURSION_DEPTH) {
+		err_str = "JSON structure is too deep";
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	switch (token) {
+		case JSON::TK_CURLY_BRACKET_OPEN: {
+			Error err = handler->begin_object();
+			if (err != OK) {
+				return err;
+			}
+			return _parse_object(p_depth + 1);
+		}
+		case JSON::TK_BRACKET_OPEN: {
+			Error err = handler->begin_array();
+			if (err != OK) {
+				return err;
+			}
+			return _parse_array(p_depth + 1);
+		}
+		case JSON::TK_IDENTIFIER: {
+			if (token_string == "true") {
+				return handler->value(true);
+			} else if (token_string == "false") {
+				return handler->value(false);
+			} else if (token_string == "null") {
+				return handler->value(Variant());
+			}
+			err_str = vformat("Expected 'true', 'false', or 'null', got '%s'", token_string);
+			return ERR_PARSE_ERROR;
+		}
+		case JSON::TK_NUMBER: {
+			return handler->value(token_number);
+		}
+		case JSON::TK_STRING: {
+			return handler->value(token_string);
+		}
+		default: {
+			err_str = vformat("Expected value, got '%s'", String(JSON::tk_name[token]));
+			return ERR_PARSE_ERROR;
+		}
+	}
+}
+
+Error JSONStreamParser::_parse_array(int p_depth) {
+	bool need_comma = false;
+
+	while (true) {
+		Error err = _get_token();
+		if (err != OK) {
+			return err;
+		}
+
+		if (token == JSON::TK_BRACKET_CLOSE) {
+			return handler->end_array();
+		}
+		if (token == JSON::TK_EOF) {
+			err_str = "Expected ']'";
+			return ERR_PARSE_ERROR;
+		}
+
+		if (need_comma) {
+			if (token != JSON::TK_COMMA) {
+				err_str = "Expected ','";
+				return ERR_PARSE_ERROR;
+			}
+			need_comma = false;
+			continue;
+		}
+
+		err = _parse_value(p_depth);
+		if (err != OK) {
+			return err;
+		}
+		need_comma = true;
+	}
+}
+
+Error JSONStreamParser::_parse_object(int p_depth) {
+	bool need_comma = false;
+
+	while (true) {
+		Error err = _get_token();
+		if (err != OK) {
+			return err;
+		}
+
+		if (token == JSON::TK_CURLY_BRACKET_CLOSE) {
+			return handler->end_object();
+		}
+		if (token == JSON::TK_EOF) {
+			err_str = "Expected '}'";
+			return ERR_PARSE_ERROR;
+		}
+
+		if (need_comma) {
+			if (token != JSON::TK_COMMA) {
+				err_str = "Expected '}' or ','";
+				return ERR_PARSE_ERROR;
+			}
+			need_comma = false;
+			continue;
+		}
+
+		if (token != JSON::TK_STRING) {
+			err_str = "Expected key";
+			return ERR_PARSE_ERROR;
+		}
+		const String key = token_string;
+
+		err = _get_token();
+		if (err != OK) {
+			return err;
+		}
+		if (token != JSON::TK_COLON) {
+			err_str = "Expected ':'";
+			return ERR_PARSE_ERROR;
+		}
+		err = handler->key(key);
+		if (err != OK) {
+			return err;
+		}
+
+		err = _get_token();
+		if (err != OK) {
+			return err;
+		}
+		err = _parse_value(p_depth);
+		if (err != OK) {
+			return err;
+		}
+		need_comma = true;
+	}
+}
+
+Error JSONStreamParser::_parse(JSONStreamHandler *p_handler) {
+	ERR_FAIL_NULL_V(p_handler, ERR_INVALID_PARAMETER);
+	handler = p_handler;
+	line = 0;
+	err_str.clear();
+
+	// Skip the byte order mark, like `String::utf8()`.
+	if (_peek() == 0xef && size - pos >= 3 && data[pos + 1] == 0xbb && data[pos + 2] == 0xbf) {
+		pos += 3;
+	}
+
+	Error err = _get_token();
+	if (err == OK) {
+		err = _parse_value(0);
+	}
+	if (err == OK) {
+		err = _get_token();
+		if (err != OK || token != JSON::TK_EOF) {
+			err_str = "Expected 'EOF'";
+			err = ERR_PARSE_ERROR;
+		}
+	}
+
+	handler = nullptr;
+	file.unref();
+	data = nullptr;
+	size = 0;
+	pos = 0;
+	return err;
+}
+
+Error JSONStreamParser::parse(const uint8_t *p_data, uint64_t p_size, JSONStreamHandler *p_handler) {
+	file.unref();
+	data = p_data;
+	size = p_size;
+	pos = 0;
+	return _parse(p_handler);
+}
+
+Error JSONStreamParser::parse(const Vector<uint8_t> &p_data, JSONStreamHandler *p_handler) {
+	return parse(p_data.ptr(), p_data.size(), p_handler);
+}
+
+Error JSONStreamParser::parse(const Ref<FileAccess> &p_file, JSONStreamHandler *p_handler) {
+	ERR_FAIL_COND_V(p_file.is_null(), ERR_INVALID_PARAMETER);
+	file = p_file;
+	chunk.resize(CHUNK_SIZE);
+	data = chunk.ptr();
+	size = 0;
+	pos = 0;
+	return _parse(p_handler);
+}
+
+JSONStreamWriter &JSONStreamWriter::operator+=(char p_char) {
+	buffer.push_back(p_char);
+	if (unlikely(buffer.size() >= JSONStreamParser::CHUNK_SIZE)) {
+		flush();
+	}
+	return *this;
+}
+
+JSONStreamWriter &JSONStreamWriter::operator+=(const char *p_str) {
+	while (*p_str) {
+		buffer.push_back(*p_str++);
+	}
+	if (unlikely(buffer.size() >= JSONStreamParser::CHUNK_SIZE)) {
+		flush();
+	}
+	return *this;
+}
+
+JSONStreamWriter &JSONStreamWriter::operator+=(const String &p_str) {
+	const char32_t *str = p_str.ptr();
+	const int len = p_str.length();
+	for (int i = 0; i < len; i++) {
+		_write_utf8(str[i]);
+	}
+	if (unlikely(buffer.size() >= JSONStreamParser::CHUNK_SIZE)) {
+		flush();
+	}
+	return *this;
+}
+
+void JSONStreamWriter::_write_utf8(char32_t p_char) {
+	if (p_char < 0x80) {
+		buffer.push_back(p_char);
+	} else if (p_char < 0x800) {
+		buffer.push_back(0xc0 | (p_char >> 6));
+		buffer.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char < 0x10000) {
+		buffer.push_back(0xe0 | (p_char >> 12));
+		buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		buffer.push_back(0x80 | (p_char & 0x3f));
+	} else if (p_char <= 0x10ffff) {
+		buffer.push_back(0xf0 | (p_char >> 18));
+		buffer.push_back(0x80 | ((p_char >> 12) & 0x3f));
+		buffer.push_back(0x80 | ((p_char >> 6) & 0x3f));
+		buffer.push_back(0x80 | (p_char & 0x3f));
+	} else {
+		_write_utf8(0xfffd);
+	}
+}
+
+void JSONStreamWriter::_write_newline_and_indent(int p_depth) {
+	if (!indent.is_empty()) {
+		*this += '\n';
+		JSON::_add_indent(*this, indent, p_depth);
+	}
+}
+
+Error JSONStreamWriter::_begin_value() {
+	if (levels.is_empty()) {
+		return OK;
+	}
+
+	Level &level = levels[levels.size() - 1];
+	if (level.is_object) {
+		ERR_FAIL_COND_V_MSG(!level.has_key, ERR_INVALID_PARAMETER, "A value in a JSON object needs a key.");
+		level.has_key = false;
+		return OK;
+	}
+
+	if (level.is_empty) {
+		level.is_empty = false;
+	} else {
+		*this += ',';
+	}
+	_write_newline_and_indent(levels.size());
+	return OK;
+}
+
+Error JSONStreamWriter::begin_object() {
+	Error err = _begin_value();
+	if (err != OK) {
+		return err;
+	}
+	*this += '{';
+	if (!indent.is_empty()) {
+		*this += '\n';
+	}
+	Level level;
+	level.is_object = true;
+	levels.push_back(level);
+	return OK;
+}
+
+Error JSONStreamWriter::end_object() {
+	ERR_FAIL_COND_V(levels.is_empty() || !levels[levels.size() - 1].is_object, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(levels[levels.size() - 1].has_key, ERR_INVALID_PARAMETER, "A key in a JSON object needs a value.");
+	levels.resize(levels.size() - 1);
+	_write_newline_and_indent(levels.size());
+	*this += '}';
+	return OK;
+}
+
+Error JSONStreamWriter::begin_array() {
+	Error err = _begin_value();
+	if (err != OK) {
+		return err;
+	}
+	*this += '[';
+	levels.push_back(Level());
+	return OK;
+}
+
+Error JSONStreamWriter::end_array() {
+	ERR_FAIL_COND_V(levels.is_empty() || levels[levels.size() - 1].is_object, ERR_INVALID_PARAMETER);
+	const bool is_empty = levels[levels.size() - 1].is_empty;
+	levels.resize(levels.size() - 1);
+	if (!is_empty) {
+		_write_newline_and_indent(levels.size());
+	}
+	*this += ']';
+	return OK;
+}
+
+Error JSONStreamWriter::key(const String &p_key) {
+	ERR_FAIL_COND_V(levels.is_empty() || !levels[levels.size() - 1].is_object, ERR_INVALID_PARAMETER);
+	Level &level = levels[levels.size() - 1];
+	ERR_FAIL_COND_V_MSG(level.has_key, ERR_INVALID_PARAMETER, "A key in a JSON object needs a value.");
+
+	if (level.is_empty) {
+		level.is_empty = false;
+	} else {
+		*this += ',';
+		if (!indent.is_empty()) {
+			*this += '\n';
+		}
+	}
+	level.has_key = true;
+	JSON::_add_indent(*this, indent, levels.size());
+	JSON::_stringify(*this, p_key, indent, levels.size(), sort_keys, markers, full_precision);
+	*this += indent.is_empty() ? ":" : ": ";
+	return OK;
+}
+
+Error JSONStreamWriter::value(const Variant &p_value) {
+	Error err = _begin_value();
+	if (err != OK) {
+		return err;
+	}
+	JSON::_stringify(*this, p_value, indent, levels.size(), sort_keys, markers, full_precision);
+	return OK;
+}
+
+Error JSONStreamWriter::flush() {
+	if (!buffer.is_empty()) {
+		file->store_buffer(buffer.ptr(), buffer.size());
+		buffer.clear();
+	}
+	const Error err = file->get_error();
+	return err == ERR_FILE_EOF ? OK : err;
+}
+
+JSONStreamWriter::JSONStreamWriter(const Ref<FileAccess> &p_file, const String &p_indent, bool p_sort_keys, bool p_full_precision) :
+		file(p_file),
+		indent(p_indent),
+		sort_keys(p_sort_keys),
+		full_precision(p_full_precision) {
+	CRASH_COND(file.is_null());
+	buffer.reserve(JSONStreamParser::CHUNK_SIZE);
+}
+
+JSONStreamWriter::~JSONStreamWriter() {
+	flush();
+}
+
 #define TYPE "type"
 #define ELEM_TYPE "elem_type"
 #define KEY_TYPE "key_type"
@@ -1580,7 +2302,15 @@ Ref<Resource> ResourceFormatLoaderJSON::load(const String &p_path, const String
 	Ref<JSON> json;
 	json.instantiate();
 
-	Error err = json->parse(FileAccess::get_file_as_string(p_path), Engine::get_singleton()->is_editor_hint());
+	Error err;
+	if (Engine::get_singleton()->is_editor_hint()) {
+		// The editor keeps the source text around for the code editor.
+		err = json->parse(FileAccess::get_file_as_string(p_path), true);
+	} else {
+		Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::READ, &err);
+		ERR_FAIL_COND_V_MSG(file.is_null(), Ref<Resource>(), vformat("Cannot open file '%s'.", p_path));
+		err = json->parse_file(file);
+	}
 	if (err != OK) {
 		String err_text = "Error parsing JSON file at '" + p_path + "', on line " + itos(json->get_error_line()) + ": " + json->get_error_message();
 
@@ -1623,15 +2353,19 @@ Error ResourceFormatSaverJSON::save(const Ref<Resource> &p_resource, const Strin
 	Ref<JSON> json = p_resource;
 	ERR_FAIL_COND_V(json.is_null(), ERR_INVALID_PARAMETER);
 
-	String source = json->get_parsed_text().is_empty() ? JSON::stringify(json->get_data(), "\t", false, true) : json->get_parsed_text();
-
 	Error err;
 	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
 
 	ERR_FAIL_COND_V_MSG(err, err, vformat("Cannot save json '%s'.", p_path));
 
-	file->store_string(source);
-	if (file->get_error() != OK && file->get_error() != ERR_FILE_EOF) {
+	if (json->get_parsed_text().is_empty()) {
+		// Write straight to the file instead of building the whole text first.
+		err = JSON::stringify_to_file(file, json->get_data(), "\t", false, true);
+	} else {
+		file->store_string(json->get_parsed_text());
+		err = file->get_error() == ERR_FILE_EOF ? OK : file->get_error();
+	}
+	if (err != OK) {
 		return ERR_CANT_CREATE;
 	}
 
@@ -38,14 +38,33 @@
  * [Add any documentation that applies to the entire file here!]
  */
 
+#include "core/io/file_access.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/variant/variant.h"
 
+/// Receives the events of a JSON document read by `JSONStreamParser`, in
+/// document order. Returning an error stops parsing.
+class JSONStreamHandler {
+public:
+	virtual Error begin_object() { return OK; }
+	virtual Error end_object() { return OK; }
+	virtual Error begin_array() { return OK; }
+	virtual Error end_array() { return OK; }
+	virtual Error key(const String &p_key) { return OK; }
+	/// Strings, numbers (always floats, like `JSON.parse()`), booleans and `null`.
+	virtual Error value(const Variant &p_value) { return OK; }
+
+	virtual ~JSONStreamHandler() {}
+};
+
 class JSON : public Resource {
 	GDCLASS(JSON, Resource);
 
+	friend class JSONStreamParser;
+	friend class JSONStreamWriter;
+
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
@@ -79,8 +98,10 @@ class JSON : public Resource {
 
 	static const char *tk_name[];
 
-	static void _add_indent(String &r_result, const String &p_indent, int p_size);
-	static void _stringify(String &r_result, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision);
+	template <typename T>
+	static void _add_indent(T &r_result, const String &p_indent, int p_size);
+	template <typename T>
+	static void _stringify(T &r_result, const Variant &p_var, const String &p_indent, int p_cur_indent, bool p_sort_keys, HashSet<const void *> &p_markers, bool p_full_precision);
 	static Error _get_token(const char32_t *p_str, int &index, int p_len, Token &r_token, int &line, String &r_err_str);
 	static Error _parse_value(Variant &value, Token &token, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
 	static Error _parse_array(Array &array, const char32_t *p_str, int &index, int p_len, int &line, int p_depth, String &r_err_str);
@@ -95,9 +116,14 @@ protected:
 
 public:
 	Error parse(const String &p_json_string, bool p_keep_text = false);
+	/// Like `parse()`, for UTF-8 text. Files are read in chunks, see `JSONStreamParser`.
+	Error parse_utf8(const Vector<uint8_t> &p_json_utf8);
+	Error parse_file(const Ref<FileAccess> &p_file);
 	String get_parsed_text() const;
 
 	static String stringify(const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	/// Same output as `stringify()`, written to `p_file` as it is generated.
+	static Error stringify_to_file(const Ref<FileAccess> &p_file, const Variant &p_var, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
 	static Variant parse_string(const String &p_json_string);
 
 	_FORCE_INLINE_ static Variant from_native(const Variant &p_variant, bool p_full_objects = false) {
@@ -114,6 +140,110 @@ public:
 	_FORCE_INLINE_ String get_error_message() const { return err_str; }
 };
 
+/// Parses UTF-8 JSON from a byte buffer, or from a file in chunks of
+/// `CHUNK_SIZE` bytes, so the document never has to be in memory as a whole.
+/// Only the string being read is decoded to a `String`.
+class JSONStreamParser {
+public:
+	static constexpr uint32_t CHUNK_SIZE = 64 * 1024;
+
+private:
+	Ref<FileAccess> file;
+	LocalVector<uint8_t> chunk;
+	const uint8_t *data = nullptr;
+	uint64_t size = 0;
+	uint64_t pos = 0;
+
+	JSONStreamHandler *handler = nullptr;
+	LocalVector<char> string_buffer;
+	LocalVector<char32_t> number_buffer;
+	JSON::TokenType token = JSON::TK_EOF;
+	double token_number = 0.0;
+	String token_string;
+
+	int line = 0;
+	String err_str;
+
+	bool _refill();
+	_FORCE_INLINE_ uint8_t _peek() {
+		if (unlikely(pos == size) && !_refill()) {
+			return 0;
+		}
+		return data[pos];
+	}
+	_FORCE_INLINE_ uint8_t _next() {
+		const uint8_t c = _peek();
+		if (likely(c != 0)) {
+			pos++;
+		}
+		return c;
+	}
+
+	void _append_utf8(char32_t p_char);
+	Error _read_hex(char32_t &r_value);
+	Error _read_string();
+	Error _read_number();
+	Error _get_token();
+	Error _parse_value(int p_depth);
+	Error _parse_array(int p_depth);
+	Error _parse_object(int p_depth);
+	Error _parse(JSONStreamHandler *p_handler);
+
+public:
+	Error parse(const uint8_t *p_data, uint64_t p_size, JSONStreamHandler *p_handler);
+	Error parse(const Vector<uint8_t> &p_data, JSONStreamHandler *p_handler);
+	Error parse(const Ref<FileAccess> &p_file, JSONStreamHandler *p_handler);
+
+	/// Same numbering as `JSON::get_error_line()`.
+	int get_error_line() const { return line; }
+	String get_error_message() const { return err_str; }
+};
+
+/// Writes JSON to a file through a small buffer, either from events (it can be
+/// given to `JSONStreamParser` to reformat a document) or from `Variant`s,
+/// formatted exactly like `JSON::stringify()`.
+class JSONStreamWriter : public JSONStreamHandler {
+	friend class JSON;
+
+	struct Level {
+		bool is_object = false;
+		bool is_empty = true;
+		bool has_key = false;
+	};
+
+	Ref<FileAccess> file;
+	String indent;
+	bool sort_keys = true;
+	bool full_precision = false;
+
+	LocalVector<uint8_t> buffer;
+	LocalVector<Level> levels;
+	HashSet<const void *> markers;
+
+	void _write_utf8(char32_t p_char);
+	void _write_newline_and_indent(int p_depth);
+	Error _begin_value();
+
+	// Output interface used by `JSON::_stringify()`.
+	JSONStreamWriter &operator+=(char p_char);
+	JSONStreamWriter &operator+=(const char *p_str);
+	JSONStreamWriter &operator+=(const String &p_str);
+
+public:
+	virtual Error begin_object() override;
+	virtual Error end_object() override;
+	virtual Error begin_array() override;
+	virtual Error end_array() override;
+	virtual Error key(const String &p_key) override;
+	virtual Error value(const Variant &p_value) override;
+
+	/// Writes buffered output to the file and returns its error, if any.
+	Error flush();
+
+	JSONStreamWriter(const Ref<FileAccess> &p_file, const String &p_indent = "", bool p_sort_keys = true, bool p_full_precision = false);
+	~JSONStreamWriter();
+};
+
 class ResourceFormatLoaderJSON : public ResourceFormatLoader {
 public:
 	virtual Ref<Resource> load(const String &p_path, const String &p_original_path = "", Error *r_error = nullptr, bool p_use_sub_threads = false, float *r_progress = nullptr, CacheMode p_cache_mode = CACHE_MODE_REUSE) override;
@@ -190,6 +190,18 @@ static Error _decode_container_type(const uint8_t *&buf, int &len, int *r_len, b
 	ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Invalid container type kind."); // Future proofing.
 }
 
+// Takes the packed array already held by `r_variant`, so that resizing it reuses its allocation
+// when nothing else references it. Only called once the data has been validated.
+template <typename T>
+static _FORCE_INLINE_ Vector<T> _take_packed_array(Variant &r_variant, Variant::Type p_type) {
+	if (r_variant.get_type() != p_type) {
+		return Vector<T>();
+	}
+	Vector<T> data = r_variant;
+	r_variant = Variant();
+	return data;
+}
+
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len, bool p_allow_objects, int p_depth) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Variant is too deep. Bailing.");
 	const uint8_t *buf = p_buffer;
@@ -932,14 +944,10 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			len -= 4;
 			ERR_FAIL_COND_V(count < 0 || count > len, ERR_INVALID_DATA);
 
-			Vector<uint8_t> data;
-
+			Vector<uint8_t> data = _take_packed_array<uint8_t>(r_variant, Variant::PACKED_BYTE_ARRAY);
+			data.resize(count);
 			if (count) {
-				data.resize(count);
-				uint8_t *w = data.ptrw();
-				for (int32_t i = 0; i < count; i++) {
-					w[i] = buf[i];
-				}
+				memcpy(data.ptrw(), buf, count);
 			}
 
 			r_variant = data;
@@ -960,15 +968,18 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<int32_t> data;
-
+			Vector<int32_t> data = _take_packed_array<int32_t>(r_variant, Variant::PACKED_INT32_ARRAY);
+			data.resize(count);
 			if (count) {
-				//const int *rbuf = (const int *)buf;
-				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				int32_t *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint32(&buf[i * 4]);
 				}
+#else
+				// The encoding is little-endian, same as the host.
+				memcpy(data.ptrw(), buf, count * sizeof(int32_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -984,15 +995,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<int64_t> data;
-
+			Vector<int64_t> data = _take_packed_array<int64_t>(r_variant, Variant::PACKED_INT64_ARRAY);
+			data.resize(count);
 			if (count) {
-				//const int *rbuf = (const int *)buf;
-				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				int64_t *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
+				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_uint64(&buf[i * 8]);
 				}
+#else
+				memcpy(data.ptrw(), buf, count * sizeof(int64_t));
+#endif
 			}
 			r_variant = Variant(data);
 			if (r_len) {
@@ -1008,15 +1021,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 4, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 4 > len, ERR_INVALID_DATA);
 
-			Vector<float> data;
-
+			Vector<float> data = _take_packed_array<float>(r_variant, Variant::PACKED_FLOAT32_ARRAY);
+			data.resize(count);
 			if (count) {
-				//const float *rbuf = (const float *)buf;
-				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				float *w = data.ptrw();
 				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_float(&buf[i * 4]);
 				}
+#else
+				memcpy(data.ptrw(), buf, count * sizeof(float));
+#endif
 			}
 			r_variant = data;
 
@@ -1033,14 +1048,17 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 			ERR_FAIL_MUL_OF(count, 8, ERR_INVALID_DATA);
 			ERR_FAIL_COND_V(count < 0 || count * 8 > len, ERR_INVALID_DATA);
 
-			Vector<double> data;
-
+			Vector<double> data = _take_packed_array<double>(r_variant, Variant::PACKED_FLOAT64_ARRAY);
+			data.resize(count);
 			if (count) {
-				data.resize(count);
+#ifdef BIG_ENDIAN_ENABLED
 				double *w = data.ptrw();
-				for (int64_t i = 0; i < count; i++) {
+				for (int32_t i = 0; i < count; i++) {
 					w[i] = decode_double(&buf[i * 8]);
 				}
+#else
+				memcpy(data.ptrw(), buf, count * sizeof(double));
+#endif
 			}
 			r_variant = data;
 
@@ -2138,6 +2156,148 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 	return OK;
 }
 
+static _FORCE_INLINE_ uint8_t *_grow(LocalVector<uint8_t> &r_buffer, int p_size) {
+	const uint32_t ofs = r_buffer.size();
+	r_buffer.resize(ofs + p_size);
+	return r_buffer.ptr() + ofs;
+}
+
+static _FORCE_INLINE_ uint8_t *_grow(Vector<uint8_t> &r_buffer, int p_size) {
+	const int ofs = r_buffer.size();
+	r_buffer.resize(ofs + p_size);
+	return r_buffer.ptrw() + ofs;
+}
+
+// Whether `p_buffer` would outgrow `p_max_size` with `p_extra` more bytes, negative sizes are unlimited.
+template <typename T>
+static _FORCE_INLINE_ bool _exceeds(const T &p_buffer, int64_t p_extra, int64_t p_max_size) {
+	return p_max_size >= 0 && int64_t(p_buffer.size()) + p_extra > p_max_size;
+}
+
+template <typename T>
+static void _append_string(const String &p_string, T &r_buffer, bool p_null_terminated = false) {
+	const CharString utf8 = p_string.utf8();
+	const int len = utf8.length() + (p_null_terminated ? 1 : 0);
+	const int pad = (4 - len % 4) % 4;
+
+	uint8_t *buf = _grow(r_buffer, 4 + len + pad);
+	encode_uint32(len, buf);
+	memcpy(buf + 4, utf8.get_data(), len);
+	memset(buf + 4 + len, 0, pad);
+}
+
+template <typename T>
+static Error _append_container_type(const ContainerType &p_type, T &r_buffer, bool p_full_objects) {
+	uint8_t *buf = nullptr;
+	int len = 0;
+	Error err = _encode_container_type(p_type, buf, len, p_full_objects);
+	if (err || len == 0) {
+		return err;
+	}
+
+	buf = _grow(r_buffer, len);
+	len = 0;
+	return _encode_container_type(p_type, buf, len, p_full_objects);
+}
+
+template <typename T>
+static Error _encode_variant_append(const Variant &p_variant, T &r_buffer, bool p_full_objects, int p_depth, int64_t p_max_size) {
+	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
+
+	// Only containers and strings are handled here, they are the ones that take a full pass to measure.
+	switch (p_variant.get_type()) {
+		case Variant::STRING:
+		case Variant::STRING_NAME: {
+			encode_uint32(p_variant.get_type(), _grow(r_buffer, 4));
+			_append_string(p_variant, r_buffer);
+			if (_exceeds(r_buffer, 0, p_max_size)) {
+				return ERR_PARAMETER_RANGE_ERROR;
+			}
+		} break;
+		case Variant::PACKED_STRING_ARRAY: {
+			const Vector<String> strings = p_variant;
+			uint8_t *buf = _grow(r_buffer, 8);
+			encode_uint32(Variant::PACKED_STRING_ARRAY, buf);
+			encode_uint32(strings.size(), buf + 4);
+			for (const String &str : strings) {
+				_append_string(str, r_buffer, true);
+				if (_exceeds(r_buffer, 0, p_max_size)) {
+					return ERR_PARAMETER_RANGE_ERROR;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dict = p_variant;
+			uint32_t header = Variant::DICTIONARY;
+			_encode_container_type_header(dict.get_key_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_KEY_SHIFT, p_full_objects);
+			_encode_container_type_header(dict.get_value_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT, p_full_objects);
+			encode_uint32(header, _grow(r_buffer, 4));
+
+			Error err = _append_container_type(dict.get_key_type(), r_buffer, p_full_objects);
+			if (err) {
+				return err;
+			}
+			err = _append_container_type(dict.get_value_type(), r_buffer, p_full_objects);
+			if (err) {
+				return err;
+			}
+
+			encode_uint32(uint32_t(dict.size()), _grow(r_buffer, 4));
+			for (const KeyValue<Variant, Variant> &kv : dict) {
+				err = _encode_variant_append(kv.key, r_buffer, p_full_objects, p_depth + 1, p_max_size);
+				if (err) {
+					return err;
+				}
+				err = _encode_variant_append(kv.value, r_buffer, p_full_objects, p_depth + 1, p_max_size);
+				if (err) {
+					return err;
+				}
+			}
+		} break;
+		case Variant::ARRAY: {
+			const Array array = p_variant;
+			uint32_t header = Variant::ARRAY;
+			_encode_container_type_header(array.get_element_type(), header, HEADER_DATA_FIELD_TYPED_ARRAY_SHIFT, p_full_objects);
+			encode_uint32(header, _grow(r_buffer, 4));
+
+			Error err = _append_container_type(array.get_element_type(), r_buffer, p_full_objects);
+			if (err) {
+				return err;
+			}
+
+			encode_uint32(uint32_t(array.size()), _grow(r_buffer, 4));
+			for (const Variant &elem : array) {
+				err = _encode_variant_append(elem, r_buffer, p_full_objects, p_depth + 1, p_max_size);
+				if (err) {
+					return err;
+				}
+			}
+		} break;
+		default: {
+			// Measuring other types doesn't touch their contents (objects and node paths aside, which are small).
+			int len;
+			Error err = encode_variant(p_variant, nullptr, len, p_full_objects, p_depth);
+			if (err) {
+				return err;
+			}
+			if (_exceeds(r_buffer, len, p_max_size)) {
+				return ERR_PARAMETER_RANGE_ERROR;
+			}
+			return encode_variant(p_variant, _grow(r_buffer, len), len, p_full_objects, p_depth);
+		}
+	}
+
+	return OK;
+}
+
+Error encode_variant_append(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects, int64_t p_max_size) {
+	return _encode_variant_append(p_variant, r_buffer, p_full_objects, 0, p_max_size);
+}
+
+Error encode_variant_append(const Variant &p_variant, Vector<uint8_t> &r_buffer, bool p_full_objects, int64_t p_max_size) {
+	return _encode_variant_append(p_variant, r_buffer, p_full_objects, 0, p_max_size);
+}
+
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count) {
 	Vector<float> floats;
 	if (count == 0) {
@@ -40,6 +40,7 @@
 
 #include "core/math/math_defs.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/typedefs.h"
 #include "core/variant/variant.h"
 
@@ -232,6 +233,14 @@ public:
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
 Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
 
+/// Appends the same bytes as `encode_variant()` to `r_buffer` in a single pass, growing it as needed,
+/// instead of encoding once to compute the size and again to write. Reusing the buffer avoids allocations.
+/// On error, a partial encoding may be left at the end of `r_buffer`.
+/// Unless `p_max_size` is negative, fails with `ERR_PARAMETER_RANGE_ERROR` as soon as `r_buffer` gets larger
+/// than `p_max_size` bytes, without encoding the rest of the Variant.
+Error encode_variant_append(const Variant &p_variant, LocalVector<uint8_t> &r_buffer, bool p_full_objects = false, int64_t p_max_size = -1);
+Error encode_variant_append(const Variant &p_variant, Vector<uint8_t> &r_buffer, bool p_full_objects = false, int64_t p_max_size = -1);
+
 /// We always allocate a new array, and we don't `memcpy()`.
 /// We also don't consider returning a pointer to the passed vectors when `sizeof(real_t) == 4`.
 /// One reason is that we could decide to put a 4th component in `Vector3` for SIMD/mobile performance,
@@ -47,7 +47,7 @@ void PacketPeer::set_encode_buffer_max_size(int p_max_size) {
 	ERR_FAIL_COND_MSG(p_max_size < 1024, "Max encode buffer must be at least 1024 bytes");
 	ERR_FAIL_COND_MSG(p_max_size > 256 * 1024 * 1024, "Max encode buffer cannot exceed 256 MiB");
 	encode_buffer_max_size = next_power_of_2((uint32_t)p_max_size);
-	encode_buffer.clear();
+	encode_buffer.reset();
 }
 
 int PacketPeer::get_encode_buffer_max_size() const {
@@ -97,28 +97,22 @@ Error PacketPeer::get_var(Variant &r_variant, bool p_allow_objects) {
 }
 
 Error PacketPeer::put_var(const Variant &p_packet, bool p_full_objects) {
-	int len;
-	Error err = encode_variant(p_packet, nullptr, len, p_full_objects); // compute len first
-	if (err) {
-		return err;
+	// The buffer keeps its capacity between calls, so steady traffic encodes without allocating.
+	encode_buffer.clear();
+	// Capped, so an oversized Variant fails as soon as it outgrows the limit instead of being encoded whole.
+	Error err = encode_variant_append(p_packet, encode_buffer, p_full_objects, encode_buffer_max_size);
+	if (unlikely(err == ERR_PARAMETER_RANGE_ERROR)) {
+		encode_buffer.reset();
+		ERR_FAIL_V_MSG(ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
 	}
+	ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
 
+	const int len = encode_buffer.size();
 	if (len == 0) {
 		return OK;
 	}
 
-	ERR_FAIL_COND_V_MSG(len > encode_buffer_max_size, ERR_OUT_OF_MEMORY, "Failed to encode variant, encode size is bigger then encode_buffer_max_size. Consider raising it via 'set_encode_buffer_max_size'.");
-
-	if (unlikely(encode_buffer.size() < len)) {
-		encode_buffer.resize(0); // Avoid realloc
-		encode_buffer.resize(next_power_of_2((uint32_t)len));
-	}
-
-	uint8_t *w = encode_buffer.ptrw();
-	err = encode_variant(p_packet, w, len, p_full_objects);
-	ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to encode Variant.");
-
-	return put_packet(w, len);
+	return put_packet(encode_buffer.ptr(), len);
 }
 
 Variant PacketPeer::_bnd_get_var(bool p_allow_objects) {
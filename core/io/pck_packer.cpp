@@ -39,9 +39,11 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/compression.h"
 #include "core/io/file_access.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/object/worker_thread_pool.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -58,6 +60,8 @@ void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
+	ClassDB::bind_method(D_METHOD("set_compression_block_size", "block_size"), &PCKPacker::set_compression_block_size);
+	ClassDB::bind_method(D_METHOD("get_compression_block_size"), &PCKPacker::get_compression_block_size);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
 }
 
@@ -98,6 +102,7 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	alignment = p_alignment;
 
 	file->store_32(PACK_HEADER_MAGIC);
+	version_ofs = file->get_position();
 	file->store_32(PACK_FORMAT_VERSION);
 	file->store_32(REDOT_VERSION_MAJOR);
 	file->store_32(REDOT_VERSION_MINOR);
@@ -153,6 +158,30 @@ Error PCKPacker::add_file_removal(const String &p_target_path) {
 	return OK;
 }
 
+void PCKPacker::set_compression_block_size(int p_block_size) {
+	ERR_FAIL_COND_MSG(p_block_size != 0 && (p_block_size < 4096 || p_block_size > (1 << 24)), "Invalid compression block size, must be 0 or between 4096 and 16777216 bytes.");
+
+	compression_block_size = p_block_size;
+}
+
+int PCKPacker::get_compression_block_size() const {
+	return compression_block_size;
+}
+
+void PCKPacker::_compress_block(uint32_t p_index, CompressedBlocks *p_blocks) {
+	const uint64_t offset = (uint64_t)p_index * p_blocks->block_size;
+	const int64_t size = MIN((uint64_t)p_blocks->block_size, p_blocks->size - offset);
+
+	Vector<uint8_t> &block = p_blocks->blocks[p_index];
+	block.resize(Compression::get_max_compressed_buffer_size(size, Compression::MODE_ZSTD));
+	const int64_t compressed_size = Compression::compress(block.ptrw(), p_blocks->src + offset, size, Compression::MODE_ZSTD);
+	if (compressed_size < 0 || compressed_size >= size) {
+		block.clear();
+	} else {
+		block.resize(compressed_size);
+	}
+}
+
 Error PCKPacker::add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt) {
 	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
 
@@ -192,7 +221,41 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 		ftmp = fae;
 	}
 
-	ftmp->store_buffer(data);
+	if (compression_block_size && !p_encrypt && !data.is_empty()) {
+		// Blocks are compressed independently, so they can be compressed in parallel and read on their own.
+		CompressedBlocks compressed;
+		compressed.src = data.ptr();
+		compressed.size = data.size();
+		compressed.block_size = compression_block_size;
+		const uint32_t block_count = (data.size() + compression_block_size - 1) / compression_block_size;
+		compressed.blocks.resize(block_count);
+
+		if (WorkerThreadPool::get_singleton() && block_count > 1) {
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &PCKPacker::_compress_block, &compressed, block_count, -1, true, SNAME("PCKPackerCompressBlocks"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		} else {
+			for (uint32_t i = 0; i < block_count; i++) {
+				_compress_block(i, &compressed);
+			}
+		}
+
+		pf.block_size = compression_block_size;
+		pf.blocks.resize(block_count);
+		for (uint32_t i = 0; i < block_count; i++) {
+			const Vector<uint8_t> &block = compressed.blocks[i];
+			if (block.is_empty()) {
+				const uint64_t offset = (uint64_t)i * compression_block_size;
+				const uint32_t size = MIN((uint64_t)compression_block_size, compressed.size - offset);
+				file->store_buffer(data.ptr() + offset, size);
+				pf.blocks.write[i] = size | PACK_BLOCK_UNCOMPRESSED;
+			} else {
+				file->store_buffer(block);
+				pf.blocks.write[i] = block.size();
+			}
+		}
+	} else {
+		ftmp->store_buffer(data);
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -219,6 +282,14 @@ Error PCKPacker::flush(bool p_verbose) {
 
 	// Write directory.
 	uint64_t dir_offset = file->get_position();
+	for (const File &pf : files) {
+		if (pf.block_size) {
+			// The block index of compressed files can't be parsed by V3 readers.
+			file->seek(version_ofs);
+			file->store_32(PACK_FORMAT_VERSION_V4);
+			break;
+		}
+	}
 	file->seek(dir_base_ofs);
 	file->store_64(dir_offset);
 	file->seek(dir_offset);
@@ -261,8 +332,19 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].block_size) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
 
+		if (files[i].block_size) {
+			fhead->store_32(files[i].block_size);
+			fhead->store_32(uint32_t(files[i].blocks.size()));
+			for (uint32_t block : files[i].blocks) {
+				fhead->store_32(block);
+			}
+		}
+
 		if (p_verbose) {
 			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i, file_num, float(i) / file_num * 100, files[i].src_path, files[i].path));
 		}
@@ -39,6 +39,7 @@
  */
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 
 class FileAccess;
 
@@ -50,8 +51,10 @@ class PCKPacker : public RefCounted {
 
 	Vector<uint8_t> key;
 	bool enc_dir = false;
+	uint32_t compression_block_size = 0;
 
 	uint64_t file_base = 0;
+	uint64_t version_ofs = 0;
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
 
@@ -65,13 +68,25 @@ class PCKPacker : public RefCounted {
 		bool encrypted = false;
 		bool removal = false;
 		Vector<uint8_t> md5;
+		uint32_t block_size = 0;
+		Vector<uint32_t> blocks;
 	};
 	Vector<File> files;
 
+	struct CompressedBlocks {
+		const uint8_t *src = nullptr;
+		uint64_t size = 0;
+		uint32_t block_size = 0;
+		LocalVector<Vector<uint8_t>> blocks; ///< Empty for blocks that don't get smaller.
+	};
+	void _compress_block(uint32_t p_index, CompressedBlocks *p_blocks);
+
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
 	Error add_file_removal(const String &p_target_path);
+	void set_compression_block_size(int p_block_size);
+	int get_compression_block_size() const;
 	Error flush(bool p_verbose = false);
 
 	PCKPacker() {}
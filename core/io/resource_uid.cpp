@@ -42,6 +42,8 @@
 #include "core/crypto/crypto_core.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/math/random_pcg.h"
 
@@ -53,6 +55,31 @@ static constexpr uint32_t char_count = ('z' - 'a');
 static constexpr uint32_t base = char_count + ('9' - '0');
 /// @}
 
+/// @name Cache file layout
+/// @details The legacy layout is an entry count followed by unsorted `{ int64 id, uint32 length, path }` records,
+/// appended to as entries are added. The table layout starts with a header, then the entries sorted by ID, each
+/// pointing into the string section that follows, then records in the legacy format for entries added since the
+/// table was written. All values are little-endian.
+/// @{
+static constexpr uint32_t CACHE_TABLE_MAGIC = 0x43444955; // "UIDC", too large to be mistaken for a legacy entry count.
+static constexpr uint32_t CACHE_TABLE_VERSION = 1;
+static constexpr uint64_t CACHE_TABLE_HEADER_SIZE = 24; // Magic, version, entry count, appended record count, strings size.
+static constexpr uint64_t CACHE_TABLE_APPENDED_COUNT_OFFSET = 12;
+static constexpr uint64_t CACHE_TABLE_ENTRY_SIZE = 16; // ID, path offset, path length.
+/// @}
+
+static Error _read_cache_record(Ref<FileAccess> &p_file, int64_t &r_id, CharString &r_path) {
+	r_id = p_file->get_64();
+	int32_t len = p_file->get_32();
+	ERR_FAIL_COND_V(len < 0, ERR_FILE_CORRUPT);
+	r_path.resize_uninitialized(len + 1);
+	ERR_FAIL_COND_V(r_path.size() != len + 1, ERR_FILE_CORRUPT); // Out of memory.
+	r_path[len] = 0;
+	int32_t rl = p_file->get_buffer((uint8_t *)r_path.ptrw(), len);
+	ERR_FAIL_COND_V(rl != len, ERR_FILE_CORRUPT);
+	return OK;
+}
+
 String ResourceUID::get_cache_file() {
 	return ProjectSettings::get_singleton()->get_project_data_path().path_join("uid_cache.bin");
 }
@@ -133,7 +160,7 @@ ResourceUID::ID ResourceUID::create_id() {
 		Error err = ((CryptoCore::RandomGenerator *)crypto)->get_random_bytes((uint8_t *)&id, sizeof(id));
 		ERR_FAIL_COND_V(err != OK, INVALID_ID);
 		id &= 0x7FFFFFFFFFFFFFFF;
-		bool exists = unique_ids.has(id);
+		bool exists = _has_id(id);
 		if (!exists) {
 			return id;
 		}
@@ -156,39 +183,100 @@ ResourceUID::ID ResourceUID::create_id_for_path(const String &p_path) {
 		id = (num1 | num2) & 0x7FFFFFFFFFFFFFFF;
 
 		MutexLock lock(mutex);
-		if (!unique_ids.has(id)) {
+		if (!_has_id(id)) {
 			break;
 		}
 	}
 	return id;
 }
 
+int64_t ResourceUID::_table_find(ID p_id) const {
+	const uint8_t *entries = table + CACHE_TABLE_HEADER_SIZE;
+	uint32_t low = 0;
+	uint32_t high = table_count;
+	while (low < high) {
+		const uint32_t middle = low + (high - low) / 2;
+		const ID id = ID(decode_uint64(entries + uint64_t(middle) * CACHE_TABLE_ENTRY_SIZE));
+		if (id < p_id) {
+			low = middle + 1;
+		} else if (id > p_id) {
+			high = middle;
+		} else {
+			return middle;
+		}
+	}
+	return -1;
+}
+
+bool ResourceUID::_table_get_path(uint32_t p_index, const char *&r_path, uint32_t &r_length) const {
+	const uint8_t *entry = table + CACHE_TABLE_HEADER_SIZE + uint64_t(p_index) * CACHE_TABLE_ENTRY_SIZE;
+	const uint32_t offset = decode_uint32(entry + 8);
+	r_length = decode_uint32(entry + 12);
+	// Entries are validated as they are used, so that loading doesn't have to go through all of them.
+	ERR_FAIL_COND_V_MSG(uint64_t(offset) + r_length > table_strings_size, false, "Corrupt entry in the UID cache.");
+	r_path = (const char *)table + CACHE_TABLE_HEADER_SIZE + uint64_t(table_count) * CACHE_TABLE_ENTRY_SIZE + offset;
+	return true;
+}
+
+bool ResourceUID::_has_id(ID p_id) const {
+	if (unique_ids.has(p_id)) {
+		return true;
+	}
+	return table_count && !removed_ids.has(p_id) && _table_find(p_id) != -1;
+}
+
+void ResourceUID::_clear_table() {
+	table = nullptr;
+	table_count = 0;
+	table_strings_size = 0;
+	table_file.unref();
+	table_buffer.clear();
+	removed_ids.clear();
+}
+
 bool ResourceUID::has_id(ID p_id) const {
 	MutexLock l(mutex);
-	return unique_ids.has(p_id);
+	return _has_id(p_id);
 }
 
 void ResourceUID::add_id(ID p_id, const String &p_path) {
 	MutexLock l(mutex);
-	ERR_FAIL_COND(unique_ids.has(p_id));
+	ERR_FAIL_COND(_has_id(p_id));
 	Cache c;
 	c.cs = p_path.utf8();
 	unique_ids[p_id] = c;
+	removed_ids.erase(p_id);
 	changed = true;
 }
 
 void ResourceUID::set_id(ID p_id, const String &p_path) {
 	MutexLock l(mutex);
-	ERR_FAIL_COND(!unique_ids.has(p_id));
 	CharString cs = p_path.utf8();
+	Cache *cache = unique_ids.getptr(p_id);
+	if (!cache) {
+		// Only in the table, the new path goes to `unique_ids` if it differs.
+		const int64_t index = (table_count && !removed_ids.has(p_id)) ? _table_find(p_id) : -1;
+		ERR_FAIL_COND(index == -1);
+		const char *path = nullptr;
+		uint32_t length = 0;
+		if (_table_get_path(index, path, length) && length == uint32_t(cs.length()) && memcmp(path, cs.get_data(), length) == 0) {
+			return;
+		}
+		Cache c;
+		c.cs = cs;
+		unique_ids[p_id] = c;
+		changed = true;
+		return;
+	}
+
 	const char *update_ptr = cs.ptr();
-	const char *cached_ptr = unique_ids[p_id].cs.ptr();
+	const char *cached_ptr = cache->cs.ptr();
 	if (update_ptr == nullptr && cached_ptr == nullptr) {
 		return; // Both are empty strings.
 	}
 	if ((update_ptr == nullptr) != (cached_ptr == nullptr) || strcmp(update_ptr, cached_ptr) != 0) {
-		unique_ids[p_id].cs = cs;
-		unique_ids[p_id].saved_to_cache = false; //changed
+		cache->cs = cs;
+		cache->saved_to_cache = false; //changed
 		changed = true;
 	}
 }
@@ -198,6 +286,15 @@ String ResourceUID::get_id_path(ID p_id) const {
 	MutexLock l(mutex);
 	const ResourceUID::Cache *cache = unique_ids.getptr(p_id);
 
+	if (!cache && table_count && !removed_ids.has(p_id)) {
+		const int64_t index = _table_find(p_id);
+		const char *path = nullptr;
+		uint32_t length = 0;
+		if (index != -1 && _table_get_path(index, path, length)) {
+			return String::utf8(path, length);
+		}
+	}
+
 #if TOOLS_ENABLED
 	// On startup, the scan_for_uid_on_startup callback should be set and will
 	// execute EditorFileSystem::scan_for_uid, which scans all project files
@@ -217,8 +314,11 @@ String ResourceUID::get_id_path(ID p_id) const {
 
 void ResourceUID::remove_id(ID p_id) {
 	MutexLock l(mutex);
-	ERR_FAIL_COND(!unique_ids.has(p_id));
+	ERR_FAIL_COND(!_has_id(p_id));
 	unique_ids.erase(p_id);
+	if (table_count && _table_find(p_id) != -1) {
+		removed_ids.insert(p_id);
+	}
 }
 
 String ResourceUID::uid_to_path(const String &p_uid) {
@@ -248,31 +348,155 @@ Error ResourceUID::save_to_cache() {
 		d->make_dir_recursive(String(cache_file).get_base_dir()); //ensure base dir exists
 	}
 
+	MutexLock l(mutex);
+
+	if (table_file.is_valid()) {
+		// The table may be mapped from the file about to be rewritten, which would truncate it under the mapping.
+		const uint64_t table_size = CACHE_TABLE_HEADER_SIZE + uint64_t(table_count) * CACHE_TABLE_ENTRY_SIZE + table_strings_size;
+		table_buffer.resize(table_size);
+		ERR_FAIL_COND_V(table_buffer.size() != int64_t(table_size), ERR_OUT_OF_MEMORY);
+		memcpy(table_buffer.ptrw(), table, table_size);
+		table = table_buffer.ptr();
+		table_file.unref();
+	}
+
 	Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
 	if (f.is_null()) {
 		return ERR_CANT_OPEN;
 	}
 
-	MutexLock l(mutex);
-	f->store_32(unique_ids.size());
+	struct Entry {
+		ID id = INVALID_ID;
+		const char *path = nullptr;
+		uint32_t length = 0;
 
-	cache_entries = 0;
+		bool operator<(const Entry &p_other) const { return id < p_other.id; }
+	};
 
+	LocalVector<Entry> entries;
+	entries.reserve(unique_ids.size() + table_count);
 	for (KeyValue<ID, Cache> &E : unique_ids) {
-		f->store_64(uint64_t(E.key));
-		uint32_t s = E.value.cs.length();
-		f->store_32(s);
-		f->store_buffer((const uint8_t *)E.value.cs.ptr(), s);
+		entries.push_back({ E.key, E.value.cs.get_data(), uint32_t(E.value.cs.length()) });
 		E.value.saved_to_cache = true;
-		cache_entries++;
 	}
+	for (uint32_t i = 0; i < table_count; i++) {
+		Entry entry;
+		entry.id = ID(decode_uint64(table + CACHE_TABLE_HEADER_SIZE + uint64_t(i) * CACHE_TABLE_ENTRY_SIZE));
+		if (unique_ids.has(entry.id) || removed_ids.has(entry.id) || !_table_get_path(i, entry.path, entry.length)) {
+			continue;
+		}
+		entries.push_back(entry);
+	}
+	entries.sort();
+
+	uint64_t strings_size = 0;
+	for (const Entry &entry : entries) {
+		strings_size += entry.length;
+	}
+	ERR_FAIL_COND_V_MSG(strings_size > UINT32_MAX, ERR_OUT_OF_MEMORY, "UID cache paths can't exceed 4 GiB in total.");
+
+	LocalVector<uint8_t> buffer;
+	buffer.resize(CACHE_TABLE_HEADER_SIZE + entries.size() * CACHE_TABLE_ENTRY_SIZE + strings_size);
+	uint8_t *w = buffer.ptr();
+	encode_uint32(CACHE_TABLE_MAGIC, w);
+	encode_uint32(CACHE_TABLE_VERSION, w + 4);
+	encode_uint32(entries.size(), w + 8);
+	encode_uint32(0, w + CACHE_TABLE_APPENDED_COUNT_OFFSET);
+	encode_uint64(strings_size, w + 16);
+
+	uint8_t *entry_w = w + CACHE_TABLE_HEADER_SIZE;
+	uint8_t *strings_w = entry_w + entries.size() * CACHE_TABLE_ENTRY_SIZE;
+	uint32_t offset = 0;
+	for (const Entry &entry : entries) {
+		encode_uint64(uint64_t(entry.id), entry_w);
+		encode_uint32(offset, entry_w + 8);
+		encode_uint32(entry.length, entry_w + 12);
+		memcpy(strings_w + offset, entry.path, entry.length);
+		entry_w += CACHE_TABLE_ENTRY_SIZE;
+		offset += entry.length;
+	}
+	f->store_buffer(buffer.ptr(), buffer.size());
 
+	cache_entries = entries.size();
+	cache_appended_entries = 0;
+	cache_is_table = true;
 	changed = false;
 	return OK;
 }
 
+Error ResourceUID::_load_table(Ref<FileAccess> &p_file, const String &p_path) {
+	const uint32_t version = p_file->get_32();
+	ERR_FAIL_COND_V_MSG(version != CACHE_TABLE_VERSION, ERR_FILE_UNRECOGNIZED, vformat("Unsupported UID cache version %d.", version));
+	const uint32_t count = p_file->get_32();
+	const uint32_t appended_count = p_file->get_32();
+	const uint64_t strings_size = p_file->get_64();
+	const uint64_t strings_offset = CACHE_TABLE_HEADER_SIZE + uint64_t(count) * CACHE_TABLE_ENTRY_SIZE;
+	const uint64_t records_offset = strings_offset + strings_size;
+	ERR_FAIL_COND_V(records_offset > p_file->get_length(), ERR_FILE_CORRUPT);
+
+	if (table_count == 0 && unique_ids.is_empty()) {
+		// Query the table in place, straight from the page cache when the file can be mapped.
+		Ref<FileAccess> mapped = p_file;
+		const uint8_t *data = p_file->get_buffer_view(0, records_offset);
+		const bool in_pack = PackedData::get_singleton() && !PackedData::get_singleton()->is_disabled() && PackedData::get_singleton()->has_path(p_path);
+		if (!data && !in_pack) {
+			mapped = FileAccess::open_mapped(p_path);
+			if (mapped.is_valid()) {
+				data = mapped->get_buffer_view(0, records_offset);
+			}
+		}
+
+		if (data) {
+			table_file = mapped;
+		} else {
+			table_buffer.resize(records_offset);
+			ERR_FAIL_COND_V(table_buffer.size() != int64_t(records_offset), ERR_FILE_CORRUPT); // Out of memory.
+			p_file->seek(0);
+			ERR_FAIL_COND_V(p_file->get_buffer(table_buffer.ptrw(), records_offset) != records_offset, ERR_FILE_CORRUPT);
+			data = table_buffer.ptr();
+		}
+		table = data;
+		table_count = count;
+		table_strings_size = strings_size;
+	} else {
+		// Merging into existing entries, which replaces them like the legacy layout does.
+		Vector<uint8_t> data = p_file->get_buffer(strings_size + count * CACHE_TABLE_ENTRY_SIZE);
+		ERR_FAIL_COND_V(uint64_t(data.size()) != strings_offset - CACHE_TABLE_HEADER_SIZE + strings_size, ERR_FILE_CORRUPT);
+		const uint8_t *entry = data.ptr();
+		const char *strings = (const char *)data.ptr() + count * CACHE_TABLE_ENTRY_SIZE;
+		for (uint32_t i = 0; i < count; i++, entry += CACHE_TABLE_ENTRY_SIZE) {
+			const uint32_t offset = decode_uint32(entry + 8);
+			const uint32_t length = decode_uint32(entry + 12);
+			ERR_FAIL_COND_V(uint64_t(offset) + length > strings_size, ERR_FILE_CORRUPT);
+			Cache c;
+			c.cs.resize_uninitialized(length + 1);
+			memcpy(c.cs.ptrw(), strings + offset, length);
+			c.cs[length] = 0;
+			c.saved_to_cache = true;
+			unique_ids[ID(decode_uint64(entry))] = c;
+		}
+	}
+
+	p_file->seek(records_offset);
+	for (uint32_t i = 0; i < appended_count; i++) {
+		int64_t id;
+		Cache c;
+		Error err = _read_cache_record(p_file, id, c.cs);
+		if (err) {
+			return err;
+		}
+		c.saved_to_cache = true;
+		unique_ids[id] = c;
+	}
+
+	cache_entries = count + appended_count;
+	cache_appended_entries = appended_count;
+	return OK;
+}
+
 Error ResourceUID::load_from_cache(bool p_reset) {
-	Ref<FileAccess> f = FileAccess::open(get_cache_file(), FileAccess::READ);
+	const String cache_file = get_cache_file();
+	Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::READ);
 	if (f.is_null()) {
 		return ERR_CANT_OPEN;
 	}
@@ -280,24 +504,34 @@ Error ResourceUID::load_from_cache(bool p_reset) {
 	MutexLock l(mutex);
 	if (p_reset) {
 		unique_ids.clear();
+		_clear_table();
 	}
 
 	uint32_t entry_count = f->get_32();
+	if (entry_count == CACHE_TABLE_MAGIC) {
+		Error err = _load_table(f, cache_file);
+		if (err) {
+			return err;
+		}
+		cache_is_table = true;
+		changed = false;
+		return OK;
+	}
+
 	for (uint32_t i = 0; i < entry_count; i++) {
-		int64_t id = f->get_64();
-		int32_t len = f->get_32();
+		int64_t id;
 		Cache c;
-		c.cs.resize_uninitialized(len + 1);
-		ERR_FAIL_COND_V(c.cs.size() != len + 1, ERR_FILE_CORRUPT); // Out of memory.
-		c.cs[len] = 0;
-		int32_t rl = f->get_buffer((uint8_t *)c.cs.ptrw(), len);
-		ERR_FAIL_COND_V(rl != len, ERR_FILE_CORRUPT);
+		Error err = _read_cache_record(f, id, c.cs);
+		if (err) {
+			return err;
+		}
 
 		c.saved_to_cache = true;
 		unique_ids[id] = c;
 	}
 
 	cache_entries = entry_count;
+	cache_is_table = false;
 	changed = false;
 	return OK;
 }
@@ -310,9 +544,14 @@ Error ResourceUID::update_cache() {
 	if (cache_entries == 0) {
 		return save_to_cache();
 	}
+	// Appended records are loaded into memory on startup, fold them back into the table once they pile up.
+	if (cache_is_table && cache_appended_entries > MAX(1024u, cache_entries / 8)) {
+		return save_to_cache();
+	}
 	MutexLock l(mutex);
 
 	Ref<FileAccess> f;
+	uint32_t appended = 0;
 	for (KeyValue<ID, Cache> &E : unique_ids) {
 		if (!E.value.saved_to_cache) {
 			if (f.is_null()) {
@@ -327,13 +566,20 @@ Error ResourceUID::update_cache() {
 			f->store_32(s);
 			f->store_buffer((const uint8_t *)E.value.cs.ptr(), s);
 			E.value.saved_to_cache = true;
-			cache_entries++;
+			appended++;
 		}
 	}
 
 	if (f.is_valid()) {
-		f->seek(0);
-		f->store_32(cache_entries); //update amount of entries
+		cache_entries += appended;
+		if (cache_is_table) {
+			cache_appended_entries += appended;
+			f->seek(CACHE_TABLE_APPENDED_COUNT_OFFSET);
+			f->store_32(cache_appended_entries);
+		} else {
+			f->seek(0);
+			f->store_32(cache_entries); //update amount of entries
+		}
 	}
 
 	changed = false;
@@ -344,14 +590,60 @@ Error ResourceUID::update_cache() {
 String ResourceUID::get_path_from_cache(Ref<FileAccess> &p_cache_file, const String &p_uid_string) {
 	const uint32_t entry_count = p_cache_file->get_32();
 	CharString cs;
+	if (entry_count == CACHE_TABLE_MAGIC) {
+		const ID uid = singleton->text_to_id(p_uid_string);
+		const uint32_t version = p_cache_file->get_32();
+		ERR_FAIL_COND_V(version != CACHE_TABLE_VERSION || uid == INVALID_ID, String());
+		const uint32_t count = p_cache_file->get_32();
+		const uint32_t appended_count = p_cache_file->get_32();
+		const uint64_t strings_size = p_cache_file->get_64();
+		const uint64_t strings_offset = CACHE_TABLE_HEADER_SIZE + uint64_t(count) * CACHE_TABLE_ENTRY_SIZE;
+
+		// Appended records are newer than the table, and the last one wins.
+		p_cache_file->seek(strings_offset + strings_size);
+		String path;
+		bool found = false;
+		for (uint32_t i = 0; i < appended_count; i++) {
+			int64_t id;
+			ERR_FAIL_COND_V(_read_cache_record(p_cache_file, id, cs) != OK, String());
+			if (id == uid) {
+				path = String::utf8(cs.get_data());
+				found = true;
+			}
+		}
+		if (found) {
+			return path;
+		}
+
+		uint32_t low = 0;
+		uint32_t high = count;
+		while (low < high) {
+			const uint32_t middle = low + (high - low) / 2;
+			p_cache_file->seek(CACHE_TABLE_HEADER_SIZE + uint64_t(middle) * CACHE_TABLE_ENTRY_SIZE);
+			const ID id = ID(p_cache_file->get_64());
+			if (id < uid) {
+				low = middle + 1;
+			} else if (id > uid) {
+				high = middle;
+			} else {
+				const uint32_t offset = p_cache_file->get_32();
+				const int32_t len = p_cache_file->get_32();
+				ERR_FAIL_COND_V(len < 0 || uint64_t(offset) + len > strings_size, String());
+				cs.resize_uninitialized(len + 1);
+				ERR_FAIL_COND_V(cs.size() != len + 1, String());
+				cs[len] = 0;
+				p_cache_file->seek(strings_offset + offset);
+				int32_t rl = p_cache_file->get_buffer((uint8_t *)cs.ptrw(), len);
+				ERR_FAIL_COND_V(rl != len, String());
+				return String::utf8(cs.get_data());
+			}
+		}
+		return String();
+	}
+
 	for (uint32_t i = 0; i < entry_count; i++) {
-		int64_t id = p_cache_file->get_64();
-		int32_t len = p_cache_file->get_32();
-		cs.resize_uninitialized(len + 1);
-		ERR_FAIL_COND_V(cs.size() != len + 1, String());
-		cs[len] = 0;
-		int32_t rl = p_cache_file->get_buffer((uint8_t *)cs.ptrw(), len);
-		ERR_FAIL_COND_V(rl != len, String());
+		int64_t id;
+		ERR_FAIL_COND_V(_read_cache_record(p_cache_file, id, cs) != OK, String());
 
 		if (singleton->id_to_text(id) == p_uid_string) {
 			return String::utf8(cs.get_data());
@@ -362,7 +654,10 @@ String ResourceUID::get_path_from_cache(Ref<FileAccess> &p_cache_file, const Str
 
 void ResourceUID::clear() {
 	cache_entries = 0;
+	cache_appended_entries = 0;
+	cache_is_table = false;
 	unique_ids.clear();
+	_clear_table();
 	changed = false;
 }
 void ResourceUID::_bind_methods() {
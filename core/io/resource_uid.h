@@ -41,6 +41,7 @@
 #include "core/object/ref_counted.h"
 #include "core/string/string_name.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 
 class FileAccess;
 
@@ -65,9 +66,30 @@ private:
 	HashMap<ID, Cache> unique_ids; ///< Unique IDs and utf8 paths (less memory used)
 	static ResourceUID *singleton;
 
+	/// @name Cache table
+	/// @details The cache file stores its entries sorted by ID, so it can be queried in place, memory mapped when possible,
+	/// instead of being loaded into `unique_ids` on startup. Entries added or changed afterwards go to `unique_ids`,
+	/// which takes precedence, and removed ones are tracked in `removed_ids`.
+	/// @{
+	Ref<FileAccess> table_file; ///< Keeps the mapping alive.
+	Vector<uint8_t> table_buffer; ///< File contents, when it can't be mapped or is being rewritten.
+	const uint8_t *table = nullptr;
+	uint32_t table_count = 0;
+	uint64_t table_strings_size = 0;
+	HashSet<ID> removed_ids;
+	/// @}
+
 	uint32_t cache_entries = 0;
+	uint32_t cache_appended_entries = 0;
+	bool cache_is_table = false; ///< Whether the file on disk is a sorted table, or uses the legacy unsorted layout.
 	bool changed = false;
 
+	int64_t _table_find(ID p_id) const;
+	bool _table_get_path(uint32_t p_index, const char *&r_path, uint32_t &r_length) const;
+	bool _has_id(ID p_id) const;
+	void _clear_table();
+	Error _load_table(Ref<FileAccess> &p_file, const String &p_path);
+
 protected:
 	static void _bind_methods();
 
@@ -291,12 +291,10 @@ void StreamPeer::put_utf8_string(const String &p_string) {
 }
 
 void StreamPeer::put_var(const Variant &p_variant, bool p_full_objects) {
-	int len = 0;
-	Vector<uint8_t> buf;
-	encode_variant(p_variant, nullptr, len, p_full_objects);
-	buf.resize(len);
-	put_32(len);
-	encode_variant(p_variant, buf.ptrw(), len, p_full_objects);
+	LocalVector<uint8_t> buf;
+	Error err = encode_variant_append(p_variant, buf, p_full_objects);
+	ERR_FAIL_COND_MSG(err != OK, "Error when trying to encode Variant.");
+	put_32(buf.size());
 	put_data(buf.ptr(), buf.size());
 }
 
@@ -44,35 +44,175 @@
 
 #include <cstdio>
 
-#ifdef DEV_ENABLED
-/// Includes safety checks to ensure that a queue set as a thread singleton override
-/// is only ever called from the thread it was set for.
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		DEV_ASSERT(!is_current_thread_override);  \
-		mutex.lock();                             \
-	} else {                                      \
-		DEV_ASSERT(is_current_thread_override);   \
-	}
-#else
-#define LOCK_MUTEX                                \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.lock();                             \
+static SafeNumeric<uint64_t> last_queue_id;
+
+/// Lets exiting threads find the queues they claimed buffers from, if these still exist.
+static BinaryMutex live_queues_mutex;
+static LocalVector<CallQueue *> live_queues;
+
+/// Buffers claimed by the calling thread, given back to their queues when it exits.
+struct CallQueueThreadBuffers {
+	static constexpr uint32_t SIZE = 8;
+
+	uint64_t queue_ids[SIZE] = {};
+	CallQueue::Buffer *buffers[SIZE] = {};
+	uint32_t count = 0;
+
+	~CallQueueThreadBuffers() {
+		MutexLock lock(live_queues_mutex);
+		for (uint32_t i = 0; i < count; i++) {
+			for (CallQueue *queue : live_queues) {
+				if (queue->queue_id == queue_ids[i]) {
+					queue->_release_thread_buffer(buffers[i]);
+					break;
+				}
+			}
+		}
 	}
-#endif
+};
+
+static thread_local CallQueueThreadBuffers thread_buffers;
+
+CallQueue::Buffer *CallQueue::_get_thread_buffer() {
+	if (this == MessageQueue::thread_singleton) {
+		DEV_ASSERT(is_current_thread_override);
+		return &owner_buffer;
+	}
+	// A queue set as a thread singleton override must only be used from the thread it was set for.
+	DEV_ASSERT(!is_current_thread_override);
+
+	CallQueueThreadBuffers &claimed = thread_buffers;
+	for (uint32_t i = 0; i < claimed.count; i++) {
+		if (claimed.queue_ids[i] == queue_id) {
+			return claimed.buffers[i];
+		}
+	}
+
+	Buffer *buffer = nullptr;
+	{
+		MutexLock lock(mutex);
+		for (Buffer *candidate : buffers) {
+			if (!candidate->claimed) {
+				buffer = candidate;
+				break;
+			}
+		}
+		if (!buffer && buffers.size() < MAX_THREAD_BUFFERS) {
+			buffer = memnew(Buffer);
+			buffers.push_back(buffer);
+		}
+
+		if (!buffer || claimed.count == CallQueueThreadBuffers::SIZE) {
+			// Too many producers, or this thread pushes to too many queues. Share a buffer then,
+			// its lock keeps pushes safe and sequence numbers keep each thread's order.
+			return buffer ? buffer : buffers[Thread::get_caller_id() % buffers.size()];
+		}
+		buffer->claimed = true;
+	}
+
+	claimed.queue_ids[claimed.count] = queue_id;
+	claimed.buffers[claimed.count] = buffer;
+	claimed.count++;
+	return buffer;
+}
+
+void CallQueue::_release_thread_buffer(Buffer *p_buffer) {
+	// Pending messages stay in the buffer and are flushed as usual.
+	MutexLock lock(mutex);
+	p_buffer->claimed = false;
+}
+
+uint8_t *CallQueue::_begin_message(uint32_t p_room_needed, Buffer *&r_buffer) {
+	r_buffer = _get_thread_buffer();
+	if (r_buffer != &owner_buffer) {
+		r_buffer->lock.lock();
+	}
+
+	uint32_t page_count = r_buffer->pages.size();
+	if (page_count == 0 || r_buffer->page_bytes[page_count - 1] + p_room_needed > uint32_t(PAGE_SIZE_BYTES)) {
+		// A soft limit, concurrent producers may overshoot it by a page each.
+		if (pages_used.get() >= max_pages) {
+			if (r_buffer != &owner_buffer) {
+				r_buffer->lock.unlock();
+			}
+			return nullptr;
+		}
+		peak_pages_used.exchange_if_greater(pages_used.increment());
+		r_buffer->pages.push_back(allocator->alloc());
+		r_buffer->page_bytes.push_back(0);
+		page_count++;
+	}
+
+	return &r_buffer->pages[page_count - 1]->data[r_buffer->page_bytes[page_count - 1]];
+}
+
+void CallQueue::_end_message(Buffer *p_buffer, Message *p_message, uint32_t p_room_needed) {
+	// Taken last, so it follows anything this push happens after.
+	p_message->sequence = next_sequence.fetch_add(1, std::memory_order_relaxed);
+	p_buffer->page_bytes[p_buffer->page_bytes.size() - 1] += p_room_needed;
+	if (p_buffer != &owner_buffer) {
+		p_buffer->lock.unlock();
+	}
+}
+
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
 
-#define UNLOCK_MUTEX                              \
-	if (this != MessageQueue::thread_singleton) { \
-		mutex.unlock();                           \
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+bool CallQueue::_steal_streams(LocalVector<Stream> &r_streams) {
+	r_streams.clear();
+
+	// The owner buffer is only ever touched by the owner thread, which is either
+	// the one flushing or not pushing to this queue anymore.
+	if (!owner_buffer.pages.is_empty()) {
+		Stream stream;
+		stream.pages = owner_buffer.pages;
+		stream.page_bytes = owner_buffer.page_bytes;
+		owner_buffer.pages.clear();
+		owner_buffer.page_bytes.clear();
+		r_streams.push_back(stream);
 	}
 
-void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
-		pages.push_back(allocator->alloc());
-		page_bytes.push_back(0);
+	MutexLock lock(mutex);
+	for (Buffer *buffer : buffers) {
+		buffer->lock.lock();
+		if (!buffer->pages.is_empty()) {
+			Stream stream;
+			stream.pages = buffer->pages;
+			stream.page_bytes = buffer->page_bytes;
+			buffer->pages.clear();
+			buffer->page_bytes.clear();
+			r_streams.push_back(stream);
+		}
+		buffer->lock.unlock();
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+
+	return !r_streams.is_empty();
+}
+
+void CallQueue::_release_streams(LocalVector<Stream> &p_streams) {
+	for (Stream &stream : p_streams) {
+		for (Page *page : stream.pages) {
+			allocator->free(page);
+		}
+		pages_used.sub(stream.pages.size());
+	}
+	p_streams.clear();
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -96,24 +236,14 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
-	LOCK_MUTEX;
-
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Buffer *buffer = nullptr;
+	uint8_t *buffer_end = _begin_message(room_needed, buffer);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = p_argcount;
 	msg->callable = p_callable;
@@ -134,37 +264,26 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		*v = *p_args[i];
 	}
 
-	page_bytes[pages_used - 1] += room_needed;
-
-	UNLOCK_MUTEX;
+	_end_message(buffer, msg, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			String type;
-			if (ObjectDB::get_instance(p_id)) {
-				type = ObjectDB::get_instance(p_id)->get_class();
-			}
-			fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
+	Buffer *buffer = nullptr;
+	uint8_t *buffer_end = _begin_message(room_needed, buffer);
+	if (unlikely(!buffer_end)) {
+		String type;
+		if (ObjectDB::get_instance(p_id)) {
+			type = ObjectDB::get_instance(p_id)->get_class();
 		}
-		_add_page();
+		fprintf(stderr, "Failed set: %s: %s target ID: %s. Message queue out of memory. %s\n", type.utf8().get_data(), String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
@@ -175,32 +294,23 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	Variant *v = memnew_placement(buffer_end, Variant);
 	*v = p_value;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_end_message(buffer, msg, room_needed);
 
 	return OK;
 }
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
-	_ensure_first_page();
-
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
-			fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
-			statistics();
-			UNLOCK_MUTEX;
-			return ERR_OUT_OF_MEMORY;
-		}
-		_add_page();
+	Buffer *buffer = nullptr;
+	uint8_t *buffer_end = _begin_message(room_needed, buffer);
+	if (unlikely(!buffer_end)) {
+		fprintf(stderr, "Failed notification: %d target ID: %s. Message queue out of memory. %s\n", p_notification, itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+		statistics();
+		return ERR_OUT_OF_MEMORY;
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
 	Message *msg = memnew_placement(buffer_end, Message);
 
 	msg->type = TYPE_NOTIFICATION;
@@ -208,8 +318,7 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	//msg->target;
 	msg->notification = p_notification;
 
-	page_bytes[pages_used - 1] += room_needed;
-	UNLOCK_MUTEX;
+	_end_message(buffer, msg, room_needed);
 
 	return OK;
 }
@@ -232,206 +341,168 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 }
 
 Error CallQueue::flush() {
-	LOCK_MUTEX;
-
-	if (pages.is_empty()) {
-		// Never allocated
-		UNLOCK_MUTEX;
+	if (pages_used.get() == 0) {
 		return OK; // Do nothing.
 	}
 
-	if (flushing) {
-		UNLOCK_MUTEX;
-		return ERR_BUSY;
-	}
-
-	flushing = true;
-
-	uint32_t i = 0;
-	uint32_t offset = 0;
-
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
-
-		//lock on each iteration, so a call can re-add itself to the message queue
-
-		Message *message = (Message *)&page->data[offset];
-
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
+	{
+		MutexLock lock(mutex);
+		if (flushing) {
+			return ERR_BUSY;
 		}
+		flushing = true;
+	}
 
-		//pre-advance so this function is reentrant
-		offset += advance;
-
-		Object *target = message->callable.get_object();
-
-		UNLOCK_MUTEX;
-
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
+	// Each thread's stream is in push order already. Always taking the message
+	// with the lowest sequence merges them back into the order of a single queue.
+	// Messages pushed while flushing are picked up by the next round.
+	LocalVector<Stream> streams;
+	while (_steal_streams(streams)) {
+		while (true) {
+			Stream *next = nullptr;
+			Message *message = nullptr;
+			for (Stream &stream : streams) {
+				Message *candidate = stream.peek();
+				if (candidate && (!message || candidate->sequence < message->sequence)) {
+					next = &stream;
+					message = candidate;
 				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
+			}
+			if (!message) {
+				break;
+			}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
+			next->offset += _get_message_size(message);
+			if (next->offset == next->page_bytes[next->page]) {
+				next->page++;
+				next->offset = 0;
 			}
-		}
 
-		message->~Message();
+			Object *target = message->callable.get_object();
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
+			switch (message->type & FLAG_MASK) {
+				case TYPE_CALL: {
+					if (target || (message->type & FLAG_NULL_IS_OK)) {
+						Variant *args = (Variant *)(message + 1);
+						_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
+					}
+				} break;
+				case TYPE_NOTIFICATION: {
+					if (target) {
+						target->notification(message->notification);
+					}
+				} break;
+				case TYPE_SET: {
+					if (target) {
+						Variant *arg = (Variant *)(message + 1);
+						target->set(message->callable.get_method(), *arg);
+					}
+				} break;
+			}
+
+			_destroy_message(message);
 		}
-	}
 
-	page_bytes[0] = 0;
-	pages_used = 1;
+		_release_streams(streams);
+	}
 
+	MutexLock lock(mutex);
 	flushing = false;
-	UNLOCK_MUTEX;
 	return OK;
 }
 
 void CallQueue::clear() {
-	LOCK_MUTEX;
-
-	if (pages.is_empty()) {
-		UNLOCK_MUTEX;
-		return; // Nothing to clear.
-	}
-
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+	LocalVector<Stream> streams;
+	while (_steal_streams(streams)) {
+		for (Stream &stream : streams) {
+			while (Message *message = stream.peek()) {
+				stream.offset += _get_message_size(message);
+				if (stream.offset == stream.page_bytes[stream.page]) {
+					stream.page++;
+					stream.offset = 0;
 				}
+				_destroy_message(message);
 			}
-
-			message->~Message();
 		}
+		_release_streams(streams);
 	}
-
-	pages_used = 1;
-	page_bytes[0] = 0;
-
-	UNLOCK_MUTEX;
 }
 
 void CallQueue::statistics() {
-	LOCK_MUTEX;
 	HashMap<StringName, int> set_count;
 	HashMap<int, int> notify_count;
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
-		uint32_t offset = 0;
-		while (offset < page_bytes[i]) {
-			Page *page = pages[i];
-
-			//lock on each iteration, so a call can re-add itself to the message queue
-
-			Message *message = (Message *)&page->data[offset];
+	// Only reads the pages, messages stay queued. Other threads' buffers are locked while counted.
+	MutexLock lock(mutex);
+	LocalVector<Buffer *> all_buffers = buffers;
+	all_buffers.push_back(&owner_buffer);
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			Object *target = message->callable.get_object();
-
-			bool null_target = true;
-			switch (message->type & FLAG_MASK) {
-				case TYPE_CALL: {
-					if (target || (message->type & FLAG_NULL_IS_OK)) {
-						if (!call_count.has(message->callable)) {
-							call_count[message->callable] = 0;
+	for (Buffer *buffer : all_buffers) {
+		if (buffer != &owner_buffer) {
+			buffer->lock.lock();
+		}
+		for (uint32_t i = 0; i < buffer->pages.size(); i++) {
+			uint32_t offset = 0;
+			while (offset < buffer->page_bytes[i]) {
+				Page *page = buffer->pages[i];
+
+				Message *message = (Message *)&page->data[offset];
+				uint32_t advance = _get_message_size(message);
+
+				Object *target = message->callable.get_object();
+
+				bool null_target = true;
+				switch (message->type & FLAG_MASK) {
+					case TYPE_CALL: {
+						if (target || (message->type & FLAG_NULL_IS_OK)) {
+							if (!call_count.has(message->callable)) {
+								call_count[message->callable] = 0;
+							}
+
+							call_count[message->callable]++;
+							null_target = false;
 						}
-
-						call_count[message->callable]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_NOTIFICATION: {
-					if (target) {
-						if (!notify_count.has(message->notification)) {
-							notify_count[message->notification] = 0;
+					} break;
+					case TYPE_NOTIFICATION: {
+						if (target) {
+							if (!notify_count.has(message->notification)) {
+								notify_count[message->notification] = 0;
+							}
+
+							notify_count[message->notification]++;
+							null_target = false;
 						}
-
-						notify_count[message->notification]++;
-						null_target = false;
-					}
-				} break;
-				case TYPE_SET: {
-					if (target) {
-						StringName t = message->callable.get_method();
-						if (!set_count.has(t)) {
-							set_count[t] = 0;
+					} break;
+					case TYPE_SET: {
+						if (target) {
+							StringName t = message->callable.get_method();
+							if (!set_count.has(t)) {
+								set_count[t] = 0;
+							}
+
+							set_count[t]++;
+							null_target = false;
 						}
+					} break;
+				}
+				if (null_target) {
+					// Object was deleted.
+					fprintf(stdout, "Object was deleted while awaiting a callback.\n");
 
-						set_count[t]++;
-						null_target = false;
-					}
-				} break;
-			}
-			if (null_target) {
-				// Object was deleted.
-				fprintf(stdout, "Object was deleted while awaiting a callback.\n");
-
-				null_count++;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
+					null_count++;
 				}
-			}
 
-			message->~Message();
+				offset += advance;
+			}
+		}
+		if (buffer != &owner_buffer) {
+			buffer->lock.unlock();
 		}
 	}
 
-	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used, pages_used * PAGE_SIZE_BYTES);
+	fprintf(stdout, "TOTAL PAGES: %d (%d bytes).\n", pages_used.get(), pages_used.get() * PAGE_SIZE_BYTES);
 	fprintf(stdout, "NULL count: %d.\n", null_count);
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -445,8 +516,6 @@ void CallQueue::statistics() {
 	for (const KeyValue<int, int> &E : notify_count) {
 		fprintf(stdout, "NOTIFY %d: %d.\n", E.key, E.value);
 	}
-
-	UNLOCK_MUTEX;
 }
 
 bool CallQueue::is_flushing() const {
@@ -454,18 +523,12 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
-		return false;
-	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
-		return false;
-	}
-
-	return true;
+	// Pages are only taken when a message is written, and given back once flushed.
+	return pages_used.get() > 0;
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	return peak_pages_used.get() * PAGE_SIZE_BYTES;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -476,15 +539,27 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 		allocator = memnew(Allocator(16)); // 16 elements per allocator page, 64kb per allocator page. Anything small will do, though.
 		allocator_is_custom = false;
 	}
+	queue_id = last_queue_id.increment();
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+
+	MutexLock lock(live_queues_mutex);
+	live_queues.push_back(this);
 }
 
 CallQueue::~CallQueue() {
+	{
+		// First, so threads exiting from now on don't give buffers back to this queue.
+		MutexLock lock(live_queues_mutex);
+		live_queues.erase(this);
+		if (live_queues.is_empty()) {
+			live_queues.reset();
+		}
+	}
+
 	clear();
-	// Let go of pages.
-	for (uint32_t i = 0; i < pages.size(); i++) {
-		allocator->free(pages[i]);
+	for (Buffer *buffer : buffers) {
+		memdelete(buffer);
 	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
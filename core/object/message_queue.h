@@ -39,7 +39,9 @@
  */
 
 #include "core/object/object_id.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/variant/variant.h"
@@ -48,6 +50,7 @@ class Object;
 
 class CallQueue {
 	friend class MessageQueue;
+	friend struct CallQueueThreadBuffers;
 
 public:
 	enum {
@@ -73,39 +76,74 @@ private:
 		FLAG_MASK = FLAG_NULL_IS_OK - 1,
 	};
 
+	struct Message {
+		Callable callable;
+		/// Position in the order of pushes to this queue, across all threads.
+		uint64_t sequence;
+		int16_t type;
+		union {
+			int16_t notification;
+			int16_t args;
+		};
+	};
+
+	/// Pages filled by a single producing thread. Each thread pushes into its
+	/// own buffer, so producers only contend with a flush stealing the pages.
+	struct Buffer {
+		SpinLock lock;
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		/// Whether a thread owns it. Given back when that thread exits, for another thread to reuse.
+		bool claimed = false;
+	};
+
+	/// Past this many buffers, further producer threads share the existing ones, which bounds what a flush visits.
+	static constexpr uint32_t MAX_THREAD_BUFFERS = 64;
+
+	/// Pages stolen from a buffer by a flush, read front to back.
+	struct Stream {
+		LocalVector<Page *> pages;
+		LocalVector<uint32_t> page_bytes;
+		uint32_t page = 0;
+		uint32_t offset = 0;
+
+		_FORCE_INLINE_ Message *peek() const {
+			return page < pages.size() ? (Message *)&pages[page]->data[offset] : nullptr;
+		}
+	};
+
+	/// Guards the buffer registry and the flushing state.
 	Mutex mutex;
 
 	Allocator *allocator = nullptr;
 	bool allocator_is_custom = false;
 
-	LocalVector<Page *> pages;
-	LocalVector<uint32_t> page_bytes;
+	/// Identifies this queue in the per-thread buffer caches; never reused, unlike the address.
+	uint64_t queue_id = 0;
+
+	/// Used by the thread this queue is the singleton override of, which needs no locking.
+	Buffer owner_buffer;
+	/// Creation order, which is also the order streams are stolen in.
+	LocalVector<Buffer *> buffers;
+
+	std::atomic<uint64_t> next_sequence{ 0 };
+	SafeNumeric<uint32_t> pages_used;
+	SafeNumeric<uint32_t> peak_pages_used;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
 	bool is_current_thread_override = false;
 #endif
 
-	struct Message {
-		Callable callable;
-		int16_t type;
-		union {
-			int16_t notification;
-			int16_t args;
-		};
-	};
-
-	_FORCE_INLINE_ void _ensure_first_page() {
-		if (unlikely(pages.is_empty())) {
-			pages.push_back(allocator->alloc());
-			page_bytes.push_back(0);
-			pages_used = 1;
-		}
-	}
-
-	void _add_page();
+	Buffer *_get_thread_buffer();
+	void _release_thread_buffer(Buffer *p_buffer);
+	uint8_t *_begin_message(uint32_t p_room_needed, Buffer *&r_buffer);
+	void _end_message(Buffer *p_buffer, Message *p_message, uint32_t p_room_needed);
+	bool _steal_streams(LocalVector<Stream> &r_streams);
+	void _release_streams(LocalVector<Stream> &p_streams);
+	static void _destroy_message(Message *p_message);
+	static uint32_t _get_message_size(const Message *p_message);
 
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
 
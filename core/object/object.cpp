@@ -50,21 +50,6 @@
 
 #ifdef DEBUG_ENABLED
 
-struct _ObjectDebugLock {
-	ObjectID obj_id;
-
-	_ObjectDebugLock(Object *p_obj) {
-		obj_id = p_obj->get_instance_id();
-		p_obj->_lock_index.ref();
-	}
-	~_ObjectDebugLock() {
-		Object *obj_ptr = ObjectDB::get_instance(obj_id);
-		if (likely(obj_ptr)) {
-			obj_ptr->_lock_index.unref();
-		}
-	}
-};
-
 #define OBJ_DEBUG_LOCK _ObjectDebugLock _debug_lock(this);
 
 #else
@@ -1211,19 +1196,54 @@ Error Object::_emit_signal(const Variant **p_args, int p_argcount, Callable::Cal
 	return emit_signalp(signal, args, argc);
 }
 
+Object::SignalData &Object::SignalData::operator=(const SignalData &p_other) {
+	if (this != &p_other) {
+		user = p_other.user;
+		slot_map = p_other.slot_map;
+		removable = p_other.removable;
+		invalidate_dispatch();
+	}
+	return *this;
+}
+
+Object::SignalDispatch *Object::SignalData::get_dispatch() {
+	if (dispatch) {
+		return dispatch;
+	}
+
+	dispatch = memnew(SignalDispatch);
+	dispatch->refcount.init();
+	dispatch->entries.resize(slot_map.size());
+	uint32_t i = 0;
+	for (const KeyValue<Callable, Slot> &slot_kv : slot_map) {
+		SignalDispatch::Entry &entry = dispatch->entries[i++];
+		entry.callable = slot_kv.value.conn.callable;
+		entry.custom = entry.callable.is_custom() ? entry.callable.get_custom() : nullptr;
+		entry.flags = slot_kv.value.conn.flags;
+		dispatch->has_one_shot = dispatch->has_one_shot || (entry.flags & CONNECT_ONE_SHOT);
+	}
+	return dispatch;
+}
+
+void Object::SignalData::invalidate_dispatch() {
+	_unref_signal_dispatch(dispatch);
+	dispatch = nullptr;
+}
+
+void Object::_unref_signal_dispatch(SignalDispatch *p_dispatch) {
+	if (p_dispatch && p_dispatch->refcount.unref()) {
+		memdelete(p_dispatch);
+	}
+}
+
 Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int p_argcount) {
 	if (_block_signals) {
 		return ERR_CANT_ACQUIRE_RESOURCE; //no emit, signals blocked
 	}
 
-	constexpr int MAX_SLOTS_ON_STACK = 5;
-	// Don't default initialize the Callable objects on the stack, just reserve the space - we'll memnew_placement() them later.
-	alignas(Callable) uint8_t slot_callable_stack[sizeof(Callable) * MAX_SLOTS_ON_STACK];
-	uint32_t slot_flags_stack[MAX_SLOTS_ON_STACK];
-
-	Callable *slot_callables = (Callable *)slot_callable_stack;
-	uint32_t *slot_flags = slot_flags_stack;
-	uint32_t slot_count = 0;
+	// Ensure that disconnecting the signal or even deleting the object
+	// will not affect the signal calling.
+	SignalDispatch *dispatch = nullptr;
 
 	{
 		OBJ_SIGNAL_LOCK
@@ -1239,32 +1259,23 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			return ERR_UNAVAILABLE;
 		}
 
-		if (s->slot_map.size() > MAX_SLOTS_ON_STACK) {
-			slot_callables = (Callable *)memalloc(sizeof(Callable) * s->slot_map.size());
-			slot_flags = (uint32_t *)memalloc(sizeof(uint32_t) * s->slot_map.size());
-		}
-
-		// Ensure that disconnecting the signal or even deleting the object
-		// will not affect the signal calling.
-		for (const KeyValue<Callable, SignalData::Slot> &slot_kv : s->slot_map) {
-			memnew_placement(&slot_callables[slot_count], Callable(slot_kv.value.conn.callable));
-			slot_flags[slot_count] = slot_kv.value.conn.flags;
-			++slot_count;
-		}
-
-		DEV_ASSERT(slot_count == s->slot_map.size());
+		dispatch = s->get_dispatch();
+		dispatch->refcount.ref();
 
 		// Disconnect all one-shot connections before emitting to prevent recursion.
-		for (uint32_t i = 0; i < slot_count; ++i) {
-			bool disconnect = slot_flags[i] & CONNECT_ONE_SHOT;
+		// This drops the signal's dispatch, but not the reference held here.
+		if (dispatch->has_one_shot) {
+			for (const SignalDispatch::Entry &entry : dispatch->entries) {
+				bool disconnect = entry.flags & CONNECT_ONE_SHOT;
 #ifdef TOOLS_ENABLED
-			if (disconnect && (slot_flags[i] & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
-				// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
-				disconnect = false;
-			}
+				if (disconnect && (entry.flags & CONNECT_PERSIST) && Engine::get_singleton()->is_editor_hint()) {
+					// This signal was connected from the editor, and is being edited. Just don't disconnect for now.
+					disconnect = false;
+				}
 #endif
-			if (disconnect) {
-				_disconnect(p_name, slot_callables[i]);
+				if (disconnect) {
+					_disconnect(p_name, entry.callable);
+				}
 			}
 		}
 	}
@@ -1280,9 +1291,9 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 
 	Error err = OK;
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		const Callable &callable = slot_callables[i];
-		const uint32_t &flags = slot_flags[i];
+	for (const SignalDispatch::Entry &entry : dispatch->entries) {
+		const Callable &callable = entry.callable;
+		const uint32_t flags = entry.flags;
 
 		if (!callable.is_valid()) {
 			// Target might have been deleted during signal callback, this is expected and OK.
@@ -1298,7 +1309,12 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 			Callable::CallError ce;
 			_emitting = true;
 			Variant ret;
-			callable.callp(args, argc, ret, ce);
+			if (entry.custom) {
+				// Validity was checked above, skip the checks of Callable::callp().
+				entry.custom->call(args, argc, ret, ce);
+			} else {
+				callable.callp(args, argc, ret, ce);
+			}
 			_emitting = false;
 
 			if (ce.error != Callable::CallError::CALL_OK) {
@@ -1318,14 +1334,7 @@ Error Object::emit_signalp(const StringName &p_name, const Variant **p_args, int
 		}
 	}
 
-	for (uint32_t i = 0; i < slot_count; ++i) {
-		slot_callables[i].~Callable();
-	}
-
-	if (slot_callables != (Callable *)slot_callable_stack) {
-		memfree(slot_callables);
-		memfree(slot_flags);
-	}
+	_unref_signal_dispatch(dispatch);
 
 	if (pending_unref) {
 		// We have to do the same Ref<T> would do. We can't just use Ref<T>
@@ -1557,6 +1566,7 @@ Error Object::connect(const StringName &p_signal, const Callable &p_callable, ui
 
 	//use callable version as key, so binds can be ignored
 	s->slot_map[*p_callable.get_base_comparator()] = slot;
+	s->invalidate_dispatch();
 
 	return OK;
 }
@@ -1637,6 +1647,7 @@ bool Object::_disconnect(const StringName &p_signal, const Callable &p_callable,
 	}
 
 	s->slot_map.erase(*p_callable.get_base_comparator());
+	s->invalidate_dispatch();
 
 	if (s->slot_map.is_empty() && ClassDB::has_signal(get_class_name(), p_signal)) {
 		//not user signal, delete
@@ -2360,10 +2371,10 @@ void postinitialize_handler(Object *p_object) {
 
 void ObjectDB::debug_objects(DebugFunc p_func) {
 	mutex.lock();
-	for (uint32_t i = 1; i < block_count; i++) {
+	for (uint32_t i = 1; i <= block_max; i++) {
 		for (uint32_t j = 0; j < blocks_max_sizes[i]; j++) {
-			if (blocks[i][j].validator) {
-				Object *obj = blocks[i][j].object;
+			if (blocks[i][j].validator.load(std::memory_order_acquire)) {
+				Object *obj = blocks[i][j].object.load(std::memory_order_relaxed);
 				p_func(obj);
 			}
 		}
@@ -2422,7 +2433,9 @@ uint32_t ObjectDB::slot_count = 0;
 uint32_t ObjectDB::block_count = 0;
 uint32_t ObjectDB::slot_max = 0;
 uint32_t ObjectDB::block_max = 0;
-uint64_t ObjectDB::validator_counter = 0;
+std::atomic<uint64_t> ObjectDB::validator_counter{ 0 };
+SafeNumeric<int> ObjectDB::object_count;
+thread_local ObjectDB::ThreadSlotCache ObjectDB::slot_cache;
 
 const uint32_t ObjectDB::blocks_max_sizes[OBJECTDB_MAX_BLOCKS] = {
 	0,
@@ -2462,60 +2475,92 @@ const uint32_t ObjectDB::blocks_max_sizes[OBJECTDB_MAX_BLOCKS] = {
 ObjectDB::ObjectSlot *ObjectDB::blocks[OBJECTDB_MAX_BLOCKS] = { nullptr };
 
 int ObjectDB::get_object_count() {
-	return slot_count;
+	return object_count.get();
+}
+
+ObjectDB::ThreadSlotCache::~ThreadSlotCache() {
+	// Threads exiting after ObjectDB cleanup have nothing to give back to.
+	if (count && !cleaned_up) {
+		MutexLock lock(mutex);
+		_push_free_slots(slots, count);
+	}
+}
+
+// The free slots form a stack overlaid on the slot array: positions below the
+// top are handed out, and each position at or above it names a free slot.
+uint32_t ObjectDB::_pop_free_slots(NextFree *r_slots, uint32_t p_count) {
+	for (uint32_t n = 0; n < p_count; n++) {
+		if (slot_count == blocks_max_sizes[block_count] && blocks[block_count + 1] != nullptr) {
+			slot_count = 0;
+			block_count++;
+		}
+		if (unlikely(slot_count == blocks_max_sizes[block_max])) {
+			CRASH_COND(block_max + 1 == OBJECTDB_MAX_BLOCKS);
+			CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
+
+			uint32_t new_block = block_max + 1;
+			uint32_t new_slot_max = blocks_max_sizes[new_block];
+			ObjectSlot *block = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * new_slot_max);
+			for (uint32_t i = 0; i < new_slot_max; i++) {
+				memnew_placement(&block[i], ObjectSlot);
+				block[i].next_free.block_number = new_block;
+				block[i].next_free.block_position = i;
+			}
+			blocks[new_block] = block;
+			block_max = new_block;
+			slot_max = new_slot_max;
+			block_count = block_max;
+			slot_count = 0;
+		}
+
+		r_slots[n] = blocks[block_count][slot_count].next_free;
+		slot_count++;
+	}
+	return p_count;
+}
+
+void ObjectDB::_push_free_slots(const NextFree *p_slots, uint32_t p_count) {
+	for (uint32_t n = 0; n < p_count; n++) {
+		if (slot_count == 0) {
+			block_count--;
+			slot_count = blocks_max_sizes[block_count];
+		}
+		slot_count--;
+		blocks[block_count][slot_count].next_free = p_slots[n];
+	}
 }
 
 ObjectID ObjectDB::add_instance(Object *p_object) {
-	mutex.lock();
-	if (slot_count == blocks_max_sizes[block_count] && blocks[block_count + 1] != nullptr) {
-		slot_count = 0;
-		block_count++;
-	}
-	if (unlikely(slot_count == blocks_max_sizes[block_max])) {
-		block_max++;
-		CRASH_COND(block_max == OBJECTDB_MAX_BLOCKS);
-		CRASH_COND(slot_count == (1 << OBJECTDB_SLOT_MAX_COUNT_BITS));
-
-		blocks[block_max] = (ObjectSlot *)memalloc(sizeof(ObjectSlot) * blocks_max_sizes[block_max]);
-		uint32_t new_slot_max = blocks_max_sizes[block_max];
-		for (uint32_t i = 0; i < new_slot_max; i++) {
-			blocks[block_max][i].object = nullptr;
-			blocks[block_max][i].is_ref_counted = false;
-			blocks[block_max][i].next_free.block_number = block_max;
-			blocks[block_max][i].next_free.block_position = i;
-			blocks[block_max][i].validator = 0;
-		}
-		slot_max = new_slot_max;
-		block_count = block_max;
-		slot_count = 0;
-	}
-
-	NextFree slot = blocks[block_count][slot_count].next_free;
-	Object *o = blocks[slot.block_number][slot.block_position].object;
-	if (o != nullptr) {
-		mutex.unlock();
-		ERR_FAIL_COND_V(o != nullptr, ObjectID());
-	}
-	blocks[slot.block_number][slot.block_position].object = p_object;
-	blocks[slot.block_number][slot.block_position].is_ref_counted = p_object->is_ref_counted();
-	validator_counter = (validator_counter + 1) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(validator_counter == 0)) {
-		validator_counter = 1;
-	}
-	blocks[slot.block_number][slot.block_position].validator = validator_counter;
-
-	uint64_t id = validator_counter;
+	ThreadSlotCache &cache = slot_cache;
+	if (unlikely(cache.count == 0)) {
+		MutexLock lock(mutex);
+		cache.count = _pop_free_slots(cache.slots, ThreadSlotCache::BATCH);
+	}
+
+	NextFree slot = cache.slots[cache.count - 1];
+	ObjectSlot &object_slot = blocks[slot.block_number][slot.block_position];
+	ERR_FAIL_COND_V(object_slot.object.load(std::memory_order_relaxed) != nullptr, ObjectID());
+	cache.count--;
+
+	uint64_t validator = 0;
+	while (unlikely(validator == 0)) {
+		validator = (validator_counter.fetch_add(1, std::memory_order_relaxed) + 1) & OBJECTDB_VALIDATOR_MASK;
+	}
+
+	const bool is_ref_counted = p_object->is_ref_counted();
+	object_slot.is_ref_counted = is_ref_counted;
+	object_slot.object.store(p_object, std::memory_order_release);
+	object_slot.validator.store(validator, std::memory_order_release);
+	object_count.increment();
+
+	uint64_t id = validator;
 	id <<= OBJECTDB_SLOT_MAX_POSITION_BITS;
 	id |= uint64_t(slot.position);
 
-	if (p_object->is_ref_counted()) {
+	if (is_ref_counted) {
 		id |= OBJECTDB_REFERENCE_BIT;
 	}
 
-	slot_count++;
-
-	mutex.unlock();
-
 	return ObjectID(id);
 }
 
@@ -2523,38 +2568,29 @@ void ObjectDB::remove_instance(Object *p_object) {
 	uint64_t t = p_object->get_instance_id();
 	NextFree slot;
 	slot.position = t & OBJECTDB_SLOT_MAX_POSITION_MASK;
-
-	mutex.lock();
+	ObjectSlot &object_slot = blocks[slot.block_number][slot.block_position];
 
 #ifdef DEBUG_ENABLED
-
-	if (blocks[slot.block_number][slot.block_position].object != p_object) {
-		mutex.unlock();
-		ERR_FAIL_COND(blocks[slot.block_number][slot.block_position].object != p_object);
-	}
+	ERR_FAIL_COND(object_slot.object.load(std::memory_order_relaxed) != p_object);
 	{
 		uint64_t validator = (t >> OBJECTDB_SLOT_MAX_POSITION_BITS) & OBJECTDB_VALIDATOR_MASK;
-		if (blocks[slot.block_number][slot.block_position].validator != validator) {
-			mutex.unlock();
-			ERR_FAIL_COND(blocks[slot.block_number][slot.block_position].validator != validator);
-		}
+		ERR_FAIL_COND(object_slot.validator.load(std::memory_order_relaxed) != validator);
 	}
-
 #endif
-	//decrease slot count
-	if (slot_count == 0) {
-		block_count--;
-		slot_count = blocks_max_sizes[block_count];
-	}
-	slot_count--;
-	//set the free slot properly
-	blocks[block_count][slot_count].next_free = slot;
-	//invalidate, so checks against it fail
-	blocks[slot.block_number][slot.block_position].validator = 0;
-	blocks[slot.block_number][slot.block_position].is_ref_counted = false;
-	blocks[slot.block_number][slot.block_position].object = nullptr;
 
-	mutex.unlock();
+	// Invalidate first, so lookups racing with the removal fail their second validator check.
+	object_slot.validator.store(0, std::memory_order_relaxed);
+	object_slot.is_ref_counted = false;
+	object_slot.object.store(nullptr, std::memory_order_release);
+	object_count.decrement();
+
+	ThreadSlotCache &cache = slot_cache;
+	if (unlikely(cache.count == ThreadSlotCache::CAPACITY)) {
+		MutexLock lock(mutex);
+		cache.count -= ThreadSlotCache::BATCH;
+		_push_free_slots(&cache.slots[cache.count], ThreadSlotCache::BATCH);
+	}
+	cache.slots[cache.count++] = slot;
 }
 
 void ObjectDB::setup() {
@@ -2564,7 +2600,7 @@ void ObjectDB::setup() {
 void ObjectDB::cleanup() {
 	mutex.lock();
 
-	if (slot_count > 0) {
+	if (object_count.get() > 0) {
 		WARN_PRINT("ObjectDB instances leaked at exit (run with --verbose for details).");
 		if (OS::get_singleton()->is_stdout_verbose()) {
 			// Ensure calling the native classes because if a leaked instance has a script
@@ -2574,10 +2610,10 @@ void ObjectDB::cleanup() {
 			MethodBind *resource_get_path = ClassDB::get_method("Resource", "get_path");
 			Callable::CallError call_error;
 
-			for (uint32_t i = 1; i < block_count; i++) {
+			for (uint32_t i = 1; i <= block_max; i++) {
 				for (uint32_t j = 0; j < blocks_max_sizes[i]; j++) {
-					if (blocks[i][j].validator) {
-						Object *obj = blocks[i][j].object;
+					if (blocks[i][j].validator.load(std::memory_order_relaxed)) {
+						Object *obj = blocks[i][j].object.load(std::memory_order_relaxed);
 
 						String extra_info;
 						if (obj->is_class("Node")) {
@@ -2587,7 +2623,7 @@ void ObjectDB::cleanup() {
 							extra_info = " - Resource path: " + String(resource_get_path->call(obj, nullptr, 0, call_error));
 						}
 
-						uint64_t id = uint64_t(i) | (uint64_t(blocks[i][j].validator) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (blocks[i][j].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
+						uint64_t id = uint64_t(i) | (uint64_t(blocks[i][j].validator.load(std::memory_order_relaxed)) << OBJECTDB_SLOT_MAX_COUNT_BITS) | (blocks[i][j].is_ref_counted ? OBJECTDB_REFERENCE_BIT : 0);
 						DEV_ASSERT(id == (uint64_t)obj->get_instance_id()); // We could just use the id from the object, but this check may help catching memory corruption catastrophes.
 						print_line("Leaked instance: " + String(obj->get_class()) + ":" + uitos(id) + extra_info);
 					}
@@ -2597,9 +2633,11 @@ void ObjectDB::cleanup() {
 		}
 	}
 
-	for (uint32_t i = 1; i < block_count; i++) {
+	for (uint32_t i = 1; i <= block_max; i++) {
 		memfree(blocks[i]);
+		blocks[i] = nullptr;
 	}
+	cleaned_up = true;
 	mutex.unlock();
 }
 Object *ObjectDB::get_instance(ObjectID p_instance_id) {
@@ -2614,10 +2652,15 @@ Object *ObjectDB::get_instance(ObjectID p_instance_id) {
 		return nullptr;
 	}
 	uint64_t validator = (id >> OBJECTDB_SLOT_MAX_POSITION_BITS) & OBJECTDB_VALIDATOR_MASK;
-	if (unlikely(blocks[slot.block_number][slot.block_position].validator != validator)) {
+	const ObjectSlot &object_slot = blocks[slot.block_number][slot.block_position];
+	if (unlikely(object_slot.validator.load(std::memory_order_acquire) != validator)) {
+		return nullptr;
+	}
+	Object *object = object_slot.object.load(std::memory_order_acquire);
+	// The slot may have been freed, or freed and reused, while the object was read.
+	if (unlikely(object_slot.validator.load(std::memory_order_relaxed) != validator)) {
 		return nullptr;
 	}
-	Object *object = blocks[slot.block_number][slot.block_position].object;
 
 	return object;
 }
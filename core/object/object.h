@@ -48,6 +48,7 @@
 #include "core/templates/hash_map.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_map.h"
 #include "core/templates/safe_refcount.h"
 #include "core/variant/callable_bind.h"
@@ -622,6 +623,23 @@ private:
 	ObjectGDExtension *_extension = nullptr;
 	GDExtensionClassInstancePtr _extension_instance = nullptr;
 
+	/// Flat copy of a signal's slots that emissions iterate. Built by the first
+	/// emission after the slots change and shared by every emission until the
+	/// next change; each emission holds a reference, so connections made or
+	/// removed by the callees don't affect the slots it calls.
+	struct SignalDispatch {
+		struct Entry {
+			Callable callable;
+			/// Set for custom callables, which are invoked directly.
+			CallableCustom *custom = nullptr;
+			uint32_t flags = 0;
+		};
+
+		SafeRefCount refcount;
+		LocalVector<Entry> entries;
+		bool has_one_shot = false;
+	};
+
 	struct SignalData {
 		struct Slot {
 			int reference_count = 0;
@@ -632,7 +650,19 @@ private:
 		MethodInfo user;
 		HashMap<Callable, Slot, HashableHasher<Callable>> slot_map;
 		bool removable = false;
+		SignalDispatch *dispatch = nullptr;
+
+		SignalDispatch *get_dispatch();
+		void invalidate_dispatch();
+
+		SignalData() {}
+		// The dispatch is not shared by copies, they build their own.
+		SignalData(const SignalData &p_other) :
+				user(p_other.user), slot_map(p_other.slot_map), removable(p_other.removable) {}
+		SignalData &operator=(const SignalData &p_other);
+		~SignalData() { invalidate_dispatch(); }
 	};
+	static void _unref_signal_dispatch(SignalDispatch *p_dispatch);
 	friend struct _ObjectSignalLock;
 	mutable Mutex *signal_mutex = nullptr;
 	HashMap<StringName, SignalData> signal_map;
@@ -1057,10 +1087,25 @@ class ObjectDB {
 	};
 
 	struct ObjectSlot {
-		uint64_t validator;
+		// Lookups read these without locking: the validator is checked before
+		// and after reading the object, so a slot freed or reused in between
+		// is never reported as valid.
+		std::atomic<uint64_t> validator{ 0 };
 		NextFree next_free;
-		bool is_ref_counted;
-		Object *object = nullptr;
+		bool is_ref_counted = false;
+		std::atomic<Object *> object{ nullptr };
+	};
+
+	/// Free slots taken from the shared stack in batches, so most additions
+	/// and removals from a thread don't touch the mutex.
+	struct ThreadSlotCache {
+		static constexpr uint32_t CAPACITY = 64;
+		static constexpr uint32_t BATCH = CAPACITY / 2;
+
+		NextFree slots[CAPACITY];
+		uint32_t count = 0;
+
+		~ThreadSlotCache();
 	};
 
 	static ObjectSlot *blocks[OBJECTDB_MAX_BLOCKS];
@@ -1071,7 +1116,13 @@ class ObjectDB {
 	static uint32_t block_max;
 
 	static BinaryMutex mutex;
-	static uint64_t validator_counter;
+	static std::atomic<uint64_t> validator_counter;
+	static SafeNumeric<int> object_count;
+	static inline bool cleaned_up = false;
+	static thread_local ThreadSlotCache slot_cache;
+
+	static uint32_t _pop_free_slots(NextFree *r_slots, uint32_t p_count);
+	static void _push_free_slots(const NextFree *p_slots, uint32_t p_count);
 
 	friend class Object;
 	friend void unregister_core_types();
@@ -1099,3 +1150,23 @@ public:
 	static void debug_objects(DebugFunc p_func);
 	static int get_object_count();
 };
+
+#ifdef DEBUG_ENABLED
+
+/// Keeps an object from being freed while one of its methods runs, see Object::callp().
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+
+#endif // DEBUG_ENABLED
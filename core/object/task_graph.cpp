@@ -0,0 +1,242 @@
+/**************************************************************************/
+/*  task_graph.cpp                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+/**
+ * @file task_graph.cpp
+ *
+ * [Add any documentation that applies to the entire file here!]
+ */
+
+#include "task_graph.h"
+
+void TaskGraph::_node_task(void *p_node) {
+	Node *node = (Node *)p_node;
+	if (node->native_func) {
+		node->native_func(node->native_func_userdata);
+	} else if (node->template_userdata) {
+		node->template_userdata->callback();
+	} else {
+		node->callable.call();
+	}
+	node->graph->_release_node(node);
+}
+
+void TaskGraph::_node_group_task(void *p_node, uint32_t p_index) {
+	Node *node = (Node *)p_node;
+	if (node->native_group_func) {
+		node->native_group_func(node->native_func_userdata, p_index);
+	} else if (node->template_userdata) {
+		node->template_userdata->callback_indexed(p_index);
+	} else {
+		node->callable.call(p_index);
+	}
+	if (node->pending_elements.decrement() == 0) {
+		node->graph->_release_node(node);
+	}
+}
+
+TaskGraph::NodeID TaskGraph::_add_node(Node *p_node, std::initializer_list<NodeID> p_dependencies) {
+	if (unlikely(running)) {
+		if (p_node->template_userdata) {
+			memdelete(p_node->template_userdata);
+		}
+		memdelete(p_node);
+		ERR_FAIL_V_MSG(INVALID_NODE_ID, "Can't add nodes to a TaskGraph while it's running.");
+	}
+
+	p_node->graph = this;
+	NodeID id = nodes.size();
+	nodes.push_back(p_node);
+	for (NodeID dependency : p_dependencies) {
+		add_dependency(id, dependency);
+	}
+	return id;
+}
+
+void TaskGraph::_post_node(Node *p_node) {
+	if (p_node->is_group) {
+		if (p_node->elements == 0) {
+			// Nothing to run, but successors still have to be released.
+			_release_node(p_node);
+			_release_node(p_node);
+			return;
+		}
+		p_node->pool_id = pool->add_native_group_task(&TaskGraph::_node_group_task, p_node, p_node->elements, p_node->tasks, p_node->high_priority, p_node->description);
+	} else {
+		p_node->pool_id = pool->add_native_task(&TaskGraph::_node_task, p_node, p_node->high_priority, p_node->description);
+	}
+	_release_node(p_node);
+}
+
+void TaskGraph::_release_node(Node *p_node) {
+	if (p_node->pending_releases.decrement() > 0) {
+		return;
+	}
+
+	for (Node *successor : p_node->successors) {
+		if (successor->pending_predecessors.decrement() == 0) {
+			_post_node(successor);
+		}
+	}
+
+	// Nothing in the graph may be touched after this, since the waiting thread can go ahead.
+	if (pending_nodes.decrement() == 0) {
+		done_semaphore.post();
+	}
+}
+
+TaskGraph::NodeID TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, std::initializer_list<NodeID> p_dependencies, bool p_high_priority, const String &p_description) {
+	Node *node = memnew(Node);
+	node->native_func = p_func;
+	node->native_func_userdata = p_userdata;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_dependencies);
+}
+
+TaskGraph::NodeID TaskGraph::add_task(const Callable &p_action, std::initializer_list<NodeID> p_dependencies, bool p_high_priority, const String &p_description) {
+	Node *node = memnew(Node);
+	node->callable = p_action;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_dependencies);
+}
+
+TaskGraph::NodeID TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, std::initializer_list<NodeID> p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	ERR_FAIL_COND_V(p_elements < 0, INVALID_NODE_ID);
+	Node *node = memnew(Node);
+	node->native_group_func = p_func;
+	node->native_func_userdata = p_userdata;
+	node->is_group = true;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_dependencies);
+}
+
+TaskGraph::NodeID TaskGraph::add_group_task(const Callable &p_action, int p_elements, std::initializer_list<NodeID> p_dependencies, int p_tasks, bool p_high_priority, const String &p_description) {
+	ERR_FAIL_COND_V(p_elements < 0, INVALID_NODE_ID);
+	Node *node = memnew(Node);
+	node->callable = p_action;
+	node->is_group = true;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	node->high_priority = p_high_priority;
+	node->description = p_description;
+	return _add_node(node, p_dependencies);
+}
+
+void TaskGraph::add_dependency(NodeID p_node, NodeID p_predecessor) {
+	ERR_FAIL_COND_MSG(running, "Can't add dependencies to a TaskGraph while it's running.");
+	ERR_FAIL_INDEX(p_node, (NodeID)nodes.size());
+	ERR_FAIL_COND_MSG(p_predecessor < 0 || p_predecessor >= p_node, "A node can only depend on nodes created before it.");
+
+	Node *node = nodes[p_node];
+	Node *predecessor = nodes[p_predecessor];
+	if (predecessor->successors.has(node)) {
+		return;
+	}
+	predecessor->successors.push_back(node);
+	node->predecessor_count++;
+}
+
+bool TaskGraph::is_completed() const {
+	return pending_nodes.get() == 0;
+}
+
+void TaskGraph::run() {
+	ERR_FAIL_COND_MSG(running, "TaskGraph is already running.");
+	ERR_FAIL_NULL(pool);
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	running = true;
+
+	// Everything must be reset before the first post, since nodes start completing right away.
+	pending_nodes.set(nodes.size());
+	for (Node *node : nodes) {
+		node->pending_predecessors.set(node->predecessor_count);
+		node->pending_elements.set(node->elements);
+		node->pending_releases.set(2);
+		node->pool_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+
+	for (Node *node : nodes) {
+		if (node->predecessor_count == 0) {
+			_post_node(node);
+		}
+	}
+}
+
+void TaskGraph::wait() {
+	if (!running) {
+		return;
+	}
+
+	done_semaphore.wait();
+
+	// Everything is complete by now, so this only gives the IDs back to the pool.
+	for (Node *node : nodes) {
+		if (node->pool_id == WorkerThreadPool::INVALID_TASK_ID) {
+			continue;
+		}
+		if (node->is_group) {
+			pool->wait_for_group_task_completion(node->pool_id);
+		} else {
+			pool->wait_for_task_completion(node->pool_id);
+		}
+	}
+
+	running = false;
+}
+
+void TaskGraph::clear() {
+	ERR_FAIL_COND_MSG(running, "Can't clear a TaskGraph while it's running.");
+	for (Node *node : nodes) {
+		if (node->template_userdata) {
+			memdelete(node->template_userdata);
+		}
+		memdelete(node);
+	}
+	nodes.clear();
+}
+
+TaskGraph::TaskGraph(WorkerThreadPool *p_pool) {
+	pool = p_pool ? p_pool : WorkerThreadPool::get_singleton();
+}
+
+TaskGraph::~TaskGraph() {
+	wait();
+	clear();
+}
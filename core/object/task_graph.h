@@ -0,0 +1,176 @@
+/**************************************************************************/
+/*  task_graph.h                                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file task_graph.h
+ *
+ * @brief Dependency-driven scheduling on top of WorkerThreadPool.
+ * Nodes are tasks or group tasks that declare the nodes they depend on. Once the graph is run,
+ * every node is posted to the pool as soon as its last predecessor completes, from whichever
+ * thread completed it, so no thread ever blocks on an intermediate result. Only wait() blocks,
+ * until the whole graph is done.
+ *
+ * A node can only depend on nodes created before it, which keeps the graph acyclic by construction.
+ * A graph can be run again after wait() returns. Nodes can't be added while it's running.
+ */
+
+#include "core/object/worker_thread_pool.h"
+
+#include <initializer_list>
+
+class TaskGraph {
+public:
+	typedef int32_t NodeID;
+
+	enum {
+		INVALID_NODE_ID = -1
+	};
+
+private:
+	struct BaseTemplateUserdata {
+		virtual void callback() {}
+		virtual void callback_indexed(uint32_t p_index) {}
+		virtual ~BaseTemplateUserdata() {}
+	};
+
+	template <typename C, typename M, typename U>
+	struct TaskUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback() override {
+			(instance->*method)(userdata);
+		}
+	};
+
+	template <typename C, typename M, typename U>
+	struct GroupUserData : public BaseTemplateUserdata {
+		C *instance;
+		M method;
+		U userdata;
+		virtual void callback_indexed(uint32_t p_index) override {
+			(instance->*method)(p_index, userdata);
+		}
+	};
+
+	struct Node {
+		TaskGraph *graph = nullptr;
+		Callable callable;
+		void (*native_func)(void *) = nullptr;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		BaseTemplateUserdata *template_userdata = nullptr;
+		String description;
+		bool high_priority = false;
+		bool is_group = false;
+		int elements = 0;
+		int tasks = -1;
+
+		LocalVector<Node *> successors;
+		uint32_t predecessor_count = 0;
+
+		SafeNumeric<uint32_t> pending_predecessors;
+		SafeNumeric<uint32_t> pending_elements; ///< Group nodes only.
+		/// Released once by the thread posting the node (after storing pool_id) and once when its work completes,
+		/// so successors never race with the bookkeeping of the post.
+		SafeNumeric<uint32_t> pending_releases;
+		int64_t pool_id = WorkerThreadPool::INVALID_TASK_ID;
+	};
+
+	WorkerThreadPool *pool = nullptr;
+	LocalVector<Node *> nodes;
+	SafeNumeric<uint32_t> pending_nodes;
+	Semaphore done_semaphore;
+	bool running = false;
+
+	static void _node_task(void *p_node);
+	static void _node_group_task(void *p_node, uint32_t p_index);
+
+	NodeID _add_node(Node *p_node, std::initializer_list<NodeID> p_dependencies);
+	void _post_node(Node *p_node);
+	void _release_node(Node *p_node);
+
+public:
+	template <typename C, typename M, typename U>
+	NodeID add_template_task(C *p_instance, M p_method, U p_userdata, std::initializer_list<NodeID> p_dependencies = {}, bool p_high_priority = false, const String &p_description = String()) {
+		typedef TaskUserData<C, M, U> TUD;
+		TUD *ud = memnew(TUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		Node *node = memnew(Node);
+		node->template_userdata = ud;
+		node->high_priority = p_high_priority;
+		node->description = p_description;
+		return _add_node(node, p_dependencies);
+	}
+	NodeID add_native_task(void (*p_func)(void *), void *p_userdata, std::initializer_list<NodeID> p_dependencies = {}, bool p_high_priority = false, const String &p_description = String());
+	NodeID add_task(const Callable &p_action, std::initializer_list<NodeID> p_dependencies = {}, bool p_high_priority = false, const String &p_description = String());
+
+	template <typename C, typename M, typename U>
+	NodeID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, std::initializer_list<NodeID> p_dependencies = {}, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String()) {
+		ERR_FAIL_COND_V(p_elements < 0, INVALID_NODE_ID);
+		typedef GroupUserData<C, M, U> GroupUD;
+		GroupUD *ud = memnew(GroupUD);
+		ud->instance = p_instance;
+		ud->method = p_method;
+		ud->userdata = p_userdata;
+		Node *node = memnew(Node);
+		node->template_userdata = ud;
+		node->is_group = true;
+		node->elements = p_elements;
+		node->tasks = p_tasks;
+		node->high_priority = p_high_priority;
+		node->description = p_description;
+		return _add_node(node, p_dependencies);
+	}
+	NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, std::initializer_list<NodeID> p_dependencies = {}, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+	NodeID add_group_task(const Callable &p_action, int p_elements, std::initializer_list<NodeID> p_dependencies = {}, int p_tasks = -1, bool p_high_priority = false, const String &p_description = String());
+
+	/// For dependencies not known when the node was created. The predecessor must have been created earlier.
+	void add_dependency(NodeID p_node, NodeID p_predecessor);
+
+	_FORCE_INLINE_ uint32_t get_node_count() const { return nodes.size(); }
+	_FORCE_INLINE_ bool is_running() const { return running; }
+	bool is_completed() const;
+
+	/// Posts the nodes without predecessors and returns immediately.
+	void run();
+	/// Blocks until every node has completed, then releases the pool resources used by the run.
+	void wait();
+	void clear();
+
+	TaskGraph(WorkerThreadPool *p_pool = nullptr);
+	~TaskGraph();
+};
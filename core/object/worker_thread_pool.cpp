@@ -192,10 +192,12 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
+	thread_data->steal_seed = hash_murmur3_one_32(thread_data->index) | 1;
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: tasks posted by pool threads can be taken without touching the task mutex.
+		Task *task_to_process = thread_data->pool->_pop_or_steal_task(thread_data);
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -208,17 +210,30 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 
 				thread_data->signaled = false;
 
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
+				if (thread_data->pool->task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->task_queue.first()->self();
+					thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
+					break;
+				}
+
+				// A local queue may have been filled since the lock-free attempt.
+				task_to_process = thread_data->pool->_pop_or_steal_task(thread_data);
+				if (task_to_process) {
+					break;
+				}
+				if (thread_data->pool->_has_local_tasks()) {
+					// Lost a race against other thieves, but there's still work around.
+					// Back off without the lock, so producers aren't starved while retrying.
+					lock.temp_unlock();
+					OS::get_singleton()->yield();
+					lock.temp_relock();
 					continue;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck.
+				thread_data->cond_var.wait(lock);
 			}
 		}
 
@@ -248,10 +263,17 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// Tasks posted from a pool thread go to its own queue, where idle threads can steal them
+	// without contending for the task mutex. Pump tasks are kept in the shared queue, since
+	// only some threads are allowed to take them.
+	bool use_local_queue = caller_pool_thread && !p_pump_task;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (!use_local_queue || !caller_pool_thread->local_queue.push(p_tasks[i])) {
+				task_queue.add_last(&p_tasks[i]->task_elem);
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -335,6 +357,46 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+WorkerThreadPool::Task *WorkerThreadPool::_pop_or_steal_task(ThreadData *p_thread_data) {
+	Task *task = p_thread_data->local_queue.pop();
+	if (task) {
+		return task;
+	}
+
+	uint32_t thread_count = threads.size();
+	if (thread_count <= 1) {
+		return nullptr;
+	}
+
+	// Start at a random victim (xorshift32), so thieves don't all pile on the same queue.
+	uint32_t seed = p_thread_data->steal_seed;
+	seed ^= seed << 13;
+	seed ^= seed >> 17;
+	seed ^= seed << 5;
+	p_thread_data->steal_seed = seed;
+
+	uint32_t start = seed % thread_count;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = threads[(start + i) % thread_count];
+		if (&victim == p_thread_data) {
+			continue;
+		}
+		if (victim.local_queue.steal(task) == WorkStealingQueue<Task, LOCAL_QUEUE_SIZE>::STEAL_OK) {
+			return task;
+		}
+	}
+	return nullptr;
+}
+
+bool WorkerThreadPool::_has_local_tasks() const {
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		if (!threads[i].local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
@@ -496,6 +558,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 	while (true) {
 		Task *task_to_process = nullptr;
 		bool relock_unlockables = false;
+		bool back_off = false;
 		{
 			MutexLock lock(task_mutex);
 
@@ -523,7 +586,7 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				if (was_signaled) {
 					// This thread was awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (task_queue.first() || !p_caller_pool_thread->local_queue.is_empty()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
 						// This thread must be left alone since it won't loop again.
@@ -541,7 +604,10 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
+			// Local queues never hold pump tasks, so they can be taken from unconditionally.
+			task_to_process = _pop_or_steal_task(p_caller_pool_thread);
+
+			if (!task_to_process && p_caller_pool_thread->pool->task_queue.first()) {
 				task_to_process = task_queue.first()->self();
 				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
 					task_to_process = nullptr;
@@ -552,19 +618,30 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 			}
 
 			if (!task_to_process) {
-				p_caller_pool_thread->awaited_task = p_task;
+				if (_has_local_tasks()) {
+					// Lost a race against other thieves, but there's still work around.
+					back_off = true;
+				} else {
+					p_caller_pool_thread->awaited_task = p_task;
 
-				if (this == singleton) {
-					_unlock_unlockable_mutexes();
-				}
-				relock_unlockables = true;
+					if (this == singleton) {
+						_unlock_unlockable_mutexes();
+					}
+					relock_unlockables = true;
 
-				p_caller_pool_thread->cond_var.wait(lock);
+					p_caller_pool_thread->cond_var.wait(lock);
 
-				p_caller_pool_thread->awaited_task = nullptr;
+					p_caller_pool_thread->awaited_task = nullptr;
+				}
 			}
 		}
 
+		if (back_off) {
+			// Retry once other threads had a chance to take the lock.
+			OS::get_singleton()->yield();
+			continue;
+		}
+
 		if (relock_unlockables && this == singleton) {
 			_lock_unlockable_mutexes();
 		}
@@ -593,7 +670,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!task_queue.first() && !low_priority_task_queue.first() && !_has_local_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -47,6 +47,7 @@
 #include "core/templates/paged_allocator.h"
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -107,6 +108,7 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t LOCAL_QUEUE_SIZE = 256;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
@@ -130,6 +132,10 @@ private:
 		Task *awaited_task = nullptr; ///< Null if not awaiting the condition variable, or special value (YIELDING).
 		ConditionVariable cond_var;
 		WorkerThreadPool *pool = nullptr;
+		/// Tasks posted by this thread. Only this thread pushes or pops; any other one may steal.
+		/// Pushes still happen under the task mutex so idle threads can't miss them before sleeping.
+		WorkStealingQueue<Task, LOCAL_QUEUE_SIZE> local_queue;
+		uint32_t steal_seed = 1; ///< For randomizing the first victim to steal from.
 
 		ThreadData() :
 				signaled(false),
@@ -199,6 +205,11 @@ private:
 
 	bool _try_promote_low_priority_task();
 
+	/// Lock-free. Pops from the thread's own queue first, then tries to steal from the others.
+	Task *_pop_or_steal_task(ThreadData *p_thread_data);
+	/// Only reliable under the task mutex, since that's where pushes happen.
+	bool _has_local_tasks() const;
+
 	static WorkerThreadPool *singleton;
 
 #ifdef THREADS_ENABLED
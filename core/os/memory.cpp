@@ -67,6 +67,7 @@ void operator delete(void *p_mem, void *p_pointer, size_t check, const char *p_d
 #ifdef DEBUG_ENABLED
 SafeNumeric<uint64_t> Memory::mem_usage;
 SafeNumeric<uint64_t> Memory::max_usage;
+SafeNumeric<uint64_t> Memory::alloc_count;
 #endif
 
 void *Memory::alloc_aligned_static(size_t p_bytes, size_t p_alignment) {
@@ -101,9 +102,67 @@ void Memory::free_aligned_static(void *p_memory) {
 	free(p);
 }
 
+#ifdef MEMORY_TAGS_ENABLED
+thread_local Memory::Tag Memory::current_tag = Memory::TAG_UNTAGGED;
+
+namespace {
+
+// The tag of an allocation is kept in the top bits of its size header.
+constexpr uint64_t HEADER_TAG_SHIFT = 56;
+constexpr uint64_t HEADER_SIZE_MASK = (uint64_t(1) << HEADER_TAG_SHIFT) - 1;
+
+// Plain atomics rather than SafeNumeric, so they are constant-initialized and valid
+// for allocations made during static initialization. Relaxed ordering is enough for statistics.
+struct TagCounters {
+	std::atomic<uint64_t> live_bytes = { 0 };
+	std::atomic<uint64_t> peak_bytes = { 0 };
+	std::atomic<uint64_t> live_allocations = { 0 };
+	std::atomic<uint64_t> total_allocations = { 0 };
+	// Unrelated subsystems allocate concurrently, so keep each tag on its own cache line.
+	uint8_t _pad[64 - 4 * sizeof(std::atomic<uint64_t>)] = {};
+};
+
+TagCounters tag_counters[Memory::TAG_MAX];
+
+_FORCE_INLINE_ uint64_t _make_header(uint64_t p_bytes, Memory::Tag p_tag) {
+	return p_bytes | ((uint64_t)p_tag << HEADER_TAG_SHIFT);
+}
+
+_FORCE_INLINE_ uint64_t _get_header_size(uint64_t p_header) {
+	return p_header & HEADER_SIZE_MASK;
+}
+
+_FORCE_INLINE_ Memory::Tag _get_header_tag(uint64_t p_header) {
+	return (Memory::Tag)(p_header >> HEADER_TAG_SHIFT);
+}
+
+_FORCE_INLINE_ void _tag_add(Memory::Tag p_tag, uint64_t p_bytes) {
+	TagCounters &counters = tag_counters[p_tag];
+	uint64_t live = counters.live_bytes.fetch_add(p_bytes, std::memory_order_relaxed) + p_bytes;
+	uint64_t peak = counters.peak_bytes.load(std::memory_order_relaxed);
+	while (live > peak && !counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+}
+
+_FORCE_INLINE_ void _tag_sub(Memory::Tag p_tag, uint64_t p_bytes) {
+	tag_counters[p_tag].live_bytes.fetch_sub(p_bytes, std::memory_order_relaxed);
+}
+
+} // namespace
+#else
+_FORCE_INLINE_ static uint64_t _make_header(uint64_t p_bytes, Memory::Tag p_tag) {
+	return p_bytes;
+}
+
+_FORCE_INLINE_ static uint64_t _get_header_size(uint64_t p_header) {
+	return p_header;
+}
+#endif
+
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TAGS_ENABLED)
+	// Tags and debug accounting need the size of each allocation when it's freed.
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -118,11 +177,21 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 
 	ERR_FAIL_NULL_V(mem, nullptr);
 
+#ifdef DEBUG_ENABLED
+	alloc_count.increment();
+#endif
+
 	if (prepad) {
 		uint8_t *s8 = (uint8_t *)mem;
 
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
-		*s = p_bytes;
+		*s = _make_header(p_bytes, get_current_tag());
+
+#ifdef MEMORY_TAGS_ENABLED
+		_tag_add(current_tag, p_bytes);
+		tag_counters[current_tag].live_allocations.fetch_add(1, std::memory_order_relaxed);
+		tag_counters[current_tag].total_allocations.fetch_add(1, std::memory_order_relaxed);
+#endif
 
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = mem_usage.add(p_bytes);
@@ -146,6 +215,11 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 #ifdef DEBUG_ENABLED
 	bool prepad = true;
+	if (p_bytes > 0) {
+		alloc_count.increment();
+	}
+#elif defined(MEMORY_TAGS_ENABLED)
+	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
 #endif
@@ -153,28 +227,46 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TAGS_ENABLED)
+		uint64_t prev_bytes = _get_header_size(*s);
+#endif
 
 #ifdef DEBUG_ENABLED
-		if (p_bytes > *s) {
-			uint64_t new_mem_usage = mem_usage.add(p_bytes - *s);
+		if (p_bytes > prev_bytes) {
+			uint64_t new_mem_usage = mem_usage.add(p_bytes - prev_bytes);
 			max_usage.exchange_if_greater(new_mem_usage);
 		} else {
-			mem_usage.sub(*s - p_bytes);
+			mem_usage.sub(prev_bytes - p_bytes);
+		}
+#endif
+
+#ifdef MEMORY_TAGS_ENABLED
+		// Reallocations stay accounted to the tag of the original allocation.
+		Tag tag = _get_header_tag(*s);
+		if (p_bytes > prev_bytes) {
+			_tag_add(tag, p_bytes - prev_bytes);
+		} else {
+			_tag_sub(tag, prev_bytes - p_bytes);
+		}
+		if (p_bytes == 0) {
+			tag_counters[tag].live_allocations.fetch_sub(1, std::memory_order_relaxed);
 		}
+#else
+		Tag tag = TAG_UNTAGGED;
 #endif
 
 		if (p_bytes == 0) {
 			free(mem);
 			return nullptr;
 		} else {
-			*s = p_bytes;
+			*s = _make_header(p_bytes, tag);
 
 			mem = (uint8_t *)realloc(mem, p_bytes + DATA_OFFSET);
 			ERR_FAIL_NULL_V(mem, nullptr);
 
 			s = (uint64_t *)(mem + SIZE_OFFSET);
 
-			*s = p_bytes;
+			*s = _make_header(p_bytes, tag);
 
 			return mem + DATA_OFFSET;
 		}
@@ -192,7 +284,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TAGS_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -201,9 +293,16 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
+#if defined(DEBUG_ENABLED) || defined(MEMORY_TAGS_ENABLED)
+		uint64_t header = *(uint64_t *)(mem + SIZE_OFFSET);
+#endif
 #ifdef DEBUG_ENABLED
-		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
-		mem_usage.sub(*s);
+		mem_usage.sub(_get_header_size(header));
+#endif
+#ifdef MEMORY_TAGS_ENABLED
+		Tag tag = _get_header_tag(header);
+		_tag_sub(tag, _get_header_size(header));
+		tag_counters[tag].live_allocations.fetch_sub(1, std::memory_order_relaxed);
 #endif
 
 		free(mem);
@@ -232,6 +331,213 @@ uint64_t Memory::get_mem_max_usage() {
 #endif
 }
 
+uint64_t Memory::get_mem_alloc_count() {
+#ifdef DEBUG_ENABLED
+	return alloc_count.get();
+#else
+	return 0;
+#endif
+}
+
+Memory::TagStats Memory::get_tag_stats(Tag p_tag) {
+	TagStats stats;
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, stats);
+#ifdef MEMORY_TAGS_ENABLED
+	const TagCounters &counters = tag_counters[p_tag];
+	stats.live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+	stats.peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+	stats.live_allocations = counters.live_allocations.load(std::memory_order_relaxed);
+	stats.total_allocations = counters.total_allocations.load(std::memory_order_relaxed);
+#endif
+	return stats;
+}
+
+const char *Memory::get_tag_name(Tag p_tag) {
+	static const char *names[TAG_MAX] = {
+		"untagged",
+		"resources",
+		"scripts",
+		"physics",
+		"text",
+		"rendering",
+		"audio",
+		"navigation",
+	};
+	ERR_FAIL_INDEX_V(p_tag, TAG_MAX, "");
+	return names[p_tag];
+}
+
+namespace {
+
+struct FrameArena {
+	// Every allocation is preceded by its size, keeping the data aligned to max_align_t.
+	static constexpr size_t HEADER_SIZE = Memory::DATA_OFFSET;
+	static constexpr size_t MIN_CHUNK_SIZE = 64 * 1024;
+
+	struct Chunk {
+		Chunk *next = nullptr;
+		size_t size = 0;
+		size_t used = 0;
+		uint8_t *data = nullptr;
+	};
+
+	Chunk *chunks = nullptr;
+	Chunk *current = nullptr;
+	uint64_t live_allocations = 0;
+	uint64_t usage = 0;
+	uint64_t capacity = 0;
+
+	static SafeNumeric<uint64_t> chunk_alloc_count;
+
+	static _FORCE_INLINE_ size_t align(size_t p_bytes) {
+		return (p_bytes + alignof(max_align_t) - 1) & ~(alignof(max_align_t) - 1);
+	}
+
+	static _FORCE_INLINE_ uint64_t *get_size_ptr(void *p_ptr) {
+		return (uint64_t *)((uint8_t *)p_ptr - HEADER_SIZE + Memory::SIZE_OFFSET);
+	}
+
+	Chunk *new_chunk(size_t p_min_size) {
+		// Grow geometrically, so the chunk count stays low until the arena reaches its steady state.
+		size_t size = MAX(MAX(MIN_CHUNK_SIZE, (size_t)capacity), align(p_min_size));
+		Chunk *chunk = (Chunk *)Memory::alloc_static(sizeof(Chunk) + alignof(max_align_t) + size);
+		ERR_FAIL_NULL_V(chunk, nullptr);
+		chunk_alloc_count.increment();
+		chunk->next = nullptr;
+		chunk->size = size;
+		chunk->used = 0;
+		chunk->data = (uint8_t *)align((uintptr_t)(chunk + 1));
+		capacity += size;
+		return chunk;
+	}
+
+	void free_chunks() {
+		while (chunks) {
+			Chunk *next = chunks->next;
+			Memory::free_static(chunks);
+			chunks = next;
+		}
+		current = nullptr;
+		capacity = 0;
+	}
+
+	void rewind() {
+		DEV_ASSERT(live_allocations == 0);
+		if (chunks && chunks->next) {
+			// The last cycle needed more than one chunk. Replace them with a single one
+			// big enough for all of it, so the next cycles run from contiguous memory.
+			size_t total = capacity;
+			free_chunks();
+			chunks = new_chunk(total);
+		} else if (chunks) {
+			chunks->used = 0;
+		}
+		current = chunks;
+		usage = 0;
+	}
+
+	void *alloc(size_t p_bytes) {
+		size_t needed = HEADER_SIZE + align(p_bytes);
+		while (!current || current->size - current->used < needed) {
+			if (current && current->next) {
+				current = current->next;
+				current->used = 0;
+				continue;
+			}
+			Chunk *chunk = new_chunk(needed);
+			ERR_FAIL_NULL_V(chunk, nullptr);
+			if (current) {
+				current->next = chunk;
+			} else {
+				chunks = chunk;
+			}
+			current = chunk;
+		}
+
+		uint8_t *mem = current->data + current->used + HEADER_SIZE;
+		current->used += needed;
+		*get_size_ptr(mem) = p_bytes;
+		live_allocations++;
+		usage += needed;
+		return mem;
+	}
+
+	void *realloc(void *p_memory, size_t p_bytes) {
+		uint64_t *size_ptr = get_size_ptr(p_memory);
+		size_t old_aligned = align(*size_ptr);
+		size_t new_aligned = align(p_bytes);
+
+		// The most recent allocation can grow or shrink in place.
+		if (current && (uint8_t *)p_memory + old_aligned == current->data + current->used && current->size - current->used + old_aligned >= new_aligned) {
+			current->used = current->used - old_aligned + new_aligned;
+			usage = usage - old_aligned + new_aligned;
+			*size_ptr = p_bytes;
+			return p_memory;
+		}
+
+		if (new_aligned <= old_aligned) {
+			*size_ptr = p_bytes;
+			return p_memory;
+		}
+
+		void *mem = alloc(p_bytes);
+		ERR_FAIL_NULL_V(mem, nullptr);
+		memcpy(mem, p_memory, *size_ptr);
+		free(p_memory);
+		return mem;
+	}
+
+	void free(void *p_memory) {
+		ERR_FAIL_COND_MSG(live_allocations == 0, "Freeing memory not allocated by this thread's FrameAllocator.");
+		live_allocations--;
+		if (live_allocations == 0) {
+			rewind();
+		}
+	}
+
+	~FrameArena() {
+		free_chunks();
+	}
+};
+
+SafeNumeric<uint64_t> FrameArena::chunk_alloc_count;
+
+thread_local FrameArena frame_arena;
+
+} // namespace
+
+void *FrameAllocator::alloc(size_t p_bytes) {
+	return frame_arena.alloc(p_bytes);
+}
+
+void *FrameAllocator::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return frame_arena.alloc(p_bytes);
+	}
+	if (p_bytes == 0) {
+		frame_arena.free(p_memory);
+		return nullptr;
+	}
+	return frame_arena.realloc(p_memory, p_bytes);
+}
+
+void FrameAllocator::free(void *p_ptr) {
+	ERR_FAIL_NULL(p_ptr);
+	frame_arena.free(p_ptr);
+}
+
+uint64_t FrameAllocator::get_chunk_alloc_count() {
+	return FrameArena::chunk_alloc_count.get();
+}
+
+uint64_t FrameAllocator::get_thread_usage() {
+	return frame_arena.usage;
+}
+
+uint64_t FrameAllocator::get_thread_capacity() {
+	return frame_arena.capacity;
+}
+
 _GlobalNil::_GlobalNil() {
 	left = this;
 	right = this;
@@ -45,9 +45,36 @@
 #include <type_traits>
 
 class Memory {
+public:
+	/// Subsystems memory can be accounted to. See MemoryTagScope.
+	enum Tag : uint8_t {
+		TAG_UNTAGGED,
+		TAG_RESOURCES,
+		TAG_SCRIPTS,
+		TAG_PHYSICS,
+		TAG_TEXT,
+		TAG_RENDERING,
+		TAG_AUDIO,
+		TAG_NAVIGATION,
+		TAG_MAX,
+	};
+
+	struct TagStats {
+		uint64_t live_bytes = 0;
+		uint64_t peak_bytes = 0;
+		uint64_t live_allocations = 0;
+		uint64_t total_allocations = 0;
+	};
+
+private:
 #ifdef DEBUG_ENABLED
 	static SafeNumeric<uint64_t> mem_usage;
 	static SafeNumeric<uint64_t> max_usage;
+	static SafeNumeric<uint64_t> alloc_count;
+#endif
+
+#ifdef MEMORY_TAGS_ENABLED
+	static thread_local Tag current_tag;
 #endif
 
 public:
@@ -100,14 +127,81 @@ public:
 	static uint64_t get_mem_available();
 	static uint64_t get_mem_usage();
 	static uint64_t get_mem_max_usage();
+	/// Number of calls that reached the system allocator (allocations and reallocations). Only counted in debug builds.
+	static uint64_t get_mem_alloc_count();
+
+#ifdef MEMORY_TAGS_ENABLED
+	/// Allocations made by the calling thread are accounted to this tag. Returns the previous one.
+	_FORCE_INLINE_ static Tag set_current_tag(Tag p_tag) {
+		Tag prev = current_tag;
+		current_tag = p_tag;
+		return prev;
+	}
+	_FORCE_INLINE_ static Tag get_current_tag() { return current_tag; }
+#else
+	_FORCE_INLINE_ static Tag set_current_tag(Tag p_tag) { return TAG_UNTAGGED; }
+	_FORCE_INLINE_ static Tag get_current_tag() { return TAG_UNTAGGED; }
+#endif
+	/// Always zeroed if the engine was built without memory tags.
+	static TagStats get_tag_stats(Tag p_tag);
+	static const char *get_tag_name(Tag p_tag);
+	static constexpr bool are_tags_enabled() {
+#ifdef MEMORY_TAGS_ENABLED
+		return true;
+#else
+		return false;
+#endif
+	}
 };
 
+/// Accounts the allocations made by the current thread to a tag until the end of the scope.
+/// Allocations keep their tag for their whole lifetime, regardless of where they are freed.
+class MemoryTagScope {
+#ifdef MEMORY_TAGS_ENABLED
+	Memory::Tag prev_tag;
+
+public:
+	_FORCE_INLINE_ explicit MemoryTagScope(Memory::Tag p_tag) { prev_tag = Memory::set_current_tag(p_tag); }
+	_FORCE_INLINE_ ~MemoryTagScope() { Memory::set_current_tag(prev_tag); }
+#else
+public:
+	_FORCE_INLINE_ explicit MemoryTagScope(Memory::Tag p_tag) {}
+#endif
+};
+
+#define MEMORY_TAG_SCOPE(m_tag) MemoryTagScope _memory_tag_scope_(Memory::m_tag)
+
 class DefaultAllocator {
 public:
 	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return Memory::alloc_static(p_memory, false); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return Memory::realloc_static(p_ptr, p_memory, false); }
 	_FORCE_INLINE_ static void free(void *p_ptr) { Memory::free_static(p_ptr, false); }
 };
 
+/// Thread-local linear (bump) allocator for short-lived scratch memory, such as per-frame temporaries.
+/// It can be used wherever DefaultAllocator is accepted, e.g. `LocalVector<T, uint32_t, false, false, FrameAllocator>`.
+///
+/// Each thread carves its allocations out of chunks it owns, so once they are warm, allocating
+/// costs a pointer bump and never reaches the system allocator. The arena of a thread rewinds
+/// as soon as all of its allocations have been freed, which for per-frame temporaries happens
+/// at least once per frame. Consequently:
+/// - Memory must be freed on the thread that allocated it.
+/// - Memory is not reused until every allocation of the thread is freed, so don't keep
+///   allocations alive across frames or the arena will keep growing.
+class FrameAllocator {
+public:
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_ptr);
+
+	/// Number of chunks requested from the system allocator by all threads so far.
+	static uint64_t get_chunk_alloc_count();
+	/// Bytes consumed from the arena of the calling thread since it last rewound.
+	static uint64_t get_thread_usage();
+	/// Bytes reserved by the arena of the calling thread.
+	static uint64_t get_thread_capacity();
+};
+
 void *operator new(size_t p_size, const char *p_description); ///< operator new that takes a description and uses MemoryStaticPool
 void *operator new(size_t p_size, void *(*p_allocfunc)(size_t p_size)); ///< operator new that takes a description and uses MemoryStaticPool
 
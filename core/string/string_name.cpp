@@ -42,35 +42,70 @@
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
+/*
+ * Interned names live in a fixed array of bucket chains.
+ *
+ * Looking up an existing name takes no lock: readers walk a chain through
+ * atomic `next` pointers and take a reference with a conditional increment,
+ * which fails on names whose count already dropped to zero. Nodes come from
+ * paged allocators that never return their pages before cleanup, so a reader
+ * racing with a removal only ever reads a stale node, never unmapped memory.
+ * The name is compared after the reference is taken, which catches nodes that
+ * were freed and reused for another name in the meantime.
+ *
+ * Insertion and removal lock only the shard owning the bucket, and fall back
+ * there whenever the lock-free walk does not find the name.
+ */
 struct StringName::Table {
 	constexpr static uint32_t TABLE_BITS = 16;
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
-	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_COUNT = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_MASK = SHARD_COUNT - 1;
+
+	// Past this many hops, the chain is likely being rewritten under us; take the lock instead.
+	constexpr static uint32_t MAX_LOCKLESS_HOPS = 32;
+
+	struct Shard {
+		BinaryMutex mutex;
+		PagedAllocator<_Data> allocator;
+
+		// Small pages, as every shard allocates at least one.
+		Shard() :
+				allocator(256) {}
+	};
+
+	static inline std::atomic<_Data *> table[TABLE_LEN];
+	static inline Shard shards[SHARD_COUNT];
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_hash) {
+		return shards[p_hash & SHARD_MASK];
+	}
 };
 
 void StringName::setup() {
 	ERR_FAIL_COND(configured);
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		Table::table[i] = nullptr;
+		Table::table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	configured = true;
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (uint32_t i = 0; i < Table::SHARD_COUNT; i++) {
+		Table::shards[i].mutex.lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
 		Vector<_Data *> data;
 		for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-			_Data *d = Table::table[i];
+			_Data *d = Table::table[i].load(std::memory_order_relaxed);
 			while (d) {
 				data.push_back(d);
-				d = d->next;
+				d = d->next.load(std::memory_order_relaxed);
 			}
 		}
 
@@ -94,8 +129,8 @@ void StringName::cleanup() {
 #endif
 	int lost_strings = 0;
 	for (uint32_t i = 0; i < Table::TABLE_LEN; i++) {
-		while (Table::table[i]) {
-			_Data *d = Table::table[i];
+		_Data *d = Table::table[i].load(std::memory_order_relaxed);
+		while (d) {
 			if (d->static_count.get() != d->refcount.get()) {
 				lost_strings++;
 
@@ -104,41 +139,124 @@ void StringName::cleanup() {
 				}
 			}
 
-			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			_Data *next = d->next.load(std::memory_order_relaxed);
+			Table::get_shard(d->hash).allocator.free(d);
+			d = next;
 		}
+		Table::table[i].store(nullptr, std::memory_order_relaxed);
 	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
 	configured = false;
+
+	for (uint32_t i = 0; i < Table::SHARD_COUNT; i++) {
+		Table::shards[i].mutex.unlock();
+	}
 }
 
 void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		Table::Shard &shard = Table::get_shard(_data->hash);
+		MutexLock lock(shard.mutex);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
 		}
+		_Data *next = _data->next.load(std::memory_order_relaxed);
 		if (_data->prev) {
-			_data->prev->next = _data->next;
+			_data->prev->next.store(next, std::memory_order_release);
 		} else {
 			const uint32_t idx = _data->hash & Table::TABLE_MASK;
-			Table::table[idx] = _data->next;
+			Table::table[idx].store(next, std::memory_order_release);
 		}
 
-		if (_data->next) {
-			_data->next->prev = _data->prev;
+		if (next) {
+			next->prev = _data->prev;
 		}
-		Table::allocator.free(_data);
+		shard.allocator.free(_data);
 	}
 
 	_data = nullptr;
 }
 
+template <typename S>
+StringName::_Data *StringName::_intern(const S &p_name, uint32_t p_hash, bool p_static) {
+	const uint32_t idx = p_hash & Table::TABLE_MASK;
+
+#ifdef DEBUG_ENABLED
+	// Reference counting for the debug ranking is not atomic, keep it under the lock.
+	if (likely(!debug_stringname))
+#endif
+	{
+		_Data *d = Table::table[idx].load(std::memory_order_acquire);
+		for (uint32_t hops = 0; d && hops < Table::MAX_LOCKLESS_HOPS; hops++) {
+			// Fails on nodes being removed, and the name check catches nodes reused
+			// for another name. Either way the node's memory stays valid to walk past.
+			if (d->hash == p_hash && d->refcount.ref()) {
+				if (likely(d->hash == p_hash && d->name == p_name)) {
+					if (p_static) {
+						d->static_count.increment();
+					}
+					return d;
+				}
+				StringName release(d);
+			}
+			d = d->next.load(std::memory_order_acquire);
+		}
+	}
+
+	Table::Shard &shard = Table::get_shard(p_hash);
+	MutexLock lock(shard.mutex);
+
+	_Data *d = Table::table[idx].load(std::memory_order_relaxed);
+	while (d) {
+		// compare hash first
+		if (d->hash == p_hash && d->name == p_name) {
+			break;
+		}
+		d = d->next.load(std::memory_order_relaxed);
+	}
+
+	if (d && d->refcount.ref()) {
+		// exists
+		if (p_static) {
+			d->static_count.increment();
+		}
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			d->debug_references++;
+		}
+#endif
+		return d;
+	}
+
+	_Data *head = Table::table[idx].load(std::memory_order_relaxed);
+	d = shard.allocator.alloc();
+	d->name = p_name;
+	d->static_count.set(p_static ? 1 : 0);
+	d->hash = p_hash;
+	d->next.store(head, std::memory_order_relaxed);
+	d->prev = nullptr;
+	// Publishes the fields above to readers that manage to take a reference.
+	d->refcount.init();
+
+#ifdef DEBUG_ENABLED
+	if (unlikely(debug_stringname)) {
+		// Keep in memory, force static.
+		d->refcount.ref();
+		d->static_count.increment();
+	}
+#endif
+	if (head) {
+		head->prev = d;
+	}
+	Table::table[idx].store(d, std::memory_order_release);
+	return d;
+}
+
 uint32_t StringName::get_empty_hash() {
 	static uint32_t empty_hash = String::hash("");
 	return empty_hash;
@@ -218,52 +336,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = _intern(p_name, String::hash(p_name), p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -275,51 +348,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = _intern(p_name, p_name.hash(), p_static);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
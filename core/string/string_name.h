@@ -58,13 +58,17 @@ class [[nodiscard]] StringName {
 
 		uint32_t hash = 0;
 		_Data *prev = nullptr;
-		_Data *next = nullptr;
+		// Atomic so existing names can be found without taking a table lock.
+		std::atomic<_Data *> next{ nullptr };
 		_Data() {}
 	};
 
 	_Data *_data = nullptr;
 
 	void unref();
+
+	template <typename S>
+	static _Data *_intern(const S &p_name, uint32_t p_hash, bool p_static);
 	friend void register_core_types();
 	friend void unregister_core_types();
 	friend class Main;
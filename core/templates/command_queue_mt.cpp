@@ -38,9 +38,42 @@
 
 #include "command_queue_mt.h"
 
+CommandQueueMT::Chunk *CommandQueueMT::_alloc_chunk() {
+	Chunk *chunk = nullptr;
+	{
+		MutexLock lock(chunk_pool_mutex);
+		if (!chunk_pool.is_empty()) {
+			chunk = chunk_pool[chunk_pool.size() - 1];
+			chunk_pool.resize(chunk_pool.size() - 1);
+		}
+	}
+	if (!chunk) {
+		return memnew(Chunk);
+	}
+	chunk->committed.store(0, std::memory_order_relaxed);
+	chunk->next.store(nullptr, std::memory_order_relaxed);
+	chunk->used = 0;
+	return chunk;
+}
+
+void CommandQueueMT::_release_chunk(Chunk *p_chunk) {
+	MutexLock lock(chunk_pool_mutex);
+	chunk_pool.push_back(p_chunk);
+}
+
 CommandQueueMT::CommandQueueMT() {
-	command_mem.reserve(DEFAULT_COMMAND_MEM_SIZE_KB * 1024);
+	write_chunk = memnew(Chunk);
+	read_chunk = write_chunk;
 }
 
 CommandQueueMT::~CommandQueueMT() {
+	Chunk *chunk = read_chunk;
+	while (chunk) {
+		Chunk *next = chunk->next.load(std::memory_order_relaxed);
+		memdelete(chunk);
+		chunk = next;
+	}
+	for (Chunk *pooled : chunk_pool) {
+		memdelete(pooled);
+	}
 }
@@ -41,6 +41,7 @@
 #include "core/object/worker_thread_pool.h"
 #include "core/os/condition_variable.h"
 #include "core/os/mutex.h"
+#include "core/os/spin_lock.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/simple_type.h"
 #include "core/templates/tuple.h"
@@ -112,103 +113,153 @@ class CommandQueueMT {
 	/***** BASE *******/
 
 	static const uint32_t DEFAULT_COMMAND_MEM_SIZE_KB = 64;
+	static const uint32_t CHUNK_SIZE = DEFAULT_COMMAND_MEM_SIZE_KB * 1024;
+
+	/// Commands are stored in a linked list of fixed-size chunks, so memory
+	/// never moves once written. The producer publishes a command by storing
+	/// the new end offset in `committed`; the consumer reads up to it without
+	/// any lock, then follows `next` once the producer has moved on.
+	struct Chunk {
+		std::atomic<uint32_t> committed{ 0 };
+		std::atomic<Chunk *> next{ nullptr };
+		uint32_t used = 0; // Only touched by producers.
+		alignas(uint64_t) uint8_t data[CHUNK_SIZE];
+	};
 
-	BinaryMutex mutex;
-	LocalVector<uint8_t> command_mem;
+	// Producer side. With a single producer thread (the common case) the spin
+	// lock is never contended, so pushing costs one atomic exchange and never
+	// waits on the consumer. It only serializes concurrent producers, keeping
+	// a single total order of commands.
+	SpinLock producer_lock;
+	Chunk *write_chunk = nullptr;
+	uint64_t sync_tail = 0;
+
+	// Consumer side. Producers never take this mutex, so commands run without
+	// blocking pushes from other threads.
+	BinaryMutex flush_mutex;
+	Chunk *read_chunk = nullptr;
+	uint32_t read_offset = 0;
+	bool flushing = false;
+
+	BinaryMutex sync_mutex;
 	ConditionVariable sync_cond_var;
-	uint32_t sync_head = 0;
-	uint32_t sync_tail = 0;
-	uint32_t sync_awaiters = 0;
-	WorkerThreadPool::TaskID pump_task_id = WorkerThreadPool::INVALID_TASK_ID;
-	uint64_t flush_read_ptr = 0;
+	uint64_t sync_head = 0;
+
+	BinaryMutex chunk_pool_mutex;
+	LocalVector<Chunk *> chunk_pool;
+
+	std::atomic<WorkerThreadPool::TaskID> pump_task_id{ WorkerThreadPool::INVALID_TASK_ID };
 	std::atomic<bool> pending{ false };
 
-	template <typename T, typename... Args>
-	_FORCE_INLINE_ void create_command(Args &&...p_args) {
-		// alloc size is size+T+safeguard
-		constexpr uint64_t alloc_size = ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
-		static_assert(alloc_size < UINT32_MAX, "Type too large to fit in the command queue.");
-
-		uint64_t size = command_mem.size();
-		command_mem.resize(size + alloc_size + sizeof(uint64_t));
-		*(uint64_t *)&command_mem[size] = alloc_size;
-		void *cmd = &command_mem[size + sizeof(uint64_t)];
-		new (cmd) T(std::forward<Args>(p_args)...);
-		pending.store(true);
+	Chunk *_alloc_chunk();
+	void _release_chunk(Chunk *p_chunk);
+
+	_FORCE_INLINE_ Chunk *_advance_write_chunk() {
+		Chunk *chunk = _alloc_chunk();
+		// Everything written to the current chunk has been committed already,
+		// so the consumer will drain it before following the link.
+		write_chunk->next.store(chunk, std::memory_order_release);
+		write_chunk = chunk;
+		return chunk;
 	}
 
 	template <typename T, bool NeedsSync, typename... Args>
 	_FORCE_INLINE_ void _push_internal(Args &&...args) {
-		MutexLock mlock(mutex);
-		create_command<T>(std::forward<Args>(args)...);
+		// Command size is header+T, rounded up to keep commands 8-byte aligned.
+		constexpr uint32_t alloc_size = sizeof(uint64_t) + ((sizeof(T) + 8U - 1U) & ~(8U - 1U));
+		static_assert(alloc_size <= CHUNK_SIZE, "Type too large to fit in the command queue.");
 
-		if (pump_task_id != WorkerThreadPool::INVALID_TASK_ID) {
-			WorkerThreadPool::get_singleton()->notify_yield_over(pump_task_id);
-		}
+		uint64_t sync_goal = 0;
 
+		producer_lock.lock();
+		Chunk *chunk = write_chunk;
+		if (unlikely(chunk->used + alloc_size > CHUNK_SIZE)) {
+			chunk = _advance_write_chunk();
+		}
+		uint8_t *ptr = &chunk->data[chunk->used];
+		*(uint64_t *)ptr = alloc_size - sizeof(uint64_t);
+		new (ptr + sizeof(uint64_t)) T(std::forward<Args>(args)...);
+		chunk->used += alloc_size;
+		chunk->committed.store(chunk->used, std::memory_order_release);
 		if constexpr (NeedsSync) {
-			sync_tail++;
-			_wait_for_sync(mlock);
+			sync_goal = ++sync_tail;
+		}
+		producer_lock.unlock();
+
+		// Only wake the pump task when the queue goes from idle to pending;
+		// a flush already scheduled will pick up anything pushed after it.
+		if (!pending.exchange(true, std::memory_order_acq_rel)) {
+			WorkerThreadPool::TaskID task_id = pump_task_id.load(std::memory_order_relaxed);
+			if (task_id != WorkerThreadPool::INVALID_TASK_ID) {
+				WorkerThreadPool::get_singleton()->notify_yield_over(task_id);
+			}
 		}
-	}
 
-	_FORCE_INLINE_ void _prevent_sync_wraparound() {
-		bool safe_to_reset = !sync_awaiters;
-		bool already_sync_to_latest = sync_head == sync_tail;
-		if (safe_to_reset && already_sync_to_latest) {
-			sync_head = 0;
-			sync_tail = 0;
+		if constexpr (NeedsSync) {
+			_wait_for_sync(sync_goal);
 		}
 	}
 
 	void _flush() {
-		if (unlikely(flush_read_ptr)) {
+		if (unlikely(flushing)) {
 			// Re-entrant call.
 			return;
 		}
 
-		MutexLock lock(mutex);
+		MutexLock lock(flush_mutex);
+		if (unlikely(flushing)) {
+			// Another thread got in while a command had the mutex unlocked.
+			return;
+		}
+		flushing = true;
+
+		// Cleared before draining, so anything pushed from now on either gets
+		// drained here or marks the queue as pending again.
+		pending.exchange(false, std::memory_order_acq_rel);
+
+		while (true) {
+			if (read_offset == read_chunk->committed.load(std::memory_order_acquire)) {
+				Chunk *next = read_chunk->next.load(std::memory_order_acquire);
+				if (!next) {
+					break;
+				}
+				if (read_offset != read_chunk->committed.load(std::memory_order_acquire)) {
+					// Last commands of this chunk landed before the link.
+					continue;
+				}
+				_release_chunk(read_chunk);
+				read_chunk = next;
+				read_offset = 0;
+				continue;
+			}
 
-		while (flush_read_ptr < command_mem.size()) {
-			uint64_t size = *(uint64_t *)&command_mem[flush_read_ptr];
-			flush_read_ptr += 8;
-			CommandBase *cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
+			uint64_t size = *(uint64_t *)&read_chunk->data[read_offset];
+			CommandBase *cmd = reinterpret_cast<CommandBase *>(&read_chunk->data[read_offset + sizeof(uint64_t)]);
 			uint32_t allowance_id = WorkerThreadPool::thread_enter_unlock_allowance_zone(lock);
 			cmd->call();
 			WorkerThreadPool::thread_exit_unlock_allowance_zone(allowance_id);
 
-			// Handle potential realloc due to the command and unlock allowance.
-			cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
-
 			if (unlikely(cmd->sync)) {
-				sync_head++;
-				lock.~MutexLock(); // Give an opportunity to awaiters right away.
+				{
+					MutexLock sync_lock(sync_mutex);
+					sync_head++;
+				}
 				sync_cond_var.notify_all();
-				new (&lock) MutexLock(mutex);
-				// Handle potential realloc happened during unlock.
-				cmd = reinterpret_cast<CommandBase *>(&command_mem[flush_read_ptr]);
 			}
 
 			cmd->~CommandBase();
 
-			flush_read_ptr += size;
+			read_offset += sizeof(uint64_t) + size;
 		}
 
-		command_mem.clear();
-		pending.store(false);
-		flush_read_ptr = 0;
-
-		_prevent_sync_wraparound();
+		flushing = false;
 	}
 
-	_FORCE_INLINE_ void _wait_for_sync(MutexLock<BinaryMutex> &p_lock) {
-		sync_awaiters++;
-		uint32_t sync_head_goal = sync_tail;
-		do {
-			sync_cond_var.wait(p_lock);
-		} while (sync_head < sync_head_goal);
-		sync_awaiters--;
-		_prevent_sync_wraparound();
+	_FORCE_INLINE_ void _wait_for_sync(uint64_t p_sync_head_goal) {
+		MutexLock lock(sync_mutex);
+		while (sync_head < p_sync_head_goal) {
+			sync_cond_var.wait(lock);
+		}
 	}
 
 	void _no_op() {}
@@ -250,14 +301,14 @@ public:
 	}
 
 	void wait_and_flush() {
-		ERR_FAIL_COND(pump_task_id == WorkerThreadPool::INVALID_TASK_ID);
-		WorkerThreadPool::get_singleton()->wait_for_task_completion(pump_task_id);
+		WorkerThreadPool::TaskID task_id = pump_task_id.load(std::memory_order_relaxed);
+		ERR_FAIL_COND(task_id == WorkerThreadPool::INVALID_TASK_ID);
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
 		_flush();
 	}
 
 	void set_pump_task_id(WorkerThreadPool::TaskID p_task_id) {
-		MutexLock lock(mutex);
-		pump_task_id = p_task_id;
+		pump_task_id.store(p_task_id, std::memory_order_relaxed);
 	}
 
 	CommandQueueMT();
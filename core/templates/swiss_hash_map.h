@@ -0,0 +1,679 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file swiss_hash_map.h
+ *
+ * Flat open-addressing hash map probed a group of control bytes at a time.
+ */
+
+#include "core/templates/hash_map.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace SwissTable {
+
+// Control bytes. Full slots store the low 7 bits of their hash, so they are never negative.
+static constexpr int8_t CTRL_EMPTY = -128; // 0b10000000
+static constexpr int8_t CTRL_DELETED = -2; // 0b11111110
+
+_FORCE_INLINE_ uint32_t count_trailing_zeros(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(p_value);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanForward(&index, (unsigned long)(p_value & 0xFFFFFFFF))) {
+		return index;
+	}
+	_BitScanForward(&index, (unsigned long)(p_value >> 32));
+	return index + 32;
+#else
+	uint32_t count = 0;
+	while (!(p_value & 1)) {
+		p_value >>= 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+_FORCE_INLINE_ uint32_t count_leading_zeros(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_clzll(p_value);
+#elif defined(_MSC_VER)
+	unsigned long index;
+	if (_BitScanReverse(&index, (unsigned long)(p_value >> 32))) {
+		return 31 - index;
+	}
+	_BitScanReverse(&index, (unsigned long)(p_value & 0xFFFFFFFF));
+	return 63 - index;
+#else
+	uint32_t count = 0;
+	while (!(p_value & (uint64_t(1) << 63))) {
+		p_value <<= 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+/// Set of matching slots in a group, one bit (SSE2) or one byte (portable) per slot.
+template <uint32_t GroupSize, uint32_t Shift>
+struct BitMask {
+	uint64_t mask = 0;
+
+	_FORCE_INLINE_ explicit operator bool() const { return mask != 0; }
+
+	/// Offset of the first matching slot in the group. The mask must not be empty.
+	_FORCE_INLINE_ uint32_t lowest() const { return count_trailing_zeros(mask) >> Shift; }
+	_FORCE_INLINE_ void clear_lowest() { mask &= mask - 1; }
+
+	_FORCE_INLINE_ uint32_t trailing_zeros() const {
+		return mask ? count_trailing_zeros(mask) >> Shift : GroupSize;
+	}
+	_FORCE_INLINE_ uint32_t leading_zeros() const {
+		constexpr uint32_t unused_bits = 64 - (GroupSize << Shift);
+		return mask ? (count_leading_zeros(mask) - unused_bits) >> Shift : GroupSize;
+	}
+
+	_FORCE_INLINE_ explicit BitMask(uint64_t p_mask) :
+			mask(p_mask) {}
+};
+
+#ifdef SWISS_TABLE_SSE2
+
+struct Group {
+	static constexpr uint32_t SIZE = 16;
+	typedef BitMask<SIZE, 0> Mask;
+
+	__m128i ctrl;
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		return Mask((uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(p_h2), ctrl)));
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		// Both special values have the sign bit set.
+		return Mask((uint16_t)_mm_movemask_epi8(ctrl));
+	}
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+};
+
+#else
+
+/// Portable fallback processing 8 control bytes at once in a 64-bit word.
+struct Group {
+	static constexpr uint32_t SIZE = 8;
+	typedef BitMask<SIZE, 3> Mask;
+
+	static constexpr uint64_t LSBS = 0x0101010101010101ULL;
+	static constexpr uint64_t MSBS = 0x8080808080808080ULL;
+
+	uint64_t ctrl;
+
+	_FORCE_INLINE_ Mask match(int8_t p_h2) const {
+		// May report a false positive next to a real match, which key comparison discards.
+		uint64_t x = ctrl ^ (LSBS * (uint8_t)p_h2);
+		return Mask((x - LSBS) & ~x & MSBS);
+	}
+	_FORCE_INLINE_ Mask match_empty() const {
+		// Only CTRL_EMPTY has the sign bit set and bit 1 clear.
+		return Mask(ctrl & ~(ctrl << 6) & MSBS);
+	}
+	_FORCE_INLINE_ Mask match_empty_or_deleted() const {
+		return Mask(ctrl & MSBS);
+	}
+
+	_FORCE_INLINE_ explicit Group(const int8_t *p_ctrl) {
+		memcpy(&ctrl, p_ctrl, sizeof(ctrl));
+#ifdef BIG_ENDIAN_ENABLED
+		ctrl = BSWAP64(ctrl);
+#endif
+	}
+};
+
+#endif // SWISS_TABLE_SSE2
+
+} // namespace SwissTable
+
+/**
+ * A flat hash map in the style of Swiss tables: keys and values live directly
+ * in the slot array, and a parallel array of one-byte control words holding 7
+ * bits of each hash lets lookups test a whole group of slots (16 with SSE2,
+ * 8 otherwise) with a few instructions before touching any key.
+ *
+ * Lookups never chase a pointer, so this is the fastest map for large, hot,
+ * read-mostly tables. In exchange:
+ *   - Iteration order is unspecified and changes on rehash. Use HashMap if you
+ *     need insertion order, or RBMap for sorted order.
+ *   - Any insertion can move every element, invalidating pointers and iterators.
+ *   - Iterating walks the whole slot array, so it is slower than AHashMap when
+ *     the map is sparse (e.g. after many erasures).
+ *
+ * Elements are relocated with memcpy on rehash, like AHashMap.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	// Must be a power of two, and at least the group size.
+	static constexpr uint32_t MIN_CAPACITY = 16;
+	static_assert(MIN_CAPACITY >= SwissTable::Group::SIZE);
+
+private:
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+	typedef SwissTable::Group Group;
+
+	/// `capacity + Group::SIZE` bytes; the tail mirrors the first group so
+	/// groups can be loaded at any slot without wrapping.
+	int8_t *ctrl = nullptr;
+	MapKeyValue *slots = nullptr;
+
+	/// Slot count, a power of two. 0 until the first insertion.
+	uint32_t capacity = 0;
+	uint32_t capacity_shift = 0;
+	uint32_t num_elements = 0;
+	/// Empty slots that can still be filled before the table must grow. Deleted slots don't count.
+	uint32_t growth_left = 0;
+	/// Capacity allocated on first insertion.
+	uint32_t initial_capacity = MIN_CAPACITY;
+
+	static _FORCE_INLINE_ uint32_t _max_elements(uint32_t p_capacity) {
+		return p_capacity - p_capacity / 8; // 87.5% max load.
+	}
+
+	static uint32_t _capacity_for(uint32_t p_elements) {
+		uint32_t new_capacity = MIN_CAPACITY;
+		while (_max_elements(new_capacity) < p_elements) {
+			new_capacity <<= 1;
+		}
+		return new_capacity;
+	}
+
+	static _FORCE_INLINE_ int8_t _h2(uint32_t p_hash) {
+		return (int8_t)(p_hash & 0x7F);
+	}
+
+	/// Probe start. Fibonacci hashing spreads weak hashes over the high bits,
+	/// which stay independent from the low bits used for the control byte.
+	_FORCE_INLINE_ uint32_t _h1(uint32_t p_hash) const {
+		return (p_hash * 0x9E3779B1u) >> capacity_shift;
+	}
+
+	_FORCE_INLINE_ void _set_ctrl(uint32_t p_slot, int8_t p_value) {
+		ctrl[p_slot] = p_value;
+		if (p_slot < Group::SIZE) {
+			ctrl[capacity + p_slot] = p_value;
+		}
+	}
+
+	bool _lookup_slot(const TKey &p_key, uint32_t p_hash, uint32_t &r_slot) const {
+		if (unlikely(num_elements == 0)) {
+			return false;
+		}
+
+		const uint32_t mask = capacity - 1;
+		const int8_t h2 = _h2(p_hash);
+		uint32_t pos = _h1(p_hash);
+		uint32_t step = 0;
+		while (true) {
+			Group group(ctrl + pos);
+			for (Group::Mask match = group.match(h2); match; match.clear_lowest()) {
+				uint32_t slot = (pos + match.lowest()) & mask;
+				if (Comparator::compare(slots[slot].key, p_key)) {
+					r_slot = slot;
+					return true;
+				}
+			}
+			if (group.match_empty()) {
+				return false;
+			}
+			// Triangular probing visits every group when the capacity is a power of two.
+			step += Group::SIZE;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	uint32_t _find_insert_slot(uint32_t p_hash) const {
+		const uint32_t mask = capacity - 1;
+		uint32_t pos = _h1(p_hash);
+		uint32_t step = 0;
+		while (true) {
+			Group::Mask free = Group(ctrl + pos).match_empty_or_deleted();
+			if (free) {
+				return (pos + free.lowest()) & mask;
+			}
+			step += Group::SIZE;
+			pos = (pos + step) & mask;
+		}
+	}
+
+	void _allocate(uint32_t p_capacity) {
+		capacity = p_capacity;
+		capacity_shift = 32 - get_shift_from_power_of_2(capacity);
+		ctrl = reinterpret_cast<int8_t *>(Memory::alloc_static(capacity + Group::SIZE));
+		memset(ctrl, (uint8_t)SwissTable::CTRL_EMPTY, capacity + Group::SIZE);
+		slots = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * capacity));
+		growth_left = _max_elements(capacity);
+	}
+
+	/// Rebuilds the table at the given capacity. Also used at the same capacity to drop tombstones.
+	void _resize_and_rehash(uint32_t p_new_capacity) {
+		int8_t *old_ctrl = ctrl;
+		MapKeyValue *old_slots = slots;
+		uint32_t old_capacity = capacity;
+
+		_allocate(p_new_capacity);
+
+		for (uint32_t i = 0; i < old_capacity; i++) {
+			if (old_ctrl[i] < 0) {
+				continue;
+			}
+			uint32_t hash = Hasher::hash(old_slots[i].key);
+			uint32_t slot = _find_insert_slot(hash);
+			_set_ctrl(slot, _h2(hash));
+			memcpy((void *)&slots[slot], (const void *)&old_slots[i], sizeof(MapKeyValue));
+		}
+		growth_left -= num_elements;
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_slots);
+	}
+
+	uint32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(ctrl == nullptr)) {
+			_allocate(initial_capacity);
+		}
+
+		uint32_t slot = _find_insert_slot(p_hash);
+		if (unlikely(growth_left == 0 && ctrl[slot] == SwissTable::CTRL_EMPTY)) {
+			// Out of empty slots. When tombstones take the room, rehash in place; only grow once the live
+			// elements alone are past 25/32 of the capacity, which leaves rehashing in place enough headroom.
+			uint32_t new_capacity = uint64_t(num_elements) * 32 <= uint64_t(capacity) * 25 ? capacity : capacity * 2;
+			_resize_and_rehash(new_capacity);
+			slot = _find_insert_slot(p_hash);
+		}
+
+		if (ctrl[slot] == SwissTable::CTRL_EMPTY) {
+			growth_left--;
+		}
+		_set_ctrl(slot, _h2(p_hash));
+		memnew_placement(&slots[slot], MapKeyValue(p_key, p_value));
+		num_elements++;
+		return slot;
+	}
+
+	void _erase_slot(uint32_t p_slot) {
+		slots[p_slot].key.~TKey();
+		slots[p_slot].value.~TValue();
+		num_elements--;
+
+		// If no group containing this slot was ever full, no probe sequence can
+		// have passed through it, so it can go straight back to empty.
+		const uint32_t before = (p_slot - Group::SIZE) & (capacity - 1);
+		Group::Mask empty_before = Group(ctrl + before).match_empty();
+		Group::Mask empty_after = Group(ctrl + p_slot).match_empty();
+		bool was_never_full = empty_before && empty_after &&
+				empty_after.trailing_zeros() + empty_before.leading_zeros() < Group::SIZE;
+
+		if (was_never_full) {
+			_set_ctrl(p_slot, SwissTable::CTRL_EMPTY);
+			growth_left++;
+		} else {
+			_set_ctrl(p_slot, SwissTable::CTRL_DELETED);
+		}
+	}
+
+	void _destroy_elements() {
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < capacity; i++) {
+				if (ctrl[i] >= 0) {
+					slots[i].key.~TKey();
+					slots[i].value.~TValue();
+				}
+			}
+		}
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		initial_capacity = p_other.initial_capacity;
+		if (p_other.num_elements == 0) {
+			return;
+		}
+
+		_allocate(p_other.capacity);
+		memcpy(ctrl, p_other.ctrl, capacity + Group::SIZE);
+		num_elements = p_other.num_elements;
+		growth_left = p_other.growth_left;
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			memcpy((void *)slots, (const void *)p_other.slots, sizeof(MapKeyValue) * capacity);
+		} else {
+			for (uint32_t i = 0; i < capacity; i++) {
+				if (ctrl[i] >= 0) {
+					memnew_placement(&slots[i], MapKeyValue(p_other.slots[i]));
+				}
+			}
+		}
+	}
+
+	_FORCE_INLINE_ uint32_t _first_full_slot() const {
+		uint32_t i = 0;
+		while (i < capacity && ctrl[i] < 0) {
+			i++;
+		}
+		return i;
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return capacity; }
+	_FORCE_INLINE_ uint32_t size() const { return num_elements; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return num_elements == 0;
+	}
+
+	void clear() {
+		if (ctrl == nullptr || num_elements == 0) {
+			return;
+		}
+
+		_destroy_elements();
+		memset(ctrl, (uint8_t)SwissTable::CTRL_EMPTY, capacity + Group::SIZE);
+		num_elements = 0;
+		growth_left = _max_elements(capacity);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, Hasher::hash(p_key), slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return slots[slot].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, Hasher::hash(p_key), slot);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return slots[slot].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return &slots[slot].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return &slots[slot].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t slot = 0;
+		return _lookup_slot(p_key, Hasher::hash(p_key), slot);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return false;
+		}
+		_erase_slot(slot);
+		return true;
+	}
+
+	/// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	void reserve(uint32_t p_new_size) {
+		uint32_t new_capacity = _capacity_for(p_new_size);
+		if (ctrl == nullptr) {
+			initial_capacity = MAX(initial_capacity, new_capacity);
+			return; // Unallocated yet.
+		}
+		if (new_capacity <= capacity) {
+			if (p_new_size < size()) {
+				WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+		_resize_and_rehash(new_capacity);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return map->slots[index];
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return &map->slots[index];
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			do {
+				index++;
+			} while (index < map->capacity && map->ctrl[index] < 0);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && index < map->capacity;
+		}
+
+		_FORCE_INLINE_ ConstIterator(const SwissHashMap *p_map, uint32_t p_index) :
+				map(p_map), index(p_index) {}
+		_FORCE_INLINE_ ConstIterator() {}
+
+	private:
+		const SwissHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return map->slots[index];
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return &map->slots[index];
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			do {
+				index++;
+			} while (index < map->capacity && map->ctrl[index] < 0);
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return index == b.index; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return index != b.index; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return map != nullptr && index < map->capacity;
+		}
+
+		_FORCE_INLINE_ Iterator(SwissHashMap *p_map, uint32_t p_index) :
+				map(p_map), index(p_index) {}
+		_FORCE_INLINE_ Iterator() {}
+
+		operator ConstIterator() const {
+			return ConstIterator(map, index);
+		}
+
+	private:
+		SwissHashMap *map = nullptr;
+		uint32_t index = 0;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(this, _first_full_slot());
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(this, capacity);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return end();
+		}
+		return Iterator(this, slot);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(this, _first_full_slot());
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(this, capacity);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t slot = 0;
+		if (!_lookup_slot(p_key, Hasher::hash(p_key), slot)) {
+			return end();
+		}
+		return ConstIterator(this, slot);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t slot = 0;
+		bool exists = _lookup_slot(p_key, Hasher::hash(p_key), slot);
+		CRASH_COND(!exists);
+		return slots[slot].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t slot = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		if (!_lookup_slot(p_key, hash, slot)) {
+			slot = _insert_element(p_key, TValue(), hash);
+		}
+		return slots[slot].value;
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t slot = 0;
+		uint32_t hash = Hasher::hash(p_key);
+		if (!_lookup_slot(p_key, hash, slot)) {
+			slot = _insert_element(p_key, p_value, hash);
+		} else {
+			slots[slot].value = p_value;
+		}
+		return Iterator(this, slot);
+	}
+
+	/// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t slot = _insert_element(p_key, p_value, Hasher::hash(p_key));
+		return Iterator(this, slot);
+	}
+
+	/* Constructors */
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_size) {
+		initial_capacity = _capacity_for(p_initial_size);
+	}
+	SwissHashMap() {}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (ctrl != nullptr) {
+			_destroy_elements();
+			Memory::free_static(ctrl);
+			Memory::free_static(slots);
+			ctrl = nullptr;
+			slots = nullptr;
+		}
+		capacity = 0;
+		capacity_shift = 0;
+		num_elements = 0;
+		growth_left = 0;
+		initial_capacity = MIN_CAPACITY;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
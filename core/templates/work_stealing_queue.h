@@ -0,0 +1,136 @@
+/**************************************************************************/
+/*  work_stealing_queue.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file work_stealing_queue.h
+ *
+ * @brief Bounded Chase-Lev work-stealing deque.
+ * - A single owner thread pushes and pops at the bottom (LIFO), without locking.
+ * - Any number of thief threads steal from the top (FIFO), without locking.
+ * - The capacity is fixed, so the buffer never has to be reclaimed while a thief may be
+ *   reading it. The owner is expected to fall back to some other queue when it is full.
+ *
+ * Memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (Lê, Pop, Cohen, Zappa Nardelli, 2013).
+ */
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+template <typename T, uint32_t CAPACITY = 256>
+class WorkStealingQueue {
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity must be a power of two.");
+	static constexpr int64_t MASK = CAPACITY - 1;
+
+	// Owner and thieves write different ends, so keep them on different cache lines.
+	// Padding is used instead of alignas() because instances may live in containers
+	// that don't honor extended alignment.
+	std::atomic<int64_t> top = { 0 };
+	uint8_t _pad_top[64 - sizeof(std::atomic<int64_t>)] = {};
+	std::atomic<int64_t> bottom = { 0 };
+	uint8_t _pad_bottom[64 - sizeof(std::atomic<int64_t>)] = {};
+	std::atomic<T *> buffer[CAPACITY] = {};
+
+public:
+	enum StealResult {
+		STEAL_OK,
+		STEAL_EMPTY,
+		STEAL_CONTENDED, ///< Lost a race against another thief or the owner; the queue may still hold items.
+	};
+
+	/// Owner only. Returns false if the queue is full.
+	bool push(T *p_item) {
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		if (unlikely(b - t >= (int64_t)CAPACITY)) {
+			return false;
+		}
+		buffer[b & MASK].store(p_item, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		bottom.store(b + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	/// Owner only. Returns the most recently pushed item, or nullptr if the queue is empty.
+	T *pop() {
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b) {
+			// Empty.
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return nullptr;
+		}
+
+		T *item = buffer[b & MASK].load(std::memory_order_relaxed);
+		if (t == b) {
+			// Last item; race against thieves for it.
+			if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+				item = nullptr;
+			}
+			bottom.store(b + 1, std::memory_order_relaxed);
+		}
+		return item;
+	}
+
+	/// Any thread. Takes the oldest item.
+	StealResult steal(T *&r_item) {
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+
+		if (t >= b) {
+			return STEAL_EMPTY;
+		}
+
+		T *item = buffer[t & MASK].load(std::memory_order_relaxed);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+			return STEAL_CONTENDED;
+		}
+		r_item = item;
+		return STEAL_OK;
+	}
+
+	/// Any thread. Only a hint unless called by the owner or while pushes are otherwise excluded.
+	_FORCE_INLINE_ bool is_empty() const {
+		int64_t b = bottom.load(std::memory_order_acquire);
+		int64_t t = top.load(std::memory_order_acquire);
+		return t >= b;
+	}
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return CAPACITY; }
+};
@@ -606,6 +606,7 @@ Array Array::filter(const Callable &p_callable) const {
 	new_arr._p->typed = _p->typed;
 	int accepted_count = 0;
 
+	const RepeatedCallable callable(p_callable, 1);
 	const Variant *argptrs[1];
 	Variant *write = new_arr._p->array.ptrw();
 	for (int i = 0; i < size(); i++) {
@@ -613,7 +614,7 @@ Array Array::filter(const Callable &p_callable) const {
 
 		Variant result;
 		Callable::CallError ce;
-		p_callable.callp(argptrs, 1, result, ce);
+		callable.callp(argptrs, result, ce);
 		if (ce.error != Callable::CallError::CALL_OK) {
 			ERR_FAIL_V_MSG(Array(), vformat("Error calling method from 'filter': %s.", Variant::get_callable_error_text(p_callable, argptrs, 1, ce)));
 		}
@@ -633,13 +634,14 @@ Array Array::map(const Callable &p_callable) const {
 	Array new_arr;
 	new_arr.resize(size());
 
+	const RepeatedCallable callable(p_callable, 1);
 	const Variant *argptrs[1];
 	Variant *write = new_arr._p->array.ptrw();
 	for (int i = 0; i < size(); i++) {
 		argptrs[0] = &get(i);
 
 		Callable::CallError ce;
-		p_callable.callp(argptrs, 1, write[i], ce);
+		callable.callp(argptrs, write[i], ce);
 		if (ce.error != Callable::CallError::CALL_OK) {
 			ERR_FAIL_V_MSG(Array(), vformat("Error calling method from 'map': %s.", Variant::get_callable_error_text(p_callable, argptrs, 1, ce)));
 		}
@@ -656,6 +658,7 @@ Variant Array::reduce(const Callable &p_callable, const Variant &p_accum) const
 		start = 1;
 	}
 
+	const RepeatedCallable callable(p_callable, 2);
 	const Variant *argptrs[2];
 	for (int i = start; i < size(); i++) {
 		argptrs[0] = &ret;
@@ -663,7 +666,7 @@ Variant Array::reduce(const Callable &p_callable, const Variant &p_accum) const
 
 		Variant result;
 		Callable::CallError ce;
-		p_callable.callp(argptrs, 2, result, ce);
+		callable.callp(argptrs, result, ce);
 		if (ce.error != Callable::CallError::CALL_OK) {
 			ERR_FAIL_V_MSG(Variant(), vformat("Error calling method from 'reduce': %s.", Variant::get_callable_error_text(p_callable, argptrs, 2, ce)));
 		}
@@ -674,13 +677,14 @@ Variant Array::reduce(const Callable &p_callable, const Variant &p_accum) const
 }
 
 bool Array::any(const Callable &p_callable) const {
+	const RepeatedCallable callable(p_callable, 1);
 	const Variant *argptrs[1];
 	for (int i = 0; i < size(); i++) {
 		argptrs[0] = &get(i);
 
 		Variant result;
 		Callable::CallError ce;
-		p_callable.callp(argptrs, 1, result, ce);
+		callable.callp(argptrs, result, ce);
 		if (ce.error != Callable::CallError::CALL_OK) {
 			ERR_FAIL_V_MSG(false, vformat("Error calling method from 'any': %s.", Variant::get_callable_error_text(p_callable, argptrs, 1, ce)));
 		}
@@ -696,13 +700,14 @@ bool Array::any(const Callable &p_callable) const {
 }
 
 bool Array::all(const Callable &p_callable) const {
+	const RepeatedCallable callable(p_callable, 1);
 	const Variant *argptrs[1];
 	for (int i = 0; i < size(); i++) {
 		argptrs[0] = &get(i);
 
 		Variant result;
 		Callable::CallError ce;
-		p_callable.callp(argptrs, 1, result, ce);
+		callable.callp(argptrs, result, ce);
 		if (ce.error != Callable::CallError::CALL_OK) {
 			ERR_FAIL_V_MSG(false, vformat("Error calling method from 'all': %s.", Variant::get_callable_error_text(p_callable, argptrs, 1, ce)));
 		}
@@ -736,7 +741,8 @@ void Array::sort() {
 
 void Array::sort_custom(const Callable &p_callable) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
-	_p->array.sort_custom<CallableComparator, true>(p_callable);
+	const RepeatedCallable callable(p_callable, 2);
+	_p->array.sort_custom<CallableComparator, true>(p_callable, callable);
 }
 
 void Array::shuffle() {
@@ -762,7 +768,8 @@ int Array::bsearch_custom(const Variant &p_value, const Callable &p_callable, bo
 	Variant value = p_value;
 	ERR_FAIL_COND_V(!_p->typed.validate(value, "custom binary search"), -1);
 
-	return _p->array.bsearch_custom<CallableComparator>(value, p_before, p_callable);
+	const RepeatedCallable callable(p_callable, 2);
+	return _p->array.bsearch_custom<CallableComparator>(value, p_before, p_callable, callable);
 }
 
 void Array::reverse() {
@@ -490,6 +490,10 @@ int CallableCustom::get_unbound_arguments_count() const {
 	return 0;
 }
 
+CallableCustom::RepeatedCall *CallableCustom::create_repeated_call(int p_argcount) const {
+	return nullptr;
+}
+
 CallableCustom::CallableCustom() {
 	ref_count.init();
 }
@@ -606,8 +610,21 @@ bool CallableComparator::operator()(const Variant &p_l, const Variant &p_r) cons
 	const Variant *args[2] = { &p_l, &p_r };
 	Callable::CallError err;
 	Variant res;
-	func.callp(args, 2, res, err);
+	callable.callp(args, res, err);
 	ERR_FAIL_COND_V_MSG(err.error != Callable::CallError::CALL_OK, false,
 			"Error calling compare method: " + Variant::get_callable_error_text(func, args, 2, err));
 	return res;
 }
+
+RepeatedCallable::RepeatedCallable(const Callable &p_callable, int p_argcount) :
+		callable(p_callable), argcount(p_argcount) {
+	if (p_callable.is_custom() && p_callable.is_valid()) {
+		prepared = p_callable.get_custom()->create_repeated_call(p_argcount);
+	}
+}
+
+RepeatedCallable::~RepeatedCallable() {
+	if (prepared) {
+		memdelete(prepared);
+	}
+}
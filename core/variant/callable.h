@@ -154,6 +154,15 @@ public:
 	typedef bool (*CompareEqualFunc)(const CallableCustom *p_a, const CallableCustom *p_b);
 	typedef bool (*CompareLessFunc)(const CallableCustom *p_a, const CallableCustom *p_b);
 
+	/// Work done once to call the same custom callable many times in a row, see RepeatedCallable.
+	class RepeatedCall {
+	public:
+		/// Like CallableCustom::call(), with the argument count given to create_repeated_call().
+		/// Validity is not checked before each call, implementations must handle it themselves.
+		virtual void call(const Variant **p_arguments, Variant &r_return_value, Callable::CallError &r_call_error) = 0;
+		virtual ~RepeatedCall() {}
+	};
+
 	//for every type that inherits, these must always be the same for this type
 	virtual uint32_t hash() const = 0;
 	virtual String get_as_text() const = 0;
@@ -169,6 +178,11 @@ public:
 	virtual int get_bound_arguments_count() const;
 	virtual void get_bound_arguments(Vector<Variant> &r_arguments) const;
 	virtual int get_unbound_arguments_count() const;
+	/// Returns a prepared call for `p_argcount` arguments, or `nullptr` to use call() every time.
+	virtual RepeatedCall *create_repeated_call(int p_argcount) const;
+
+	/// Number of `Callable`s currently wrapping this object.
+	_FORCE_INLINE_ uint32_t get_reference_count() const { return ref_count.get(); }
 
 	CallableCustom();
 	virtual ~CallableCustom() {}
@@ -213,8 +227,30 @@ public:
 template <>
 struct is_zero_constructible<Signal> : std::true_type {};
 
+/// Calls the same callable many times with the same argument count, e.g. once per element from `Array::map()`.
+/// Custom callables can do the work that doesn't depend on the arguments only once, see CallableCustom::create_repeated_call().
+class RepeatedCallable {
+	const Callable &callable;
+	int argcount = 0;
+	CallableCustom::RepeatedCall *prepared = nullptr;
+
+public:
+	_FORCE_INLINE_ void callp(const Variant **p_arguments, Variant &r_return_value, Callable::CallError &r_call_error) const {
+		if (prepared) {
+			prepared->call(p_arguments, r_return_value, r_call_error);
+		} else {
+			callable.callp(p_arguments, argcount, r_return_value, r_call_error);
+		}
+	}
+
+	RepeatedCallable(const RepeatedCallable &) = delete;
+	RepeatedCallable(const Callable &p_callable, int p_argcount);
+	~RepeatedCallable();
+};
+
 struct CallableComparator {
 	const Callable &func;
+	const RepeatedCallable &callable; ///< Prepared from func with two arguments.
 
 	bool operator()(const Variant &p_l, const Variant &p_r) const;
 };
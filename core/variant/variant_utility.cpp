@@ -1131,44 +1131,23 @@ Variant VariantUtilityFunctions::str_to_var_with_objects(const String &p_var) {
 	return ret;
 }
 
-PackedByteArray VariantUtilityFunctions::var_to_bytes(const Variant &p_var) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, false);
+// Encoded in a LocalVector, which grows cheaper than a Vector, then copied once at its final size.
+static PackedByteArray _var_to_bytes(const Variant &p_var, bool p_full_objects) {
+	LocalVector<uint8_t> buffer;
+	Error err = encode_variant_append(p_var, buffer, p_full_objects);
 	if (err != OK) {
 		return PackedByteArray();
 	}
 
-	PackedByteArray barr;
-	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, false);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
+	return buffer;
+}
 
-	return barr;
+PackedByteArray VariantUtilityFunctions::var_to_bytes(const Variant &p_var) {
+	return _var_to_bytes(p_var, false);
 }
 
 PackedByteArray VariantUtilityFunctions::var_to_bytes_with_objects(const Variant &p_var) {
-	int len;
-	Error err = encode_variant(p_var, nullptr, len, true);
-	if (err != OK) {
-		return PackedByteArray();
-	}
-
-	PackedByteArray barr;
-	barr.resize(len);
-	{
-		uint8_t *w = barr.ptrw();
-		err = encode_variant(p_var, w, len, true);
-		if (err != OK) {
-			return PackedByteArray();
-		}
-	}
-
-	return barr;
+	return _var_to_bytes(p_var, true);
 }
 
 Variant VariantUtilityFunctions::bytes_to_var(const PackedByteArray &p_arr) {
@@ -0,0 +1,92 @@
+/**************************************************************************/
+/*  drivers/unix/file_access_unix_mmap.h                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file file_access_unix_mmap.h
+ *
+ * Read-only file access backed by a memory mapping of the whole file.
+ */
+
+#include "drivers/unix/file_access_unix.h"
+
+#if defined(UNIX_ENABLED)
+
+/// Maps a file read-only instead of reading it through stdio, so the data is
+/// read straight from the page cache and `get_buffer_view()` can hand out
+/// pointers into it. Writing is not supported. Truncating the file while it
+/// is mapped makes accesses past the new end fault, so only map files that
+/// are not modified while open, such as PCKs.
+class FileAccessUnixMmap : public FileAccessUnix {
+	GDSOFTCLASS(FileAccessUnixMmap, FileAccessUnix);
+	const uint8_t *data = nullptr; ///< `nullptr` for empty files.
+	uint64_t length = 0;
+	mutable uint64_t pos = 0;
+	mutable bool eof = false;
+	bool opened = false;
+	String path;
+	String path_src;
+
+	void _close();
+
+public:
+	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file, only `READ` is supported
+	virtual bool is_open() const override; ///< @return `true` when file is open
+
+	virtual String get_path() const override; ///< @return The path for the current open file
+	virtual String get_path_absolute() const override; ///< @return The absolute path for the current open file
+
+	virtual void seek(uint64_t p_position) override; ///< seek to a given position
+	virtual void seek_end(int64_t p_position = 0) override; ///< seek from the end of file
+	virtual uint64_t get_position() const override; ///< get position in the file
+	virtual uint64_t get_length() const override; ///< get size of the file
+
+	virtual bool eof_reached() const override; ///< reading passed EOF
+
+	virtual uint8_t get_8() const override;
+	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_buffer_view(uint64_t p_position, uint64_t p_length) const override;
+
+	virtual Error get_error() const override; ///< get last error
+
+	virtual Error resize(int64_t p_length) override { return ERR_UNAVAILABLE; }
+	virtual void flush() override {}
+	virtual bool store_buffer(const uint8_t *p_src, uint64_t p_length) override;
+
+	virtual void close() override;
+
+	FileAccessUnixMmap() {}
+	virtual ~FileAccessUnixMmap();
+};
+
+#endif // UNIX_ENABLED
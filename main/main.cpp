@@ -147,6 +147,7 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#include "modules/gdscript/gdscript_sampling_profiler.h"
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -286,6 +287,7 @@ static int fixed_fps = -1;
 static MovieWriter *movie_writer = nullptr;
 static bool disable_vsync = false;
 static bool print_fps = false;
+static bool print_memory_tags = false;
 #ifdef TOOLS_ENABLED
 static bool editor_pseudolocalization = false;
 static bool dump_gdextension_interface = false;
@@ -295,6 +297,10 @@ static bool validate_extension_api = false;
 static String validate_extension_api_file;
 #endif
 bool profile_gpu = false;
+#ifdef MODULE_GDSCRIPT_ENABLED
+static String gdscript_sample_profile_path;
+static int gdscript_sample_interval = 1000;
+#endif // MODULE_GDSCRIPT_ENABLED
 
 #ifdef MODULE_MCP_ENABLED
 static bool mcp_server_enabled = false;
@@ -633,6 +639,10 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--ignore-error-breaks", "If debugger is connected, prevents sending error breakpoints.\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
+#ifdef MODULE_GDSCRIPT_ENABLED
+	print_help_option("--gdscript-sample-profile <file>", "Sample the GDScript call stacks and save them to <file> on exit, as a Chrome trace if it ends in \".json\", as collapsed stacks (for flame graphs) otherwise.\n");
+	print_help_option("--gdscript-sample-interval <usec>", "Time between two GDScript samples, in microseconds (used with --gdscript-sample-profile, defaults to 1000).\n");
+#endif // MODULE_GDSCRIPT_ENABLED
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
 	print_help_option("--gpu-abort", "Abort on graphics API usage errors (usually validation layer errors). May help see the problem if your system freezes.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
@@ -662,6 +672,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--fixed-fps <fps>", "Force a fixed number of frames per second. This setting disables real-time synchronization.\n");
 	print_help_option("--delta-smoothing <enable>", "Enable or disable frame delta smoothing [\"enable\", \"disable\"].\n");
 	print_help_option("--print-fps", "Print the frames per second to the stdout.\n");
+	print_help_option("--print-memory-tags", "Print the memory usage of each engine subsystem to the stdout on exit.\n");
 #ifdef TOOLS_ENABLED
 	print_help_option("--editor-pseudolocalization", "Enable pseudolocalization for the editor and the project manager.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif
@@ -1811,12 +1822,36 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 			disable_vsync = true;
 		} else if (arg == "--print-fps") {
 			print_fps = true;
+		} else if (arg == "--print-memory-tags") {
+			print_memory_tags = true;
 #ifdef TOOLS_ENABLED
 		} else if (arg == "--editor-pseudolocalization") {
 			editor_pseudolocalization = true;
 #endif // TOOLS_ENABLED
 		} else if (arg == "--gpu-profile") {
 			profile_gpu = true;
+#ifdef MODULE_GDSCRIPT_ENABLED
+		} else if (arg == "--gdscript-sample-profile") {
+			if (N) {
+				gdscript_sample_profile_path = N->get();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --gdscript-sample-profile <file>.\n");
+				goto error;
+			}
+		} else if (arg == "--gdscript-sample-interval") {
+			if (N) {
+				gdscript_sample_interval = N->get().to_int();
+				if (gdscript_sample_interval <= 0) {
+					OS::get_singleton()->print("<usec> argument for --gdscript-sample-interval <usec> must be greater than 0.\n");
+					goto error;
+				}
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <usec> argument for --gdscript-sample-interval <usec>.\n");
+				goto error;
+			}
+#endif // MODULE_GDSCRIPT_ENABLED
 		} else if (arg == "--disable-crash-handler") {
 			OS::get_singleton()->disable_crash_handler();
 		} else if (arg == "--skip-breakpoints") {
@@ -1911,6 +1946,13 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 		I = N;
 	}
 
+#ifdef MODULE_GDSCRIPT_ENABLED
+	if (!gdscript_sample_profile_path.is_empty()) {
+		// Started along with the GDScript language, when modules get registered.
+		GDScriptSamplingProfiler::request(gdscript_sample_profile_path, gdscript_sample_interval);
+	}
+#endif // MODULE_GDSCRIPT_ENABLED
+
 #ifdef TOOLS_ENABLED
 	if (editor && project_manager) {
 		OS::get_singleton()->print(
@@ -5094,6 +5136,18 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+	if (print_memory_tags) {
+		if (Memory::are_tags_enabled()) {
+			print_line(vformat("%-12s %14s %14s %12s %14s", "Tag", "Live bytes", "Peak bytes", "Live allocs", "Total allocs"));
+			for (int i = 0; i < Memory::TAG_MAX; i++) {
+				Memory::TagStats stats = Memory::get_tag_stats((Memory::Tag)i);
+				print_line(vformat("%-12s %14d %14d %12d %14d", Memory::get_tag_name((Memory::Tag)i), stats.live_bytes, stats.peak_bytes, stats.live_allocations, stats.total_allocations));
+			}
+		} else {
+			print_line("Memory tags are disabled in this build, build with memory_tags=yes to enable them.");
+		}
+	}
+
 #ifdef DEBUG_ENABLED
 	if (input) {
 		input->flush_frame_parsed_events();
@@ -149,6 +149,10 @@ int Performance::_get_node_count() const {
 	return sml->get_node_count();
 }
 
+uint64_t Performance::_get_memory_tag_usage(int p_tag) const {
+	return Memory::get_tag_stats((Memory::Tag)p_tag).live_bytes;
+}
+
 String Performance::get_monitor_name(Monitor p_monitor) const {
 	ERR_FAIL_INDEX_V(p_monitor, MONITOR_MAX, String());
 	static const char *names[MONITOR_MAX] = {
@@ -579,6 +583,13 @@ Performance::Performance() {
 	_navigation_process_time = 0;
 	_monitor_modification_time = 0;
 	singleton = this;
+
+	if (Memory::are_tags_enabled()) {
+		// Exposed as custom monitors, so they show up in the debugger without a fixed set of built-in monitors.
+		for (int i = 0; i < Memory::TAG_MAX; i++) {
+			add_custom_monitor(StringName(vformat("memory_tags/%s", Memory::get_tag_name((Memory::Tag)i))), callable_mp(this, &Performance::_get_memory_tag_usage), varray(i));
+		}
+	}
 }
 
 Performance::MonitorCall::MonitorCall(Callable p_callable, Vector<Variant> p_arguments) {
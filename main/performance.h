@@ -54,6 +54,7 @@ class Performance : public Object {
 	static void _bind_methods();
 
 	int _get_node_count() const;
+	uint64_t _get_memory_tag_usage(int p_tag) const;
 
 	double _process_time;
 	double _physics_process_time;
@@ -39,10 +39,13 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
+#include "gdscript_jit.h"
 #include "gdscript_parser.h"
 #include "gdscript_rpc_callable.h"
+#include "gdscript_sampling_profiler.h"
 #include "gdscript_tokenizer_buffer.h"
 #include "gdscript_warning.h"
 
@@ -751,6 +754,8 @@ void GDScript::_restore_old_static_data() {
 #endif
 
 Error GDScript::reload(bool p_keep_state) {
+	MEMORY_TAG_SCOPE(TAG_SCRIPTS);
+
 	if (reloading) {
 		return OK;
 	}
@@ -863,6 +868,7 @@ Error GDScript::reload(bool p_keep_state) {
 
 	GDScriptCompiler compiler;
 	err = compiler.compile(&parser, this, p_keep_state);
+	GDScriptInlineCache::invalidate_all();
 
 	if (err) {
 		/// @todo Provide the script function as the first argument.
@@ -879,6 +885,10 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	if (GDScriptBytecodeCache::is_enabled()) {
+		GDScriptBytecodeCache::save(this, &parser);
+	}
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1547,12 +1557,51 @@ void GDScript::_recurse_replace_function_ptrs(const HashMap<GDScriptFunction *,
 	}
 }
 
+void GDScript::_take_reusable_callables(GDScriptFunction *p_func, LocalVector<Callable> &r_callables) {
+	if (p_func == nullptr) {
+		return;
+	}
+	p_func->reusable_callable_lock.lock();
+	if (p_func->reusable_callable.is_valid()) {
+		r_callables.push_back(p_func->reusable_callable);
+		p_func->reusable_callable = Callable();
+	}
+	p_func->reusable_callable_lock.unlock();
+
+	for (GDScriptFunction *lambda : p_func->lambdas) {
+		_take_reusable_callables(lambda, r_callables);
+	}
+}
+
+void GDScript::_take_reusable_callables(LocalVector<Callable> &r_callables) {
+	for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+		_take_reusable_callables(E.value, r_callables);
+	}
+	_take_reusable_callables(implicit_initializer, r_callables);
+	_take_reusable_callables(implicit_ready, r_callables);
+	_take_reusable_callables(static_initializer, r_callables);
+
+	for (const KeyValue<StringName, Ref<GDScript>> &E : subclasses) {
+		E.value->_take_reusable_callables(r_callables);
+	}
+}
+
+void GDScript::release_reusable_callables() {
+	// Released once the walk is done, they may hold the last references to the script.
+	LocalVector<Callable> callables;
+	_take_reusable_callables(callables);
+}
+
 void GDScript::clear(ClearData *p_clear_data) {
 	if (clearing) {
 		return;
 	}
 	clearing = true;
 
+	// Declared first so it is released last, once nothing else touches the script.
+	LocalVector<Callable> reusable_callables;
+	_take_reusable_callables(reusable_callables);
+
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
 	bool is_root = false;
@@ -1665,6 +1714,9 @@ GDScript::~GDScript() {
 	}
 	destructing = true;
 
+	// Inline caches are keyed by script pointers, which may get reused.
+	GDScriptInlineCache::invalidate_all();
+
 	if (is_print_verbose_enabled()) {
 		MutexLock lock(func_ptrs_to_update_mutex);
 		if (!func_ptrs_to_update.is_empty()) {
@@ -2150,6 +2202,7 @@ const Variant GDScriptInstance::get_rpc_config() const {
 
 void GDScriptInstance::reload_members() {
 #ifdef DEBUG_ENABLED
+	GDScriptInlineCache::invalidate_all();
 
 	Vector<Variant> new_members;
 	new_members.resize(script->member_indices.size());
@@ -2301,6 +2354,19 @@ void GDScriptLanguage::init() {
 	}
 #endif
 
+	if (GLOBAL_GET("gdscript/startup/parallel_parsing")) {
+		// Named classes are what most scripts depend on, get them parsed before anything is loaded.
+		List<StringName> global_classes;
+		ScriptServer::get_global_class_list(&global_classes);
+		Vector<String> paths;
+		for (const StringName &class_name : global_classes) {
+			if (ScriptServer::get_global_class_language(class_name) == get_name()) {
+				paths.push_back(ScriptServer::get_global_class_path(class_name));
+			}
+		}
+		GDScriptCache::parse_scripts(paths);
+	}
+
 #ifdef TESTS_ENABLED
 	GDScriptTests::GDScriptTestRunner::handle_cmdline();
 #endif
@@ -2342,6 +2408,15 @@ void GDScriptLanguage::finish() {
 	}
 	finishing = true;
 
+	if (GDScriptSamplingProfiler::is_running()) {
+		GDScriptSamplingProfiler::stop();
+		const String path = GDScriptSamplingProfiler::get_requested_path();
+		if (!path.is_empty() && GDScriptSamplingProfiler::save(path) == OK) {
+			print_line(vformat("GDScript: Saved %d samples to \"%s\".", GDScriptSamplingProfiler::get_sample_count(), path));
+		}
+	}
+	GDScriptSamplingProfiler::clear();
+
 	// Clear the cache before parsing the script_list
 	GDScriptCache::clear();
 
@@ -2722,6 +2797,9 @@ void GDScriptLanguage::reload_tool_script(const Ref<Script> &p_script, bool p_so
 }
 
 void GDScriptLanguage::frame() {
+	// Startup loading is done by the first frame.
+	GDScriptCache::release_parsed_ahead();
+
 #ifdef DEBUG_ENABLED
 	if (profiling) {
 		MutexLock lock(mutex);
@@ -2973,6 +3051,12 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	GDScriptJIT::set_enabled(GLOBAL_DEF_RST("gdscript/jit/enabled", false));
+	GDScriptJIT::set_tier_up_threshold(GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "gdscript/jit/tier_up_threshold", PROPERTY_HINT_RANGE, "0,100000,1,or_greater"), 1000));
+	GLOBAL_DEF_RST("gdscript/startup/parallel_parsing", false);
+	// The editor recompiles scripts as they are edited and needs their parse trees for documentation.
+	GDScriptBytecodeCache::set_enabled(GLOBAL_DEF_RST("gdscript/bytecode_cache/enabled", false) && !Engine::get_singleton()->is_editor_hint());
+	GDScriptBytecodeCache::set_directory(GLOBAL_DEF_RST("gdscript/bytecode_cache/path", "user://gdscript_cache"));
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
@@ -2994,6 +3078,11 @@ GDScriptLanguage::GDScriptLanguage() {
 	ProjectSettings::get_singleton()->set_as_internal("debug/gdscript/warnings/function_used_as_property", true);
 #endif
 #endif // DEBUG_ENABLED
+
+	if (!GDScriptSamplingProfiler::get_requested_path().is_empty()) {
+		// Turns on call stack tracking, before any script gets compiled.
+		GDScriptSamplingProfiler::start(GDScriptSamplingProfiler::get_requested_interval());
+	}
 }
 
 GDScriptLanguage::~GDScriptLanguage() {
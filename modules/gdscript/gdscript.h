@@ -46,6 +46,7 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/object/script_language.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/rb_set.h"
 
 class GDScriptNativeClass : public RefCounted {
@@ -92,8 +93,10 @@ class GDScript : public Script {
 	friend class GDScriptInstance;
 	friend class GDScriptFunction;
 	friend class GDScriptAnalyzer;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptDocGen;
+	friend class GDScriptInlineCache;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
@@ -229,6 +232,9 @@ private:
 	void _collect_function_dependencies(GDScriptFunction *p_func, RBSet<GDScript *> &p_dependencies, const GDScript *p_except);
 	void _collect_dependencies(RBSet<GDScript *> &p_dependencies, const GDScript *p_except);
 
+	static void _take_reusable_callables(GDScriptFunction *p_func, LocalVector<Callable> &r_callables);
+	void _take_reusable_callables(LocalVector<Callable> &r_callables);
+
 protected:
 	bool _get(const StringName &p_name, Variant &r_ret) const;
 	bool _set(const StringName &p_name, const Variant &p_value);
@@ -251,6 +257,9 @@ public:
 	_FORCE_INLINE_ StringName get_local_name() const { return local_name; }
 
 	void clear(GDScript::ClearData *p_clear_data = nullptr);
+	/// Drops the callables cached by lambdas without captures, including those of inner classes.
+	/// They reference the script, so the script can't be freed while they are cached.
+	void release_reusable_callables();
 
 	/// Cancels all functions of the script that are are waiting to be resumed after using await.
 	void cancel_pending_functions(bool warn);
@@ -369,6 +378,7 @@ public:
 class GDScriptInstance : public ScriptInstance {
 	friend class GDScript;
 	friend class GDScriptFunction;
+	friend class GDScriptInlineCache;
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptCompiler;
@@ -428,6 +438,7 @@ public:
 
 class GDScriptLanguage : public ScriptLanguage {
 	friend class GDScriptFunctionState;
+	friend class GDScriptSamplingProfiler;
 
 	static GDScriptLanguage *singleton;
 
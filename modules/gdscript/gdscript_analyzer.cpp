@@ -1361,6 +1361,19 @@ void GDScriptAnalyzer::resolve_class_interface(GDScriptParser::ClassNode *p_clas
 	}
 }
 
+bool GDScriptAnalyzer::can_skip_function_body(const GDScriptParser::FunctionNode *p_function) const {
+	if (!parser->for_completion || !skip_bodies_for_completion) {
+		return false;
+	}
+	// Completion and lookup need the function under the cursor.
+	if (p_function == parser->completion_context.current_function || (parser->completion_cursor_line >= p_function->start_line && parser->completion_cursor_line <= p_function->end_line)) {
+		return false;
+	}
+	// Other bodies only matter when the return type has to be guessed from them.
+	const GDScriptParser::DataType &return_type = p_function->get_datatype();
+	return return_type.is_set() && !return_type.is_variant();
+}
+
 void GDScriptAnalyzer::resolve_class_body(GDScriptParser::ClassNode *p_class, const GDScriptParser::Node *p_source) {
 	if (p_source == nullptr && parser->has_class(p_class)) {
 		p_source = p_class;
@@ -1419,7 +1432,9 @@ void GDScriptAnalyzer::resolve_class_body(GDScriptParser::ClassNode *p_class, co
 				resolve_annotation(E);
 				E->apply(parser, member.function, p_class);
 			}
-			resolve_function_body(member.function);
+			if (!can_skip_function_body(member.function)) {
+				resolve_function_body(member.function);
+			}
 		} else if (member.type == GDScriptParser::ClassNode::Member::VARIABLE && member.variable->property != GDScriptParser::VariableNode::PROP_NONE) {
 			if (member.variable->property == GDScriptParser::VariableNode::PROP_INLINE) {
 				if (member.variable->getter != nullptr) {
@@ -172,11 +172,20 @@ class GDScriptAnalyzer {
 	Ref<GDScriptParserRef> find_cached_external_parser_for_class(const GDScriptParser::ClassNode *p_class, GDScriptParser *p_dependant_parser);
 	Ref<GDScript> get_depended_shallow_script(const String &p_path, Error &r_error);
 	/// @}
+	bool can_skip_function_body(const GDScriptParser::FunctionNode *p_function) const;
 #ifdef DEBUG_ENABLED
 	void is_shadowing(GDScriptParser::IdentifierNode *p_identifier, const String &p_context, const bool p_in_local_scope);
 #endif
 
 public:
+#ifdef TESTS_ENABLED
+	/// When analyzing for completion or symbol lookup, only resolve the bodies
+	/// that can affect the result. Cleared by benchmarks for comparison.
+	static inline bool skip_bodies_for_completion = true;
+#else
+	static constexpr bool skip_bodies_for_completion = true;
+#endif
+
 	Error resolve_inheritance();
 	Error resolve_interface();
 	Error resolve_body();
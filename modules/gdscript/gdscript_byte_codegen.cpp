@@ -400,6 +400,14 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	} else {
+		function->_inline_caches_ptr = nullptr;
+		function->_inline_caches_count = 0;
+	}
+
 	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
 		function->stack_debug = stack_debug;
 	}
@@ -420,6 +428,109 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 	return function;
 }
 
+GDScriptFunction::Opcode GDScriptByteCodeGenerator::get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type) {
+	if (!specialize_typed_operators || p_left_type != p_right_type) {
+		return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+	}
+
+	if (p_left_type == Variant::INT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_ADD;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_SUBTRACT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_MULTIPLY;
+			case Variant::OP_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL;
+			case Variant::OP_NOT_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_NOT_EQUAL;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_LESS;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_LESS_EQUAL;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_GREATER;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL;
+			default:
+				break;
+		}
+	} else if (p_left_type == Variant::FLOAT) {
+		switch (p_operator) {
+			case Variant::OP_ADD:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_ADD;
+			case Variant::OP_SUBTRACT:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_SUBTRACT;
+			case Variant::OP_MULTIPLY:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_MULTIPLY;
+			case Variant::OP_DIVIDE:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_DIVIDE;
+			case Variant::OP_LESS:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS;
+			case Variant::OP_LESS_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL;
+			case Variant::OP_GREATER:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER;
+			case Variant::OP_GREATER_EQUAL:
+				return GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL;
+			default:
+				break;
+		}
+	}
+	return GDScriptFunction::OPCODE_OPERATOR_VALIDATED;
+}
+
+void GDScriptByteCodeGenerator::try_fuse_with_last(GDScriptFunction::Opcode p_next) {
+	if (!fuse_superinstructions || last_opcode_pos < 0) {
+		return;
+	}
+
+	// The second instruction is kept as is: the superinstruction replaces only the
+	// opcode of the first one and skips over the second after running both.
+	GDScriptFunction::Opcode fused = GDScriptFunction::OPCODE_END;
+	int last_size = 0;
+	switch (last_opcode) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+			last_size = 5;
+			if (p_next == GDScriptFunction::OPCODE_JUMP_IF_NOT) {
+				fused = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+			} else if (p_next == GDScriptFunction::OPCODE_ASSIGN) {
+				fused = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+			}
+		} break;
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+			last_size = 5;
+			if (GDScriptFunction::is_validated_operator(p_next)) {
+				fused = GDScriptFunction::OPCODE_GET_KEYED_OPERATOR_VALIDATED;
+			}
+		} break;
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+			last_size = 5;
+			if (GDScriptFunction::is_validated_operator(p_next)) {
+				fused = GDScriptFunction::OPCODE_GET_INDEXED_OPERATOR_VALIDATED;
+			}
+		} break;
+		default:
+			break;
+	}
+
+	// Only instructions that directly follow each other can be fused.
+	if (fused != GDScriptFunction::OPCODE_END && last_opcode_pos + last_size == opcodes.size()) {
+		opcodes.write[last_opcode_pos] = fused;
+	}
+}
+
+void GDScriptByteCodeGenerator::append_loop_jump(int p_continue_address) {
+	if (fuse_superinstructions && opcodes[p_continue_address] == GDScriptFunction::OPCODE_ITERATE_RANGE) {
+		// Run the next iteration of range loops without dispatching it separately.
+		append_opcode(GDScriptFunction::OPCODE_JUMP_ITERATE_RANGE);
+	} else {
+		append_opcode(GDScriptFunction::OPCODE_JUMP);
+	}
+	append(p_continue_address);
+}
+
 #ifdef DEBUG_ENABLED
 void GDScriptByteCodeGenerator::set_signature(const String &p_signature) {
 	function->profile.signature = p_signature;
@@ -621,7 +732,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
-		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
+		append_opcode(get_typed_operator_opcode(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type));
 		append(p_left_operand);
 		append(p_right_operand);
 		append(p_target);
@@ -867,6 +978,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -885,6 +997,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1099,6 +1212,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1124,6 +1238,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1358,6 +1473,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1371,6 +1487,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1384,6 +1501,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1760,8 +1878,7 @@ void GDScriptByteCodeGenerator::write_for(const Address &p_variable, bool p_use_
 
 void GDScriptByteCodeGenerator::write_endfor(bool p_is_range) {
 	// Jump back to loop check.
-	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_loop_jump(continue_addrs.back()->get());
 	continue_addrs.pop_back();
 
 	// Patch end jumps (two of them).
@@ -1824,8 +1941,7 @@ void GDScriptByteCodeGenerator::write_break() {
 }
 
 void GDScriptByteCodeGenerator::write_continue() {
-	append_opcode(GDScriptFunction::OPCODE_JUMP);
-	append(continue_addrs.back()->get());
+	append_loop_jump(continue_addrs.back()->get());
 }
 
 void GDScriptByteCodeGenerator::write_breakpoint() {
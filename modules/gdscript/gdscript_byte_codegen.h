@@ -106,6 +106,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int current_line = 0;
 	int instr_args_max = 0;
 
+	// Last instruction written with `append_opcode()`, checked for superinstruction fusion.
+	int last_opcode_pos = -1;
+	GDScriptFunction::Opcode last_opcode = GDScriptFunction::OPCODE_END;
+
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
 #endif
@@ -128,6 +132,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<GDScriptUtilityFunctions::FunctionPtr, int> gds_utilities_map;
 	RBMap<MethodBind *, int> method_bind_map;
 	RBMap<GDScriptFunction *, int> lambdas_map;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	/// Keep method and property names for pointer and validated operations.
@@ -362,6 +367,10 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		return pos;
 	}
 
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	CallTarget get_call_target(const Address &p_target, Variant::Type p_type = Variant::NIL);
 
 	int address_of(const Address &p_address) {
@@ -386,11 +395,20 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		return -1; // Unreachable.
 	}
 
+	static GDScriptFunction::Opcode get_typed_operator_opcode(Variant::Operator p_operator, Variant::Type p_left_type, Variant::Type p_right_type);
+	void try_fuse_with_last(GDScriptFunction::Opcode p_next);
+
 	void append_opcode(GDScriptFunction::Opcode p_code) {
+		try_fuse_with_last(p_code);
+		last_opcode_pos = opcodes.size();
+		last_opcode = p_code;
 		opcodes.push_back(p_code);
 	}
 
 	void append_opcode_and_argcount(GDScriptFunction::Opcode p_code, int p_argument_count) {
+		try_fuse_with_last(p_code);
+		last_opcode_pos = opcodes.size();
+		last_opcode = p_code;
 		opcodes.push_back(p_code);
 		opcodes.push_back(p_argument_count);
 		instr_args_max = MAX(instr_args_max, p_argument_count);
@@ -464,7 +482,24 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.write[p_address] = opcodes.size();
 	}
 
+	void append_loop_jump(int p_continue_address);
+
 public:
+#ifdef TESTS_ENABLED
+	/// Whether common instruction pairs are fused into superinstructions.
+	/// Only meant to be turned off to compare against unfused bytecode.
+	static inline bool fuse_superinstructions = true;
+#else
+	static constexpr bool fuse_superinstructions = true;
+#endif
+#ifdef TESTS_ENABLED
+	/// Whether operators on operands known to be int or float get their own opcodes.
+	/// Only meant to be turned off to compare against the generic validated operators.
+	static inline bool specialize_typed_operators = true;
+#else
+	static constexpr bool specialize_typed_operators = true;
+#endif
+
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local_constant(const StringName &p_name, const Variant &p_constant) override;
@@ -0,0 +1,1804 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_cache.h"
+#include "gdscript_function.h"
+#include "gdscript_inline_cache.h"
+#include "gdscript_parser.h"
+#include "gdscript_utility_functions.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
+#include "core/object/class_db.h"
+#include "core/templates/local_vector.h"
+#include "core/version.h"
+
+static constexpr uint8_t BYTECODE_CACHE_MAGIC[4] = { 'G', 'D', 'B', 'C' };
+static constexpr int BYTECODE_CACHE_DIGEST_SIZE = 16;
+
+enum {
+	BYTECODE_CACHE_FLAG_DEBUG = 1 << 0, ///< Debug builds store extra names for the disassembler.
+	BYTECODE_CACHE_FLAG_TRACK_LOCALS = 1 << 1, ///< Functions carry the stack debug info the debugger needs.
+	BYTECODE_CACHE_FLAG_TRACK_CALL_STACK = 1 << 2, ///< Functions contain OPCODE_LINE.
+};
+
+bool GDScriptBytecodeCache::enabled = false;
+String GDScriptBytecodeCache::directory = "user://gdscript_cache";
+Mutex GDScriptBytecodeCache::file_digests_mutex;
+HashMap<String, GDScriptBytecodeCache::FileDigest> GDScriptBytecodeCache::file_digests;
+
+class GDScriptBytecodeCache::Writer {
+public:
+	Vector<uint8_t> data;
+	bool failed = false; ///< Set when something can't be stored, the entry is dropped then.
+
+	const GDScript *script = nullptr;
+	HashSet<String> scripts; ///< Scripts referenced by values and types, the entry depends on them.
+
+	void put_buffer(const uint8_t *p_buffer, int p_length) {
+		if (p_length <= 0) {
+			return;
+		}
+		const int offset = data.size();
+		data.resize(offset + p_length);
+		memcpy(data.ptrw() + offset, p_buffer, p_length);
+	}
+
+	void put_8(uint8_t p_value) {
+		data.push_back(p_value);
+	}
+
+	void put_32(uint32_t p_value) {
+		uint8_t buffer[4];
+		encode_uint32(p_value, buffer);
+		put_buffer(buffer, 4);
+	}
+
+	void put_string(const String &p_string) {
+		const CharString utf8 = p_string.utf8();
+		put_32(utf8.length());
+		put_buffer((const uint8_t *)utf8.get_data(), utf8.length());
+	}
+};
+
+class GDScriptBytecodeCache::Reader {
+public:
+	const uint8_t *data = nullptr;
+	int size = 0;
+	int position = 0;
+	bool failed = false; ///< Sticky, every read after a failed one returns zeroes.
+
+	GDScript *script = nullptr;
+	String path;
+
+	const uint8_t *get_buffer(int64_t p_length) {
+		if (failed || p_length < 0 || p_length > size - position) {
+			failed = true;
+			return nullptr;
+		}
+		const uint8_t *buffer = data + position;
+		position += p_length;
+		return buffer;
+	}
+
+	uint8_t get_8() {
+		const uint8_t *buffer = get_buffer(1);
+		return buffer ? *buffer : 0;
+	}
+
+	uint32_t get_32() {
+		const uint8_t *buffer = get_buffer(4);
+		return buffer ? decode_uint32(buffer) : 0;
+	}
+
+	/// Element counts are checked against the bytes left, so damaged files can't cause huge allocations.
+	int get_count(int p_min_element_size = 1) {
+		const uint32_t count = get_32();
+		if (failed || count > uint32_t(size - position) / p_min_element_size) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	String get_string() {
+		const uint32_t length = get_32();
+		const uint8_t *buffer = get_buffer(length);
+		return buffer ? String::utf8((const char *)buffer, length) : String();
+	}
+
+	Variant::Type get_variant_type() {
+		const uint8_t type = get_8();
+		if (type >= Variant::VARIANT_MAX) {
+			failed = true;
+			return Variant::NIL;
+		}
+		return Variant::Type(type);
+	}
+
+	Ref<GDScript> get_script(const String &p_path) {
+		Error err = OK;
+		// Shallow like the compiler does, GDScriptCache::finish_compiling() completes them once the entry is loaded.
+		Ref<GDScript> referenced = GDScriptCache::get_shallow_script(p_path, err, path);
+		if (err != OK || referenced.is_null()) {
+			failed = true;
+		}
+		return referenced;
+	}
+};
+
+/// Reverse lookup of the native function pointers GDScriptFunction tables
+/// hold, built the first time an entry gets saved. Different keys may map
+/// to the same pointer, any of them resolves to it again when loading.
+struct GDScriptBytecodeSymbols {
+	HashMap<uint64_t, uint32_t> operators; ///< Operator and operand types, packed by pack_operator().
+	HashMap<uint64_t, Pair<Variant::Type, StringName>> setters;
+	HashMap<uint64_t, Pair<Variant::Type, StringName>> getters;
+	HashMap<uint64_t, Variant::Type> keyed_setters;
+	HashMap<uint64_t, Variant::Type> keyed_getters;
+	HashMap<uint64_t, Variant::Type> indexed_setters;
+	HashMap<uint64_t, Variant::Type> indexed_getters;
+	HashMap<uint64_t, Pair<Variant::Type, StringName>> builtin_methods;
+	HashMap<uint64_t, Pair<Variant::Type, int>> constructors;
+	HashMap<uint64_t, StringName> utilities;
+	HashMap<uint64_t, StringName> gds_utilities;
+
+	template <typename T>
+	static uint64_t key(T p_pointer) {
+		return (uint64_t)(uintptr_t)p_pointer;
+	}
+
+	template <typename V, typename T>
+	static const V *find(const HashMap<uint64_t, V> &p_map, T p_pointer) {
+		return p_map.getptr(key(p_pointer));
+	}
+
+	static uint32_t pack_operator(Variant::Operator p_operator, Variant::Type p_left, Variant::Type p_right) {
+		return (uint32_t(p_operator) << 16) | (uint32_t(p_left) << 8) | uint32_t(p_right);
+	}
+
+	template <typename T, typename V>
+	static void add(HashMap<uint64_t, V> &r_map, T p_pointer, const V &p_value) {
+		if (p_pointer != nullptr && !r_map.has(key(p_pointer))) {
+			r_map.insert(key(p_pointer), p_value);
+		}
+	}
+
+	GDScriptBytecodeSymbols() {
+		for (int type = 0; type < Variant::VARIANT_MAX; type++) {
+			const Variant::Type vtype = Variant::Type(type);
+			for (int op = 0; op < Variant::OP_MAX; op++) {
+				for (int right = 0; right < Variant::VARIANT_MAX; right++) {
+					add(operators, Variant::get_validated_operator_evaluator(Variant::Operator(op), vtype, Variant::Type(right)), pack_operator(Variant::Operator(op), vtype, Variant::Type(right)));
+				}
+			}
+
+			List<StringName> members;
+			Variant::get_member_list(vtype, &members);
+			for (const StringName &member : members) {
+				add(setters, Variant::get_member_validated_setter(vtype, member), Pair<Variant::Type, StringName>(vtype, member));
+				add(getters, Variant::get_member_validated_getter(vtype, member), Pair<Variant::Type, StringName>(vtype, member));
+			}
+
+			add(keyed_setters, Variant::get_member_validated_keyed_setter(vtype), vtype);
+			add(keyed_getters, Variant::get_member_validated_keyed_getter(vtype), vtype);
+			add(indexed_setters, Variant::get_member_validated_indexed_setter(vtype), vtype);
+			add(indexed_getters, Variant::get_member_validated_indexed_getter(vtype), vtype);
+
+			List<StringName> methods;
+			Variant::get_builtin_method_list(vtype, &methods);
+			for (const StringName &method : methods) {
+				add(builtin_methods, Variant::get_validated_builtin_method(vtype, method), Pair<Variant::Type, StringName>(vtype, method));
+			}
+
+			for (int i = 0; i < Variant::get_constructor_count(vtype); i++) {
+				add(constructors, Variant::get_validated_constructor(vtype, i), Pair<Variant::Type, int>(vtype, i));
+			}
+		}
+
+		List<StringName> functions;
+		Variant::get_utility_function_list(&functions);
+		for (const StringName &function : functions) {
+			add(utilities, Variant::get_validated_utility_function(function), function);
+		}
+
+		functions.clear();
+		GDScriptUtilityFunctions::get_function_list(&functions);
+		for (const StringName &function : functions) {
+			add(gds_utilities, GDScriptUtilityFunctions::get_function(function), function);
+		}
+	}
+
+	static const GDScriptBytecodeSymbols &get() {
+		static const GDScriptBytecodeSymbols symbols;
+		return symbols;
+	}
+};
+
+String GDScriptBytecodeCache::_get_build_id() {
+	return String(REDOT_VERSION_FULL_BUILD) + "." + REDOT_VERSION_HASH;
+}
+
+uint32_t GDScriptBytecodeCache::_get_flags() {
+	uint32_t flags = 0;
+#ifdef DEBUG_ENABLED
+	flags |= BYTECODE_CACHE_FLAG_DEBUG;
+#endif
+	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+		flags |= BYTECODE_CACHE_FLAG_TRACK_LOCALS;
+	}
+	if (GDScriptLanguage::get_singleton()->should_track_call_stack()) {
+		flags |= BYTECODE_CACHE_FLAG_TRACK_CALL_STACK;
+	}
+	return flags;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::_get_source_digest(const GDScript *p_script) {
+	if (p_script->binary_tokens.is_empty()) {
+		return p_script->source.md5_buffer();
+	}
+	Vector<uint8_t> digest;
+	digest.resize(BYTECODE_CACHE_DIGEST_SIZE);
+	CryptoCore::md5(p_script->binary_tokens.ptr(), p_script->binary_tokens.size(), digest.ptrw());
+	return digest;
+}
+
+Vector<uint8_t> GDScriptBytecodeCache::_get_file_digest(const String &p_path) {
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	const uint64_t modified_time = FileAccess::get_modified_time(remapped_path);
+	{
+		MutexLock lock(file_digests_mutex);
+		const FileDigest *cached = file_digests.getptr(remapped_path);
+		if (cached && cached->modified_time == modified_time) {
+			return cached->digest;
+		}
+	}
+
+	FileDigest file_digest;
+	file_digest.modified_time = modified_time;
+	if (remapped_path.get_extension().to_lower() == "gdc") {
+		const Vector<uint8_t> tokens = GDScriptCache::get_binary_tokens(remapped_path);
+		file_digest.digest.resize(BYTECODE_CACHE_DIGEST_SIZE);
+		CryptoCore::md5(tokens.ptr(), tokens.size(), file_digest.digest.ptrw());
+	} else {
+		file_digest.digest = GDScriptCache::get_source_code(remapped_path).md5_buffer();
+	}
+
+	MutexLock lock(file_digests_mutex);
+	file_digests[remapped_path] = file_digest;
+	return file_digest.digest;
+}
+
+void GDScriptBytecodeCache::_collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_paths) {
+	for (const KeyValue<String, Ref<GDScriptParserRef>> &E : p_parser->get_depended_parsers()) {
+		if (r_paths.has(E.key)) {
+			continue;
+		}
+		r_paths.insert(E.key);
+		if (E.value.is_valid() && E.value->parser != nullptr) {
+			_collect_dependencies(E.value->parser, r_paths);
+		}
+	}
+}
+
+static bool _is_plain_value(const Variant &p_value) {
+	switch (p_value.get_type()) {
+		case Variant::OBJECT:
+		case Variant::CALLABLE:
+		case Variant::SIGNAL:
+		case Variant::RID:
+			return false;
+		case Variant::ARRAY: {
+			const Array array = p_value;
+			if (array.get_typed_script() != Variant()) {
+				return false;
+			}
+			for (int i = 0; i < array.size(); i++) {
+				if (!_is_plain_value(array[i])) {
+					return false;
+				}
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			const Dictionary dictionary = p_value;
+			if (dictionary.get_typed_key_script() != Variant() || dictionary.get_typed_value_script() != Variant()) {
+				return false;
+			}
+			for (const KeyValue<Variant, Variant> &kv : dictionary) {
+				if (!_is_plain_value(kv.key) || !_is_plain_value(kv.value)) {
+					return false;
+				}
+			}
+		} break;
+		default:
+			break;
+	}
+	return true;
+}
+
+void GDScriptBytecodeCache::_write_value(Writer &p_writer, const Variant &p_value) {
+	if (p_value.get_type() == Variant::OBJECT) {
+		Object *object = p_value.get_validated_object();
+		if (object == nullptr) {
+			p_writer.put_8(VALUE_NULL_OBJECT);
+			return;
+		}
+		if (GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(object)) {
+			p_writer.put_8(VALUE_NATIVE_CLASS);
+			p_writer.put_string(native_class->get_name());
+			return;
+		}
+		Resource *resource = Object::cast_to<Resource>(object);
+		if (resource == nullptr || !resource->get_path().is_resource_file()) {
+			p_writer.failed = true;
+			return;
+		}
+		if (Object::cast_to<GDScript>(resource)) {
+			p_writer.put_8(VALUE_SCRIPT);
+			p_writer.scripts.insert(resource->get_path());
+		} else {
+			p_writer.put_8(VALUE_RESOURCE);
+		}
+		p_writer.put_string(resource->get_path());
+		return;
+	}
+
+	int length = 0;
+	if (!_is_plain_value(p_value) || encode_variant(p_value, nullptr, length, false) != OK) {
+		p_writer.failed = true;
+		return;
+	}
+	p_writer.put_8(VALUE_PLAIN);
+	p_writer.put_32(length);
+	const int offset = p_writer.data.size();
+	p_writer.data.resize(offset + length);
+	encode_variant(p_value, p_writer.data.ptrw() + offset, length, false);
+}
+
+bool GDScriptBytecodeCache::_read_value(Reader &p_reader, Variant &r_value) {
+	switch (p_reader.get_8()) {
+		case VALUE_PLAIN: {
+			const int length = p_reader.get_count();
+			const uint8_t *buffer = p_reader.get_buffer(length);
+			if (buffer == nullptr || decode_variant(r_value, buffer, length, nullptr, false) != OK) {
+				return false;
+			}
+		} break;
+		case VALUE_NULL_OBJECT: {
+			r_value = Variant((Object *)nullptr);
+		} break;
+		case VALUE_NATIVE_CLASS: {
+			const StringName name = p_reader.get_string();
+			const HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(name);
+			if (!E) {
+				return false;
+			}
+			r_value = GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+			if (!Object::cast_to<GDScriptNativeClass>(r_value.get_validated_object())) {
+				return false;
+			}
+		} break;
+		case VALUE_SCRIPT: {
+			r_value = p_reader.get_script(p_reader.get_string());
+		} break;
+		case VALUE_RESOURCE: {
+			const Ref<Resource> resource = ResourceLoader::load(p_reader.get_string());
+			if (resource.is_null()) {
+				return false;
+			}
+			r_value = resource;
+		} break;
+		default:
+			return false;
+	}
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_write_data_type(Writer &p_writer, const GDScriptDataType &p_type) {
+	p_writer.put_8(p_type.has_type);
+	p_writer.put_8(p_type.kind);
+	p_writer.put_8(p_type.builtin_type);
+	p_writer.put_string(p_type.native_type);
+	if (p_type.kind == GDScriptDataType::SCRIPT || p_type.kind == GDScriptDataType::GDSCRIPT) {
+		if (p_type.script_type == p_writer.script) {
+			// Own class, only referenced weakly, see GDScriptCompiler::_gdtype_from_datatype().
+			p_writer.put_string(String());
+		} else {
+			const String type_path = p_type.script_type ? p_type.script_type->get_path() : String();
+			if (!type_path.is_resource_file()) {
+				// Inner classes of other scripts, and built-in scripts.
+				p_writer.failed = true;
+				return;
+			}
+			if (p_type.kind == GDScriptDataType::GDSCRIPT) {
+				p_writer.scripts.insert(type_path);
+			}
+			p_writer.put_string(type_path);
+		}
+	}
+	p_writer.put_32(p_type.container_element_types.size());
+	for (const GDScriptDataType &element_type : p_type.container_element_types) {
+		_write_data_type(p_writer, element_type);
+	}
+}
+
+bool GDScriptBytecodeCache::_read_data_type(Reader &p_reader, GDScriptDataType &r_type) {
+	r_type.has_type = p_reader.get_8();
+	const uint8_t kind = p_reader.get_8();
+	if (kind > GDScriptDataType::GDSCRIPT) {
+		return false;
+	}
+	r_type.kind = GDScriptDataType::Kind(kind);
+	r_type.builtin_type = p_reader.get_variant_type();
+	r_type.native_type = p_reader.get_string();
+	if (r_type.kind == GDScriptDataType::SCRIPT || r_type.kind == GDScriptDataType::GDSCRIPT) {
+		const String type_path = p_reader.get_string();
+		if (type_path.is_empty()) {
+			r_type.script_type = p_reader.script;
+		} else {
+			if (r_type.kind == GDScriptDataType::GDSCRIPT) {
+				r_type.script_type_ref = p_reader.get_script(type_path);
+			} else {
+				r_type.script_type_ref = ResourceLoader::load(type_path);
+			}
+			if (r_type.script_type_ref.is_null()) {
+				return false;
+			}
+			r_type.script_type = r_type.script_type_ref.ptr();
+		}
+	}
+	r_type.container_element_types.resize(p_reader.get_count());
+	for (GDScriptDataType &element_type : r_type.container_element_types) {
+		if (!_read_data_type(p_reader, element_type)) {
+			return false;
+		}
+	}
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_write_property_info(Writer &p_writer, const PropertyInfo &p_info) {
+	p_writer.put_8(p_info.type);
+	p_writer.put_string(p_info.name);
+	p_writer.put_string(p_info.class_name);
+	p_writer.put_32(p_info.hint);
+	p_writer.put_string(p_info.hint_string);
+	p_writer.put_32(p_info.usage);
+}
+
+bool GDScriptBytecodeCache::_read_property_info(Reader &p_reader, PropertyInfo &r_info) {
+	r_info.type = p_reader.get_variant_type();
+	r_info.name = p_reader.get_string();
+	r_info.class_name = p_reader.get_string();
+	r_info.hint = PropertyHint(p_reader.get_32());
+	r_info.hint_string = p_reader.get_string();
+	r_info.usage = p_reader.get_32();
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_write_method_info(Writer &p_writer, const MethodInfo &p_info) {
+	p_writer.put_string(p_info.name);
+	_write_property_info(p_writer, p_info.return_val);
+	p_writer.put_32(p_info.flags);
+	p_writer.put_32(p_info.id);
+	p_writer.put_32(p_info.arguments.size());
+	for (const PropertyInfo &argument : p_info.arguments) {
+		_write_property_info(p_writer, argument);
+	}
+	p_writer.put_32(p_info.default_arguments.size());
+	for (const Variant &default_argument : p_info.default_arguments) {
+		_write_value(p_writer, default_argument);
+	}
+	p_writer.put_32(p_info.return_val_metadata);
+	p_writer.put_32(p_info.arguments_metadata.size());
+	for (int metadata : p_info.arguments_metadata) {
+		p_writer.put_32(metadata);
+	}
+}
+
+bool GDScriptBytecodeCache::_read_method_info(Reader &p_reader, MethodInfo &r_info) {
+	r_info.name = p_reader.get_string();
+	if (!_read_property_info(p_reader, r_info.return_val)) {
+		return false;
+	}
+	r_info.flags = p_reader.get_32();
+	r_info.id = p_reader.get_32();
+	r_info.arguments.resize(p_reader.get_count());
+	for (PropertyInfo &argument : r_info.arguments) {
+		if (!_read_property_info(p_reader, argument)) {
+			return false;
+		}
+	}
+	r_info.default_arguments.resize(p_reader.get_count());
+	for (Variant &default_argument : r_info.default_arguments) {
+		if (!_read_value(p_reader, default_argument)) {
+			return false;
+		}
+	}
+	r_info.return_val_metadata = p_reader.get_32();
+	r_info.arguments_metadata.resize(p_reader.get_count(4));
+	for (int &metadata : r_info.arguments_metadata) {
+		metadata = p_reader.get_32();
+	}
+	return !p_reader.failed;
+}
+
+void GDScriptBytecodeCache::_write_function(Writer &p_writer, const GDScriptFunction *p_function) {
+	if (!p_function->lambdas.is_empty()) {
+		p_writer.failed = true;
+		return;
+	}
+
+	p_writer.put_string(p_function->name);
+	p_writer.put_8(p_function->_static);
+	p_writer.put_32(p_function->argument_types.size());
+	for (const GDScriptDataType &argument_type : p_function->argument_types) {
+		_write_data_type(p_writer, argument_type);
+	}
+	_write_data_type(p_writer, p_function->return_type);
+	_write_method_info(p_writer, p_function->method_info);
+	_write_value(p_writer, p_function->rpc_config);
+
+	p_writer.put_32(p_function->_initial_line);
+	p_writer.put_32(p_function->_argument_count);
+	p_writer.put_32(p_function->_vararg_index);
+	p_writer.put_32(p_function->_stack_size);
+	p_writer.put_32(p_function->_instruction_args_size);
+
+	p_writer.put_32(p_function->temporary_slots.size());
+	for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+		p_writer.put_32(E.key);
+		p_writer.put_8(E.value);
+	}
+
+	p_writer.put_32(p_function->stack_debug.size());
+	for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+		p_writer.put_32(stack_debug.line);
+		p_writer.put_32(stack_debug.pos);
+		p_writer.put_8(stack_debug.added);
+		p_writer.put_string(stack_debug.identifier);
+	}
+
+	p_writer.put_32(p_function->code.size());
+	for (int code : p_function->code) {
+		p_writer.put_32(code);
+	}
+	p_writer.put_32(p_function->default_arguments.size());
+	for (int default_argument : p_function->default_arguments) {
+		p_writer.put_32(default_argument);
+	}
+	p_writer.put_32(p_function->constants.size());
+	for (const Variant &constant : p_function->constants) {
+		_write_value(p_writer, constant);
+	}
+	p_writer.put_32(p_function->global_names.size());
+	for (const StringName &global_name : p_function->global_names) {
+		p_writer.put_string(global_name);
+	}
+
+	const GDScriptBytecodeSymbols &symbols = GDScriptBytecodeSymbols::get();
+
+	p_writer.put_32(p_function->operator_funcs.size());
+	for (Variant::ValidatedOperatorEvaluator evaluator : p_function->operator_funcs) {
+		const uint32_t *packed = GDScriptBytecodeSymbols::find(symbols.operators, evaluator);
+		if (packed == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_32(*packed);
+	}
+
+	p_writer.put_32(p_function->setters.size());
+	for (Variant::ValidatedSetter setter : p_function->setters) {
+		const Pair<Variant::Type, StringName> *symbol = GDScriptBytecodeSymbols::find(symbols.setters, setter);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(symbol->first);
+		p_writer.put_string(symbol->second);
+	}
+
+	p_writer.put_32(p_function->getters.size());
+	for (Variant::ValidatedGetter getter : p_function->getters) {
+		const Pair<Variant::Type, StringName> *symbol = GDScriptBytecodeSymbols::find(symbols.getters, getter);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(symbol->first);
+		p_writer.put_string(symbol->second);
+	}
+
+	p_writer.put_32(p_function->keyed_setters.size());
+	for (Variant::ValidatedKeyedSetter setter : p_function->keyed_setters) {
+		const Variant::Type *symbol = GDScriptBytecodeSymbols::find(symbols.keyed_setters, setter);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(*symbol);
+	}
+
+	p_writer.put_32(p_function->keyed_getters.size());
+	for (Variant::ValidatedKeyedGetter getter : p_function->keyed_getters) {
+		const Variant::Type *symbol = GDScriptBytecodeSymbols::find(symbols.keyed_getters, getter);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(*symbol);
+	}
+
+	p_writer.put_32(p_function->indexed_setters.size());
+	for (Variant::ValidatedIndexedSetter setter : p_function->indexed_setters) {
+		const Variant::Type *symbol = GDScriptBytecodeSymbols::find(symbols.indexed_setters, setter);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(*symbol);
+	}
+
+	p_writer.put_32(p_function->indexed_getters.size());
+	for (Variant::ValidatedIndexedGetter getter : p_function->indexed_getters) {
+		const Variant::Type *symbol = GDScriptBytecodeSymbols::find(symbols.indexed_getters, getter);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(*symbol);
+	}
+
+	p_writer.put_32(p_function->builtin_methods.size());
+	for (Variant::ValidatedBuiltInMethod method : p_function->builtin_methods) {
+		const Pair<Variant::Type, StringName> *symbol = GDScriptBytecodeSymbols::find(symbols.builtin_methods, method);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(symbol->first);
+		p_writer.put_string(symbol->second);
+	}
+
+	p_writer.put_32(p_function->constructors.size());
+	for (Variant::ValidatedConstructor constructor : p_function->constructors) {
+		const Pair<Variant::Type, int> *symbol = GDScriptBytecodeSymbols::find(symbols.constructors, constructor);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_8(symbol->first);
+		p_writer.put_32(symbol->second);
+	}
+
+	p_writer.put_32(p_function->utilities.size());
+	for (Variant::ValidatedUtilityFunction utility : p_function->utilities) {
+		const StringName *symbol = GDScriptBytecodeSymbols::find(symbols.utilities, utility);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_string(*symbol);
+	}
+
+	p_writer.put_32(p_function->gds_utilities.size());
+	for (GDScriptUtilityFunctions::FunctionPtr utility : p_function->gds_utilities) {
+		const StringName *symbol = GDScriptBytecodeSymbols::find(symbols.gds_utilities, utility);
+		if (symbol == nullptr) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_string(*symbol);
+	}
+
+	p_writer.put_32(p_function->methods.size());
+	for (MethodBind *method : p_function->methods) {
+		// Compatibility binds can't be found by name again.
+		if (ClassDB::get_method(method->get_instance_class(), method->get_name()) != method) {
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.put_string(method->get_instance_class());
+		p_writer.put_string(method->get_name());
+	}
+
+	p_writer.put_32(p_function->_inline_caches_count);
+
+#ifdef DEBUG_ENABLED
+	p_writer.put_string(p_function->profile.signature);
+	const Vector<String> *debug_names[] = {
+		&p_function->operator_names,
+		&p_function->setter_names,
+		&p_function->getter_names,
+		&p_function->builtin_methods_names,
+		&p_function->constructors_names,
+		&p_function->utilities_names,
+		&p_function->gds_utilities_names,
+	};
+	for (const Vector<String> *names : debug_names) {
+		p_writer.put_32(names->size());
+		for (const String &name : *names) {
+			p_writer.put_string(name);
+		}
+	}
+#endif
+}
+
+/// Checks the bytecode of a function read from an entry before the VM runs
+/// it. Release builds of the VM trust every operand, so a damaged file
+/// could otherwise make it read or jump anywhere. The operand layouts match
+/// the ones decoded in gdscript_vm.cpp, unknown opcodes are rejected.
+class GDScriptBytecodeCache::CodeValidator {
+	const GDScriptFunction *function = nullptr;
+	const int *code = nullptr;
+	int code_size = 0;
+	int member_count = 0;
+	int static_variable_count = 0;
+	int inline_cache_count = 0;
+	int instruction_args_max = 0;
+
+	LocalVector<bool> instruction_starts;
+	LocalVector<int> jump_targets;
+	LocalVector<int> iterate_range_targets;
+
+	bool _is_valid_address(int p_address) const {
+		const int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		const int index = p_address & GDScriptFunction::ADDR_MASK;
+		switch (type) {
+			case GDScriptFunction::ADDR_TYPE_STACK:
+				return index < function->_stack_size;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT:
+				return index < function->_constant_count;
+			case GDScriptFunction::ADDR_TYPE_MEMBER:
+				// Static functions run without an instance.
+				return !function->_static && index < member_count;
+			default:
+				return false;
+		}
+	}
+
+	bool _check_addresses(int p_ip, int p_from, int p_count) const {
+		for (int i = p_from; i < p_from + p_count; i++) {
+			if (!_is_valid_address(code[p_ip + i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	static bool _check_index(int p_index, int p_count) {
+		return p_index >= 0 && p_index < p_count;
+	}
+
+	static bool _check_type(int p_type) {
+		return p_type >= 0 && p_type < Variant::VARIANT_MAX;
+	}
+
+	bool _check_name(int p_index) const {
+		return _check_index(p_index, function->_global_names_count);
+	}
+
+	/// Element type and native class name of a typed container, as stored by the typed array and dictionary opcodes.
+	bool _check_element_type(int p_ip, int p_offset) const {
+		return _check_type(code[p_ip + p_offset]) && _check_name(code[p_ip + p_offset + 1]);
+	}
+
+	/// Whether the second half of a GET_*_OPERATOR_VALIDATED superinstruction can start at `p_ip`, it may be fused itself.
+	bool _is_validated_operator_at(int p_ip) const {
+		if (p_ip >= code_size) {
+			return false;
+		}
+		const int opcode = code[p_ip];
+		return GDScriptFunction::is_validated_operator(opcode) || opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT || opcode == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN;
+	}
+
+	void _add_jump(int p_target) {
+		jump_targets.push_back(p_target);
+	}
+
+	bool _check_static_variable(int p_ip) const {
+		// The class is always a constant, the index is resolved against its static variables.
+		const int address = code[p_ip + 2];
+		if ((address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS != GDScriptFunction::ADDR_TYPE_CONSTANT) {
+			return false;
+		}
+		const GDScript *gdscript = Object::cast_to<GDScript>(function->_constants_ptr[address & GDScriptFunction::ADDR_MASK].operator Object *());
+		if (gdscript == nullptr) {
+			return false;
+		}
+		const int count = gdscript == function->_script ? static_variable_count : gdscript->static_variables.size();
+		return _check_index(code[p_ip + 3], count);
+	}
+
+	/// Instructions with a variable number of addresses are laid out as the opcode,
+	/// the address count, the addresses and then `p_trailing` fixed fields, one of
+	/// them being the argument count the VM indexes the addresses with.
+	bool _check_instruction_args(int p_ip, int p_trailing, int p_argc_field, int p_argc_scale, int p_extra_args, int &r_size, int &r_fields) {
+		if (code_size - p_ip < 2) {
+			return false;
+		}
+		const int instr_arg_count = code[p_ip + 1];
+		if (instr_arg_count < 0 || instr_arg_count > function->_instruction_args_size || code_size - p_ip - 2 - instr_arg_count < p_trailing) {
+			return false;
+		}
+		if (!_check_addresses(p_ip, 2, instr_arg_count)) {
+			return false;
+		}
+		instruction_args_max = MAX(instruction_args_max, instr_arg_count);
+		r_size = 2 + instr_arg_count + p_trailing;
+		r_fields = p_ip + 2 + instr_arg_count;
+		const int argc = code[r_fields + p_argc_field];
+		return argc >= 0 && instr_arg_count == argc * p_argc_scale + p_extra_args;
+	}
+
+	bool _check_instruction(int p_ip, int &r_size);
+
+public:
+	CodeValidator(const GDScriptFunction *p_function, int p_member_count, int p_static_variable_count, int p_inline_cache_count) :
+			function(p_function),
+			code(p_function->_code_ptr),
+			code_size(p_function->_code_size),
+			member_count(p_member_count),
+			static_variable_count(p_static_variable_count),
+			inline_cache_count(p_inline_cache_count) {}
+
+	bool validate();
+};
+
+bool GDScriptBytecodeCache::CodeValidator::_check_instruction(int p_ip, int &r_size) {
+	const int *instr = &code[p_ip];
+	const int remaining = code_size - p_ip;
+	int fields = 0;
+
+#define CHECK(m_cond)  \
+	if (!(m_cond)) {   \
+		return false;  \
+	}                  \
+	((void)0)
+
+#define CHECK_SIZE(m_size)      \
+	CHECK(remaining >= (m_size)); \
+	r_size = (m_size)
+
+	switch (instr[0]) {
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			const int size = 7 + (int)(sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int));
+			CHECK_SIZE(size);
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(instr[4] >= 0 && instr[4] < Variant::OP_MAX);
+			// The signature, return type and evaluator cached by the VM must start out empty.
+			for (int i = 5; i < size; i++) {
+				CHECK(instr[i] == 0);
+			}
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+			// The second instruction of a superinstruction is checked on its own.
+			CHECK_SIZE(5);
+			const int next = instr[0] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN ? GDScriptFunction::OPCODE_ASSIGN : GDScriptFunction::OPCODE_JUMP_IF_NOT;
+			CHECK(remaining > 5 && instr[5] == next);
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(_check_index(instr[4], function->_operator_funcs_count));
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+			CHECK_SIZE(4);
+			CHECK(_check_addresses(p_ip, 1, 2));
+			CHECK(_check_type(instr[3]));
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+			CHECK_SIZE(6);
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(_check_element_type(p_ip, 4));
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+			CHECK_SIZE(9);
+			CHECK(_check_addresses(p_ip, 1, 4));
+			CHECK(_check_element_type(p_ip, 5));
+			CHECK(_check_element_type(p_ip, 7));
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE: {
+			CHECK_SIZE(4);
+			CHECK(_check_addresses(p_ip, 1, 2));
+			CHECK(_check_name(instr[3]));
+		} break;
+		case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+		case GDScriptFunction::OPCODE_SET_KEYED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+		case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+			CHECK_SIZE(4);
+			CHECK(_check_addresses(p_ip, 1, 3));
+		} break;
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+			CHECK_SIZE(5);
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(_check_index(instr[4], function->_keyed_setters_count));
+		} break;
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			CHECK_SIZE(5);
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(_check_index(instr[4], function->_indexed_setters_count));
+		} break;
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_KEYED_OPERATOR_VALIDATED: {
+			CHECK_SIZE(5);
+			CHECK(instr[0] == GDScriptFunction::OPCODE_GET_KEYED_VALIDATED || _is_validated_operator_at(p_ip + 5));
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(_check_index(instr[4], function->_keyed_getters_count));
+		} break;
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_OPERATOR_VALIDATED: {
+			CHECK_SIZE(5);
+			CHECK(instr[0] == GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED || _is_validated_operator_at(p_ip + 5));
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(_check_index(instr[4], function->_indexed_getters_count));
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED:
+		case GDScriptFunction::OPCODE_GET_NAMED: {
+			CHECK_SIZE(5);
+			CHECK(_check_addresses(p_ip, 1, 2));
+			CHECK(_check_name(instr[3]));
+			CHECK(_check_index(instr[4], inline_cache_count));
+		} break;
+		case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+			CHECK_SIZE(4);
+			CHECK(_check_addresses(p_ip, 1, 2));
+			CHECK(_check_index(instr[3], function->_setters_count));
+		} break;
+		case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+			CHECK_SIZE(4);
+			CHECK(_check_addresses(p_ip, 1, 2));
+			CHECK(_check_index(instr[3], function->_getters_count));
+		} break;
+		case GDScriptFunction::OPCODE_SET_MEMBER:
+		case GDScriptFunction::OPCODE_GET_MEMBER:
+		case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+			CHECK_SIZE(3);
+			CHECK(_check_addresses(p_ip, 1, 1));
+			CHECK(_check_name(instr[2]));
+		} break;
+		case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+		case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE: {
+			CHECK_SIZE(4);
+			CHECK(_check_addresses(p_ip, 1, 2));
+			CHECK(_check_static_variable(p_ip));
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSERT: {
+			CHECK_SIZE(3);
+			CHECK(_check_addresses(p_ip, 1, 2));
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_AWAIT_RESUME:
+		case GDScriptFunction::OPCODE_RETURN: {
+			CHECK_SIZE(2);
+			CHECK(_check_addresses(p_ip, 1, 1));
+		} break;
+		case GDScriptFunction::OPCODE_AWAIT: {
+			// The VM resumes at the OPCODE_AWAIT_RESUME that always follows.
+			CHECK_SIZE(2);
+			CHECK(remaining > 2 && instr[2] == GDScriptFunction::OPCODE_AWAIT_RESUME);
+			CHECK(_check_addresses(p_ip, 1, 1));
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 1, r_size, fields));
+			CHECK(_check_type(code[fields + 1]));
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 1, r_size, fields));
+			CHECK(_check_index(code[fields + 1], function->_constructors_count));
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+			CHECK(_check_instruction_args(p_ip, 1, 0, 1, 1, r_size, fields));
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+			CHECK(_check_instruction_args(p_ip, 3, 0, 1, 2, r_size, fields));
+			CHECK(_check_element_type(fields, 1));
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+			CHECK(_check_instruction_args(p_ip, 1, 0, 2, 1, r_size, fields));
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+			CHECK(_check_instruction_args(p_ip, 5, 0, 2, 3, r_size, fields));
+			CHECK(_check_element_type(fields, 1));
+			CHECK(_check_element_type(fields, 3));
+		} break;
+		case GDScriptFunction::OPCODE_CALL:
+		case GDScriptFunction::OPCODE_CALL_RETURN:
+		case GDScriptFunction::OPCODE_CALL_ASYNC: {
+			CHECK(_check_instruction_args(p_ip, 3, 0, 1, 2, r_size, fields));
+			CHECK(_check_name(code[fields + 1]));
+			CHECK(_check_index(code[fields + 2], inline_cache_count));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_UTILITY:
+		case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 1, r_size, fields));
+			CHECK(_check_name(code[fields + 1]));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 1, r_size, fields));
+			CHECK(_check_index(code[fields + 1], function->_utilities_count));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 1, r_size, fields));
+			CHECK(_check_index(code[fields + 1], function->_gds_utilities_count));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 2, r_size, fields));
+			CHECK(_check_index(code[fields + 1], function->_builtin_methods_count));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 2, r_size, fields));
+			CHECK(_check_index(code[fields + 1], function->_methods_count));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+			CHECK(_check_instruction_args(p_ip, 2, 0, 1, 1, r_size, fields));
+			CHECK(_check_index(code[fields + 1], function->_methods_count));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC: {
+			CHECK(_check_instruction_args(p_ip, 2, 1, 1, 1, r_size, fields));
+			CHECK(_check_index(code[fields], function->_methods_count));
+		} break;
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+			CHECK(_check_instruction_args(p_ip, 3, 2, 1, 1, r_size, fields));
+			CHECK(_check_type(code[fields]));
+			CHECK(_check_name(code[fields + 1]));
+		} break;
+		case GDScriptFunction::OPCODE_JUMP: {
+			CHECK_SIZE(2);
+			_add_jump(instr[1]);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_ITERATE_RANGE: {
+			CHECK_SIZE(2);
+			_add_jump(instr[1]);
+			iterate_range_targets.push_back(instr[1]);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+			CHECK_SIZE(3);
+			CHECK(_check_addresses(p_ip, 1, 1));
+			_add_jump(instr[2]);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			CHECK_SIZE(1);
+			CHECK(!function->default_arguments.is_empty());
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+			CHECK_SIZE(3);
+			CHECK(_check_addresses(p_ip, 1, 1));
+			CHECK(_check_type(instr[2]));
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY: {
+			CHECK_SIZE(5);
+			CHECK(_check_addresses(p_ip, 1, 2));
+			CHECK(_check_element_type(p_ip, 3));
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY: {
+			CHECK_SIZE(8);
+			CHECK(_check_addresses(p_ip, 1, 3));
+			CHECK(_check_element_type(p_ip, 4));
+			CHECK(_check_element_type(p_ip, 6));
+		} break;
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT: {
+			CHECK_SIZE(3);
+			CHECK(_check_addresses(p_ip, 1, 2));
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+			CHECK_SIZE(7);
+			CHECK(_check_addresses(p_ip, 1, 5));
+			_add_jump(instr[6]);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+			CHECK_SIZE(6);
+			CHECK(_check_addresses(p_ip, 1, 4));
+			_add_jump(instr[5]);
+		} break;
+		case GDScriptFunction::OPCODE_STORE_GLOBAL: {
+			CHECK_SIZE(3);
+			CHECK(_check_addresses(p_ip, 1, 1));
+			CHECK(_check_index(instr[2], GDScriptLanguage::get_singleton()->get_global_array_size()));
+		} break;
+		case GDScriptFunction::OPCODE_BREAKPOINT:
+		case GDScriptFunction::OPCODE_END: {
+			CHECK_SIZE(1);
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			CHECK_SIZE(2);
+		} break;
+		default: {
+			if (GDScriptFunction::is_validated_operator(instr[0])) {
+				CHECK_SIZE(5);
+				CHECK(_check_addresses(p_ip, 1, 3));
+				CHECK(_check_index(instr[4], function->_operator_funcs_count));
+			} else if ((instr[0] >= GDScriptFunction::OPCODE_ITERATE_BEGIN && instr[0] <= GDScriptFunction::OPCODE_ITERATE_BEGIN_OBJECT) || (instr[0] >= GDScriptFunction::OPCODE_ITERATE && instr[0] <= GDScriptFunction::OPCODE_ITERATE_OBJECT)) {
+				CHECK_SIZE(5);
+				CHECK(_check_addresses(p_ip, 1, 3));
+				_add_jump(instr[4]);
+			} else if (instr[0] >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && instr[0] <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+				CHECK_SIZE(2);
+				CHECK(_check_addresses(p_ip, 1, 1));
+			} else {
+				// Lambdas are never cached, neither are opcodes this build doesn't know.
+				return false;
+			}
+		} break;
+	}
+
+#undef CHECK_SIZE
+#undef CHECK
+
+	return true;
+}
+
+bool GDScriptBytecodeCache::CodeValidator::validate() {
+	if (function->_argument_count < 0 || function->_argument_count != function->argument_types.size()) {
+		return false;
+	}
+	if (function->_stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX + function->_argument_count || function->_stack_size > GDScriptFunction::ADDR_MASK + 1) {
+		return false;
+	}
+	if (function->_vararg_index >= function->_stack_size || (function->_vararg_index >= 0 && function->_vararg_index < GDScriptFunction::FIXED_ADDRESSES_MAX)) {
+		return false;
+	}
+	for (const KeyValue<int, Variant::Type> &E : function->temporary_slots) {
+		if (E.key < GDScriptFunction::FIXED_ADDRESSES_MAX || E.key >= function->_stack_size) {
+			return false;
+		}
+	}
+	if (code_size == 0 || code[code_size - 1] != GDScriptFunction::OPCODE_END) {
+		return false;
+	}
+
+	instruction_starts.resize(code_size);
+	for (bool &start : instruction_starts) {
+		start = false;
+	}
+	for (int ip = 0; ip < code_size;) {
+		int size = 0;
+		if (!_check_instruction(ip, size)) {
+			return false;
+		}
+		instruction_starts[ip] = true;
+		ip += size;
+	}
+	// The compiler sizes the argument pointers for the largest instruction, the VM shouldn't allocate more.
+	if (function->_instruction_args_size != instruction_args_max) {
+		return false;
+	}
+
+	for (int target : jump_targets) {
+		if (!_check_index(target, code_size) || !instruction_starts[target]) {
+			return false;
+		}
+	}
+	for (int target : iterate_range_targets) {
+		if (code[target] != GDScriptFunction::OPCODE_ITERATE_RANGE) {
+			return false;
+		}
+	}
+	for (int target : function->default_arguments) {
+		if (!_check_index(target, code_size) || !instruction_starts[target]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+GDScriptFunction *GDScriptBytecodeCache::_read_function(Reader &p_reader, int p_member_count, int p_static_variable_count) {
+	GDScriptFunction *function = memnew(GDScriptFunction);
+	function->_script = p_reader.script;
+	function->source = p_reader.script->get_script_path();
+	function->name = p_reader.get_string();
+
+#ifdef DEBUG_ENABLED
+	function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+	function->_func_cname = function->func_cname.get_data();
+#endif
+
+	bool valid = true;
+	function->_static = p_reader.get_8();
+	function->argument_types.resize(p_reader.get_count());
+	for (GDScriptDataType &argument_type : function->argument_types) {
+		valid = valid && _read_data_type(p_reader, argument_type);
+	}
+	valid = valid && _read_data_type(p_reader, function->return_type);
+	valid = valid && _read_method_info(p_reader, function->method_info);
+	valid = valid && _read_value(p_reader, function->rpc_config);
+	if (!valid) {
+		memdelete(function);
+		return nullptr;
+	}
+
+	function->_initial_line = p_reader.get_32();
+	function->_argument_count = p_reader.get_32();
+	function->_vararg_index = int32_t(p_reader.get_32());
+	function->_stack_size = p_reader.get_32();
+	function->_instruction_args_size = p_reader.get_32();
+
+	for (int i = p_reader.get_count(5); i > 0; i--) {
+		const int slot = p_reader.get_32();
+		function->temporary_slots[slot] = p_reader.get_variant_type();
+	}
+
+	for (int i = p_reader.get_count(13); i > 0; i--) {
+		GDScriptFunction::StackDebug stack_debug;
+		stack_debug.line = p_reader.get_32();
+		stack_debug.pos = p_reader.get_32();
+		stack_debug.added = p_reader.get_8();
+		stack_debug.identifier = p_reader.get_string();
+		function->stack_debug.push_back(stack_debug);
+	}
+
+	function->code.resize(p_reader.get_count(4));
+	for (int &code : function->code) {
+		code = p_reader.get_32();
+	}
+	function->default_arguments.resize(p_reader.get_count(4));
+	for (int &default_argument : function->default_arguments) {
+		default_argument = p_reader.get_32();
+	}
+	function->constants.resize(p_reader.get_count());
+	for (Variant &constant : function->constants) {
+		valid = valid && _read_value(p_reader, constant);
+	}
+	function->global_names.resize(p_reader.get_count(4));
+	for (StringName &global_name : function->global_names) {
+		global_name = p_reader.get_string();
+	}
+
+	function->operator_funcs.resize(p_reader.get_count(4));
+	for (Variant::ValidatedOperatorEvaluator &evaluator : function->operator_funcs) {
+		const uint32_t packed = p_reader.get_32();
+		const uint32_t op = packed >> 16;
+		const uint32_t left = (packed >> 8) & 0xFF;
+		const uint32_t right = packed & 0xFF;
+		if (op >= Variant::OP_MAX || left >= Variant::VARIANT_MAX || right >= Variant::VARIANT_MAX) {
+			valid = false;
+			break;
+		}
+		evaluator = Variant::get_validated_operator_evaluator(Variant::Operator(op), Variant::Type(left), Variant::Type(right));
+		valid = valid && evaluator != nullptr;
+	}
+
+	function->setters.resize(p_reader.get_count(5));
+	for (Variant::ValidatedSetter &setter : function->setters) {
+		const Variant::Type type = p_reader.get_variant_type();
+		setter = Variant::get_member_validated_setter(type, p_reader.get_string());
+		valid = valid && setter != nullptr;
+	}
+
+	function->getters.resize(p_reader.get_count(5));
+	for (Variant::ValidatedGetter &getter : function->getters) {
+		const Variant::Type type = p_reader.get_variant_type();
+		getter = Variant::get_member_validated_getter(type, p_reader.get_string());
+		valid = valid && getter != nullptr;
+	}
+
+	function->keyed_setters.resize(p_reader.get_count());
+	for (Variant::ValidatedKeyedSetter &setter : function->keyed_setters) {
+		setter = Variant::get_member_validated_keyed_setter(p_reader.get_variant_type());
+		valid = valid && setter != nullptr;
+	}
+
+	function->keyed_getters.resize(p_reader.get_count());
+	for (Variant::ValidatedKeyedGetter &getter : function->keyed_getters) {
+		getter = Variant::get_member_validated_keyed_getter(p_reader.get_variant_type());
+		valid = valid && getter != nullptr;
+	}
+
+	function->indexed_setters.resize(p_reader.get_count());
+	for (Variant::ValidatedIndexedSetter &setter : function->indexed_setters) {
+		setter = Variant::get_member_validated_indexed_setter(p_reader.get_variant_type());
+		valid = valid && setter != nullptr;
+	}
+
+	function->indexed_getters.resize(p_reader.get_count());
+	for (Variant::ValidatedIndexedGetter &getter : function->indexed_getters) {
+		getter = Variant::get_member_validated_indexed_getter(p_reader.get_variant_type());
+		valid = valid && getter != nullptr;
+	}
+
+	function->builtin_methods.resize(p_reader.get_count(5));
+	for (Variant::ValidatedBuiltInMethod &method : function->builtin_methods) {
+		const Variant::Type type = p_reader.get_variant_type();
+		const StringName name = p_reader.get_string();
+		method = Variant::has_builtin_method(type, name) ? Variant::get_validated_builtin_method(type, name) : nullptr;
+		valid = valid && method != nullptr;
+	}
+
+	function->constructors.resize(p_reader.get_count(5));
+	for (Variant::ValidatedConstructor &constructor : function->constructors) {
+		const Variant::Type type = p_reader.get_variant_type();
+		const int index = p_reader.get_32();
+		constructor = index >= 0 && index < Variant::get_constructor_count(type) ? Variant::get_validated_constructor(type, index) : nullptr;
+		valid = valid && constructor != nullptr;
+	}
+
+	function->utilities.resize(p_reader.get_count(4));
+	for (Variant::ValidatedUtilityFunction &utility : function->utilities) {
+		utility = Variant::get_validated_utility_function(p_reader.get_string());
+		valid = valid && utility != nullptr;
+	}
+
+	function->gds_utilities.resize(p_reader.get_count(4));
+	for (GDScriptUtilityFunctions::FunctionPtr &utility : function->gds_utilities) {
+		utility = GDScriptUtilityFunctions::get_function(p_reader.get_string());
+		valid = valid && utility != nullptr;
+	}
+
+	function->methods.resize(p_reader.get_count(8));
+	for (MethodBind *&method : function->methods) {
+		const StringName class_name = p_reader.get_string();
+		method = ClassDB::get_method(class_name, p_reader.get_string());
+		valid = valid && method != nullptr;
+	}
+
+	const uint32_t inline_cache_count = p_reader.get_32();
+	valid = valid && inline_cache_count <= uint32_t(function->code.size());
+
+#ifdef DEBUG_ENABLED
+	function->profile.signature = p_reader.get_string();
+	Vector<String> *debug_names[] = {
+		&function->operator_names,
+		&function->setter_names,
+		&function->getter_names,
+		&function->builtin_methods_names,
+		&function->constructors_names,
+		&function->utilities_names,
+		&function->gds_utilities_names,
+	};
+	for (Vector<String> *names : debug_names) {
+		names->resize(p_reader.get_count(4));
+		for (String &name : *names) {
+			name = p_reader.get_string();
+		}
+	}
+#endif
+
+	if (!valid || p_reader.failed) {
+		memdelete(function);
+		return nullptr;
+	}
+
+	// Same as GDScriptByteCodeGenerator::write_end().
+	function->_code_ptr = function->code.ptrw();
+	function->_code_size = function->code.size();
+	function->_default_arg_ptr = function->default_arguments.ptr();
+	function->_default_arg_count = MAX(0, function->default_arguments.size() - 1);
+	function->_constants_ptr = function->constants.ptrw();
+	function->_constant_count = function->constants.size();
+	function->_global_names_ptr = function->global_names.ptr();
+	function->_global_names_count = function->global_names.size();
+	function->_operator_funcs_ptr = function->operator_funcs.ptr();
+	function->_operator_funcs_count = function->operator_funcs.size();
+	function->_setters_ptr = function->setters.ptr();
+	function->_setters_count = function->setters.size();
+	function->_getters_ptr = function->getters.ptr();
+	function->_getters_count = function->getters.size();
+	function->_keyed_setters_ptr = function->keyed_setters.ptr();
+	function->_keyed_setters_count = function->keyed_setters.size();
+	function->_keyed_getters_ptr = function->keyed_getters.ptr();
+	function->_keyed_getters_count = function->keyed_getters.size();
+	function->_indexed_setters_ptr = function->indexed_setters.ptr();
+	function->_indexed_setters_count = function->indexed_setters.size();
+	function->_indexed_getters_ptr = function->indexed_getters.ptr();
+	function->_indexed_getters_count = function->indexed_getters.size();
+	function->_builtin_methods_ptr = function->builtin_methods.ptr();
+	function->_builtin_methods_count = function->builtin_methods.size();
+	function->_constructors_ptr = function->constructors.ptr();
+	function->_constructors_count = function->constructors.size();
+	function->_utilities_ptr = function->utilities.ptr();
+	function->_utilities_count = function->utilities.size();
+	function->_gds_utilities_ptr = function->gds_utilities.ptr();
+	function->_gds_utilities_count = function->gds_utilities.size();
+	function->_methods_ptr = function->methods.ptrw();
+	function->_methods_count = function->methods.size();
+
+	if (!CodeValidator(function, p_member_count, p_static_variable_count, inline_cache_count).validate()) {
+		memdelete(function);
+		return nullptr;
+	}
+	if (inline_cache_count) {
+		function->_inline_caches_ptr = memnew_arr(GDScriptInlineCache, inline_cache_count);
+		function->_inline_caches_count = inline_cache_count;
+	}
+
+	return function;
+}
+
+void GDScriptBytecodeCache::_write_script(Writer &p_writer, const GDScript *p_script) {
+	p_writer.put_8(p_script->tool);
+	p_writer.put_8(p_script->_is_abstract);
+	p_writer.put_string(p_script->native.is_valid() ? String(p_script->native->get_name()) : String());
+	if (p_script->base.is_valid()) {
+		if (!p_script->base->get_path().is_resource_file()) {
+			// Inner class of another script.
+			p_writer.failed = true;
+			return;
+		}
+		p_writer.scripts.insert(p_script->base->get_path());
+		p_writer.put_string(p_script->base->get_path());
+	} else {
+		p_writer.put_string(String());
+	}
+
+	p_writer.put_string(p_script->local_name);
+	p_writer.put_string(p_script->global_name);
+	p_writer.put_string(p_script->fully_qualified_name);
+	p_writer.put_string(p_script->simplified_icon_path);
+
+	const HashMap<StringName, GDScript::MemberInfo> *member_tables[] = { &p_script->member_indices, &p_script->static_variables_indices };
+	for (const HashMap<StringName, GDScript::MemberInfo> *members : member_tables) {
+		p_writer.put_32(members->size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : *members) {
+			p_writer.put_string(E.key);
+			p_writer.put_32(E.value.index);
+			p_writer.put_string(E.value.setter);
+			p_writer.put_string(E.value.getter);
+			_write_data_type(p_writer, E.value.data_type);
+			_write_property_info(p_writer, E.value.property_info);
+		}
+	}
+	p_writer.put_32(p_script->members.size());
+	for (const StringName &member : p_script->members) {
+		p_writer.put_string(member);
+	}
+
+	p_writer.put_32(p_script->constants.size());
+	for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+		p_writer.put_string(E.key);
+		_write_value(p_writer, E.value);
+	}
+	p_writer.put_32(p_script->_signals.size());
+	for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+		p_writer.put_string(E.key);
+		_write_method_info(p_writer, E.value);
+	}
+	_write_value(p_writer, p_script->rpc_config);
+	p_writer.put_8(GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name));
+
+	Vector<Pair<FunctionRole, const GDScriptFunction *>> functions;
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+		functions.push_back({ FUNCTION_MEMBER, E.value });
+	}
+	if (p_script->implicit_initializer) {
+		functions.push_back({ FUNCTION_IMPLICIT_INITIALIZER, p_script->implicit_initializer });
+	}
+	if (p_script->implicit_ready) {
+		functions.push_back({ FUNCTION_IMPLICIT_READY, p_script->implicit_ready });
+	}
+	if (p_script->static_initializer) {
+		functions.push_back({ FUNCTION_STATIC_INITIALIZER, p_script->static_initializer });
+	}
+	p_writer.put_32(functions.size());
+	for (const Pair<FunctionRole, const GDScriptFunction *> &function : functions) {
+		p_writer.put_8(function.first);
+		_write_function(p_writer, function.second);
+	}
+}
+
+bool GDScriptBytecodeCache::_read_script(Reader &p_reader) {
+	GDScript *script = p_reader.script;
+
+	const bool tool = p_reader.get_8();
+	const bool is_abstract = p_reader.get_8();
+
+	Ref<GDScriptNativeClass> native;
+	{
+		const HashMap<StringName, int>::ConstIterator E = GDScriptLanguage::get_singleton()->get_global_map().find(p_reader.get_string());
+		if (E) {
+			native = GDScriptLanguage::get_singleton()->get_global_array()[E->value];
+		}
+		if (native.is_null()) {
+			return false;
+		}
+	}
+
+	Ref<GDScript> base;
+	const String base_path = p_reader.get_string();
+	if (!base_path.is_empty()) {
+		base = p_reader.get_script(base_path);
+		if (base.is_null()) {
+			return false;
+		}
+	}
+
+	const StringName local_name = p_reader.get_string();
+	const StringName global_name = p_reader.get_string();
+	const String fully_qualified_name = p_reader.get_string();
+	const String simplified_icon_path = p_reader.get_string();
+
+	HashMap<StringName, GDScript::MemberInfo> member_tables[2];
+	for (HashMap<StringName, GDScript::MemberInfo> &members : member_tables) {
+		for (int i = p_reader.get_count(); i > 0; i--) {
+			const StringName name = p_reader.get_string();
+			GDScript::MemberInfo info;
+			info.index = p_reader.get_32();
+			info.setter = p_reader.get_string();
+			info.getter = p_reader.get_string();
+			if (!_read_data_type(p_reader, info.data_type) || !_read_property_info(p_reader, info.property_info)) {
+				return false;
+			}
+			members.insert(name, info);
+		}
+		// Instances and the static variables of the class are sized by the number of entries.
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : members) {
+			if (E.value.index < 0 || E.value.index >= members.size()) {
+				return false;
+			}
+		}
+	}
+	HashSet<StringName> members;
+	for (int i = p_reader.get_count(4); i > 0; i--) {
+		members.insert(p_reader.get_string());
+	}
+
+	HashMap<StringName, Variant> constants;
+	for (int i = p_reader.get_count(); i > 0; i--) {
+		const StringName name = p_reader.get_string();
+		if (!_read_value(p_reader, constants[name])) {
+			return false;
+		}
+	}
+	HashMap<StringName, MethodInfo> signals;
+	for (int i = p_reader.get_count(); i > 0; i--) {
+		const StringName name = p_reader.get_string();
+		if (!_read_method_info(p_reader, signals[name])) {
+			return false;
+		}
+	}
+	Variant rpc_config;
+	if (!_read_value(p_reader, rpc_config) || rpc_config.get_type() != Variant::DICTIONARY) {
+		return false;
+	}
+	const bool has_static_data = p_reader.get_8();
+
+	Vector<Pair<FunctionRole, GDScriptFunction *>> functions;
+	bool valid = !p_reader.failed;
+	for (int i = p_reader.get_count(); valid && i > 0; i--) {
+		const uint8_t role = p_reader.get_8();
+		GDScriptFunction *function = role <= FUNCTION_STATIC_INITIALIZER ? _read_function(p_reader, member_tables[0].size(), member_tables[1].size()) : nullptr;
+		if (function == nullptr) {
+			valid = false;
+			break;
+		}
+		functions.push_back({ FunctionRole(role), function });
+	}
+	// Trailing bytes mean the entry was not written by this version.
+	if (!valid || p_reader.failed || p_reader.position != p_reader.size) {
+		for (const Pair<FunctionRole, GDScriptFunction *> &function : functions) {
+			memdelete(function.second);
+		}
+		return false;
+	}
+
+	script->tool = tool;
+	script->_is_abstract = is_abstract;
+	script->native = native;
+	script->base = base;
+	script->_base = base.ptr();
+	script->local_name = local_name;
+	script->global_name = global_name;
+	script->fully_qualified_name = fully_qualified_name;
+	script->simplified_icon_path = simplified_icon_path;
+	script->member_indices = member_tables[0];
+	script->static_variables_indices = member_tables[1];
+	script->static_variables.resize(script->static_variables_indices.size());
+	script->members = members;
+	script->constants = constants;
+	script->_signals = signals;
+	script->rpc_config = rpc_config;
+
+	for (const Pair<FunctionRole, GDScriptFunction *> &function : functions) {
+		switch (function.first) {
+			case FUNCTION_MEMBER:
+				script->member_functions[function.second->get_name()] = function.second;
+				break;
+			case FUNCTION_IMPLICIT_INITIALIZER:
+				script->implicit_initializer = function.second;
+				break;
+			case FUNCTION_IMPLICIT_READY:
+				script->implicit_ready = function.second;
+				break;
+			case FUNCTION_STATIC_INITIALIZER:
+				script->static_initializer = function.second;
+				break;
+		}
+	}
+	if (GDScriptFunction **initializer = script->member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init)) {
+		script->initializer = *initializer;
+	}
+
+	script->_static_default_init();
+	script->valid = true;
+
+	if (has_static_data) {
+		GDScriptCache::add_static_script(Ref<GDScript>(script));
+	}
+	return true;
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	return directory.path_join(p_script_path.md5_text() + ".gdbc");
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	const String script_path = p_script->get_path();
+	if (!script_path.is_resource_file()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	Error err = OK;
+	Ref<FileAccess> file = FileAccess::open(get_cache_path(script_path), FileAccess::READ, &err);
+	if (file.is_null()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	const Vector<uint8_t> data = file->get_buffer(file->get_length());
+	file.unref();
+
+	Reader reader;
+	reader.data = data.ptr();
+	reader.size = data.size();
+	reader.script = p_script;
+	reader.path = script_path;
+
+	const uint8_t *magic = reader.get_buffer(sizeof(BYTECODE_CACHE_MAGIC));
+	if (magic == nullptr || memcmp(magic, BYTECODE_CACHE_MAGIC, sizeof(BYTECODE_CACHE_MAGIC)) != 0) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (reader.get_32() != FORMAT_VERSION || reader.get_string() != _get_build_id() || reader.get_32() != _get_flags()) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+
+	const uint8_t *digest = reader.get_buffer(BYTECODE_CACHE_DIGEST_SIZE);
+	if (digest == nullptr || memcmp(digest, _get_source_digest(p_script).ptr(), BYTECODE_CACHE_DIGEST_SIZE) != 0) {
+		return ERR_INVALID_DATA;
+	}
+	for (int i = reader.get_count(4 + BYTECODE_CACHE_DIGEST_SIZE); i > 0; i--) {
+		const String dependency = reader.get_string();
+		digest = reader.get_buffer(BYTECODE_CACHE_DIGEST_SIZE);
+		if (digest == nullptr) {
+			return ERR_FILE_CORRUPT;
+		}
+		const Vector<uint8_t> current_digest = _get_file_digest(dependency);
+		if (current_digest.size() != BYTECODE_CACHE_DIGEST_SIZE || memcmp(digest, current_digest.ptr(), BYTECODE_CACHE_DIGEST_SIZE) != 0) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+	}
+
+	// Keeps scripts loaded on the way from reloading this one, like GDScript::reload() does while compiling.
+	p_script->reloading = true;
+	const bool loaded = _read_script(reader);
+	p_script->reloading = false;
+	if (!loaded) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	// The script is complete now. Errors of the scripts it depends on are reported when they compile.
+	GDScriptCache::finish_compiling(script_path);
+	if (ScriptServer::is_scripting_enabled() || p_script->is_tool()) {
+		p_script->_static_init();
+	}
+	return OK;
+}
+
+Error GDScriptBytecodeCache::save(GDScript *p_script, GDScriptParser *p_parser) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	const String script_path = p_script->get_path();
+	if (!script_path.is_resource_file()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	{
+		// The script was just compiled from its current source, entries depending on it must see that.
+		const String remapped_path = ResourceLoader::path_remap(script_path);
+		MutexLock lock(file_digests_mutex);
+		FileDigest &file_digest = file_digests[remapped_path];
+		file_digest.modified_time = FileAccess::get_modified_time(remapped_path);
+		file_digest.digest = _get_source_digest(p_script);
+	}
+
+	if (!p_script->subclasses.is_empty() || !p_script->lambda_info.is_empty()) {
+		return ERR_UNAVAILABLE;
+	}
+
+	// The body is written first, it collects the scripts the entry depends on.
+	Writer body;
+	body.script = p_script;
+	_write_script(body, p_script);
+	if (body.failed) {
+		print_verbose(vformat(R"(GDScript: "%s" can't be stored in the bytecode cache.)", script_path));
+		return ERR_UNAVAILABLE;
+	}
+
+	HashSet<String> dependencies = body.scripts;
+	if (p_parser) {
+		_collect_dependencies(p_parser, dependencies);
+	}
+	dependencies.erase(script_path);
+
+	Writer writer;
+	writer.put_buffer(BYTECODE_CACHE_MAGIC, sizeof(BYTECODE_CACHE_MAGIC));
+	writer.put_32(FORMAT_VERSION);
+	writer.put_string(_get_build_id());
+	writer.put_32(_get_flags());
+	writer.put_buffer(_get_source_digest(p_script).ptr(), BYTECODE_CACHE_DIGEST_SIZE);
+	writer.put_32(dependencies.size());
+	for (const String &dependency : dependencies) {
+		const Vector<uint8_t> digest = _get_file_digest(dependency);
+		if (digest.size() != BYTECODE_CACHE_DIGEST_SIZE) {
+			return ERR_FILE_MISSING_DEPENDENCIES;
+		}
+		writer.put_string(dependency);
+		writer.put_buffer(digest.ptr(), BYTECODE_CACHE_DIGEST_SIZE);
+	}
+	writer.put_buffer(body.data.ptr(), body.data.size());
+
+	const String cache_path = get_cache_path(script_path);
+	Error err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	if (err != OK) {
+		// Read-only caches, e.g. shipped inside the main pack.
+		return err;
+	}
+	// Written under another name first, so other processes never see a partial entry.
+	const String temp_path = cache_path + ".tmp";
+	{
+		Ref<FileAccess> file = FileAccess::open(temp_path, FileAccess::WRITE, &err);
+		if (file.is_null()) {
+			return err;
+		}
+		file->store_buffer(writer.data.ptr(), writer.data.size());
+	}
+	Ref<DirAccess> dir = DirAccess::create_for_path(cache_path);
+	return dir->rename(temp_path, cache_path);
+}
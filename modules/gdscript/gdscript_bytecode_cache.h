@@ -0,0 +1,138 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file gdscript_bytecode_cache.h
+ *
+ * On-disk cache of compiled GDScript classes. After a script compiles, its
+ * member layout, constants and the bytecode of every function are written
+ * to a versioned binary file, keyed by the script path. The next time the
+ * script is loaded and neither its source nor the sources it depends on
+ * changed, the class is rebuilt from that file without running the parser,
+ * the analyzer or the compiler.
+ *
+ * Native function pointers referenced by the bytecode (operators, setters,
+ * getters, builtin methods, constructors, utility functions and method
+ * binds) are stored by name and resolved again when loading, so an entry
+ * stays valid across runs of the same engine build. Entries written by
+ * another build are ignored.
+ */
+
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
+#include "core/templates/vector.h"
+
+class GDScript;
+class GDScriptFunction;
+class GDScriptDataType;
+class GDScriptParser;
+class Variant;
+struct MethodInfo;
+struct PropertyInfo;
+
+class GDScriptBytecodeCache {
+public:
+	static constexpr uint32_t FORMAT_VERSION = 1; ///< Bump whenever the layout of the file or the meaning of any opcode changes.
+
+private:
+	class CodeValidator;
+	class Reader;
+	class Writer;
+
+	enum FunctionRole : uint8_t {
+		FUNCTION_MEMBER,
+		FUNCTION_IMPLICIT_INITIALIZER,
+		FUNCTION_IMPLICIT_READY,
+		FUNCTION_STATIC_INITIALIZER,
+	};
+
+	enum ValueTag : uint8_t {
+		VALUE_PLAIN, ///< Anything encode_variant() handles without objects.
+		VALUE_NULL_OBJECT,
+		VALUE_NATIVE_CLASS, ///< GDScriptNativeClass, stored by class name.
+		VALUE_SCRIPT, ///< GDScript, stored by path.
+		VALUE_RESOURCE, ///< Any other resource saved to its own file, stored by path.
+	};
+
+	struct FileDigest {
+		uint64_t modified_time = 0;
+		Vector<uint8_t> digest;
+	};
+
+	static bool enabled;
+	static String directory;
+
+	/// Dependencies are shared by many entries, their sources are only hashed again once modified.
+	static Mutex file_digests_mutex;
+	static HashMap<String, FileDigest> file_digests;
+
+	static String _get_build_id();
+	static uint32_t _get_flags();
+	static Vector<uint8_t> _get_source_digest(const GDScript *p_script);
+	static Vector<uint8_t> _get_file_digest(const String &p_path);
+	static void _collect_dependencies(GDScriptParser *p_parser, HashSet<String> &r_paths);
+
+	static void _write_value(Writer &p_writer, const Variant &p_value);
+	static void _write_data_type(Writer &p_writer, const GDScriptDataType &p_type);
+	static void _write_property_info(Writer &p_writer, const PropertyInfo &p_info);
+	static void _write_method_info(Writer &p_writer, const MethodInfo &p_info);
+	static void _write_function(Writer &p_writer, const GDScriptFunction *p_function);
+	static void _write_script(Writer &p_writer, const GDScript *p_script);
+
+	static bool _read_value(Reader &p_reader, Variant &r_value);
+	static bool _read_data_type(Reader &p_reader, GDScriptDataType &r_type);
+	static bool _read_property_info(Reader &p_reader, PropertyInfo &r_info);
+	static bool _read_method_info(Reader &p_reader, MethodInfo &r_info);
+	static GDScriptFunction *_read_function(Reader &p_reader, int p_member_count, int p_static_variable_count);
+	static bool _read_script(Reader &p_reader);
+
+public:
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+	static void set_directory(const String &p_directory) { directory = p_directory; }
+	static String get_directory() { return directory; }
+
+	static String get_cache_path(const String &p_script_path);
+
+	/// Rebuilds a freshly created, not yet parsed script from its cache
+	/// entry. On any error the script is left untouched, and the caller
+	/// must parse and compile it as usual.
+	static Error load(GDScript *p_script);
+	/// Writes the cache entry of a script that `p_parser` just compiled.
+	/// Scripts with inner classes or lambdas, and scripts whose constants
+	/// hold objects that can't be referenced by path, are not cached.
+	static Error save(GDScript *p_script, GDScriptParser *p_parser);
+};
@@ -40,10 +40,12 @@
 
 #include "gdscript.h"
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
 
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/vector.h"
 
 GDScriptParserRef::Status GDScriptParserRef::get_status() const {
@@ -73,6 +75,8 @@ GDScriptAnalyzer *GDScriptParserRef::get_analyzer() {
 }
 
 Error GDScriptParserRef::raise_status(Status p_new_status) {
+	MEMORY_TAG_SCOPE(TAG_SCRIPTS);
+
 	ERR_FAIL_COND_V(clearing, ERR_BUG);
 	ERR_FAIL_COND_V(parser == nullptr && status != EMPTY, ERR_BUG);
 
@@ -189,12 +193,23 @@ void GDScriptCache::remove_script(const String &p_path) {
 		return;
 	}
 
+	Ref<GDScript> script; // Released outside of the lock.
 	MutexLock lock(singleton->mutex);
 
 	if (singleton->cleared) {
 		return;
 	}
 
+	// Cached lambda callables reference their script, so it wouldn't be freed once dropped from the cache.
+	if (HashMap<String, Ref<GDScript>>::Iterator E = singleton->full_gdscript_cache.find(p_path)) {
+		script = E->value;
+	} else if (HashMap<String, Ref<GDScript>>::Iterator F = singleton->shallow_gdscript_cache.find(p_path)) {
+		script = F->value;
+	}
+	if (script.is_valid()) {
+		script->release_reusable_callables();
+	}
+
 	if (HashMap<String, Vector<ObjectID>>::Iterator E = singleton->abandoned_parser_map.find(p_path)) {
 		for (ObjectID parser_ref_id : E->value) {
 			Ref<GDScriptParserRef> parser_ref = { ObjectDB::get_instance(parser_ref_id) };
@@ -261,6 +276,7 @@ void GDScriptCache::remove_parser(const String &p_path) {
 
 	// Can't clear the parser because some other parser might be currently using it in the chain of calls.
 	singleton->parser_map.erase(p_path);
+	singleton->parsed_ahead_map.erase(p_path);
 
 	// Have to copy while iterating, because parser_inverse_dependencies is modified.
 	HashSet<String> ideps = singleton->parser_inverse_dependencies[p_path];
@@ -270,6 +286,73 @@ void GDScriptCache::remove_parser(const String &p_path) {
 	}
 }
 
+void GDScriptCache::_parse_script_task(void *p_userdata, uint32_t p_index) {
+	Ref<GDScriptParserRef> *refs = static_cast<Ref<GDScriptParserRef> *>(p_userdata);
+	refs[p_index]->raise_status(GDScriptParserRef::PARSED);
+}
+
+/// Parses scripts concurrently on the WorkerThreadPool, so their parsers are
+/// ready by the time the analyzer of a dependent script asks for them.
+/// Analysis and compilation reach into the parsers of other scripts and stay
+/// on the loading thread, in the order dependencies are discovered.
+void GDScriptCache::parse_scripts(const Vector<String> &p_paths) {
+	Vector<Ref<GDScriptParserRef>> refs;
+	{
+		MutexLock lock(singleton->mutex);
+		if (singleton->cleared) {
+			return;
+		}
+		for (const String &path : p_paths) {
+			if (singleton->parser_map.has(path) || !FileAccess::exists(ResourceLoader::path_remap(path))) {
+				continue;
+			}
+			Ref<GDScriptParserRef> ref;
+			ref.instantiate();
+			ref->path = path;
+			// Not in parser_map until parsed, so its destructor must not remove another parser's entry.
+			ref->abandoned = true;
+			// The first parser constructed fills shared tables, don't let the workers race for it.
+			ref->get_parser();
+			refs.push_back(ref);
+		}
+	}
+
+	if (refs.is_empty()) {
+		return;
+	}
+	GDScriptParser::get_builtin_type(StringName()); // Same for the built-in type table.
+
+	// The cache isn't locked while parsing, the refs aren't reachable through it yet.
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(&_parse_script_task, refs.ptrw(), refs.size(), -1, false, SNAME("GDScriptParse"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	MutexLock lock(singleton->mutex);
+	if (singleton->cleared) {
+		return;
+	}
+	for (Ref<GDScriptParserRef> &ref : refs) {
+		if (singleton->parser_map.has(ref->path)) {
+			continue; // Requested by another thread meanwhile, keep that one.
+		}
+		ref->abandoned = false;
+		singleton->parser_map[ref->path] = ref.ptr();
+		singleton->parsed_ahead_map[ref->path] = ref;
+	}
+	singleton->has_parsed_ahead.set();
+}
+
+/// Drops the parsers parse_scripts() made for scripts nothing loaded while
+/// starting up, which would otherwise stay around until clear(). Parsers
+/// still referenced elsewhere are kept by those references.
+void GDScriptCache::release_parsed_ahead() {
+	if (!singleton->has_parsed_ahead.is_set()) {
+		return;
+	}
+	MutexLock lock(singleton->mutex);
+	singleton->has_parsed_ahead.clear();
+	singleton->parsed_ahead_map.clear();
+}
+
 String GDScriptCache::get_source_code(const String &p_path) {
 	Vector<uint8_t> source_file;
 	Error err;
@@ -335,6 +418,14 @@ Ref<GDScript> GDScriptCache::get_shallow_script(const String &p_path, Error &r_e
 		return Ref<GDScript>(); // Returns null and does not cache when the script fails to load.
 	}
 
+	if (GDScriptBytecodeCache::is_enabled()) {
+		// Cached before loading, scripts the entry refers to may refer back to this one.
+		singleton->shallow_gdscript_cache[p_path] = script;
+		if (GDScriptBytecodeCache::load(script.ptr()) == OK) {
+			return script;
+		}
+	}
+
 	Ref<GDScriptParserRef> parser_ref = get_parser(p_path, GDScriptParserRef::PARSED, r_error);
 	if (r_error == OK) {
 		GDScriptCompiler::make_scripts(script.ptr(), parser_ref->get_parser()->get_tree(), true);
@@ -367,6 +458,10 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 		if (script.is_null()) {
 			return script;
 		}
+		// Restored from the bytecode cache, nothing left to compile.
+		if (script->is_valid() && !p_update_from_disk) {
+			return script;
+		}
 	}
 
 	const String remapped_path = ResourceLoader::path_remap(p_path);
@@ -398,6 +493,7 @@ Ref<GDScript> GDScriptCache::get_full_script(const String &p_path, Error &r_erro
 
 	singleton->full_gdscript_cache[p_path] = script;
 	singleton->shallow_gdscript_cache.erase(p_path);
+	singleton->parsed_ahead_map.erase(p_path);
 
 	return script;
 }
@@ -491,6 +587,7 @@ void GDScriptCache::clear() {
 	}
 
 	parser_map_refs.clear();
+	singleton->parsed_ahead_map.clear();
 	singleton->shallow_gdscript_cache.clear();
 	singleton->full_gdscript_cache.clear();
 	singleton->static_gdscript_cache.clear();
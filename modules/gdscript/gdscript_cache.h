@@ -70,6 +70,7 @@ private:
 	bool clearing = false;
 	bool abandoned = false;
 
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCache;
 	friend class GDScript;
 
@@ -95,8 +96,11 @@ class GDScriptCache {
 	HashMap<String, Ref<GDScript>> static_gdscript_cache;
 	HashMap<String, HashSet<String>> dependencies;
 	HashMap<String, HashSet<String>> parser_inverse_dependencies;
+	HashMap<String, Ref<GDScriptParserRef>> parsed_ahead_map; ///< Keeps parsers made by parse_scripts() alive until their script is compiled, or startup is over.
+	SafeFlag has_parsed_ahead; ///< Whether parsed_ahead_map may hold entries, checked every frame without locking.
 
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
 
@@ -111,12 +115,16 @@ private:
 	static SafeBinaryMutex<BINARY_MUTEX_TAG> mutex;
 	friend SafeBinaryMutex<BINARY_MUTEX_TAG> &_get_gdscript_cache_mutex();
 
+	static void _parse_script_task(void *p_userdata, uint32_t p_index);
+
 public:
 	static void move_script(const String &p_from, const String &p_to);
 	static void remove_script(const String &p_path);
 	static Ref<GDScriptParserRef> get_parser(const String &p_path, GDScriptParserRef::Status status, Error &r_error, const String &p_owner = String());
 	static bool has_parser(const String &p_path);
 	static void remove_parser(const String &p_path);
+	static void parse_scripts(const Vector<String> &p_paths);
+	static void release_parsed_ahead();
 	static String get_source_code(const String &p_path);
 	static Vector<uint8_t> get_binary_tokens(const String &p_path);
 	static Ref<GDScript> get_shallow_script(const String &p_path, Error &r_error, const String &p_owner = String());
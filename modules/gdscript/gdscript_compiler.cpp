@@ -2751,6 +2751,8 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 		memdelete(p_script->static_initializer);
 	}
 
+	// Inline caches may still point into the member map.
+	GDScriptInlineCache::invalidate_all();
 	p_script->member_functions.clear();
 	p_script->member_indices.clear();
 	p_script->static_variables_indices.clear();
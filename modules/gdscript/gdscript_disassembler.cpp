@@ -149,6 +149,50 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_OPERATOR_INT_ADD:
+			case OPCODE_OPERATOR_INT_SUBTRACT:
+			case OPCODE_OPERATOR_INT_MULTIPLY:
+			case OPCODE_OPERATOR_INT_EQUAL:
+			case OPCODE_OPERATOR_INT_NOT_EQUAL:
+			case OPCODE_OPERATOR_INT_LESS:
+			case OPCODE_OPERATOR_INT_LESS_EQUAL:
+			case OPCODE_OPERATOR_INT_GREATER:
+			case OPCODE_OPERATOR_INT_GREATER_EQUAL:
+			case OPCODE_OPERATOR_FLOAT_ADD:
+			case OPCODE_OPERATOR_FLOAT_SUBTRACT:
+			case OPCODE_OPERATOR_FLOAT_MULTIPLY:
+			case OPCODE_OPERATOR_FLOAT_DIVIDE:
+			case OPCODE_OPERATOR_FLOAT_LESS:
+			case OPCODE_OPERATOR_FLOAT_LESS_EQUAL:
+			case OPCODE_OPERATOR_FLOAT_GREATER:
+			case OPCODE_OPERATOR_FLOAT_GREATER_EQUAL: {
+				text += opcode <= OPCODE_OPERATOR_INT_GREATER_EQUAL ? "int operator " : "float operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+
+				incr += 5;
+			} break;
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			case OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += opcode == OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT ? " (fused with jump-if-not)" : " (fused with assign)";
+
+				incr += 5;
+			} break;
 			case OPCODE_TYPE_TEST_BUILTIN: {
 				text += "type test ";
 				text += DADDR(1);
@@ -308,6 +352,19 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr += 5;
 			} break;
+			case OPCODE_GET_KEYED_OPERATOR_VALIDATED:
+			case OPCODE_GET_INDEXED_OPERATOR_VALIDATED: {
+				text += opcode == OPCODE_GET_KEYED_OPERATOR_VALIDATED ? "get keyed validated " : "get indexed validated ";
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += "[";
+				text += DADDR(2);
+				text += "]";
+				text += " (fused with validated operator)";
+
+				incr += 5;
+			} break;
 			case OPCODE_SET_NAMED: {
 				text += "set_named ";
 				text += DADDR(1);
@@ -316,7 +373,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -337,7 +394,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -716,7 +773,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -1050,6 +1107,12 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 
 				incr = 2;
 			} break;
+			case OPCODE_JUMP_ITERATE_RANGE: {
+				text += "jump and iterate range ";
+				text += itos(_code_ptr[ip + 1]);
+
+				incr = 2;
+			} break;
 			case OPCODE_JUMP_IF: {
 				text += "jump-if ";
 				text += DADDR(1);
@@ -134,6 +134,16 @@ GDScriptFunction::~GDScriptFunction() {
 	}
 	return_type.script_type_ref = Ref<Script>();
 
+	if (_inline_caches_ptr) {
+		memdelete_arr(_inline_caches_ptr);
+	}
+	// Caches elsewhere may point at this function.
+	GDScriptInlineCache::invalidate_all();
+
+#ifdef GDSCRIPT_JIT_ENABLED
+	GDScriptJIT::free_code(jit_code.load());
+#endif
+
 #ifdef DEBUG_ENABLED
 	MutexLock lock(GDScriptLanguage::get_singleton()->mutex);
 	GDScriptLanguage::get_singleton()->function_list.remove(&function_list);
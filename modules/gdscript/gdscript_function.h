@@ -38,10 +38,13 @@
  * [Add any documentation that applies to the entire file here!]
  */
 
+#include "gdscript_inline_cache.h"
+#include "gdscript_jit.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
 #include "core/object/script_language.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
@@ -429,6 +432,34 @@ public:
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,
+		// Superinstructions. Each runs its own instruction and then the one after it,
+		// which is left in place, so jumps to the second instruction still work.
+		// See `GDScriptByteCodeGenerator::try_fuse_with_last()`.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_OPERATOR_VALIDATED_ASSIGN,
+		OPCODE_GET_KEYED_OPERATOR_VALIDATED,
+		OPCODE_GET_INDEXED_OPERATOR_VALIDATED,
+		OPCODE_JUMP_ITERATE_RANGE, ///< Jump to an OPCODE_ITERATE_RANGE and run it.
+		// Validated operators on int or float operands, computed in place instead of
+		// through the evaluator. Laid out like OPCODE_OPERATOR_VALIDATED, whose
+		// evaluator index they keep so they can still be fused or disassembled.
+		OPCODE_OPERATOR_INT_ADD,
+		OPCODE_OPERATOR_INT_SUBTRACT,
+		OPCODE_OPERATOR_INT_MULTIPLY,
+		OPCODE_OPERATOR_INT_EQUAL,
+		OPCODE_OPERATOR_INT_NOT_EQUAL,
+		OPCODE_OPERATOR_INT_LESS,
+		OPCODE_OPERATOR_INT_LESS_EQUAL,
+		OPCODE_OPERATOR_INT_GREATER,
+		OPCODE_OPERATOR_INT_GREATER_EQUAL,
+		OPCODE_OPERATOR_FLOAT_ADD,
+		OPCODE_OPERATOR_FLOAT_SUBTRACT,
+		OPCODE_OPERATOR_FLOAT_MULTIPLY,
+		OPCODE_OPERATOR_FLOAT_DIVIDE,
+		OPCODE_OPERATOR_FLOAT_LESS,
+		OPCODE_OPERATOR_FLOAT_LESS_EQUAL,
+		OPCODE_OPERATOR_FLOAT_GREATER,
+		OPCODE_OPERATOR_FLOAT_GREATER_EQUAL,
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
@@ -464,8 +495,11 @@ public:
 
 private:
 	friend class GDScript;
+	friend class GDScriptBytecodeCache;
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
+	friend class GDScriptLambdaCallable;
+	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
 
 	StringName name;
@@ -523,6 +557,7 @@ private:
 	int _gds_utilities_count = 0;
 	int _methods_count = 0;
 	int _lambdas_count = 0;
+	int _inline_caches_count = 0;
 
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
@@ -541,6 +576,21 @@ private:
 	const GDScriptUtilityFunctions::FunctionPtr *_gds_utilities_ptr = nullptr;
 	MethodBind **_methods_ptr = nullptr;
 	GDScriptFunction **_lambdas_ptr = nullptr;
+	GDScriptInlineCache *_inline_caches_ptr = nullptr; ///< One per OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL* site, owned by the function.
+
+	/// Last callable created for this lambda when it has no captures, handed out again once nothing else references it.
+	/// Only set on lambda functions, see GDScriptLambdaCallable::get_reusable().
+	SpinLock reusable_callable_lock;
+	Callable reusable_callable;
+
+#ifdef GDSCRIPT_JIT_ENABLED
+	friend class GDScriptJIT;
+	friend class GDScriptJITCompiler;
+
+	std::atomic<uint32_t> jit_counter = { 0 }; ///< Calls plus loop iterations, see GDScriptJIT::tier_up().
+	std::atomic<uint8_t> jit_state = { GDScriptJIT::STATE_INTERPRETED };
+	std::atomic<GDScriptJIT::Code *> jit_code = { nullptr };
+#endif
 
 #ifdef DEBUG_ENABLED
 	CharString func_cname;
@@ -582,6 +632,11 @@ private:
 public:
 	static constexpr int MAX_CALL_DEPTH = 2048; ///< Limit to try to avoid crash because of a stack overflow.
 
+	/// Whether the opcode is OPCODE_OPERATOR_VALIDATED or one of its int and float specializations.
+	_FORCE_INLINE_ static bool is_validated_operator(int p_opcode) {
+		return p_opcode == OPCODE_OPERATOR_VALIDATED || (p_opcode >= OPCODE_OPERATOR_INT_ADD && p_opcode <= OPCODE_OPERATOR_FLOAT_GREATER_EQUAL);
+	}
+
 	struct CallState {
 		Signal completed;
 		GDScript *script = nullptr;
@@ -607,6 +662,9 @@ public:
 	_FORCE_INLINE_ int get_argument_count() const { return _argument_count; }
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
+#ifdef GDSCRIPT_JIT_ENABLED
+	_FORCE_INLINE_ GDScriptJIT::State get_jit_state() const { return (GDScriptJIT::State)jit_state.load(std::memory_order_acquire); }
+#endif
 
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
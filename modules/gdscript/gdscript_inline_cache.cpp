@@ -0,0 +1,270 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_inline_cache.h"
+
+#include "gdscript.h"
+
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#include "core/variant/variant_internal.h"
+#include "scene/scene_string_names.h"
+
+bool GDScriptInlineCache::_lookup(const void *p_key, Hit &r_hit) const {
+	const uint32_t seq = sequence.load(std::memory_order_acquire);
+	if (seq & 1) {
+		return false;
+	}
+	if (entries_epoch.load(std::memory_order_relaxed) != epoch.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	bool found = false;
+	for (int i = 0; i < ENTRY_COUNT; i++) {
+		const Entry &entry = entries[i];
+		if (entry.key.load(std::memory_order_relaxed) == p_key) {
+			r_hit.value = entry.value.load(std::memory_order_relaxed);
+			r_hit.kind = entry.kind.load(std::memory_order_relaxed);
+			r_hit.value_type = entry.value_type.load(std::memory_order_relaxed);
+			found = true;
+			break;
+		}
+	}
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return found && sequence.load(std::memory_order_relaxed) == seq;
+}
+
+void GDScriptInlineCache::_insert(const void *p_key, uint32_t p_kind, const void *p_value, uint32_t p_value_type) {
+	uint32_t seq = sequence.load(std::memory_order_relaxed);
+	if ((seq & 1) || !sequence.compare_exchange_strong(seq, seq + 1, std::memory_order_acquire)) {
+		return; // Another thread is filling this cache, no need to wait for it.
+	}
+	std::atomic_thread_fence(std::memory_order_release);
+
+	const uint32_t current_epoch = epoch.load(std::memory_order_acquire);
+	if (entries_epoch.load(std::memory_order_relaxed) != current_epoch) {
+		for (int i = 0; i < ENTRY_COUNT; i++) {
+			entries[i].key.store(nullptr, std::memory_order_relaxed);
+			entries[i].kind.store(KIND_EMPTY, std::memory_order_relaxed);
+		}
+		next_victim.store(0, std::memory_order_relaxed);
+		entries_epoch.store(current_epoch, std::memory_order_relaxed);
+	}
+
+	// Empty entries are used first, after that the oldest one is replaced.
+	const uint32_t slot = next_victim.load(std::memory_order_relaxed);
+	next_victim.store((slot + 1) % ENTRY_COUNT, std::memory_order_relaxed);
+
+	Entry &entry = entries[slot];
+	entry.key.store(p_key, std::memory_order_relaxed);
+	entry.value.store(p_value, std::memory_order_relaxed);
+	entry.kind.store(p_kind, std::memory_order_relaxed);
+	entry.value_type.store(p_value_type, std::memory_order_relaxed);
+
+	sequence.store(seq + 2, std::memory_order_release);
+}
+
+GDScriptInstance *GDScriptInlineCache::_get_gdscript_instance(Object *p_object) {
+	ScriptInstance *script_instance = p_object->get_script_instance();
+	if (!script_instance || script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+		return nullptr;
+	}
+	return static_cast<GDScriptInstance *>(script_instance);
+}
+
+Variant GDScriptInlineCache::get_named(const Variant &p_base, const StringName &p_name, bool &r_valid) {
+	if (unlikely(!enabled)) {
+		return p_base.get_named(p_name, r_valid);
+	}
+
+	Hit hit;
+	const Variant::Type base_type = p_base.get_type();
+	if (base_type == Variant::OBJECT) {
+		Object *obj = p_base.get_validated_object();
+		GDScriptInstance *instance = obj ? _get_gdscript_instance(obj) : nullptr;
+		if (instance) {
+			const GDScript *script = instance->script.ptr();
+			if (_lookup(script, hit) && hit.kind == KIND_SCRIPT_MEMBER) {
+				const GDScript::MemberInfo *member = static_cast<const GDScript::MemberInfo *>(hit.value);
+				if (likely(member->index < instance->members.size())) {
+					r_valid = true;
+					return instance->members[member->index];
+				}
+			} else {
+				// Properties with a getter keep going through GDScriptInstance::get().
+				HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+				if (E && !E->value.getter) {
+					_insert(script, KIND_SCRIPT_MEMBER, &E->value);
+				}
+			}
+		}
+	} else if (base_type != Variant::DICTIONARY) {
+		const void *key = _builtin_key(base_type);
+		if (_lookup(key, hit) && hit.kind == KIND_BUILTIN_GETTER) {
+			// The validated getter only writes the payload, the result needs its type set beforehand.
+			Variant ret;
+			VariantInternal::initialize(&ret, Variant::Type(hit.value_type));
+			reinterpret_cast<Variant::ValidatedGetter>(const_cast<void *>(hit.value))(&p_base, &ret);
+			r_valid = true;
+			return ret;
+		}
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(base_type, p_name);
+		if (getter) {
+			_insert(key, KIND_BUILTIN_GETTER, reinterpret_cast<const void *>(getter), Variant::get_member_type(base_type, p_name));
+		}
+	}
+
+	return p_base.get_named(p_name, r_valid);
+}
+
+void GDScriptInlineCache::set_named(Variant &p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+	if (unlikely(!enabled)) {
+		p_base.set_named(p_name, p_value, r_valid);
+		return;
+	}
+
+	Hit hit;
+	const Variant::Type base_type = p_base.get_type();
+	if (base_type == Variant::OBJECT) {
+		Object *obj = p_base.get_validated_object();
+		GDScriptInstance *instance = obj ? _get_gdscript_instance(obj) : nullptr;
+#ifdef TOOLS_ENABLED
+		// Object::set() flags the object as edited, let it do so the first time.
+		if (instance && !obj->is_edited()) {
+			instance = nullptr;
+		}
+#endif
+		if (instance) {
+			const GDScript *script = instance->script.ptr();
+			if (_lookup(script, hit) && hit.kind == KIND_SCRIPT_MEMBER) {
+				const GDScript::MemberInfo *member = static_cast<const GDScript::MemberInfo *>(hit.value);
+				// Values that need a conversion keep going through GDScriptInstance::set().
+				if (likely(member->index < instance->members.size()) && (!member->data_type.has_type || member->data_type.is_type(p_value))) {
+					instance->members.write[member->index] = p_value;
+					r_valid = true;
+					return;
+				}
+			} else {
+				HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = script->member_indices.find(p_name);
+				if (E && !E->value.setter) {
+					_insert(script, KIND_SCRIPT_MEMBER, &E->value);
+				}
+			}
+		}
+	} else if (base_type != Variant::DICTIONARY) {
+		const void *key = _builtin_key(base_type);
+		if (_lookup(key, hit) && hit.kind == KIND_BUILTIN_SETTER) {
+			// The validated setter trusts the value type, conversions take the slow path.
+			if (p_value.get_type() == Variant::Type(hit.value_type)) {
+				reinterpret_cast<Variant::ValidatedSetter>(const_cast<void *>(hit.value))(&p_base, &p_value);
+				r_valid = true;
+				return;
+			}
+		} else {
+			Variant::ValidatedSetter setter = Variant::get_member_validated_setter(base_type, p_name);
+			if (setter) {
+				_insert(key, KIND_BUILTIN_SETTER, reinterpret_cast<const void *>(setter), Variant::get_member_type(base_type, p_name));
+			}
+		}
+	}
+
+	p_base.set_named(p_name, p_value, r_valid);
+}
+
+void GDScriptInlineCache::callp(Variant &p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
+	if (likely(enabled) && p_base.get_type() == Variant::OBJECT && p_method != CoreStringName(free_)) {
+#ifdef DEBUG_ENABLED
+		Object *obj = p_base.get_validated_object();
+#else
+		Object *obj = p_base; // Variant::callp() doesn't validate in release builds either.
+#endif
+		if (obj) {
+			Hit hit;
+			GDScriptInstance *instance = _get_gdscript_instance(obj);
+			if (instance) {
+				GDScript *script = instance->script.ptr();
+				if (_lookup(script, hit) && hit.kind == KIND_SCRIPT_FUNCTION) {
+#ifdef DEBUG_ENABLED
+					_ObjectDebugLock debug_lock(obj);
+#endif
+					r_error.error = Callable::CallError::CALL_OK;
+					r_ret = static_cast<GDScriptFunction *>(const_cast<void *>(hit.value))->call(instance, p_args, p_argcount, r_error);
+					return;
+				}
+				// GDScriptInstance::callp() runs the implicit initializers before `_ready()`.
+				if (p_method != SceneStringName(_ready)) {
+					for (GDScript *sptr = script; sptr; sptr = sptr->_base) {
+						if (likely(sptr->valid)) {
+							HashMap<StringName, GDScriptFunction *>::Iterator E = sptr->member_functions.find(p_method);
+							if (E) {
+								_insert(script, KIND_SCRIPT_FUNCTION, E->value);
+								break;
+							}
+						}
+					}
+				}
+			} else if (!obj->get_script_instance()) {
+				const StringName &class_name = obj->get_class_name();
+				const void *key = class_name.data_unique_pointer();
+				if (_lookup(key, hit) && hit.kind == KIND_METHOD_BIND) {
+#ifdef DEBUG_ENABLED
+					_ObjectDebugLock debug_lock(obj);
+#endif
+					r_error.error = Callable::CallError::CALL_OK;
+					r_ret = static_cast<MethodBind *>(const_cast<void *>(hit.value))->call(obj, p_args, p_argcount, r_error);
+					return;
+				}
+				MethodBind *method = ClassDB::get_method(class_name, p_method);
+				// Extension classes are left out, their method binds go away when the extension is unloaded.
+				if (method && ClassDB::get_api_type(class_name) <= ClassDB::API_EDITOR) {
+					_insert(key, KIND_METHOD_BIND, method);
+				}
+			}
+		}
+	}
+
+	p_base.callp(p_method, p_args, p_argcount, r_ret, r_error);
+}
+
+uint32_t GDScriptInlineCache::get_entry_count() const {
+	if (entries_epoch.load(std::memory_order_acquire) != epoch.load(std::memory_order_acquire)) {
+		return 0;
+	}
+	uint32_t count = 0;
+	for (int i = 0; i < ENTRY_COUNT; i++) {
+		if (entries[i].kind.load(std::memory_order_relaxed) != KIND_EMPTY) {
+			count++;
+		}
+	}
+	return count;
+}
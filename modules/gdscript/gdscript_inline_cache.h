@@ -0,0 +1,112 @@
+/**************************************************************************/
+/*  gdscript_inline_cache.h                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file gdscript_inline_cache.h
+ *
+ * Inline caches for GDScript named accesses on untyped bases. Every
+ * OPCODE_GET_NAMED, OPCODE_SET_NAMED and OPCODE_CALL* site owns one cache
+ * that remembers how the name was resolved for the last few receiver
+ * types, so repeated accesses skip the hash lookups done by Object::get(),
+ * Object::set(), Object::callp() and GDScriptInstance.
+ */
+
+#include "core/variant/variant.h"
+
+#include <atomic>
+
+class GDScript;
+class GDScriptInstance;
+class MethodBind;
+
+class GDScriptInlineCache {
+public:
+	static constexpr int ENTRY_COUNT = 4; ///< Receiver types remembered per site before entries get replaced.
+
+	enum Kind : uint32_t {
+		KIND_EMPTY,
+		KIND_SCRIPT_MEMBER, ///< Key is a GDScript, value its GDScript::MemberInfo.
+		KIND_SCRIPT_FUNCTION, ///< Key is a GDScript, value the GDScriptFunction found in its inheritance chain.
+		KIND_METHOD_BIND, ///< Key is a native class name, value its MethodBind.
+		KIND_BUILTIN_GETTER, ///< Key is a Variant::Type, value its Variant::ValidatedGetter.
+		KIND_BUILTIN_SETTER, ///< Key is a Variant::Type, value its Variant::ValidatedSetter.
+	};
+
+private:
+	struct Entry {
+		std::atomic<const void *> key = { nullptr };
+		std::atomic<const void *> value = { nullptr };
+		std::atomic<uint32_t> kind = { KIND_EMPTY };
+		std::atomic<uint32_t> value_type = { Variant::NIL }; ///< Type of the member for KIND_BUILTIN_GETTER and KIND_BUILTIN_SETTER.
+	};
+
+	struct Hit {
+		const void *value = nullptr;
+		uint32_t kind = KIND_EMPTY;
+		uint32_t value_type = Variant::NIL;
+	};
+
+	static inline std::atomic<uint32_t> epoch = { 1 };
+
+	// Entries are written under a sequence lock, readers that race with a
+	// writer simply miss and take the slow path.
+	std::atomic<uint32_t> sequence = { 0 };
+	std::atomic<uint32_t> entries_epoch = { 0 };
+	std::atomic<uint32_t> next_victim = { 0 };
+	Entry entries[ENTRY_COUNT];
+
+	bool _lookup(const void *p_key, Hit &r_hit) const;
+	void _insert(const void *p_key, uint32_t p_kind, const void *p_value, uint32_t p_value_type = Variant::NIL);
+
+	static const void *_builtin_key(Variant::Type p_type) { return reinterpret_cast<const void *>(uintptr_t(p_type) + 1); }
+	static GDScriptInstance *_get_gdscript_instance(Object *p_object);
+
+public:
+#ifdef TESTS_ENABLED
+	static inline bool enabled = true; ///< Only meant to be turned off by benchmarks.
+#else
+	static constexpr bool enabled = true;
+#endif
+
+	/// Drops every cached entry. Called whenever a script's members or
+	/// functions may have changed, or a script or function is freed.
+	static void invalidate_all() { epoch.fetch_add(1, std::memory_order_acq_rel); }
+
+	// Same contracts as Variant::get_named(), Variant::set_named() and Variant::callp().
+	Variant get_named(const Variant &p_base, const StringName &p_name, bool &r_valid);
+	void set_named(Variant &p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	void callp(Variant &p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error);
+
+	uint32_t get_entry_count() const;
+};
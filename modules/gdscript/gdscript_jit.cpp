@@ -0,0 +1,1160 @@
+/**************************************************************************/
+/*  gdscript_jit.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_jit.h"
+
+bool GDScriptJIT::enabled = false;
+uint32_t GDScriptJIT::tier_up_threshold = 1000;
+
+#ifdef GDSCRIPT_JIT_ENABLED
+
+#include "gdscript_function.h"
+#include "gdscript_sampling_profiler.h"
+
+#include "core/templates/local_vector.h"
+#include "core/variant/variant_internal.h"
+
+#include <sys/mman.h>
+
+static_assert(GDScriptFunction::ADDR_TYPE_MAX == sizeof(GDScriptJIT::Context::addresses) / sizeof(Variant *), "JIT context doesn't cover every address type.");
+
+// Runtime helpers called from the native code. Each mirrors one opcode of
+// the interpreter. The ones returning bool report false when the opcode
+// would fail, without having changed anything, so the interpreter can run
+// the same instruction again and report the error.
+
+static Variant *_get_address(const GDScriptJIT::Context *p_context, int p_address) {
+	return &p_context->addresses[(p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS][p_address & GDScriptFunction::ADDR_MASK];
+}
+
+static void _load_instruction_args(const GDScriptJIT::Context *p_context, const int *p_instruction) {
+	const int instr_arg_count = p_instruction[1];
+	for (int i = 0; i < instr_arg_count; i++) {
+		p_context->instruction_args[i] = _get_address(p_context, p_instruction[2 + i]);
+	}
+}
+
+static void _assign(Variant *r_dst, const Variant *p_src) {
+	*r_dst = *p_src;
+}
+
+static void _assign_null(Variant *r_dst) {
+	*r_dst = Variant();
+}
+
+static void _assign_true(Variant *r_dst) {
+	*r_dst = true;
+}
+
+static void _assign_false(Variant *r_dst) {
+	*r_dst = false;
+}
+
+static bool _assign_typed_builtin(Variant *r_dst, const Variant *p_src, Variant::Type p_type) {
+	if (p_src->get_type() == p_type) {
+		*r_dst = *p_src;
+		return true;
+	}
+	if (!Variant::can_convert_strict(p_src->get_type(), p_type)) {
+		return false;
+	}
+	Callable::CallError ce;
+	Variant::construct(p_type, *r_dst, &p_src, 1, ce);
+	return true;
+}
+
+static bool _assign_typed_array(const GDScriptJIT::Context *p_context, const int *p_instruction, const StringName *p_native_type) {
+	Variant *dst = _get_address(p_context, p_instruction[1]);
+	const Variant *src = _get_address(p_context, p_instruction[2]);
+	const Variant *script_type = _get_address(p_context, p_instruction[3]);
+	if (src->get_type() != Variant::ARRAY) {
+		return false;
+	}
+	const Array *array = VariantInternal::get_array(src);
+	if (array->get_typed_builtin() != (uint32_t)p_instruction[4] || array->get_typed_class_name() != *p_native_type || array->get_typed_script() != *script_type) {
+		return false;
+	}
+	*dst = *src;
+	return true;
+}
+
+// Takes the signature path the interpreter cached on the first run when the
+// operand types match it, evaluates generically otherwise.
+static bool _operator(const int *p_instruction, const Variant *p_a, const Variant *p_b, Variant *r_dst) {
+	const uint32_t actual_signature = (p_a->get_type() << 8) | p_b->get_type();
+	if ((uint32_t)p_instruction[5] == actual_signature) {
+		Variant::ValidatedOperatorEvaluator op_func = *reinterpret_cast<const Variant::ValidatedOperatorEvaluator *>(&p_instruction[7]);
+		VariantInternal::initialize(r_dst, (Variant::Type)p_instruction[6]);
+		op_func(p_a, p_b, r_dst);
+		return true;
+	}
+
+	Variant ret;
+	bool valid;
+	Variant::evaluate((Variant::Operator)p_instruction[4], *p_a, *p_b, ret, valid);
+	if (!valid) {
+		return false;
+	}
+	*r_dst = ret;
+	return true;
+}
+
+static bool _booleanize(const Variant *p_value) {
+	return p_value->booleanize();
+}
+
+static void _poll_sampling_profiler() {
+	GDScriptSamplingProfiler::poll();
+}
+
+static bool _get_keyed(Variant::ValidatedKeyedGetter p_getter, const Variant *p_src, const Variant *p_key, Variant *r_dst) {
+	// Source and destination may share a stack slot.
+	Variant ret;
+	bool valid;
+	p_getter(p_src, p_key, &ret, &valid);
+	if (!valid) {
+		return false;
+	}
+	*r_dst = ret;
+	return true;
+}
+
+static bool _set_keyed(Variant::ValidatedKeyedSetter p_setter, Variant *r_dst, const Variant *p_key, const Variant *p_value) {
+	bool valid;
+	p_setter(r_dst, p_key, p_value, &valid);
+	return valid;
+}
+
+static bool _get_indexed(Variant::ValidatedIndexedGetter p_getter, const Variant *p_src, const Variant *p_index, Variant *r_dst) {
+	bool oob;
+	p_getter(p_src, *VariantInternal::get_int(p_index), r_dst, &oob);
+	return !oob;
+}
+
+static bool _set_indexed(Variant::ValidatedIndexedSetter p_setter, Variant *r_dst, const Variant *p_index, const Variant *p_value) {
+	bool oob;
+	p_setter(r_dst, *VariantInternal::get_int(p_index), p_value, &oob);
+	return !oob;
+}
+
+static bool _iterate_begin_range(Variant *r_counter, const Variant *p_from, const Variant *p_to, const Variant *p_step, Variant *r_iterator) {
+	int64_t from = *VariantInternal::get_int(p_from);
+	int64_t to = *VariantInternal::get_int(p_to);
+	int64_t step = *VariantInternal::get_int(p_step);
+
+	VariantInternal::initialize(r_counter, Variant::INT);
+	*VariantInternal::get_int(r_counter) = from;
+
+	bool do_continue = from == to ? false : (from < to ? step > 0 : step < 0);
+	if (do_continue) {
+		VariantInternal::initialize(r_iterator, Variant::INT);
+		*VariantInternal::get_int(r_iterator) = from;
+	}
+	return do_continue;
+}
+
+static bool _iterate_range(Variant *r_counter, const Variant *p_to, const Variant *p_step, Variant *r_iterator) {
+	int64_t to = *VariantInternal::get_int(p_to);
+	int64_t step = *VariantInternal::get_int(p_step);
+
+	int64_t *count = VariantInternal::get_int(r_counter);
+	*count += step;
+
+	if ((step < 0 && *count <= to) || (step > 0 && *count >= to)) {
+		return false;
+	}
+	*VariantInternal::get_int(r_iterator) = *count;
+	return true;
+}
+
+static bool _iterate_begin_int(Variant *r_counter, const Variant *p_container, Variant *r_iterator) {
+	VariantInternal::initialize(r_counter, Variant::INT);
+	*VariantInternal::get_int(r_counter) = 0;
+
+	if (*VariantInternal::get_int(p_container) <= 0) {
+		return false;
+	}
+	VariantInternal::initialize(r_iterator, Variant::INT);
+	*VariantInternal::get_int(r_iterator) = 0;
+	return true;
+}
+
+static bool _iterate_int(Variant *r_counter, const Variant *p_container, Variant *r_iterator) {
+	int64_t *count = VariantInternal::get_int(r_counter);
+	(*count)++;
+
+	if (*count >= *VariantInternal::get_int(p_container)) {
+		return false;
+	}
+	*VariantInternal::get_int(r_iterator) = *count;
+	return true;
+}
+
+static bool _iterate_begin_array(Variant *r_counter, const Variant *p_container, Variant *r_iterator) {
+	const Array *array = VariantInternal::get_array(p_container);
+
+	VariantInternal::initialize(r_counter, Variant::INT);
+	*VariantInternal::get_int(r_counter) = 0;
+
+	if (array->is_empty()) {
+		return false;
+	}
+	*r_iterator = array->get(0);
+	return true;
+}
+
+static bool _iterate_array(Variant *r_counter, const Variant *p_container, Variant *r_iterator) {
+	const Array *array = VariantInternal::get_array(p_container);
+	int64_t *idx = VariantInternal::get_int(r_counter);
+	(*idx)++;
+
+	if (*idx >= array->size()) {
+		return false;
+	}
+	*r_iterator = array->get(*idx);
+	return true;
+}
+
+static bool _call_method_bind_validated(const GDScriptJIT::Context *p_context, const int *p_instruction, MethodBind *p_method) {
+	_load_instruction_args(p_context, p_instruction);
+	const int argc = p_instruction[p_instruction[1] + 2];
+	Variant *base = p_context->instruction_args[argc];
+
+	bool freed = false;
+	Object *base_obj = base->get_validated_object_with_check(freed);
+	if (unlikely(!base_obj)) {
+		return false;
+	}
+
+	Variant *ret = p_context->instruction_args[argc + 1];
+	if (p_instruction[0] == GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN) {
+		VariantInternal::initialize(ret, Variant::NIL);
+		ret = nullptr;
+	}
+	p_method->validated_call(base_obj, (const Variant **)p_context->instruction_args, ret);
+	return true;
+}
+
+static void _call_builtin_type_validated(const GDScriptJIT::Context *p_context, const int *p_instruction, Variant::ValidatedBuiltInMethod p_method) {
+	_load_instruction_args(p_context, p_instruction);
+	const int argc = p_instruction[p_instruction[1] + 2];
+	p_method(p_context->instruction_args[argc], (const Variant **)p_context->instruction_args, argc, p_context->instruction_args[argc + 1]);
+}
+
+static void _call_utility_validated(const GDScriptJIT::Context *p_context, const int *p_instruction, Variant::ValidatedUtilityFunction p_function) {
+	_load_instruction_args(p_context, p_instruction);
+	const int argc = p_instruction[p_instruction[1] + 2];
+	p_function(p_context->instruction_args[argc], (const Variant **)p_context->instruction_args, argc);
+}
+
+static void _construct_validated(const GDScriptJIT::Context *p_context, const int *p_instruction, Variant::ValidatedConstructor p_constructor) {
+	_load_instruction_args(p_context, p_instruction);
+	const int argc = p_instruction[p_instruction[1] + 2];
+	p_constructor(p_context->instruction_args[argc], (const Variant **)p_context->instruction_args);
+}
+
+static void _construct_typed_array(const GDScriptJIT::Context *p_context, const int *p_instruction, const StringName *p_native_type) {
+	_load_instruction_args(p_context, p_instruction);
+	const int argc = p_instruction[p_instruction[1] + 2];
+	const Variant::Type builtin_type = (Variant::Type)p_instruction[p_instruction[1] + 3];
+
+	Array array;
+	array.resize(argc);
+	for (int i = 0; i < argc; i++) {
+		array[i] = *p_context->instruction_args[i];
+	}
+
+	Variant *dst = p_context->instruction_args[argc];
+	*dst = Variant(); // Clear potential previous typed array.
+	*dst = Array(array, builtin_type, *p_native_type, *p_context->instruction_args[argc + 1]);
+}
+
+template <typename T>
+static void _type_adjust(Variant *r_value) {
+	VariantTypeAdjust<T>::adjust(r_value);
+}
+
+static void (*const type_adjust_funcs[])(Variant *) = {
+	_type_adjust<bool>,
+	_type_adjust<int64_t>,
+	_type_adjust<double>,
+	_type_adjust<String>,
+	_type_adjust<Vector2>,
+	_type_adjust<Vector2i>,
+	_type_adjust<Rect2>,
+	_type_adjust<Rect2i>,
+	_type_adjust<Vector3>,
+	_type_adjust<Vector3i>,
+	_type_adjust<Transform2D>,
+	_type_adjust<Vector4>,
+	_type_adjust<Vector4i>,
+	_type_adjust<Plane>,
+	_type_adjust<Quaternion>,
+	_type_adjust<AABB>,
+	_type_adjust<Basis>,
+	_type_adjust<Transform3D>,
+	_type_adjust<Projection>,
+	_type_adjust<Color>,
+	_type_adjust<StringName>,
+	_type_adjust<NodePath>,
+	_type_adjust<RID>,
+	_type_adjust<Object *>,
+	_type_adjust<Callable>,
+	_type_adjust<Signal>,
+	_type_adjust<Dictionary>,
+	_type_adjust<Array>,
+	_type_adjust<PackedByteArray>,
+	_type_adjust<PackedInt32Array>,
+	_type_adjust<PackedInt64Array>,
+	_type_adjust<PackedFloat32Array>,
+	_type_adjust<PackedFloat64Array>,
+	_type_adjust<PackedStringArray>,
+	_type_adjust<PackedVector2Array>,
+	_type_adjust<PackedVector3Array>,
+	_type_adjust<PackedColorArray>,
+	_type_adjust<PackedVector4Array>,
+};
+static_assert(std::size(type_adjust_funcs) == GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL + 1, "Type adjust table doesn't match the opcodes.");
+
+// Minimal x86-64 encoder, only what the translation below needs.
+class GDScriptJITAssembler {
+public:
+	enum Register : uint8_t {
+		RAX,
+		RCX,
+		RDX,
+		RBX,
+		RSP,
+		RBP,
+		RSI,
+		RDI,
+		R8,
+		R9,
+		R10,
+		R11,
+		R12,
+		R13,
+		R14,
+		R15,
+	};
+
+	enum Condition : uint8_t {
+		COND_ABOVE_EQUAL = 0x3,
+		COND_EQUAL = 0x4,
+		COND_NOT_EQUAL = 0x5,
+		COND_ABOVE = 0x7,
+		COND_LESS = 0xC,
+		COND_GREATER_EQUAL = 0xD,
+		COND_LESS_EQUAL = 0xE,
+		COND_GREATER = 0xF,
+	};
+
+	enum AluOpcode : uint8_t {
+		ALU_ADD = 0x03,
+		ALU_SUB = 0x2B,
+		ALU_CMP = 0x3B,
+	};
+
+	enum SseOpcode : uint8_t {
+		SSE_LOAD = 0x10,
+		SSE_STORE = 0x11,
+		SSE_ADD = 0x58,
+		SSE_MUL = 0x59,
+		SSE_SUB = 0x5C,
+		SSE_DIV = 0x5E,
+	};
+
+	struct Fixup {
+		uint32_t position = 0; ///< Offset of the rel32 to patch.
+		int target = 0; ///< Bytecode address jumped to.
+	};
+
+	LocalVector<uint8_t> bytes;
+	LocalVector<Fixup> fixups;
+
+private:
+	void _rex(bool p_wide, uint8_t p_reg, uint8_t p_rm) {
+		uint8_t rex = 0x40 | (p_wide ? 0x8 : 0) | ((p_reg & 8) ? 0x4 : 0) | ((p_rm & 8) ? 0x1 : 0);
+		if (rex != 0x40) {
+			emit8(rex);
+		}
+	}
+
+	// [base + disp32] operand.
+	void _mem(uint8_t p_reg, Register p_base, int32_t p_disp) {
+		emit8(0x80 | ((p_reg & 7) << 3) | (p_base & 7));
+		if ((p_base & 7) == RSP) {
+			emit8(0x24); // SIB without index, needed for rsp and r12.
+		}
+		emit32(p_disp);
+	}
+
+public:
+	void emit8(uint8_t p_byte) { bytes.push_back(p_byte); }
+	void emit32(uint32_t p_value) {
+		for (int i = 0; i < 4; i++) {
+			emit8((p_value >> (i * 8)) & 0xFF);
+		}
+	}
+	void emit64(uint64_t p_value) {
+		for (int i = 0; i < 8; i++) {
+			emit8((p_value >> (i * 8)) & 0xFF);
+		}
+	}
+
+	void push(Register p_reg) {
+		_rex(false, 0, p_reg);
+		emit8(0x50 | (p_reg & 7));
+	}
+	void pop(Register p_reg) {
+		_rex(false, 0, p_reg);
+		emit8(0x58 | (p_reg & 7));
+	}
+	void mov(Register p_dst, Register p_src) {
+		_rex(true, p_src, p_dst);
+		emit8(0x89);
+		emit8(0xC0 | ((p_src & 7) << 3) | (p_dst & 7));
+	}
+	void mov_imm32(Register p_dst, uint32_t p_imm) {
+		_rex(false, 0, p_dst);
+		emit8(0xB8 | (p_dst & 7));
+		emit32(p_imm);
+	}
+	void mov_imm64(Register p_dst, uint64_t p_imm) {
+		_rex(true, 0, p_dst);
+		emit8(0xB8 | (p_dst & 7));
+		emit64(p_imm);
+	}
+	void load64(Register p_dst, Register p_base, int32_t p_disp) {
+		_rex(true, p_dst, p_base);
+		emit8(0x8B);
+		_mem(p_dst, p_base, p_disp);
+	}
+	void load32(Register p_dst, Register p_base, int32_t p_disp) {
+		_rex(false, p_dst, p_base);
+		emit8(0x8B);
+		_mem(p_dst, p_base, p_disp);
+	}
+	void store64(Register p_base, int32_t p_disp, Register p_src) {
+		_rex(true, p_src, p_base);
+		emit8(0x89);
+		_mem(p_src, p_base, p_disp);
+	}
+	void store8(Register p_base, int32_t p_disp, Register p_src) {
+		_rex(false, p_src, p_base);
+		emit8(0x88);
+		_mem(p_src, p_base, p_disp);
+	}
+	// add, sub or cmp of a register with a 64-bit memory operand.
+	void alu64(AluOpcode p_opcode, Register p_dst, Register p_base, int32_t p_disp) {
+		_rex(true, p_dst, p_base);
+		emit8(p_opcode);
+		_mem(p_dst, p_base, p_disp);
+	}
+	void imul64(Register p_dst, Register p_base, int32_t p_disp) {
+		_rex(true, p_dst, p_base);
+		emit8(0x0F);
+		emit8(0xAF);
+		_mem(p_dst, p_base, p_disp);
+	}
+	void setcc(Condition p_condition, Register p_dst) {
+		_rex(false, 0, p_dst);
+		emit8(0x0F);
+		emit8(0x90 | p_condition);
+		emit8(0xC0 | (p_dst & 7));
+	}
+	// Scalar double operation between xmm0 and a memory operand.
+	void sse_sd(SseOpcode p_opcode, Register p_base, int32_t p_disp) {
+		emit8(0xF2);
+		_rex(false, 0, p_base);
+		emit8(0x0F);
+		emit8(p_opcode);
+		_mem(0, p_base, p_disp);
+	}
+	void ucomisd(Register p_base, int32_t p_disp) {
+		emit8(0x66);
+		_rex(false, 0, p_base);
+		emit8(0x0F);
+		emit8(0x2E);
+		_mem(0, p_base, p_disp);
+	}
+	void store32_imm(Register p_base, int32_t p_disp, uint32_t p_imm) {
+		_rex(false, 0, p_base);
+		emit8(0xC7);
+		_mem(0, p_base, p_disp);
+		emit32(p_imm);
+	}
+	void lea(Register p_dst, Register p_base, int32_t p_disp) {
+		_rex(true, p_dst, p_base);
+		emit8(0x8D);
+		_mem(p_dst, p_base, p_disp);
+	}
+	void cmp8_imm(Register p_base, int32_t p_disp, uint8_t p_imm) {
+		_rex(false, 0, p_base);
+		emit8(0x80);
+		_mem(7, p_base, p_disp);
+		emit8(p_imm);
+	}
+	void cmp_imm32(Register p_reg, int32_t p_imm) {
+		_rex(false, 0, p_reg);
+		emit8(0x81);
+		emit8(0xF8 | (p_reg & 7));
+		emit32(p_imm);
+	}
+	void test_al() {
+		emit8(0x84);
+		emit8(0xC0);
+	}
+	void call(const void *p_function) {
+		mov_imm64(RAX, (uint64_t)p_function);
+		emit8(0xFF);
+		emit8(0xD0); // call rax
+	}
+	void ret() { emit8(0xC3); }
+
+	void jmp(int p_target) {
+		emit8(0xE9);
+		fixups.push_back({ bytes.size(), p_target });
+		emit32(0);
+	}
+	void jcc(Condition p_condition, int p_target) {
+		emit8(0x0F);
+		emit8(0x80 | p_condition);
+		fixups.push_back({ bytes.size(), p_target });
+		emit32(0);
+	}
+};
+
+// Translates the bytecode of one function. Operands are resolved to their
+// final addresses at compile time since stack and constant layouts are fixed,
+// and every bytecode address gets a native label so jumps map one to one.
+class GDScriptJITCompiler {
+	typedef GDScriptJITAssembler Asm;
+
+	// Callee saved, so they survive the helper calls.
+	static constexpr Asm::Register CONTEXT = Asm::RBX;
+	static constexpr Asm::Register ADDRESS_BASES[GDScriptFunction::ADDR_TYPE_MAX] = { Asm::R12, Asm::R13, Asm::R14 };
+
+	const GDScriptFunction *function = nullptr;
+	Asm as;
+	LocalVector<int> native_offsets; ///< Native offset of each bytecode address, -1 inside instructions.
+	int max_member_index = -1;
+	int32_t payload_offset = 0;
+
+	bool _is_valid_address(int p_address) {
+		int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		int index = p_address & GDScriptFunction::ADDR_MASK;
+		switch (type) {
+			case GDScriptFunction::ADDR_TYPE_STACK:
+				return index < function->_stack_size;
+			case GDScriptFunction::ADDR_TYPE_CONSTANT:
+				return index < function->_constant_count;
+			case GDScriptFunction::ADDR_TYPE_MEMBER:
+				max_member_index = MAX(max_member_index, index);
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	bool _load_operand(Asm::Register p_dst, int p_address) {
+		if (!_is_valid_address(p_address)) {
+			return false;
+		}
+		int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		int index = p_address & GDScriptFunction::ADDR_MASK;
+		as.lea(p_dst, ADDRESS_BASES[type], index * (int)sizeof(Variant));
+		return true;
+	}
+
+	// Memory operand for the int, float or bool stored in a Variant.
+	bool _get_payload(int p_address, Asm::Register &r_base, int32_t &r_disp) {
+		if (!_is_valid_address(p_address)) {
+			return false;
+		}
+		int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+		int index = p_address & GDScriptFunction::ADDR_MASK;
+		r_base = ADDRESS_BASES[type];
+		r_disp = index * (int)sizeof(Variant) + payload_offset;
+		return true;
+	}
+
+	bool _compile_typed_operator(const int *p_instruction);
+
+	bool _check_instruction_args(const int *p_instruction) {
+		if (p_instruction[1] > function->_instruction_args_size) {
+			return false;
+		}
+		for (int i = 0; i < p_instruction[1]; i++) {
+			if (!_is_valid_address(p_instruction[2 + i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void _prologue() {
+		as.push(Asm::RBX);
+		as.push(Asm::R12);
+		as.push(Asm::R13);
+		as.push(Asm::R14);
+		as.push(Asm::R15); // Unused, keeps the stack 16 byte aligned for the calls.
+		as.mov(CONTEXT, Asm::RDI);
+		for (int i = 0; i < GDScriptFunction::ADDR_TYPE_MAX; i++) {
+			as.load64(ADDRESS_BASES[i], CONTEXT, offsetof(GDScriptJIT::Context, addresses) + i * sizeof(Variant *));
+		}
+	}
+
+	// Leaves the native code, the interpreter resumes at p_ip.
+	void _exit(int p_ip) {
+		as.mov_imm32(Asm::RAX, p_ip);
+		as.pop(Asm::R15);
+		as.pop(Asm::R14);
+		as.pop(Asm::R13);
+		as.pop(Asm::R12);
+		as.pop(Asm::RBX);
+		as.ret();
+	}
+
+	void _exit_if_false(int p_ip) {
+		as.test_al();
+		as.emit8(0x75); // jnz rel8 over the exit sequence.
+		as.emit8(0);
+		uint32_t exit_start = as.bytes.size();
+		_exit(p_ip);
+		as.bytes[exit_start - 1] = as.bytes.size() - exit_start;
+	}
+
+	bool _compile_instruction(int p_ip, int &r_size);
+
+public:
+	GDScriptJIT::Code *compile(const GDScriptFunction *p_function);
+};
+
+// Typed operators work on the payloads directly, the destination already has
+// the result type as for every validated operator.
+bool GDScriptJITCompiler::_compile_typed_operator(const int *p_instruction) {
+	Asm::Register a_base, b_base, dst_base;
+	int32_t a, b, dst;
+	if (!_get_payload(p_instruction[1], a_base, a) || !_get_payload(p_instruction[2], b_base, b) || !_get_payload(p_instruction[3], dst_base, dst)) {
+		return false;
+	}
+
+	switch (p_instruction[0]) {
+		case GDScriptFunction::OPCODE_OPERATOR_INT_ADD:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_SUBTRACT:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_MULTIPLY: {
+			as.load64(Asm::RAX, a_base, a);
+			if (p_instruction[0] == GDScriptFunction::OPCODE_OPERATOR_INT_MULTIPLY) {
+				as.imul64(Asm::RAX, b_base, b);
+			} else {
+				as.alu64(p_instruction[0] == GDScriptFunction::OPCODE_OPERATOR_INT_ADD ? Asm::ALU_ADD : Asm::ALU_SUB, Asm::RAX, b_base, b);
+			}
+			as.store64(dst_base, dst, Asm::RAX);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_NOT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_LESS:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL: {
+			static const Asm::Condition conditions[] = { Asm::COND_EQUAL, Asm::COND_NOT_EQUAL, Asm::COND_LESS, Asm::COND_LESS_EQUAL, Asm::COND_GREATER, Asm::COND_GREATER_EQUAL };
+			as.load64(Asm::RAX, a_base, a);
+			as.alu64(Asm::ALU_CMP, Asm::RAX, b_base, b);
+			as.setcc(conditions[p_instruction[0] - GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL], Asm::RAX);
+			as.store8(dst_base, dst, Asm::RAX);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_ADD:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_SUBTRACT:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_MULTIPLY:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_DIVIDE: {
+			static const Asm::SseOpcode operations[] = { Asm::SSE_ADD, Asm::SSE_SUB, Asm::SSE_MUL, Asm::SSE_DIV };
+			as.sse_sd(Asm::SSE_LOAD, a_base, a);
+			as.sse_sd(operations[p_instruction[0] - GDScriptFunction::OPCODE_OPERATOR_FLOAT_ADD], b_base, b);
+			as.sse_sd(Asm::SSE_STORE, dst_base, dst);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL: {
+			// Compared as "above" with the operands swapped for less, so NaN
+			// (unordered) yields false like in C++.
+			const bool less = p_instruction[0] == GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS || p_instruction[0] == GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL;
+			const bool or_equal = p_instruction[0] == GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL || p_instruction[0] == GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL;
+			if (less) {
+				as.sse_sd(Asm::SSE_LOAD, b_base, b);
+				as.ucomisd(a_base, a);
+			} else {
+				as.sse_sd(Asm::SSE_LOAD, a_base, a);
+				as.ucomisd(b_base, b);
+			}
+			as.setcc(or_equal ? Asm::COND_ABOVE_EQUAL : Asm::COND_ABOVE, Asm::RAX);
+			as.store8(dst_base, dst, Asm::RAX);
+		} break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+bool GDScriptJITCompiler::_compile_instruction(int p_ip, int &r_size) {
+	const int *code = function->_code_ptr;
+	const int *instr = &code[p_ip];
+	const int remaining = function->_code_size - p_ip;
+
+#define CHECK_SIZE(m_size)         \
+	if (remaining < (m_size)) {    \
+		return false;              \
+	}                              \
+	r_size = (m_size)
+
+#define LOAD_OPERAND(m_reg, m_idx)                       \
+	if (!_load_operand(Asm::m_reg, instr[1 + (m_idx)])) { \
+		return false;                                    \
+	}
+
+	switch (code[p_ip]) {
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_ASSIGN: {
+			// Fused instructions are compiled as their first half, the second
+			// half follows in the bytecode and gets its own translation.
+			CHECK_SIZE(5);
+			if (instr[4] < 0 || instr[4] >= function->_operator_funcs_count) {
+				return false;
+			}
+			LOAD_OPERAND(RDI, 0);
+			LOAD_OPERAND(RSI, 1);
+			LOAD_OPERAND(RDX, 2);
+			as.call((const void *)function->_operator_funcs_ptr[instr[4]]);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR: {
+			CHECK_SIZE(7 + (int)(sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(int)));
+			if (instr[4] < 0 || instr[4] >= Variant::OP_MAX) {
+				return false;
+			}
+			as.mov_imm64(Asm::RDI, (uint64_t)instr);
+			LOAD_OPERAND(RSI, 0);
+			LOAD_OPERAND(RDX, 1);
+			LOAD_OPERAND(RCX, 2);
+			as.call((const void *)_operator);
+			_exit_if_false(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_OPERATOR_INT_ADD:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_SUBTRACT:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_MULTIPLY:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_NOT_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_LESS:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER:
+		case GDScriptFunction::OPCODE_OPERATOR_INT_GREATER_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_ADD:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_SUBTRACT:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_MULTIPLY:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_DIVIDE:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_LESS_EQUAL:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER:
+		case GDScriptFunction::OPCODE_OPERATOR_FLOAT_GREATER_EQUAL: {
+			CHECK_SIZE(5);
+			if (!_compile_typed_operator(instr)) {
+				return false;
+			}
+		} break;
+		case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_KEYED_OPERATOR_VALIDATED: {
+			CHECK_SIZE(5);
+			if (instr[4] < 0 || instr[4] >= function->_keyed_getters_count) {
+				return false;
+			}
+			as.mov_imm64(Asm::RDI, (uint64_t)function->_keyed_getters_ptr[instr[4]]);
+			LOAD_OPERAND(RSI, 0);
+			LOAD_OPERAND(RDX, 1);
+			LOAD_OPERAND(RCX, 2);
+			as.call((const void *)_get_keyed);
+			_exit_if_false(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+			CHECK_SIZE(5);
+			if (instr[4] < 0 || instr[4] >= function->_keyed_setters_count) {
+				return false;
+			}
+			as.mov_imm64(Asm::RDI, (uint64_t)function->_keyed_setters_ptr[instr[4]]);
+			LOAD_OPERAND(RSI, 0);
+			LOAD_OPERAND(RDX, 1);
+			LOAD_OPERAND(RCX, 2);
+			as.call((const void *)_set_keyed);
+			_exit_if_false(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_INDEXED_OPERATOR_VALIDATED: {
+			CHECK_SIZE(5);
+			if (instr[4] < 0 || instr[4] >= function->_indexed_getters_count) {
+				return false;
+			}
+			as.mov_imm64(Asm::RDI, (uint64_t)function->_indexed_getters_ptr[instr[4]]);
+			LOAD_OPERAND(RSI, 0);
+			LOAD_OPERAND(RDX, 1);
+			LOAD_OPERAND(RCX, 2);
+			as.call((const void *)_get_indexed);
+			_exit_if_false(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+			CHECK_SIZE(5);
+			if (instr[4] < 0 || instr[4] >= function->_indexed_setters_count) {
+				return false;
+			}
+			as.mov_imm64(Asm::RDI, (uint64_t)function->_indexed_setters_ptr[instr[4]]);
+			LOAD_OPERAND(RSI, 0);
+			LOAD_OPERAND(RDX, 1);
+			LOAD_OPERAND(RCX, 2);
+			as.call((const void *)_set_indexed);
+			_exit_if_false(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN: {
+			CHECK_SIZE(3);
+			LOAD_OPERAND(RDI, 0);
+			LOAD_OPERAND(RSI, 1);
+			as.call((const void *)_assign);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN: {
+			CHECK_SIZE(4);
+			if (instr[3] < 0 || instr[3] >= Variant::VARIANT_MAX) {
+				return false;
+			}
+			LOAD_OPERAND(RDI, 0);
+			LOAD_OPERAND(RSI, 1);
+			as.mov_imm32(Asm::RDX, instr[3]);
+			as.call((const void *)_assign_typed_builtin);
+			_exit_if_false(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+			CHECK_SIZE(6);
+			if (!_is_valid_address(instr[1]) || !_is_valid_address(instr[2]) || !_is_valid_address(instr[3]) || instr[5] < 0 || instr[5] >= function->_global_names_count) {
+				return false;
+			}
+			as.mov(Asm::RDI, CONTEXT);
+			as.mov_imm64(Asm::RSI, (uint64_t)instr);
+			as.mov_imm64(Asm::RDX, (uint64_t)&function->_global_names_ptr[instr[5]]);
+			as.call((const void *)_assign_typed_array);
+			_exit_if_false(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_NULL: {
+			CHECK_SIZE(2);
+			LOAD_OPERAND(RDI, 0);
+			as.call((const void *)_assign_null);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE: {
+			CHECK_SIZE(2);
+			LOAD_OPERAND(RDI, 0);
+			as.call((const void *)_assign_true);
+		} break;
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE: {
+			CHECK_SIZE(2);
+			LOAD_OPERAND(RDI, 0);
+			as.call((const void *)_assign_false);
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+			if (remaining < 2 || instr[1] < 0) {
+				return false;
+			}
+			CHECK_SIZE(instr[1] + 4);
+			if (!_check_instruction_args(instr)) {
+				return false;
+			}
+			const int argc = instr[instr[1] + 2];
+			const int index = instr[instr[1] + 3];
+			// Base or return value sit right after the arguments.
+			const int needed_args = argc + (code[p_ip] == GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED || code[p_ip] == GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED ? 1 : 2);
+			if (argc < 0 || needed_args > instr[1] || index < 0) {
+				return false;
+			}
+
+			as.mov(Asm::RDI, CONTEXT);
+			as.mov_imm64(Asm::RSI, (uint64_t)instr);
+			switch (code[p_ip]) {
+				case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+					if (index >= function->_constructors_count) {
+						return false;
+					}
+					as.mov_imm64(Asm::RDX, (uint64_t)function->_constructors_ptr[index]);
+					as.call((const void *)_construct_validated);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+					if (index >= function->_builtin_methods_count) {
+						return false;
+					}
+					as.mov_imm64(Asm::RDX, (uint64_t)function->_builtin_methods_ptr[index]);
+					as.call((const void *)_call_builtin_type_validated);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+					if (index >= function->_utilities_count) {
+						return false;
+					}
+					as.mov_imm64(Asm::RDX, (uint64_t)function->_utilities_ptr[index]);
+					as.call((const void *)_call_utility_validated);
+				} break;
+				default: {
+					if (index >= function->_methods_count) {
+						return false;
+					}
+					as.mov_imm64(Asm::RDX, (uint64_t)function->_methods_ptr[index]);
+					as.call((const void *)_call_method_bind_validated);
+					_exit_if_false(p_ip);
+				} break;
+			}
+		} break;
+		case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+			if (remaining < 2 || instr[1] < 0) {
+				return false;
+			}
+			CHECK_SIZE(instr[1] + 5);
+			if (!_check_instruction_args(instr)) {
+				return false;
+			}
+			// Destination and element script type sit right after the elements.
+			const int argc = instr[instr[1] + 2];
+			const int native_type_idx = instr[instr[1] + 4];
+			if (argc < 0 || argc + 2 > instr[1] || native_type_idx < 0 || native_type_idx >= function->_global_names_count) {
+				return false;
+			}
+			as.mov(Asm::RDI, CONTEXT);
+			as.mov_imm64(Asm::RSI, (uint64_t)instr);
+			as.mov_imm64(Asm::RDX, (uint64_t)&function->_global_names_ptr[native_type_idx]);
+			as.call((const void *)_construct_typed_array);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_JUMP_ITERATE_RANGE: {
+			CHECK_SIZE(2);
+			as.jmp(instr[1]);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+			CHECK_SIZE(3);
+			LOAD_OPERAND(RDI, 0);
+			as.call((const void *)_booleanize);
+			as.test_al();
+			as.jcc(code[p_ip] == GDScriptFunction::OPCODE_JUMP_IF ? Asm::COND_NOT_EQUAL : Asm::COND_EQUAL, instr[2]);
+		} break;
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+			CHECK_SIZE(2);
+			as.load32(Asm::RAX, CONTEXT, offsetof(GDScriptJIT::Context, defarg));
+			for (int i = 0; i < function->default_arguments.size(); i++) {
+				as.cmp_imm32(Asm::RAX, i);
+				as.jcc(Asm::COND_EQUAL, function->_default_arg_ptr[i]);
+			}
+			_exit(p_ip);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_RANGE: {
+			CHECK_SIZE(7);
+			LOAD_OPERAND(RDI, 0);
+			LOAD_OPERAND(RSI, 1);
+			LOAD_OPERAND(RDX, 2);
+			LOAD_OPERAND(RCX, 3);
+			LOAD_OPERAND(R8, 4);
+			as.call((const void *)_iterate_begin_range);
+			as.test_al();
+			as.jcc(Asm::COND_EQUAL, instr[6]);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_RANGE: {
+			CHECK_SIZE(6);
+			LOAD_OPERAND(RDI, 0);
+			LOAD_OPERAND(RSI, 1);
+			LOAD_OPERAND(RDX, 2);
+			LOAD_OPERAND(RCX, 3);
+			as.call((const void *)_iterate_range);
+			as.test_al();
+			as.jcc(Asm::COND_EQUAL, instr[5]);
+		} break;
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+		case GDScriptFunction::OPCODE_ITERATE_INT:
+		case GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY:
+		case GDScriptFunction::OPCODE_ITERATE_ARRAY: {
+			CHECK_SIZE(5);
+			LOAD_OPERAND(RDI, 0);
+			LOAD_OPERAND(RSI, 1);
+			LOAD_OPERAND(RDX, 2);
+			switch (code[p_ip]) {
+				case GDScriptFunction::OPCODE_ITERATE_BEGIN_INT:
+					as.call((const void *)_iterate_begin_int);
+					break;
+				case GDScriptFunction::OPCODE_ITERATE_INT:
+					as.call((const void *)_iterate_int);
+					break;
+				case GDScriptFunction::OPCODE_ITERATE_BEGIN_ARRAY:
+					as.call((const void *)_iterate_begin_array);
+					break;
+				default:
+					as.call((const void *)_iterate_array);
+					break;
+			}
+			as.test_al();
+			as.jcc(Asm::COND_EQUAL, instr[4]);
+		} break;
+		case GDScriptFunction::OPCODE_LINE: {
+			CHECK_SIZE(2);
+			as.load64(Asm::RAX, CONTEXT, offsetof(GDScriptJIT::Context, line));
+			as.store32_imm(Asm::RAX, 0, instr[1]);
+
+			// Same as GDScriptSamplingProfiler::poll() in the interpreter, the call is only made while it runs.
+			static_assert(sizeof(std::atomic<bool>) == sizeof(bool), "The profiler flag is read as a single byte.");
+			as.mov_imm64(Asm::RAX, (uint64_t)GDScriptSamplingProfiler::get_running_flag());
+			as.cmp8_imm(Asm::RAX, 0, 0);
+			as.emit8(0x74); // je rel8 over the call.
+			as.emit8(0);
+			uint32_t call_start = as.bytes.size();
+			as.call((const void *)_poll_sampling_profiler);
+			as.bytes[call_start - 1] = as.bytes.size() - call_start;
+		} break;
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_END: {
+			// Let the interpreter handle the return value conversion and cleanup.
+			r_size = code[p_ip] == GDScriptFunction::OPCODE_END ? 1 : 2;
+			_exit(p_ip);
+		} break;
+		default: {
+			if (code[p_ip] >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && code[p_ip] <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+				CHECK_SIZE(2);
+				LOAD_OPERAND(RDI, 0);
+				as.call((const void *)type_adjust_funcs[code[p_ip] - GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL]);
+				break;
+			}
+			return false;
+		}
+	}
+
+#undef CHECK_SIZE
+#undef LOAD_OPERAND
+
+	return true;
+}
+
+GDScriptJIT::Code *GDScriptJITCompiler::compile(const GDScriptFunction *p_function) {
+	function = p_function;
+	{
+		Variant probe;
+		payload_offset = (uint8_t *)VariantInternal::get_int(&probe) - (uint8_t *)&probe;
+	}
+	native_offsets.resize(function->_code_size);
+	for (int &offset : native_offsets) {
+		offset = -1;
+	}
+
+	_prologue();
+
+	int ip = 0;
+	while (ip < function->_code_size) {
+		native_offsets[ip] = as.bytes.size();
+		int size = 0;
+		if (!_compile_instruction(ip, size)) {
+			return nullptr;
+		}
+		ip += size;
+	}
+
+	for (const Asm::Fixup &fixup : as.fixups) {
+		if (fixup.target < 0 || fixup.target >= function->_code_size || native_offsets[fixup.target] < 0) {
+			return nullptr;
+		}
+		int32_t rel = native_offsets[fixup.target] - (int32_t)(fixup.position + 4);
+		memcpy(&as.bytes[fixup.position], &rel, sizeof(int32_t));
+	}
+
+	void *memory = mmap(nullptr, as.bytes.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	ERR_FAIL_COND_V_MSG(memory == MAP_FAILED, nullptr, "Failed to allocate memory for GDScript native code.");
+	memcpy(memory, as.bytes.ptr(), as.bytes.size());
+	if (mprotect(memory, as.bytes.size(), PROT_READ | PROT_EXEC) != 0) {
+		munmap(memory, as.bytes.size());
+		ERR_FAIL_V_MSG(nullptr, "Failed to make GDScript native code executable.");
+	}
+
+	GDScriptJIT::Code *code = memnew(GDScriptJIT::Code);
+	code->entry = (GDScriptJIT::Entry)memory;
+	code->memory = memory;
+	code->size = as.bytes.size();
+	code->max_member_index = max_member_index;
+	return code;
+}
+
+GDScriptJIT::Code *GDScriptJIT::tier_up(GDScriptFunction *p_function) {
+	Code *code = p_function->jit_code.load(std::memory_order_acquire);
+	if (likely(code) || p_function->jit_state.load(std::memory_order_relaxed) != STATE_INTERPRETED) {
+		return code;
+	}
+	if (p_function->jit_counter.fetch_add(1, std::memory_order_relaxed) < tier_up_threshold) {
+		return nullptr;
+	}
+
+	// Only one caller compiles, the others keep interpreting meanwhile.
+	uint8_t expected = STATE_INTERPRETED;
+	if (!p_function->jit_state.compare_exchange_strong(expected, STATE_COMPILING, std::memory_order_acq_rel)) {
+		return nullptr;
+	}
+
+	code = compile(p_function);
+	if (code) {
+		p_function->jit_code.store(code, std::memory_order_release);
+	}
+	p_function->jit_state.store(code ? STATE_COMPILED : STATE_UNSUPPORTED, std::memory_order_release);
+	return code;
+}
+
+void GDScriptJIT::count_loop_iterations(GDScriptFunction *p_function, uint32_t p_iterations) {
+	if (p_function->jit_state.load(std::memory_order_relaxed) == STATE_INTERPRETED) {
+		p_function->jit_counter.fetch_add(p_iterations, std::memory_order_relaxed);
+	}
+}
+
+GDScriptJIT::Code *GDScriptJIT::compile(const GDScriptFunction *p_function) {
+	GDScriptJITCompiler compiler;
+	return compiler.compile(p_function);
+}
+
+void GDScriptJIT::free_code(Code *p_code) {
+	if (!p_code) {
+		return;
+	}
+	munmap(p_code->memory, p_code->size);
+	memdelete(p_code);
+}
+
+#endif // GDSCRIPT_JIT_ENABLED
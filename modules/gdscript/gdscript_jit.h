@@ -0,0 +1,103 @@
+/**************************************************************************/
+/*  gdscript_jit.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file gdscript_jit.h
+ *
+ * Second execution tier for GDScript. Functions that get called (or loop)
+ * often enough are translated from bytecode into native code which calls
+ * the same validated operator, getter, setter and method pointers the VM
+ * would, without the dispatch and operand decoding overhead. Anything the
+ * native code cannot handle is resumed by the interpreter.
+ */
+
+#include "core/typedefs.h"
+
+#include <atomic>
+
+#if defined(__linux__) && defined(__x86_64__)
+#define GDSCRIPT_JIT_ENABLED
+#endif
+
+class GDScriptFunction;
+class Variant;
+
+class GDScriptJIT {
+public:
+	enum State : uint8_t {
+		STATE_INTERPRETED, ///< Still counting calls and loop iterations.
+		STATE_COMPILING,
+		STATE_COMPILED,
+		STATE_UNSUPPORTED, ///< Uses opcodes the compiler can't translate, never retried.
+	};
+
+	/// Interpreter state shared with the native code of a single call.
+	struct Context {
+		Variant *addresses[3] = {}; ///< Stack, constants and members, indexed like GDScriptFunction::Address types.
+		Variant **instruction_args = nullptr;
+		int *line = nullptr;
+		int defarg = 0;
+	};
+
+	/// Runs the compiled function from the start and returns the address
+	/// the interpreter must continue at. That is always a return instruction
+	/// or an instruction that is about to fail, so the interpreter produces
+	/// the return value and error messages exactly as it would have.
+	typedef int (*Entry)(Context *p_context);
+
+	struct Code {
+		Entry entry = nullptr;
+		void *memory = nullptr;
+		size_t size = 0;
+		int max_member_index = -1; ///< Highest member accessed, checked against the instance before entering.
+	};
+
+private:
+	static bool enabled;
+	static uint32_t tier_up_threshold;
+
+public:
+	static void set_enabled(bool p_enabled) { enabled = p_enabled; }
+	_FORCE_INLINE_ static bool is_enabled() { return enabled; }
+	static void set_tier_up_threshold(uint32_t p_threshold) { tier_up_threshold = p_threshold; }
+	static uint32_t get_tier_up_threshold() { return tier_up_threshold; }
+
+	/// Counts a call to the function and returns its native code once it
+	/// became hot and was compiled successfully, nullptr otherwise.
+	static Code *tier_up(GDScriptFunction *p_function);
+	static void count_loop_iterations(GDScriptFunction *p_function, uint32_t p_iterations);
+
+	static Code *compile(const GDScriptFunction *p_function);
+	static void free_code(Code *p_code);
+};
@@ -42,6 +42,116 @@
 
 #include "core/templates/hashfuncs.h"
 
+// Captures live right after the callable, so creating a lambda costs a single allocation.
+// This is compatible with `memdelete()`, which is how `Callable` frees its custom.
+template <typename T>
+static constexpr size_t _get_captures_offset() {
+	return (sizeof(T) + alignof(Variant) - 1) & ~(alignof(Variant) - 1);
+}
+
+template <typename T>
+static Variant *_construct_captures(T *p_callable, int p_captures_count) {
+	Variant *captures = reinterpret_cast<Variant *>(reinterpret_cast<uint8_t *>(p_callable) + _get_captures_offset<T>());
+	for (int i = 0; i < p_captures_count; i++) {
+		memnew_placement(&captures[i], Variant);
+	}
+	return captures;
+}
+
+// Makes errors refer to the arguments given by the caller, which come after the captures.
+static void _adjust_call_error_for_captures(Callable::CallError &r_call_error, int p_captures_count) {
+	switch (r_call_error.error) {
+		case Callable::CallError::CALL_ERROR_INVALID_ARGUMENT:
+			r_call_error.argument -= p_captures_count;
+#ifdef DEBUG_ENABLED
+			if (r_call_error.argument < 0) {
+				ERR_PRINT(vformat("GDScript bug (please report): Invalid value of lambda capture at index %d.", p_captures_count + r_call_error.argument));
+				r_call_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD; /// @todo Add a more suitable error code.
+				r_call_error.argument = 0;
+				r_call_error.expected = 0;
+			}
+#endif
+			break;
+		case Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS:
+		case Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS:
+			r_call_error.expected -= p_captures_count;
+#ifdef DEBUG_ENABLED
+			if (r_call_error.expected < 0) {
+				ERR_PRINT("GDScript bug (please report): Invalid lambda captures count.");
+				r_call_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD; /// @todo Add a more suitable error code.
+				r_call_error.argument = 0;
+				r_call_error.expected = 0;
+			}
+#endif
+			break;
+		default:
+			break;
+	}
+}
+
+GDScriptLambdaRepeatedCall::GDScriptLambdaRepeatedCall(const GDScript::UpdatableFuncPtr &p_function, int p_argcount, const Variant *p_captures, int p_captures_count) :
+		function(p_function) {
+	argcount = p_argcount;
+	captures = p_captures;
+	captures_count = p_captures_count;
+
+	args.resize(p_captures_count + p_argcount);
+	for (int i = 0; i < p_captures_count; i++) {
+		args[i] = &p_captures[i];
+		if (p_captures[i].get_type() == Variant::OBJECT) {
+			object_captures.push_back(i);
+		}
+	}
+}
+
+void GDScriptLambdaRepeatedCall::call(const Variant **p_arguments, Variant &r_return_value, Callable::CallError &r_call_error) {
+	GDScriptInstance *instance = nullptr;
+	if (object) {
+		if (object_id.is_valid() && ObjectDB::get_instance(object_id) == nullptr) {
+			r_return_value = Variant();
+			r_call_error.error = Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL;
+			return;
+		}
+#ifdef DEBUG_ENABLED
+		if (object->get_script_instance() == nullptr || object->get_script_instance()->get_language() != GDScriptLanguage::get_singleton()) {
+			ERR_PRINT("Trying to call a lambda with an invalid instance.");
+			r_call_error.error = Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL;
+			return;
+		}
+#endif
+		instance = static_cast<GDScriptInstance *>(object->get_script_instance());
+	}
+
+	if (function == nullptr) {
+		r_return_value = Variant();
+		r_call_error.error = Callable::CallError::CALL_ERROR_INSTANCE_IS_NULL;
+		return;
+	}
+
+	if (captures_count == 0) {
+		r_return_value = function->call(instance, p_arguments, argcount, r_call_error);
+		return;
+	}
+
+	for (int index : object_captures) {
+		bool was_freed = false;
+		captures[index].get_validated_object_with_check(was_freed);
+		if (was_freed) {
+			ERR_PRINT(vformat(R"(Lambda capture at index %d was freed. Passed "null" instead.)", index));
+			static Variant nil;
+			args[index] = &nil;
+		} else {
+			args[index] = &captures[index];
+		}
+	}
+	for (int i = 0; i < argcount; i++) {
+		args[captures_count + i] = p_arguments[i];
+	}
+
+	r_return_value = function->call(instance, args.ptr(), args.size(), r_call_error);
+	_adjust_call_error_for_captures(r_call_error, captures_count);
+}
+
 bool GDScriptLambdaCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
 	// Lambda callables are only compared by reference.
 	return p_a == p_b;
@@ -94,11 +204,11 @@ int GDScriptLambdaCallable::get_argument_count(bool &r_is_valid) const {
 		return 0;
 	}
 	r_is_valid = true;
-	return function->get_argument_count() - captures.size();
+	return function->get_argument_count() - captures_count;
 }
 
 void GDScriptLambdaCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
-	int captures_amount = captures.size();
+	int captures_amount = captures_count;
 
 	if (function == nullptr) {
 		r_return_value = Variant();
@@ -126,48 +236,75 @@ void GDScriptLambdaCallable::call(const Variant **p_arguments, int p_argcount, V
 		}
 
 		r_return_value = function->call(nullptr, args, total_argcount, r_call_error);
-		switch (r_call_error.error) {
-			case Callable::CallError::CALL_ERROR_INVALID_ARGUMENT:
-				r_call_error.argument -= captures_amount;
-#ifdef DEBUG_ENABLED
-				if (r_call_error.argument < 0) {
-					ERR_PRINT(vformat("GDScript bug (please report): Invalid value of lambda capture at index %d.", captures_amount + r_call_error.argument));
-					r_call_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD; /// @todo Add a more suitable error code.
-					r_call_error.argument = 0;
-					r_call_error.expected = 0;
-				}
-#endif
-				break;
-			case Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS:
-			case Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS:
-				r_call_error.expected -= captures_amount;
-#ifdef DEBUG_ENABLED
-				if (r_call_error.expected < 0) {
-					ERR_PRINT("GDScript bug (please report): Invalid lambda captures count.");
-					r_call_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD; /// @todo Add a more suitable error code.
-					r_call_error.argument = 0;
-					r_call_error.expected = 0;
-				}
-#endif
-				break;
-			default:
-				break;
-		}
+		_adjust_call_error_for_captures(r_call_error, captures_amount);
 	} else {
 		r_return_value = function->call(nullptr, p_arguments, p_argcount, r_call_error);
 	}
 }
 
-GDScriptLambdaCallable::GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, const Vector<Variant> &p_captures) :
+CallableCustom::RepeatedCall *GDScriptLambdaCallable::create_repeated_call(int p_argcount) const {
+	if (!GDScriptLambdaRepeatedCall::enabled) {
+		return nullptr;
+	}
+	return memnew(GDScriptLambdaRepeatedCall(function, p_argcount, captures, captures_count));
+}
+
+GDScriptLambdaCallable::GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, int p_captures_count) :
 		function(p_function) {
+	captures_count = p_captures_count;
+	captures = _construct_captures(this, p_captures_count);
+
 	ERR_FAIL_COND(p_script.is_null());
 	ERR_FAIL_NULL(p_function);
 	script = p_script;
-	captures = p_captures;
 
 	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
 }
 
+GDScriptLambdaCallable::~GDScriptLambdaCallable() {
+	for (int i = 0; i < captures_count; i++) {
+		captures[i].~Variant();
+	}
+}
+
+GDScriptLambdaCallable *GDScriptLambdaCallable::create(Ref<GDScript> p_script, GDScriptFunction *p_function, int p_captures_count) {
+	ERR_FAIL_COND_V(p_captures_count < 0, nullptr);
+	void *memory = Memory::alloc_static(_get_captures_offset<GDScriptLambdaCallable>() + sizeof(Variant) * p_captures_count);
+	ERR_FAIL_NULL_V(memory, nullptr);
+	return memnew_placement(memory, GDScriptLambdaCallable(p_script, p_function, p_captures_count));
+}
+
+Callable GDScriptLambdaCallable::get_reusable(GDScript *p_script, GDScriptFunction *p_function) {
+	Callable callable;
+
+	p_function->reusable_callable_lock.lock();
+	const Callable &reusable = p_function->reusable_callable;
+	// When only the cache references the previous callable, nothing can tell it apart from a new one.
+	if (reusable.is_custom() && reusable.get_custom()->get_reference_count() == 1 && static_cast<GDScriptLambdaCallable *>(reusable.get_custom())->function == p_function) {
+		callable = reusable;
+	}
+	p_function->reusable_callable_lock.unlock();
+
+	if (callable.is_null()) {
+		callable = Callable(create(Ref<GDScript>(p_script), p_function, 0));
+
+		// The cached callable keeps the script alive. Only cache it for scripts held by GDScriptCache,
+		// which releases it when the script is removed, see GDScript::release_reusable_callables().
+		const String path = p_script->get_root_script()->get_path();
+		if (path.is_empty() || path.contains("::")) {
+			return callable;
+		}
+
+		Callable previous; // Released outside of the lock.
+		p_function->reusable_callable_lock.lock();
+		previous = p_function->reusable_callable;
+		p_function->reusable_callable = callable;
+		p_function->reusable_callable_lock.unlock();
+	}
+
+	return callable;
+}
+
 bool GDScriptLambdaSelfCallable::compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) {
 	// Lambda callables are only compared by reference.
 	return p_a == p_b;
@@ -218,7 +355,7 @@ int GDScriptLambdaSelfCallable::get_argument_count(bool &r_is_valid) const {
 		return 0;
 	}
 	r_is_valid = true;
-	return function->get_argument_count() - captures.size();
+	return function->get_argument_count() - captures_count;
 }
 
 void GDScriptLambdaSelfCallable::call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const {
@@ -230,7 +367,7 @@ void GDScriptLambdaSelfCallable::call(const Variant **p_arguments, int p_argcoun
 	}
 #endif
 
-	int captures_amount = captures.size();
+	int captures_amount = captures_count;
 
 	if (function == nullptr) {
 		r_return_value = Variant();
@@ -258,55 +395,80 @@ void GDScriptLambdaSelfCallable::call(const Variant **p_arguments, int p_argcoun
 		}
 
 		r_return_value = function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), args, total_argcount, r_call_error);
-		switch (r_call_error.error) {
-			case Callable::CallError::CALL_ERROR_INVALID_ARGUMENT:
-				r_call_error.argument -= captures_amount;
-#ifdef DEBUG_ENABLED
-				if (r_call_error.argument < 0) {
-					ERR_PRINT(vformat("GDScript bug (please report): Invalid value of lambda capture at index %d.", captures_amount + r_call_error.argument));
-					r_call_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD; /// @todo Add a more suitable error code.
-					r_call_error.argument = 0;
-					r_call_error.expected = 0;
-				}
-#endif
-				break;
-			case Callable::CallError::CALL_ERROR_TOO_MANY_ARGUMENTS:
-			case Callable::CallError::CALL_ERROR_TOO_FEW_ARGUMENTS:
-				r_call_error.expected -= captures_amount;
-#ifdef DEBUG_ENABLED
-				if (r_call_error.expected < 0) {
-					ERR_PRINT("GDScript bug (please report): Invalid lambda captures count.");
-					r_call_error.error = Callable::CallError::CALL_ERROR_INVALID_METHOD; /// @todo Add a more suitable error code.
-					r_call_error.argument = 0;
-					r_call_error.expected = 0;
-				}
-#endif
-				break;
-			default:
-				break;
-		}
+		_adjust_call_error_for_captures(r_call_error, captures_amount);
 	} else {
 		r_return_value = function->call(static_cast<GDScriptInstance *>(object->get_script_instance()), p_arguments, p_argcount, r_call_error);
 	}
 }
 
-GDScriptLambdaSelfCallable::GDScriptLambdaSelfCallable(Ref<RefCounted> p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures) :
-		function(p_function) {
-	ERR_FAIL_COND(p_self.is_null());
-	ERR_FAIL_NULL(p_function);
-	reference = p_self;
-	object = p_self.ptr();
-	captures = p_captures;
-
-	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
+CallableCustom::RepeatedCall *GDScriptLambdaSelfCallable::create_repeated_call(int p_argcount) const {
+	if (!GDScriptLambdaRepeatedCall::enabled) {
+		return nullptr;
+	}
+	GDScriptLambdaRepeatedCall *repeated_call = memnew(GDScriptLambdaRepeatedCall(function, p_argcount, captures, captures_count));
+	repeated_call->object = object;
+	if (reference.is_null()) {
+		repeated_call->object_id = object->get_instance_id();
+	}
+	return repeated_call;
 }
 
-GDScriptLambdaSelfCallable::GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures) :
+GDScriptLambdaSelfCallable::GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, int p_captures_count) :
 		function(p_function) {
+	captures_count = p_captures_count;
+	captures = _construct_captures(this, p_captures_count);
+
 	ERR_FAIL_NULL(p_self);
 	ERR_FAIL_NULL(p_function);
+	if (p_self->is_ref_counted()) {
+		reference = Ref<RefCounted>(Object::cast_to<RefCounted>(p_self));
+	}
 	object = p_self;
-	captures = p_captures;
 
 	h = (uint32_t)hash_murmur3_one_64((uint64_t)this);
 }
+
+GDScriptLambdaSelfCallable::~GDScriptLambdaSelfCallable() {
+	for (int i = 0; i < captures_count; i++) {
+		captures[i].~Variant();
+	}
+}
+
+GDScriptLambdaSelfCallable *GDScriptLambdaSelfCallable::create(Object *p_self, GDScriptFunction *p_function, int p_captures_count) {
+	ERR_FAIL_COND_V(p_captures_count < 0, nullptr);
+	void *memory = Memory::alloc_static(_get_captures_offset<GDScriptLambdaSelfCallable>() + sizeof(Variant) * p_captures_count);
+	ERR_FAIL_NULL_V(memory, nullptr);
+	return memnew_placement(memory, GDScriptLambdaSelfCallable(p_self, p_function, p_captures_count));
+}
+
+Callable GDScriptLambdaSelfCallable::get_reusable(Object *p_self, GDScriptFunction *p_function) {
+	if (p_self->is_ref_counted()) {
+		// A cached callable would keep the object alive.
+		return Callable(create(p_self, p_function, 0));
+	}
+
+	Callable callable;
+
+	p_function->reusable_callable_lock.lock();
+	const Callable &reusable = p_function->reusable_callable;
+	// When only the cache references the previous callable, nothing can tell it apart from a new one.
+	if (reusable.is_custom() && reusable.get_custom()->get_reference_count() == 1) {
+		const GDScriptLambdaSelfCallable *previous = static_cast<const GDScriptLambdaSelfCallable *>(reusable.get_custom());
+		if (previous->object == p_self && previous->function == p_function) {
+			callable = reusable;
+		}
+	}
+	p_function->reusable_callable_lock.unlock();
+
+	if (callable.is_null()) {
+		callable = Callable(create(p_self, p_function, 0));
+
+		Callable previous; // Released outside of the lock.
+		p_function->reusable_callable_lock.lock();
+		previous = p_function->reusable_callable;
+		p_function->reusable_callable = callable;
+		p_function->reusable_callable_lock.unlock();
+	}
+
+	return callable;
+}
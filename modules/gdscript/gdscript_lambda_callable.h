@@ -41,6 +41,7 @@
 #include "gdscript.h"
 
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/variant.h"
@@ -48,16 +49,45 @@
 class GDScriptFunction;
 class GDScriptInstance;
 
+/// Calls a lambda many times in a row, e.g. from `Array::map()`, resolving the captures and `self` only once.
+class GDScriptLambdaRepeatedCall : public CallableCustom::RepeatedCall {
+	friend class GDScriptLambdaCallable;
+	friend class GDScriptLambdaSelfCallable;
+
+	const GDScript::UpdatableFuncPtr &function;
+	Object *object = nullptr; // For self lambdas.
+	ObjectID object_id; // Checked before each call when the callable doesn't keep `object` alive.
+	int argcount = 0;
+	int captures_count = 0;
+	const Variant *captures = nullptr;
+	LocalVector<int> object_captures; // Captured objects may be freed between calls.
+	LocalVector<const Variant *> args; // Captures first, then the arguments.
+
+	GDScriptLambdaRepeatedCall(const GDScript::UpdatableFuncPtr &p_function, int p_argcount, const Variant *p_captures, int p_captures_count);
+
+public:
+#ifdef TESTS_ENABLED
+	static inline bool enabled = true; ///< Only meant to be turned off by benchmarks.
+#else
+	static constexpr bool enabled = true;
+#endif
+
+	void call(const Variant **p_arguments, Variant &r_return_value, Callable::CallError &r_call_error) override;
+};
+
 class GDScriptLambdaCallable : public CallableCustom {
 	GDScript::UpdatableFuncPtr function;
 	Ref<GDScript> script;
 	uint32_t h;
 
-	Vector<Variant> captures;
+	int captures_count = 0;
+	Variant *captures = nullptr; // Stored right after the callable, in the same allocation.
 
 	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
 	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
 
+	GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, int p_captures_count);
+
 public:
 	bool is_valid() const override;
 	uint32_t hash() const override;
@@ -68,11 +98,19 @@ public:
 	StringName get_method() const override;
 	int get_argument_count(bool &r_is_valid) const override;
 	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
+	RepeatedCall *create_repeated_call(int p_argcount) const override;
+
+	/// Captures to be filled by the caller after create().
+	_FORCE_INLINE_ Variant *get_captures() { return captures; }
+
+	/// Allocates the callable and its `p_captures_count` (null) captures in a single block. Freed by `memdelete()` as usual.
+	static GDScriptLambdaCallable *create(Ref<GDScript> p_script, GDScriptFunction *p_function, int p_captures_count);
+	/// Returns a callable for a lambda without captures, reusing the previous one if it's no longer referenced anywhere else.
+	static Callable get_reusable(GDScript *p_script, GDScriptFunction *p_function);
 
 	GDScriptLambdaCallable(GDScriptLambdaCallable &) = delete;
 	GDScriptLambdaCallable(const GDScriptLambdaCallable &) = delete;
-	GDScriptLambdaCallable(Ref<GDScript> p_script, GDScriptFunction *p_function, const Vector<Variant> &p_captures);
-	virtual ~GDScriptLambdaCallable() = default;
+	virtual ~GDScriptLambdaCallable();
 };
 
 /// Lambda callable that references a particular object, so it can use `self` in the body.
@@ -82,11 +120,14 @@ class GDScriptLambdaSelfCallable : public CallableCustom {
 	Object *object = nullptr; // For non RefCounted objects, use a direct pointer.
 	uint32_t h;
 
-	Vector<Variant> captures;
+	int captures_count = 0;
+	Variant *captures = nullptr; // Stored right after the callable, in the same allocation.
 
 	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b);
 	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b);
 
+	GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, int p_captures_count);
+
 public:
 	bool is_valid() const override;
 	uint32_t hash() const override;
@@ -97,10 +138,18 @@ public:
 	StringName get_method() const override;
 	int get_argument_count(bool &r_is_valid) const override;
 	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override;
+	RepeatedCall *create_repeated_call(int p_argcount) const override;
+
+	/// Captures to be filled by the caller after create().
+	_FORCE_INLINE_ Variant *get_captures() { return captures; }
+
+	/// Allocates the callable and its `p_captures_count` (null) captures in a single block. Freed by `memdelete()` as usual.
+	static GDScriptLambdaSelfCallable *create(Object *p_self, GDScriptFunction *p_function, int p_captures_count);
+	/// Returns a callable for a lambda without captures, reusing the previous one if it's no longer referenced anywhere else.
+	/// Only non-RefCounted objects are reused, since the cache must not keep `p_self` alive.
+	static Callable get_reusable(Object *p_self, GDScriptFunction *p_function);
 
 	GDScriptLambdaSelfCallable(GDScriptLambdaSelfCallable &) = delete;
 	GDScriptLambdaSelfCallable(const GDScriptLambdaSelfCallable &) = delete;
-	GDScriptLambdaSelfCallable(Ref<RefCounted> p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures);
-	GDScriptLambdaSelfCallable(Object *p_self, GDScriptFunction *p_function, const Vector<Variant> &p_captures);
-	virtual ~GDScriptLambdaSelfCallable() = default;
+	virtual ~GDScriptLambdaSelfCallable();
 };
@@ -397,6 +397,7 @@ Error GDScriptParser::parse(const String &p_source_code, const String &p_script_
 	tokenizer = text_tokenizer;
 
 	tokenizer->set_cursor_position(cursor_line, cursor_column);
+	completion_cursor_line = cursor_line;
 	script_path = p_script_path.simplify_path();
 	current = tokenizer->scan();
 	// Avoid error or newline as the first token.
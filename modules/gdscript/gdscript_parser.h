@@ -1345,6 +1345,7 @@ private:
 	bool _is_tool = false;
 	String script_path;
 	bool for_completion = false;
+	int completion_cursor_line = -1;
 	bool parse_body = true;
 	bool panic_mode = false;
 	bool can_break = false;
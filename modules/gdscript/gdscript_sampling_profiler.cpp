@@ -0,0 +1,234 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_sampling_profiler.h"
+
+#include "gdscript.h"
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "core/templates/hashfuncs.h"
+
+uint32_t GDScriptSamplingProfiler::Frame::hash(const Frame &p_frame) {
+	uint32_t h = hash_murmur3_one_32(p_frame.parent);
+	h = hash_murmur3_one_32(p_frame.function.hash(), h);
+	h = hash_murmur3_one_32(p_frame.source.hash(), h);
+	h = hash_murmur3_one_32(p_frame.line, h);
+	return hash_fmix32(h);
+}
+
+bool GDScriptSamplingProfiler::Frame::compare(const Frame &p_a, const Frame &p_b) {
+	return p_a.parent == p_b.parent && p_a.line == p_b.line && p_a.function == p_b.function && p_a.source == p_b.source;
+}
+
+void GDScriptSamplingProfiler::_timer_thread_func(void *p_userdata) {
+	Thread::set_name("GDScript Sampling Profiler");
+	while (!timer_exit.load(std::memory_order_acquire)) {
+		OS::get_singleton()->delay_usec(interval_usec);
+		sample_epoch.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+uint32_t GDScriptSamplingProfiler::_get_frame(uint32_t p_parent, const StringName &p_function, const StringName &p_source, int p_line) {
+	Frame key;
+	key.parent = p_parent;
+	key.function = p_function;
+	key.source = p_source;
+	key.line = p_line;
+
+	HashMap<Frame, uint32_t, Frame, Frame>::Iterator E = frame_indices.find(key);
+	if (E) {
+		return E->value;
+	}
+	const uint32_t index = frames.size();
+	frames.push_back(key);
+	frame_indices.insert(key, index);
+	return index;
+}
+
+String GDScriptSamplingProfiler::_get_frame_name(const Frame &p_frame) {
+	String function = p_frame.function;
+	if (function.is_empty()) {
+		function = "<anonymous>";
+	}
+	String source = p_frame.source;
+	if (source.is_empty()) {
+		source = "<built-in>";
+	}
+	return vformat("%s (%s:%d)", function, source, p_frame.line);
+}
+
+void GDScriptSamplingProfiler::_sample() {
+	thread_epoch = sample_epoch.load(std::memory_order_relaxed);
+
+	// The call stack is a thread local list of levels living on the C++
+	// stack, so only the thread itself can safely walk it.
+	static thread_local LocalVector<const GDScriptLanguage::CallLevel *> levels;
+	levels.clear();
+	for (const GDScriptLanguage::CallLevel *level = GDScriptLanguage::_call_stack; level; level = level->prev) {
+		levels.push_back(level);
+	}
+	if (levels.is_empty()) {
+		return;
+	}
+
+	const uint64_t time = OS::get_singleton()->get_ticks_usec();
+
+	MutexLock lock(mutex);
+	if (!running.load(std::memory_order_relaxed)) {
+		return;
+	}
+
+	uint32_t frame = NO_PARENT;
+	for (uint32_t i = levels.size(); i > 0; i--) {
+		const GDScriptLanguage::CallLevel *level = levels[i - 1];
+		if (level->function == nullptr) {
+			continue;
+		}
+		frame = _get_frame(frame, level->function->get_name(), level->function->get_source(), *level->line);
+	}
+	if (frame == NO_PARENT) {
+		return;
+	}
+
+	frames[frame].self_samples++;
+	sample_count++;
+	if (samples.size() < MAX_TRACE_SAMPLES) {
+		Sample sample;
+		sample.time = time - start_time;
+		sample.thread = Thread::get_caller_id();
+		sample.frame = frame;
+		samples.push_back(sample);
+	}
+}
+
+Error GDScriptSamplingProfiler::_save_collapsed(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot open "%s" to save GDScript samples.)", p_path));
+
+	// One line per distinct stack, root first: "a (res://a.gd:3);b (res://b.gd:7) 42".
+	for (uint32_t i = 0; i < frames.size(); i++) {
+		if (frames[i].self_samples == 0) {
+			continue;
+		}
+		String stack;
+		for (uint32_t frame = i; frame != NO_PARENT; frame = frames[frame].parent) {
+			const String name = _get_frame_name(frames[frame]).replace(";", ":");
+			stack = stack.is_empty() ? name : name + ";" + stack;
+		}
+		f->store_line(vformat("%s %d", stack, frames[i].self_samples));
+	}
+	return OK;
+}
+
+Error GDScriptSamplingProfiler::_save_chrome_trace(const String &p_path) {
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat(R"(Cannot open "%s" to save GDScript samples.)", p_path));
+
+	// Trace Event Format with the stack frames and samples sections, as read
+	// by chrome://tracing and Perfetto.
+	f->store_string("{\"traceEvents\":[],\n\"stackFrames\":{");
+	for (uint32_t i = 0; i < frames.size(); i++) {
+		String entry = vformat("%s\n\"%d\":{\"category\":\"gdscript\",\"name\":\"%s\"", i > 0 ? "," : "", i, _get_frame_name(frames[i]).json_escape());
+		if (frames[i].parent != NO_PARENT) {
+			entry += vformat(",\"parent\":\"%d\"", frames[i].parent);
+		}
+		f->store_string(entry + "}");
+	}
+	f->store_string("},\n\"samples\":[");
+	for (uint32_t i = 0; i < samples.size(); i++) {
+		const Sample &sample = samples[i];
+		f->store_string(vformat("%s\n{\"cpu\":0,\"tid\":%d,\"ts\":%d,\"name\":\"gdscript\",\"sf\":\"%d\",\"weight\":1}", i > 0 ? "," : "", sample.thread, sample.time, sample.frame));
+	}
+	f->store_string("]}\n");
+
+	if (sample_count > samples.size()) {
+		WARN_PRINT(vformat("Only the first %d of %d GDScript samples were saved to the trace.", samples.size(), sample_count));
+	}
+	return OK;
+}
+
+void GDScriptSamplingProfiler::request(const String &p_path, uint32_t p_interval_usec) {
+	requested_path = p_path;
+	interval_usec = p_interval_usec;
+}
+
+void GDScriptSamplingProfiler::start(uint32_t p_interval_usec) {
+#ifdef THREADS_ENABLED
+	ERR_FAIL_COND_MSG(is_running(), "The GDScript sampling profiler is already running.");
+	ERR_FAIL_COND(p_interval_usec == 0);
+
+	GDScriptLanguage::get_singleton()->track_call_stack = true;
+
+	interval_usec = p_interval_usec;
+	start_time = OS::get_singleton()->get_ticks_usec();
+	running.store(true, std::memory_order_relaxed);
+	timer_exit.store(false, std::memory_order_release);
+	timer_thread.start(_timer_thread_func, nullptr);
+#else
+	WARN_PRINT("The GDScript sampling profiler needs threads, which are disabled in this build.");
+#endif
+}
+
+void GDScriptSamplingProfiler::stop() {
+	if (!is_running()) {
+		return;
+	}
+	timer_exit.store(true, std::memory_order_release);
+	timer_thread.wait_to_finish();
+
+	MutexLock lock(mutex);
+	running.store(false, std::memory_order_relaxed);
+}
+
+void GDScriptSamplingProfiler::clear() {
+	MutexLock lock(mutex);
+	frames.reset();
+	frame_indices.clear();
+	samples.reset();
+	sample_count = 0;
+}
+
+Error GDScriptSamplingProfiler::save(const String &p_path) {
+	MutexLock lock(mutex);
+	if (p_path.get_extension().to_lower() == "json") {
+		return _save_chrome_trace(p_path);
+	}
+	return _save_collapsed(p_path);
+}
+
+uint64_t GDScriptSamplingProfiler::get_sample_count() {
+	MutexLock lock(mutex);
+	return sample_count;
+}
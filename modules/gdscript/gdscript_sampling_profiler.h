@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  gdscript_sampling_profiler.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+/**
+ * @file gdscript_sampling_profiler.h
+ *
+ * Low overhead alternative to the instrumenting script profiler. A timer
+ * thread periodically requests a sample, and each thread running GDScript
+ * records its own call stack (functions and lines) the next time it
+ * executes an OPCODE_LINE. Samples are aggregated into a tree of frames and
+ * exported as collapsed stacks (for flame graphs) or as a Chrome trace.
+ */
+
+#include "core/os/mutex.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+
+#include <atomic>
+
+class GDScriptSamplingProfiler {
+	static constexpr uint32_t NO_PARENT = UINT32_MAX;
+	static constexpr uint32_t MAX_TRACE_SAMPLES = 1 << 20; ///< Beyond this, samples are only counted in the collapsed stacks.
+
+	struct Frame {
+		uint32_t parent = NO_PARENT;
+		StringName function;
+		StringName source;
+		int line = 0;
+		uint64_t self_samples = 0;
+
+		static uint32_t hash(const Frame &p_frame);
+		static bool compare(const Frame &p_a, const Frame &p_b);
+	};
+
+	struct Sample {
+		uint64_t time = 0; ///< Microseconds since the profiler started.
+		uint64_t thread = 0;
+		uint32_t frame = 0;
+	};
+
+	static inline std::atomic<bool> running = { false };
+	static inline std::atomic<uint32_t> sample_epoch = { 0 };
+	static inline thread_local uint32_t thread_epoch = 0;
+
+	static inline String requested_path;
+	static inline uint32_t interval_usec = 1000;
+
+	static inline Thread timer_thread;
+	static inline std::atomic<bool> timer_exit = { false };
+	static inline uint64_t start_time = 0;
+
+	static inline Mutex mutex;
+	static inline LocalVector<Frame> frames;
+	static inline HashMap<Frame, uint32_t, Frame, Frame> frame_indices;
+	static inline LocalVector<Sample> samples;
+	static inline uint64_t sample_count = 0;
+
+	static void _timer_thread_func(void *p_userdata);
+	static uint32_t _get_frame(uint32_t p_parent, const StringName &p_function, const StringName &p_source, int p_line);
+	static String _get_frame_name(const Frame &p_frame);
+	static void _sample();
+
+	static Error _save_collapsed(const String &p_path);
+	static Error _save_chrome_trace(const String &p_path);
+
+public:
+	/// Makes the GDScriptLanguage constructor start the profiler and GDScriptLanguage::finish() save to `p_path`.
+	/// Used by the `--gdscript-sample-profile` command line option.
+	static void request(const String &p_path, uint32_t p_interval_usec);
+	static String get_requested_path() { return requested_path; }
+	static uint32_t get_requested_interval() { return interval_usec; }
+
+	/// Starts sampling. Call stack tracking is turned on if needed, so this
+	/// must happen before any GDScript function starts running.
+	static void start(uint32_t p_interval_usec);
+	static void stop();
+	static bool is_running() { return running.load(std::memory_order_relaxed); }
+	/// Flag checked by poll(), read directly by the native code of GDScriptJIT.
+	static const std::atomic<bool> *get_running_flag() { return &running; }
+	static void clear();
+
+	/// Chrome trace (JSON) when `p_path` ends in `.json`, collapsed stacks otherwise.
+	static Error save(const String &p_path);
+	static uint64_t get_sample_count();
+
+	/// Called by OPCODE_LINE, so it must stay cheap when no sample is pending.
+	_FORCE_INLINE_ static void poll() {
+		if (unlikely(running.load(std::memory_order_relaxed) && sample_epoch.load(std::memory_order_relaxed) != thread_epoch)) {
+			_sample();
+		}
+	}
+};
@@ -39,6 +39,7 @@
 #include "gdscript.h"
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
+#include "gdscript_sampling_profiler.h"
 
 #include "core/os/os.h"
 
@@ -414,6 +415,28 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,       \
 		&&OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,         \
 		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,       \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_OPERATOR_VALIDATED_ASSIGN,              \
+		&&OPCODE_GET_KEYED_OPERATOR_VALIDATED,           \
+		&&OPCODE_GET_INDEXED_OPERATOR_VALIDATED,         \
+		&&OPCODE_JUMP_ITERATE_RANGE,                     \
+		&&OPCODE_OPERATOR_INT_ADD,                       \
+		&&OPCODE_OPERATOR_INT_SUBTRACT,                  \
+		&&OPCODE_OPERATOR_INT_MULTIPLY,                  \
+		&&OPCODE_OPERATOR_INT_EQUAL,                     \
+		&&OPCODE_OPERATOR_INT_NOT_EQUAL,                 \
+		&&OPCODE_OPERATOR_INT_LESS,                      \
+		&&OPCODE_OPERATOR_INT_LESS_EQUAL,                \
+		&&OPCODE_OPERATOR_INT_GREATER,                   \
+		&&OPCODE_OPERATOR_INT_GREATER_EQUAL,             \
+		&&OPCODE_OPERATOR_FLOAT_ADD,                     \
+		&&OPCODE_OPERATOR_FLOAT_SUBTRACT,                \
+		&&OPCODE_OPERATOR_FLOAT_MULTIPLY,                \
+		&&OPCODE_OPERATOR_FLOAT_DIVIDE,                  \
+		&&OPCODE_OPERATOR_FLOAT_LESS,                    \
+		&&OPCODE_OPERATOR_FLOAT_LESS_EQUAL,              \
+		&&OPCODE_OPERATOR_FLOAT_GREATER,                 \
+		&&OPCODE_OPERATOR_FLOAT_GREATER_EQUAL,           \
 		&&OPCODE_ASSERT,                                 \
 		&&OPCODE_BREAKPOINT,                             \
 		&&OPCODE_LINE,                                   \
@@ -745,6 +768,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	uint32_t jit_loop_iterations = 0;
+	if (GDScriptJIT::is_enabled() && !p_state && !EngineDebugger::is_active()) {
+		// Native code neither times native calls nor stops at breakpoints.
+#ifdef DEBUG_ENABLED
+		GDScriptJIT::Code *jit_code = GDScriptLanguage::get_singleton()->profiling ? nullptr : GDScriptJIT::tier_up(this);
+#else
+		GDScriptJIT::Code *jit_code = GDScriptJIT::tier_up(this);
+#endif
+		if (jit_code && jit_code->max_member_index < (p_instance ? (int)p_instance->members.size() : 0)) {
+			// Runs up to the first return or failing instruction, which the
+			// loop below then executes as usual.
+			GDScriptJIT::Context jit_context;
+			for (int i = 0; i < ADDR_TYPE_MAX; i++) {
+				jit_context.addresses[i] = variant_addresses[i];
+			}
+			jit_context.instruction_args = instruction_args;
+			jit_context.line = &line;
+			jit_context.defarg = defarg;
+			ip = jit_code->entry(&jit_context);
+		}
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -1201,7 +1248,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1211,8 +1258,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_idx];
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				cache->set_named(*dst, *index, *value, valid);
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1233,7 +1284,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1253,7 +1304,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1263,13 +1314,17 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int cache_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_idx];
+
 				bool valid;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret = cache->get_named(*src, *index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+				*dst = cache->get_named(*src, *index, valid);
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1278,7 +1333,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1897,7 +1952,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1908,6 +1963,10 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int cache_idx = _code_ptr[ip + 3];
+				GD_ERR_BREAK(cache_idx < 0 || cache_idx >= _inline_caches_count);
+				GDScriptInlineCache *cache = &_inline_caches_ptr[cache_idx];
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1926,7 +1985,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					cache->callp(*base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1956,7 +2015,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					}
 #endif
 				} else {
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					cache->callp(*base, *methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
 
@@ -2011,7 +2070,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2656,17 +2715,18 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
 				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
 
-				Vector<Variant> captures;
-				captures.resize(captures_count);
-				for (int i = 0; i < captures_count; i++) {
-					GET_INSTRUCTION_ARG(arg, i);
-					captures.write[i] = *arg;
-				}
-
-				GDScriptLambdaCallable *callable = memnew(GDScriptLambdaCallable(Ref<GDScript>(script), lambda, captures));
-
 				GET_INSTRUCTION_ARG(result, captures_count);
-				*result = Callable(callable);
+				if (captures_count == 0) {
+					*result = GDScriptLambdaCallable::get_reusable(script, lambda);
+				} else {
+					GDScriptLambdaCallable *callable = GDScriptLambdaCallable::create(Ref<GDScript>(script), lambda, captures_count);
+					Variant *captures = callable->get_captures();
+					for (int i = 0; i < captures_count; i++) {
+						GET_INSTRUCTION_ARG(arg, i);
+						captures[i] = *arg;
+					}
+					*result = Callable(callable);
+				}
 
 				ip += 3;
 			}
@@ -2687,23 +2747,19 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(lambda_index < 0 || lambda_index >= _lambdas_count);
 				GDScriptFunction *lambda = _lambdas_ptr[lambda_index];
 
-				Vector<Variant> captures;
-				captures.resize(captures_count);
-				for (int i = 0; i < captures_count; i++) {
-					GET_INSTRUCTION_ARG(arg, i);
-					captures.write[i] = *arg;
-				}
-
-				GDScriptLambdaSelfCallable *callable;
-				if (Object::cast_to<RefCounted>(p_instance->owner)) {
-					callable = memnew(GDScriptLambdaSelfCallable(Ref<RefCounted>(Object::cast_to<RefCounted>(p_instance->owner)), lambda, captures));
+				GET_INSTRUCTION_ARG(result, captures_count);
+				if (captures_count == 0) {
+					*result = GDScriptLambdaSelfCallable::get_reusable(p_instance->owner, lambda);
 				} else {
-					callable = memnew(GDScriptLambdaSelfCallable(p_instance->owner, lambda, captures));
+					GDScriptLambdaSelfCallable *callable = GDScriptLambdaSelfCallable::create(p_instance->owner, lambda, captures_count);
+					Variant *captures = callable->get_captures();
+					for (int i = 0; i < captures_count; i++) {
+						GET_INSTRUCTION_ARG(arg, i);
+						captures[i] = *arg;
+					}
+					*result = Callable(callable);
 				}
 
-				GET_INSTRUCTION_ARG(result, captures_count);
-				*result = Callable(callable);
-
 				ip += 3;
 			}
 			DISPATCH_OPCODE;
@@ -2713,6 +2769,11 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				int to = _code_ptr[ip + 1];
 
 				GD_ERR_BREAK(to < 0 || to > _code_size);
+#ifdef GDSCRIPT_JIT_ENABLED
+				if (to < ip) {
+					jit_loop_iterations++;
+				}
+#endif
 				ip = to;
 			}
 			DISPATCH_OPCODE;
@@ -3841,6 +3902,218 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE_TYPE_ADJUST(PACKED_COLOR_ARRAY, PackedColorArray);
 			OPCODE_TYPE_ADJUST(PACKED_VECTOR4_ARRAY, PackedVector4Array);
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(8);
+
+				{
+					int operator_idx = _code_ptr[ip + 4];
+					GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+					Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+					GET_VARIANT_PTR(a, 0);
+					GET_VARIANT_PTR(b, 1);
+					GET_VARIANT_PTR(dst, 2);
+
+					operator_func(a, b, dst);
+				}
+				ip += 5;
+
+				GET_VARIANT_PTR(test, 0);
+
+				if (!test->booleanize()) {
+					int to = _code_ptr[ip + 2];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 3;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_OPERATOR_VALIDATED_ASSIGN) {
+				CHECK_SPACE(8);
+
+				{
+					int operator_idx = _code_ptr[ip + 4];
+					GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+					Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+					GET_VARIANT_PTR(a, 0);
+					GET_VARIANT_PTR(b, 1);
+					GET_VARIANT_PTR(dst, 2);
+
+					operator_func(a, b, dst);
+				}
+				ip += 5;
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(src, 1);
+
+				*dst = *src;
+
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_KEYED_OPERATOR_VALIDATED) {
+				CHECK_SPACE(10);
+
+				{
+					GET_VARIANT_PTR(src, 0);
+					GET_VARIANT_PTR(key, 1);
+					GET_VARIANT_PTR(dst, 2);
+
+					int index_getter = _code_ptr[ip + 4];
+					GD_ERR_BREAK(index_getter < 0 || index_getter >= _keyed_getters_count);
+					const Variant::ValidatedKeyedGetter getter = _keyed_getters_ptr[index_getter];
+
+					bool valid;
+#ifdef DEBUG_ENABLED
+					// Allow better error message in cases where src and dst are the same stack position.
+					Variant ret;
+					getter(src, key, &ret, &valid);
+					if (!valid) {
+						String v = key->operator String();
+						if (!v.is_empty()) {
+							v = "'" + v + "'";
+						} else {
+							v = "of type '" + _get_var_type(key) + "'";
+						}
+						err_text = "Invalid access to property or key " + v + " on a base object of type '" + _get_var_type(src) + "'.";
+						OPCODE_BREAK;
+					}
+					*dst = ret;
+#else
+					getter(src, key, dst, &valid);
+#endif
+				}
+				ip += 5;
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_INDEXED_OPERATOR_VALIDATED) {
+				CHECK_SPACE(10);
+
+				{
+					GET_VARIANT_PTR(src, 0);
+					GET_VARIANT_PTR(index, 1);
+					GET_VARIANT_PTR(dst, 2);
+
+					int index_getter = _code_ptr[ip + 4];
+					GD_ERR_BREAK(index_getter < 0 || index_getter >= _indexed_getters_count);
+					const Variant::ValidatedIndexedGetter getter = _indexed_getters_ptr[index_getter];
+
+					int64_t int_index = *VariantInternal::get_int(index);
+
+					bool oob;
+					getter(src, int_index, dst, &oob);
+
+#ifdef DEBUG_ENABLED
+					if (oob) {
+						String v = index->operator String();
+						if (!v.is_empty()) {
+							v = "'" + v + "'";
+						} else {
+							v = "of type '" + _get_var_type(index) + "'";
+						}
+						err_text = "Out of bounds get index " + v + " (on base: '" + _get_var_type(src) + "')";
+						OPCODE_BREAK;
+					}
+#endif
+				}
+				ip += 5;
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				ip += 5;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_JUMP_ITERATE_RANGE) {
+				CHECK_SPACE(2);
+				int to = _code_ptr[ip + 1];
+
+				GD_ERR_BREAK(to < 0 || to > _code_size);
+#ifdef GDSCRIPT_JIT_ENABLED
+				jit_loop_iterations++;
+#endif
+				ip = to;
+				GD_ERR_BREAK(_code_ptr[ip] != OPCODE_ITERATE_RANGE);
+				CHECK_SPACE(5);
+
+				GET_VARIANT_PTR(counter, 0);
+				GET_VARIANT_PTR(to_ptr, 1);
+				GET_VARIANT_PTR(step_ptr, 2);
+
+				int64_t range_to = *VariantInternal::get_int(to_ptr);
+				int64_t step = *VariantInternal::get_int(step_ptr);
+
+				int64_t *count = VariantInternal::get_int(counter);
+
+				*count += step;
+
+				if ((step < 0 && *count <= range_to) || (step > 0 && *count >= range_to)) {
+					int jumpto = _code_ptr[ip + 5];
+					GD_ERR_BREAK(jumpto < 0 || jumpto > _code_size);
+					ip = jumpto;
+				} else {
+					GET_VARIANT_PTR(iterator, 3);
+					*VariantInternal::get_int(iterator) = *count;
+
+					ip += 6; // Loop again.
+				}
+			}
+			DISPATCH_OPCODE;
+
+#define OPCODE_OPERATOR_TYPED(m_name, m_get_func, m_ret_get_func, m_op)                                               \
+	OPCODE(OPCODE_OPERATOR_##m_name) {                                                                                \
+		CHECK_SPACE(5);                                                                                               \
+		GET_VARIANT_PTR(a, 0);                                                                                        \
+		GET_VARIANT_PTR(b, 1);                                                                                        \
+		GET_VARIANT_PTR(dst, 2);                                                                                      \
+		*VariantInternal::m_ret_get_func(dst) = *VariantInternal::m_get_func(a) m_op *VariantInternal::m_get_func(b); \
+		ip += 5;                                                                                                      \
+	}                                                                                                                 \
+	DISPATCH_OPCODE
+
+			OPCODE_OPERATOR_TYPED(INT_ADD, get_int, get_int, +);
+			OPCODE_OPERATOR_TYPED(INT_SUBTRACT, get_int, get_int, -);
+			OPCODE_OPERATOR_TYPED(INT_MULTIPLY, get_int, get_int, *);
+			OPCODE_OPERATOR_TYPED(INT_EQUAL, get_int, get_bool, ==);
+			OPCODE_OPERATOR_TYPED(INT_NOT_EQUAL, get_int, get_bool, !=);
+			OPCODE_OPERATOR_TYPED(INT_LESS, get_int, get_bool, <);
+			OPCODE_OPERATOR_TYPED(INT_LESS_EQUAL, get_int, get_bool, <=);
+			OPCODE_OPERATOR_TYPED(INT_GREATER, get_int, get_bool, >);
+			OPCODE_OPERATOR_TYPED(INT_GREATER_EQUAL, get_int, get_bool, >=);
+			OPCODE_OPERATOR_TYPED(FLOAT_ADD, get_float, get_float, +);
+			OPCODE_OPERATOR_TYPED(FLOAT_SUBTRACT, get_float, get_float, -);
+			OPCODE_OPERATOR_TYPED(FLOAT_MULTIPLY, get_float, get_float, *);
+			OPCODE_OPERATOR_TYPED(FLOAT_DIVIDE, get_float, get_float, /);
+			OPCODE_OPERATOR_TYPED(FLOAT_LESS, get_float, get_bool, <);
+			OPCODE_OPERATOR_TYPED(FLOAT_LESS_EQUAL, get_float, get_bool, <=);
+			OPCODE_OPERATOR_TYPED(FLOAT_GREATER, get_float, get_bool, >);
+			OPCODE_OPERATOR_TYPED(FLOAT_GREATER_EQUAL, get_float, get_bool, >=);
+
 			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(3);
 
@@ -3886,6 +4159,8 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				line = _code_ptr[ip + 1];
 				ip += 2;
 
+				GDScriptSamplingProfiler::poll();
+
 				if (EngineDebugger::is_active()) {
 					// line
 					bool do_break = false;
@@ -3977,6 +4252,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	}
 #endif
 
+#ifdef GDSCRIPT_JIT_ENABLED
+	if (jit_loop_iterations) {
+		GDScriptJIT::count_loop_iterations(this, jit_loop_iterations);
+	}
+#endif
+
 	// Check if this is not the last time it was interrupted by `await` or if it's the first time executing.
 	// If that is the case then we exit the function as normal. Otherwise we postpone it until the last `await` is completed.
 	// This ensures the call stack can be properly shown when using `await`, showing what resumed the function.
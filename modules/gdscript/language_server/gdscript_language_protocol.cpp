@@ -264,6 +264,9 @@ void GDScriptLanguageProtocol::poll(int p_limit_usec) {
 		on_client_connected();
 	}
 
+	// Diagnostics for documents that stopped changing, sent below.
+	workspace->flush_idle_documents(GDScriptWorkspace::REPARSE_DELAY_MSEC);
+
 	HashMap<int, Ref<LSPeer>>::Iterator E = clients.begin();
 	while (E != clients.end()) {
 		Ref<LSPeer> peer = E->value;
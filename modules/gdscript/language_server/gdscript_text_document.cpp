@@ -78,16 +78,70 @@ void GDScriptTextDocument::didOpen(const Variant &p_param) {
 void GDScriptTextDocument::didClose(const Variant &p_param) {
 }
 
+// Replaces `p_range` with `p_text`, only splitting the lines that changed.
+static void apply_text_change(Vector<String> &r_lines, const LSP::Range &p_range, const String &p_text) {
+	if (r_lines.is_empty()) {
+		r_lines.push_back(String());
+	}
+	const int line_count = r_lines.size();
+
+	String prefix;
+	int start_line = p_range.start.line;
+	if (start_line >= line_count) {
+		start_line = line_count - 1;
+		prefix = r_lines[start_line];
+	} else {
+		start_line = MAX(start_line, 0);
+		prefix = r_lines[start_line].substr(0, MAX(p_range.start.character, 0));
+	}
+
+	String suffix;
+	int end_line = p_range.end.line;
+	if (end_line >= line_count) {
+		end_line = line_count - 1;
+	} else {
+		end_line = MAX(end_line, start_line);
+		suffix = r_lines[end_line].substr(MAX(p_range.end.character, 0));
+	}
+
+	const Vector<String> inserted = (prefix + p_text + suffix).split("\n");
+	const int removed = end_line - start_line + 1;
+
+	Vector<String> lines;
+	lines.resize(line_count - removed + inserted.size());
+	String *dst = lines.ptrw();
+	for (int i = 0; i < start_line; i++) {
+		*dst++ = r_lines[i];
+	}
+	for (const String &line : inserted) {
+		*dst++ = line;
+	}
+	for (int i = end_line + 1; i < line_count; i++) {
+		*dst++ = r_lines[i];
+	}
+	r_lines = lines;
+}
+
 void GDScriptTextDocument::didChange(const Variant &p_param) {
 	LSP::TextDocumentItem doc = load_document_item(p_param);
 	Dictionary dict = p_param;
 	Array contentChanges = dict["contentChanges"];
+
+	Ref<GDScriptWorkspace> workspace = GDScriptLanguageProtocol::get_singleton()->get_workspace();
+	String path = workspace->get_file_path(doc.uri);
+	Vector<String> lines = workspace->get_document_lines(path);
 	for (int i = 0; i < contentChanges.size(); ++i) {
+		Dictionary change = contentChanges[i];
 		LSP::TextDocumentContentChangeEvent evt;
-		evt.load(contentChanges[i]);
-		doc.text = evt.text;
+		evt.load(change);
+		if (change.has("range")) {
+			apply_text_change(lines, evt.range, evt.text);
+		} else {
+			lines = evt.text.split("\n");
+		}
 	}
-	sync_script_content(doc.uri, doc.text);
+	// Parsed when the edits stop, see `GDScriptLanguageProtocol::poll()`.
+	workspace->update_document(path, lines);
 }
 
 void GDScriptTextDocument::willSaveWaitUntil(const Variant &p_param) {
@@ -177,6 +231,7 @@ Array GDScriptTextDocument::documentSymbol(const Dictionary &p_params) {
 	Dictionary params = p_params["textDocument"];
 	String uri = params["uri"];
 	String path = GDScriptLanguageProtocol::get_singleton()->get_workspace()->get_file_path(uri);
+	GDScriptLanguageProtocol::get_singleton()->get_workspace()->flush_document(path);
 	Array arr;
 	if (HashMap<String, ExtendGDScriptParser *>::ConstIterator parser = GDScriptLanguageProtocol::get_singleton()->get_workspace()->scripts.find(path)) {
 		LSP::DocumentSymbol symbol = parser->value->get_symbols();
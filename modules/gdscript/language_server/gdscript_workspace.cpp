@@ -44,6 +44,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
 #include "editor/doc/doc_tools.h"
 #include "editor/doc/editor_help.h"
 #include "editor/editor_node.h"
@@ -124,7 +125,44 @@ void GDScriptWorkspace::didDeleteFiles(const Dictionary &p_params) {
 	}
 }
 
+void GDScriptWorkspace::_index_script_symbols(const String &p_path, const ExtendGDScriptParser *p_parser) {
+	LocalVector<String> &names = script_symbol_index_names[p_path];
+
+	const auto index_members = [&](const ClassMembers &p_members) {
+		for (const KeyValue<String, const LSP::DocumentSymbol *> &E : p_members) {
+			LocalVector<const LSP::DocumentSymbol *> &symbols = script_symbol_index[E.key][p_path];
+			if (symbols.is_empty()) {
+				names.push_back(E.key);
+			}
+			symbols.push_back(E.value);
+		}
+	};
+
+	index_members(p_parser->get_members());
+	for (const KeyValue<String, ClassMembers> &E : p_parser->get_inner_classes()) {
+		index_members(E.value);
+	}
+}
+
+void GDScriptWorkspace::_unindex_script_symbols(const String &p_path) {
+	HashMap<String, LocalVector<String>>::Iterator names = script_symbol_index_names.find(p_path);
+	if (!names) {
+		return;
+	}
+	for (const String &name : names->value) {
+		HashMap<String, HashMap<String, LocalVector<const LSP::DocumentSymbol *>>>::Iterator E = script_symbol_index.find(name);
+		if (E) {
+			E->value.erase(p_path);
+			if (E->value.is_empty()) {
+				script_symbol_index.remove(E);
+			}
+		}
+	}
+	script_symbol_index_names.remove(names);
+}
+
 void GDScriptWorkspace::remove_cache_parser(const String &p_path) {
+	_unindex_script_symbols(p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator parser = parse_results.find(p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator scr = scripts.find(p_path);
 	if (parser && scr) {
@@ -267,6 +305,7 @@ void GDScriptWorkspace::list_script_files(const String &p_root_dir, List<String>
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String &p_path) {
+	flush_document(p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator S = scripts.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -279,6 +318,7 @@ ExtendGDScriptParser *GDScriptWorkspace::get_parse_successed_script(const String
 }
 
 ExtendGDScriptParser *GDScriptWorkspace::get_parse_result(const String &p_path) {
+	flush_document(p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator S = parse_results.find(p_path);
 	if (!S) {
 		parse_local_script(p_path);
@@ -434,6 +474,12 @@ Error GDScriptWorkspace::initialize() {
 			native_members.insert(E.key, members);
 		}
 
+		for (const KeyValue<StringName, ClassMembers> &E : native_members) {
+			for (const KeyValue<String, const LSP::DocumentSymbol *> &F : E.value) {
+				native_symbol_index[F.key].push_back(F.value);
+			}
+		}
+
 		// Cache member completions.
 		for (const KeyValue<String, ExtendGDScriptParser *> &S : scripts) {
 			S.value->get_member_completions();
@@ -447,6 +493,9 @@ Error GDScriptWorkspace::initialize() {
 }
 
 Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_content) {
+	// Supersedes any edit not parsed yet.
+	pending_documents.erase(p_path);
+
 	ExtendGDScriptParser *parser = memnew(ExtendGDScriptParser);
 	Error err = parser->parse(p_content, p_path);
 	HashMap<String, ExtendGDScriptParser *>::Iterator last_parser = parse_results.find(p_path);
@@ -456,6 +505,7 @@ Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_cont
 		remove_cache_parser(p_path);
 		parse_results[p_path] = parser;
 		scripts[p_path] = parser;
+		_index_script_symbols(p_path, parser);
 
 	} else {
 		if (last_parser && last_script && last_parser->value != last_script->value) {
@@ -469,6 +519,54 @@ Error GDScriptWorkspace::parse_script(const String &p_path, const String &p_cont
 	return err;
 }
 
+Vector<String> GDScriptWorkspace::get_document_lines(const String &p_path) const {
+	if (HashMap<String, PendingDocument>::ConstIterator E = pending_documents.find(p_path)) {
+		return E->value.lines;
+	}
+	if (HashMap<String, ExtendGDScriptParser *>::ConstIterator E = parse_results.find(p_path)) {
+		return E->value->get_lines();
+	}
+	return Vector<String>();
+}
+
+void GDScriptWorkspace::update_document(const String &p_path, const Vector<String> &p_lines) {
+	HashMap<String, ExtendGDScriptParser *>::ConstIterator parsed = parse_results.find(p_path);
+	if (parsed && parsed->value->get_lines() == p_lines) {
+		// Edits that cancel out (or an unchanged document) don't need another parse.
+		pending_documents.erase(p_path);
+		return;
+	}
+
+	PendingDocument &document = pending_documents[p_path];
+	document.lines = p_lines;
+	document.changed_msec = OS::get_singleton()->get_ticks_msec();
+}
+
+void GDScriptWorkspace::flush_document(const String &p_path) {
+	HashMap<String, PendingDocument>::Iterator E = pending_documents.find(p_path);
+	if (E) {
+		const String content = String("\n").join(E->value.lines);
+		parse_script(p_path, content);
+	}
+}
+
+void GDScriptWorkspace::flush_idle_documents(uint64_t p_idle_msec) {
+	if (pending_documents.is_empty()) {
+		return;
+	}
+
+	const uint64_t now = OS::get_singleton()->get_ticks_msec();
+	LocalVector<String> idle;
+	for (const KeyValue<String, PendingDocument> &E : pending_documents) {
+		if (now - E.value.changed_msec >= p_idle_msec) {
+			idle.push_back(E.key);
+		}
+	}
+	for (const String &path : idle) {
+		flush_document(path);
+	}
+}
+
 static bool is_valid_rename_target(const LSP::DocumentSymbol *p_symbol) {
 	// Must be valid symbol.
 	if (!p_symbol) {
@@ -850,24 +948,16 @@ void GDScriptWorkspace::resolve_related_symbols(const LSP::TextDocumentPositionP
 		LSP::Range range;
 		symbol_identifier = parser->get_identifier_under_position(p_doc_pos.position, range);
 
-		for (const KeyValue<StringName, ClassMembers> &E : native_members) {
-			const ClassMembers &members = native_members.get(E.key);
-			if (const LSP::DocumentSymbol *const *symbol = members.getptr(symbol_identifier)) {
-				r_list.push_back(*symbol);
+		if (const LocalVector<const LSP::DocumentSymbol *> *symbols = native_symbol_index.getptr(symbol_identifier)) {
+			for (const LSP::DocumentSymbol *symbol : *symbols) {
+				r_list.push_back(symbol);
 			}
 		}
 
-		for (const KeyValue<String, ExtendGDScriptParser *> &E : scripts) {
-			const ExtendGDScriptParser *scr = E.value;
-			const ClassMembers &members = scr->get_members();
-			if (const LSP::DocumentSymbol *const *symbol = members.getptr(symbol_identifier)) {
-				r_list.push_back(*symbol);
-			}
-
-			for (const KeyValue<String, ClassMembers> &F : scr->get_inner_classes()) {
-				const ClassMembers *inner_class = &F.value;
-				if (const LSP::DocumentSymbol *const *symbol = inner_class->getptr(symbol_identifier)) {
-					r_list.push_back(*symbol);
+		if (const HashMap<String, LocalVector<const LSP::DocumentSymbol *>> *script_symbols = script_symbol_index.getptr(symbol_identifier)) {
+			for (const KeyValue<String, LocalVector<const LSP::DocumentSymbol *>> &E : *script_symbols) {
+				for (const LSP::DocumentSymbol *symbol : E.value) {
+					r_list.push_back(symbol);
 				}
 			}
 		}
@@ -49,6 +49,22 @@ class GDScriptWorkspace : public RefCounted {
 	GDCLASS(GDScriptWorkspace, RefCounted);
 
 private:
+	/// Text of a document edited since it was last parsed. Edits are applied
+	/// here and the document is parsed once they stop, or when a request needs it.
+	struct PendingDocument {
+		Vector<String> lines;
+		uint64_t changed_msec = 0;
+	};
+	HashMap<String, PendingDocument> pending_documents;
+
+	/// Members of the parsed scripts and native classes by name, for smart resolve.
+	HashMap<String, LocalVector<const LSP::DocumentSymbol *>> native_symbol_index;
+	HashMap<String, HashMap<String, LocalVector<const LSP::DocumentSymbol *>>> script_symbol_index;
+	HashMap<String, LocalVector<String>> script_symbol_index_names;
+
+	void _index_script_symbols(const String &p_path, const ExtendGDScriptParser *p_parser);
+	void _unindex_script_symbols(const String &p_path);
+
 	void _get_owners(EditorFileSystemDirectory *efsd, String p_path, List<String> &owners);
 	Node *_get_owner_scene_node(String p_path);
 
@@ -85,11 +101,19 @@ public:
 	HashMap<StringName, ClassMembers> native_members;
 
 public:
+	/// Time without edits after which a changed document is parsed and its diagnostics published.
+	static constexpr uint64_t REPARSE_DELAY_MSEC = 150;
+
 	Error initialize();
 
 	Error parse_script(const String &p_path, const String &p_content);
 	Error parse_local_script(const String &p_path);
 
+	Vector<String> get_document_lines(const String &p_path) const;
+	void update_document(const String &p_path, const Vector<String> &p_lines);
+	void flush_document(const String &p_path);
+	void flush_idle_documents(uint64_t p_idle_msec);
+
 	String get_file_path(const String &p_uri);
 	String get_file_uri(const String &p_path) const;
 
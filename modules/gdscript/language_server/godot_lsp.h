@@ -608,7 +608,7 @@ struct TextDocumentSyncOptions {
 	 * Change notifications are sent to the server. See TextDocumentSyncKind.None, TextDocumentSyncKind.Full
 	 * and TextDocumentSyncKind.Incremental. If omitted it defaults to TextDocumentSyncKind.None.
 	 */
-	int change = TextDocumentSyncKind::Full;
+	int change = TextDocumentSyncKind::Incremental;
 
 	/**
 	 * If present will save notifications are sent to the server. If omitted the notification should not be
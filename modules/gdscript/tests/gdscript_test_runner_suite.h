@@ -40,7 +40,21 @@
 
 #include "gdscript_test_runner.h"
 
+#include "../gdscript_byte_codegen.h"
+#include "../gdscript_bytecode_cache.h"
+#include "../gdscript_cache.h"
+#include "../gdscript_inline_cache.h"
+#include "../gdscript_jit.h"
+#include "../gdscript_lambda_callable.h"
+#include "../gdscript_sampling_profiler.h"
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/io/marshalls.h"
+#include "core/io/resource_loader.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace GDScriptTests {
 
@@ -80,6 +94,779 @@ func _init():
 	CHECK_MESSAGE(int(ref_counted->get_meta("result")) == 42, "The script should assign object metadata successfully.");
 }
 
+/// Times the methods with a setting turned off, then on, and reports the speedup. Both runs
+/// must return the same. The script is compiled for each run, so compiler settings apply too.
+static void benchmark_setting(const String &p_source, const Vector<String> &p_methods, void (*p_set)(bool), const String &p_off_label, const String &p_on_label, int p_repeat = 5, const StringName &p_setup = StringName()) {
+	LocalVector<uint64_t> elapsed[2];
+	LocalVector<Variant> results[2];
+
+	for (int on = 0; on < 2; on++) {
+		p_set(on);
+
+		Ref<GDScript> gdscript = memnew(GDScript);
+		gdscript->set_source_code(p_source);
+		ERR_PRINT_OFF;
+		const Error error = gdscript->reload();
+		ERR_PRINT_ON;
+		REQUIRE(error == OK);
+
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		if (p_setup != StringName()) {
+			ref_counted->call(p_setup);
+		}
+
+		for (const String &method : p_methods) {
+			Variant result;
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int repeat = 0; repeat < p_repeat; repeat++) {
+				result = ref_counted->call(StringName(method));
+			}
+			elapsed[on].push_back(MAX(uint64_t(1), OS::get_singleton()->get_ticks_usec() - begin));
+			results[on].push_back(result);
+		}
+	}
+	p_set(true);
+
+	for (int i = 0; i < p_methods.size(); i++) {
+		CHECK(results[0][i] == results[1][i]);
+		MESSAGE(vformat("%s: %d usec %s, %d usec %s (%.2fx).", p_methods[i], elapsed[0][i], p_off_label, elapsed[1][i], p_on_label, double(elapsed[0][i]) / elapsed[1][i]));
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Superinstruction fusion" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+var values: Array[int] = []
+var prices := {}
+
+func _init():
+	for i in range(100000):
+		values.push_back(i % 100)
+		prices[i % 100] = i
+
+func indexed_operator() -> int:
+	var total := 0
+	for i in range(values.size()):
+		total += values[i] * 3
+	return total
+
+func keyed_operator() -> int:
+	var total := 0
+	for i in range(values.size()):
+		total += prices[values[i]] * 3
+	return total
+
+func compare_and_jump() -> int:
+	var i := 0
+	var hits := 0
+	while i < 1000000:
+		if i < 500000:
+			hits += 1
+		i += 1
+	return hits
+
+func range_loop() -> int:
+	var last := 0
+	for i in range(1000000):
+		last = i
+	return last
+)";
+
+	benchmark_setting(source, { "indexed_operator", "keyed_operator", "compare_and_jump", "range_loop" }, [](bool p_on) { GDScriptByteCodeGenerator::fuse_superinstructions = p_on; }, "unfused", "fused");
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Typed operator opcodes" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func int_arithmetic() -> int:
+	var a := 1
+	var b := 0
+	for i in range(1000000):
+		b = (b * 3 + a - i) % 65521
+		a = b - a
+	return a + b
+
+func float_arithmetic() -> float:
+	var x := 0.5
+	var y := 1.0
+	for i in range(1000000):
+		x = x * 0.5 + y / 3.0
+		y = y - x * 0.25
+	return x + y
+
+func comparisons() -> int:
+	var hits := 0
+	var limit := 500000
+	for i in range(1000000):
+		var above := i > limit
+		var even_bucket := i % 4 == 0
+		if above == even_bucket:
+			hits += 1
+	return hits
+)";
+
+	benchmark_setting(source, { "int_arithmetic", "float_arithmetic", "comparisons" }, [](bool p_on) { GDScriptByteCodeGenerator::specialize_typed_operators = p_on; }, "validated", "typed");
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches are dropped when a script is reloaded") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> reader = memnew(GDScript);
+	reader->set_source_code(R"(
+extends RefCounted
+
+func read(object):
+	return object.value
+
+func call_describe(object):
+	return object.describe()
+)");
+	REQUIRE(reader->reload() == OK);
+	Ref<RefCounted> reader_object = memnew(RefCounted);
+	reader_object->set_script(reader);
+
+	Ref<GDScript> target = memnew(GDScript);
+	target->set_source_code(R"(
+extends RefCounted
+var value = 1
+var other = 2
+func describe():
+	return "first"
+)");
+	REQUIRE(target->reload() == OK);
+	{
+		Ref<RefCounted> target_object = memnew(RefCounted);
+		target_object->set_script(target);
+		CHECK(reader_object->call("read", target_object) == Variant(1));
+		CHECK(reader_object->call("call_describe", target_object) == Variant("first"));
+	}
+
+	// Same script object, different member layout and functions.
+	target->set_source_code(R"(
+extends RefCounted
+var other = 3
+var padding = 4
+var value = 5
+func describe():
+	return "second"
+)");
+	REQUIRE(target->reload() == OK);
+	Ref<RefCounted> target_object = memnew(RefCounted);
+	target_object->set_script(target);
+	CHECK(reader_object->call("read", target_object) == Variant(5));
+	CHECK(reader_object->call("call_describe", target_object) == Variant("second"));
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Inline caches" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+class Point:
+	var x = 1
+	var y = 2
+	func length_squared():
+		return x * x + y * y
+
+class Particle:
+	var position = Vector2(1, 2)
+	var x = 3
+	func length_squared():
+		return position.length_squared()
+
+func get_members() -> int:
+	var objects = [Point.new(), Particle.new()]
+	var total = 0
+	for i in range(1000000):
+		var object = objects[i & 1]
+		total += object.x
+	return total
+
+func set_members() -> int:
+	var objects = [Point.new(), Particle.new()]
+	for i in range(1000000):
+		var object = objects[i & 1]
+		object.x = i
+	return objects[0].x + objects[1].x
+
+func call_methods() -> float:
+	var objects = [Point.new(), Particle.new()]
+	var total = 0.0
+	for i in range(1000000):
+		var object = objects[i & 1]
+		total += object.length_squared()
+	return total
+
+func builtin_members() -> float:
+	var vector = Vector2(1, 2)
+	var total = 0.0
+	for i in range(1000000):
+		total += vector.x + vector.y
+		vector.x = i
+	return total
+)";
+
+	benchmark_setting(source, { "get_members", "set_members", "call_methods", "builtin_members" }, [](bool p_on) { GDScriptInlineCache::enabled = p_on; }, "uncached", "cached");
+}
+
+static Vector<String> write_synthetic_project(const String &p_dir, int p_script_count) {
+	DirAccess::make_dir_recursive_absolute(p_dir);
+	Vector<String> paths;
+	for (int i = 0; i < p_script_count; i++) {
+		paths.push_back(p_dir.path_join(vformat("script_%d.gd", i)));
+	}
+	for (int i = 0; i < p_script_count; i++) {
+		// Every script depends on another one, so loading one also analyzes a chain of others.
+		String source = "extends RefCounted\n\n";
+		if (i > 0) {
+			source += vformat("const Parent = preload(\"%s\")\n\nvar parent: Parent\n", paths[i / 2]);
+		}
+		source += vformat(R"(var value: int = %d
+var items: Array[int] = []
+
+func compute(p_count: int) -> int:
+	var total := 0
+	for i in range(p_count):
+		if i %% 3 == 0:
+			total += i * value
+		else:
+			total -= i
+	return total
+
+func describe() -> String:
+	return "script %d: %%d" %% compute(10)
+)",
+				i, i);
+		Ref<FileAccess> f = FileAccess::open(paths[i], FileAccess::WRITE);
+		f->store_string(source);
+	}
+	return paths;
+}
+
+TEST_CASE("[Modules][GDScript] Scripts parsed in parallel load like any other") {
+	GDScriptLanguage::get_singleton()->init();
+	const Vector<String> paths = write_synthetic_project(TestUtils::get_temp_path("gdscript_parse_scripts"), 16);
+
+	GDScriptCache::parse_scripts(paths);
+	for (const String &path : paths) {
+		CHECK(GDScriptCache::has_parser(path));
+	}
+
+	for (int i = 0; i < paths.size(); i++) {
+		Ref<GDScript> script = ResourceLoader::load(paths[i]);
+		REQUIRE(script.is_valid());
+		CHECK(script->is_valid());
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(script);
+		CHECK(object->call("describe") == Variant(vformat("script %d: %d", i, -27 + 18 * i)));
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Scripts parsed in parallel but never loaded release their parsers") {
+	GDScriptLanguage::get_singleton()->init();
+	const Vector<String> paths = write_synthetic_project(TestUtils::get_temp_path("gdscript_release_parsed_ahead"), 4);
+
+	GDScriptCache::parse_scripts(paths);
+	GDScriptCache::release_parsed_ahead();
+	for (const String &path : paths) {
+		CHECK_FALSE(GDScriptCache::has_parser(path));
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Parallel parsing" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const int script_count = 5000;
+
+	uint64_t elapsed[2] = {};
+	for (int parallel = 0; parallel < 2; parallel++) {
+		// A separate directory per run, so nothing is served from the caches of the previous one.
+		const Vector<String> paths = write_synthetic_project(TestUtils::get_temp_path(vformat("gdscript_parallel_parsing_%d", parallel)), script_count);
+
+		Vector<Ref<Resource>> scripts;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		if (parallel) {
+			GDScriptCache::parse_scripts(paths);
+		}
+		for (const String &path : paths) {
+			scripts.push_back(ResourceLoader::load(path));
+		}
+		elapsed[parallel] = MAX(uint64_t(1), OS::get_singleton()->get_ticks_usec() - begin);
+
+		for (const Ref<Resource> &script : scripts) {
+			CHECK(script.is_valid());
+		}
+	}
+
+	MESSAGE(vformat("Loading %d scripts: %d usec serial, %d usec parsed in parallel (%.2fx).", script_count, elapsed[0], elapsed[1], double(elapsed[0]) / elapsed[1]));
+}
+
+static void load_with_bytecode_cache(const Vector<String> &p_paths, Vector<Ref<GDScript>> &r_scripts) {
+	// Dropped from the caches first, so every script is loaded again.
+	r_scripts.clear();
+	for (const String &path : p_paths) {
+		GDScriptCache::remove_script(path);
+	}
+	for (const String &path : p_paths) {
+		Error err = OK;
+		r_scripts.push_back(GDScriptCache::get_full_script(path, err));
+		CHECK(err == OK);
+	}
+}
+
+TEST_CASE("[Modules][GDScript] Scripts restored from the bytecode cache run like compiled ones") {
+	GDScriptLanguage::get_singleton()->init();
+	const bool was_enabled = GDScriptBytecodeCache::is_enabled();
+	const String previous_directory = GDScriptBytecodeCache::get_directory();
+	GDScriptBytecodeCache::set_enabled(true);
+	GDScriptBytecodeCache::set_directory(TestUtils::get_temp_path("gdscript_bytecode_cache/cache"));
+
+	const Vector<String> paths = write_synthetic_project(TestUtils::get_temp_path("gdscript_bytecode_cache/project"), 8);
+	for (const String &path : paths) {
+		DirAccess::remove_absolute(GDScriptBytecodeCache::get_cache_path(path));
+	}
+
+	Vector<Ref<GDScript>> scripts;
+	for (int pass = 0; pass < 2; pass++) {
+		load_with_bytecode_cache(paths, scripts);
+		for (int i = 0; i < paths.size(); i++) {
+			REQUIRE(scripts[i].is_valid());
+			CHECK(scripts[i]->is_valid());
+			CHECK(FileAccess::exists(GDScriptBytecodeCache::get_cache_path(paths[i])));
+			// Only the first pass parses.
+			CHECK(GDScriptCache::has_parser(paths[i]) == (pass == 0));
+			Ref<RefCounted> object = memnew(RefCounted);
+			object->set_script(scripts[i]);
+			CHECK(object->call("describe") == Variant(vformat("script %d: %d", i, -27 + 18 * i)));
+		}
+	}
+
+	// Editing a script invalidates its entry and the entries of the scripts that depend on it.
+	const String source = FileAccess::get_file_as_string(paths[0]).replace("var value: int = 0", "var value: int = 5");
+	FileAccess::open(paths[0], FileAccess::WRITE)->store_string(source);
+
+	load_with_bytecode_cache(paths, scripts);
+	CHECK(GDScriptCache::has_parser(paths[0]));
+	CHECK(GDScriptCache::has_parser(paths[1]));
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(scripts[0]);
+	CHECK(object->call("describe") == Variant("script 0: 63"));
+
+	GDScriptBytecodeCache::set_enabled(was_enabled);
+	GDScriptBytecodeCache::set_directory(previous_directory);
+}
+
+TEST_CASE("[Modules][GDScript] Damaged bytecode cache entries fall back to compiling") {
+	GDScriptLanguage::get_singleton()->init();
+	const bool was_enabled = GDScriptBytecodeCache::is_enabled();
+	const String previous_directory = GDScriptBytecodeCache::get_directory();
+	GDScriptBytecodeCache::set_enabled(true);
+	GDScriptBytecodeCache::set_directory(TestUtils::get_temp_path("gdscript_bytecode_cache_damaged/cache"));
+
+	const Vector<String> paths = write_synthetic_project(TestUtils::get_temp_path("gdscript_bytecode_cache_damaged/project"), 1);
+	const String cache_path = GDScriptBytecodeCache::get_cache_path(paths[0]);
+	DirAccess::remove_absolute(cache_path);
+	Vector<Ref<GDScript>> scripts;
+	load_with_bytecode_cache(paths, scripts);
+	const Vector<uint8_t> entry = FileAccess::get_file_as_bytes(cache_path);
+	REQUIRE_FALSE(entry.is_empty());
+
+	// Out of range for every address, index and jump target, whichever field it lands on.
+	ERR_PRINT_OFF;
+	for (int offset = 0; offset + 4 <= entry.size(); offset += 4) {
+		Vector<uint8_t> damaged = entry;
+		encode_uint32(0x00FFFFFF, damaged.ptrw() + offset);
+		FileAccess::open(cache_path, FileAccess::WRITE)->store_buffer(damaged);
+
+		load_with_bytecode_cache(paths, scripts);
+		REQUIRE(scripts[0].is_valid());
+		CHECK(scripts[0]->is_valid());
+		Ref<RefCounted> object = memnew(RefCounted);
+		object->set_script(scripts[0]);
+		object->call("describe");
+	}
+	ERR_PRINT_ON;
+
+	GDScriptBytecodeCache::set_enabled(was_enabled);
+	GDScriptBytecodeCache::set_directory(previous_directory);
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Bytecode cache" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const bool was_enabled = GDScriptBytecodeCache::is_enabled();
+	const String previous_directory = GDScriptBytecodeCache::get_directory();
+	GDScriptBytecodeCache::set_enabled(true);
+	GDScriptBytecodeCache::set_directory(TestUtils::get_temp_path("gdscript_bytecode_cache_benchmark/cache"));
+
+	const int script_count = 5000;
+	const Vector<String> paths = write_synthetic_project(TestUtils::get_temp_path("gdscript_bytecode_cache_benchmark/project"), script_count);
+	for (const String &path : paths) {
+		DirAccess::remove_absolute(GDScriptBytecodeCache::get_cache_path(path));
+	}
+
+	// The first pass compiles and writes the entries, the second one only reads them.
+	uint64_t elapsed[2] = {};
+	Vector<Ref<GDScript>> scripts;
+	for (int pass = 0; pass < 2; pass++) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		load_with_bytecode_cache(paths, scripts);
+		elapsed[pass] = MAX(uint64_t(1), OS::get_singleton()->get_ticks_usec() - begin);
+		for (const Ref<GDScript> &script : scripts) {
+			CHECK(script.is_valid());
+		}
+	}
+
+	MESSAGE(vformat("Loading %d scripts: %d usec compiled, %d usec from the bytecode cache (%.2fx).", script_count, elapsed[0], elapsed[1], double(elapsed[0]) / elapsed[1]));
+
+	GDScriptBytecodeCache::set_enabled(was_enabled);
+	GDScriptBytecodeCache::set_directory(previous_directory);
+}
+
+#ifdef GDSCRIPT_JIT_ENABLED
+static Vector<Variant> call_methods_with_jit(const String &p_source, const Vector<String> &p_methods, bool p_jit, int p_repeat, Vector<String> *r_not_compiled = nullptr) {
+	const bool was_enabled = GDScriptJIT::is_enabled();
+	const uint32_t previous_threshold = GDScriptJIT::get_tier_up_threshold();
+	GDScriptJIT::set_enabled(p_jit);
+	GDScriptJIT::set_tier_up_threshold(0);
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	ERR_PRINT_OFF;
+	const Error error = gdscript->reload();
+	ERR_PRINT_ON;
+	Vector<Variant> results;
+	if (error == OK) {
+		Ref<RefCounted> ref_counted = memnew(RefCounted);
+		ref_counted->set_script(gdscript);
+		for (int i = 0; i < p_methods.size(); i++) {
+			for (int repeat = 0; repeat < p_repeat; repeat++) {
+				results.push_back(ref_counted->call(StringName(p_methods[i])));
+			}
+			GDScriptFunction *const *function = gdscript->get_member_functions().getptr(StringName(p_methods[i]));
+			if (r_not_compiled && (!function || (*function)->get_jit_state() != GDScriptJIT::STATE_COMPILED)) {
+				r_not_compiled->push_back(p_methods[i]);
+			}
+		}
+	}
+
+	GDScriptJIT::set_enabled(was_enabled);
+	GDScriptJIT::set_tier_up_threshold(previous_threshold);
+	return results;
+}
+
+TEST_CASE("[Modules][GDScript] Native code matches the interpreter") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+var scale := 3
+var values: Array[int] = [4, -8, 15, 16, -23, 42]
+var lookup := { "a": 1, "b": 2 }
+
+func arithmetic(x: int = 7, y: float = 0.5) -> float:
+	var total := 0.0
+	for i in range(x, 40, 3):
+		total += i * y - scale
+		if total > 50.0:
+			total -= 25.0
+	return total
+
+func arrays() -> Array[int]:
+	var out: Array[int] = []
+	for value in values:
+		if value < 0:
+			continue
+		out.push_back(absi(value) * scale)
+	for i in range(out.size()):
+		out[i] += values[i]
+	return out
+
+func dictionaries() -> int:
+	var sum := 0
+	for i in 10:
+		sum += lookup["a"] + lookup["b"] * i
+	lookup["c"] = sum
+	return lookup["c"]
+
+func vectors() -> Vector2:
+	var v := Vector2(1.0, 2.0)
+	var i := 0
+	while i < 20:
+		v = v * 1.5 + Vector2(float(i), -1.0)
+		i += 1
+	return v.normalized()
+
+func indexed_sum() -> int:
+	var total := 0
+	for i in range(values.size()):
+		total += values[i]
+	total += values[values.size() - 1]
+	return total
+)";
+	const Vector<String> methods = { "arithmetic", "arrays", "dictionaries", "vectors", "indexed_sum" };
+
+	const Vector<Variant> interpreted = call_methods_with_jit(source, methods, false, 2);
+	Vector<String> not_compiled;
+	const Vector<Variant> compiled = call_methods_with_jit(source, methods, true, 2, &not_compiled);
+	// Otherwise the comparison below only runs the interpreter twice.
+	CHECK_MESSAGE(not_compiled.is_empty(), vformat("Functions left to the interpreter: %s.", String(", ").join(not_compiled)));
+	REQUIRE(interpreted.size() == methods.size() * 2);
+	REQUIRE(compiled.size() == interpreted.size());
+	for (int i = 0; i < interpreted.size(); i++) {
+		CHECK_MESSAGE(compiled[i] == interpreted[i], vformat("%s() should return the same value when compiled.", methods[i / 2]));
+	}
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Native code tier" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func sum_range() -> int:
+	var total := 0
+	for i in range(2000000):
+		total += i * 3 - 1
+	return total
+
+func fibonacci() -> int:
+	var a := 0
+	var b := 1
+	var i := 0
+	while i < 1000000:
+		var c := (a + b) % 1000007
+		a = b
+		b = c
+		i += 1
+	return b
+
+func array_scan() -> int:
+	var values: Array[int] = []
+	values.resize(100000)
+	for i in range(values.size()):
+		values[i] = i % 97
+	var hits := 0
+	for repeat in 10:
+		for i in range(values.size()):
+			if values[i] > 48:
+				hits += 1
+	return hits
+)";
+	const bool was_enabled = GDScriptJIT::is_enabled();
+	const uint32_t previous_threshold = GDScriptJIT::get_tier_up_threshold();
+	GDScriptJIT::set_tier_up_threshold(0);
+	benchmark_setting(source, { "sum_range", "fibonacci", "array_scan" }, GDScriptJIT::set_enabled, "interpreted", "native", 3);
+	GDScriptJIT::set_enabled(was_enabled);
+	GDScriptJIT::set_tier_up_threshold(previous_threshold);
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[Modules][GDScript] Sampling profiler records functions running as native code") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func sum_range() -> int:
+	var total := 0
+	for i in range(20000000):
+		total += i * 3 - 1
+	return total
+)";
+	const bool was_enabled = GDScriptJIT::is_enabled();
+	const uint32_t previous_threshold = GDScriptJIT::get_tier_up_threshold();
+	GDScriptJIT::set_enabled(true);
+	GDScriptJIT::set_tier_up_threshold(0);
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	REQUIRE(gdscript->reload() == OK);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::start(200);
+	ref_counted->call("sum_range");
+	GDScriptSamplingProfiler::stop();
+	CHECK_MESSAGE(GDScriptSamplingProfiler::get_sample_count() > 0, "Native code should take the pending samples at each line.");
+	GDScriptSamplingProfiler::clear();
+
+	GDScriptJIT::set_enabled(was_enabled);
+	GDScriptJIT::set_tier_up_threshold(previous_threshold);
+}
+#endif // THREADS_ENABLED
+#endif // GDSCRIPT_JIT_ENABLED
+
+TEST_CASE("[Modules][GDScript] Reused lambdas don't keep their script alive") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func make() -> Callable:
+	return func(): return 1
+
+func run() -> int:
+	var total := 0
+	for i in 3:
+		total += make().call()
+	return total
+)";
+
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_path(TestUtils::get_temp_path("gdscript_lambda_reuse.gd"));
+	gdscript->set_source_code(source);
+	REQUIRE(gdscript->reload() == OK);
+	const ObjectID script_id = gdscript->get_instance_id();
+
+	Ref<RefCounted> object = memnew(RefCounted);
+	object->set_script(gdscript);
+	CHECK(int(object->call("run")) == 3);
+	object.unref();
+
+	GDScriptCache::remove_script(gdscript->get_path());
+	gdscript.unref();
+	CHECK(ObjectDB::get_instance(script_id) == nullptr);
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Lambda creation" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	// Owned by a plain Object, so lambdas using `self` can be reused too.
+	const String source = R"(
+extends Object
+
+var offset := 1
+
+func apply(f: Callable, x: int) -> int:
+	return f.call(x)
+
+func plain(n: int) -> int:
+	var total := 0
+	for i in range(n):
+		total += apply(func(x): return x + 1, i)
+	return total
+
+func using_self(n: int) -> int:
+	var total := 0
+	for i in range(n):
+		total += apply(func(x): return x + offset, i)
+	return total
+
+func capturing(n: int) -> int:
+	var one := 1
+	var total := 0
+	for i in range(n):
+		total += apply(func(x): return x + one, i)
+	return total
+)";
+	const char *methods[] = { "plain", "using_self", "capturing" };
+	constexpr int evaluations = 1000000;
+
+	// Lambdas are only reused for scripts held by GDScriptCache, which needs a path.
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_path(TestUtils::get_temp_path("gdscript_lambda_creation.gd"));
+	gdscript->set_source_code(source);
+	REQUIRE(gdscript->reload() == OK);
+	Object *object = memnew(Object);
+	object->set_script(gdscript);
+
+	Variant expected;
+	for (const char *method : methods) {
+		// Allocation counts are only tracked in debug builds.
+		const uint64_t allocations = Memory::get_mem_alloc_count();
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		const Variant result = object->call(method, evaluations);
+		const uint64_t elapsed = OS::get_singleton()->get_ticks_usec() - begin;
+		const double allocations_per_evaluation = double(Memory::get_mem_alloc_count() - allocations) / evaluations;
+
+		if (expected.get_type() == Variant::NIL) {
+			expected = result;
+		}
+		CHECK(result == expected);
+		MESSAGE(vformat("%s: %d usec, %.2f allocations per lambda.", method, elapsed, allocations_per_evaluation));
+	}
+
+	memdelete(object);
+	GDScriptCache::remove_script(gdscript->get_path());
+}
+
+TEST_CASE("[Modules][GDScript][Benchmark] Array methods with lambdas" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+var values: Array[int] = []
+
+func setup() -> void:
+	values.resize(1000000)
+	for i in values.size():
+		values[i] = (i * 7919) % 1000003
+
+func map_values() -> int:
+	return values.map(func(v): return v * 2).size()
+
+func filter_values() -> int:
+	var divisor := 3
+	return values.filter(func(v): return v % divisor == 0).size()
+
+func reduce_values() -> int:
+	return values.reduce(func(accum, v): return accum + v, 0)
+
+func all_values() -> bool:
+	return values.all(func(v): return v >= 0)
+
+func sort_values() -> int:
+	var slice := values.slice(0, 100000)
+	slice.sort_custom(func(a, b): return a < b)
+	return slice[0]
+)";
+	benchmark_setting(source, { "map_values", "filter_values", "reduce_values", "all_values", "sort_values" }, [](bool p_on) { GDScriptLambdaRepeatedCall::enabled = p_on; }, "per call", "prepared", 1, "setup");
+}
+
+#ifdef THREADS_ENABLED
+TEST_CASE("[Modules][GDScript] Sampling profiler records the running functions") {
+	GDScriptLanguage::get_singleton()->init();
+	const String source = R"(
+extends RefCounted
+
+func leaf(i: int) -> int:
+	return (i * 31) % 7
+
+func busy(msec: int) -> int:
+	var total := 0
+	var end := Time.get_ticks_msec() + msec
+	while Time.get_ticks_msec() < end:
+		total += leaf(total)
+	return total
+)";
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(source);
+	REQUIRE(gdscript->reload() == OK);
+	Ref<RefCounted> ref_counted = memnew(RefCounted);
+	ref_counted->set_script(gdscript);
+
+	GDScriptSamplingProfiler::start(200);
+	ref_counted->call("busy", 100);
+	GDScriptSamplingProfiler::stop();
+	CHECK(GDScriptSamplingProfiler::get_sample_count() > 0);
+
+	const String collapsed_path = TestUtils::get_temp_path("gdscript_sampling_profiler/profile.txt");
+	const String trace_path = TestUtils::get_temp_path("gdscript_sampling_profiler/profile.json");
+	DirAccess::make_dir_recursive_absolute(collapsed_path.get_base_dir());
+	REQUIRE(GDScriptSamplingProfiler::save(collapsed_path) == OK);
+	REQUIRE(GDScriptSamplingProfiler::save(trace_path) == OK);
+	GDScriptSamplingProfiler::clear();
+	CHECK(GDScriptSamplingProfiler::get_sample_count() == 0);
+
+	CHECK_MESSAGE(FileAccess::get_file_as_string(collapsed_path).contains("busy"), "Collapsed stacks should name the sampled function.");
+
+	const Variant trace = JSON::parse_string(FileAccess::get_file_as_string(trace_path));
+	REQUIRE(trace.get_type() == Variant::DICTIONARY);
+	const Dictionary trace_dict = trace;
+	CHECK(trace_dict.has("stackFrames"));
+	CHECK(Array(trace_dict.get("samples", Array())).size() > 0);
+}
+#endif // THREADS_ENABLED
+
 TEST_CASE("[Modules][GDScript] Validate built-in API") {
 	GDScriptLanguage *lang = GDScriptLanguage::get_singleton();
 
@@ -0,0 +1,36 @@
+# Array methods taking a callable call lambdas through a prepared fast path.
+
+var factor := 3
+
+class Holder extends Object:
+	var bias := 100
+
+	func shifted(values: Array) -> Array:
+		return values.map(func(v): return v + bias)
+
+
+func test():
+	var values: Array[int] = [5, 1, 4, 2, 3]
+	var offset := 10
+
+	print(values.map(func(v): return v * 2))
+	print(values.map(func(v): return v + offset))
+	print(values.map(func(v): return v * factor))
+	print(values.filter(func(v): return v % 2 == offset % 2))
+	print(values.reduce(func(accum, v): return accum + v * factor, offset))
+	print(values.any(func(v): return v > offset), " ", values.all(func(v): return v < offset))
+
+	var sorted := values.duplicate()
+	sorted.sort_custom(func(a, b): return a * factor > b * factor)
+	print(sorted)
+
+	var holder := Holder.new()
+	print(holder.shifted(values))
+	holder.free()
+
+	var nested := [[1, 2], [3]].map(func(inner): return inner.map(func(v): return v * offset))
+	print(nested)
+
+	var total := [0]
+	var _mapped := values.map(func(v): total[0] += v)
+	print(total[0])
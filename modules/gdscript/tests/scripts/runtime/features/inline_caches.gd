@@ -0,0 +1,74 @@
+# Named accesses on untyped values are cached per site by receiver type.
+# Sites that see many types, properties with accessors and values that need
+# a conversion must behave the same as an uncached lookup.
+
+class A:
+	var value = 1
+	func describe():
+		return "A%s" % value
+
+class B:
+	var padding = 0
+	var value = 2
+	func describe():
+		return "B%s" % value
+
+class C extends A:
+	func describe():
+		return "C%s" % value
+
+class D:
+	var value = 4:
+		get:
+			return value
+		set(new_value):
+			value = new_value * 10
+	func describe():
+		return "D%s" % value
+
+class E:
+	var value: float = 5.0
+	func describe():
+		return "E%s" % value
+
+func bump(object):
+	object.value = object.value + 1
+	return object.describe()
+
+func assign(object, value):
+	object.value = value
+
+func test():
+	var objects = [A.new(), B.new(), C.new(), D.new(), E.new()]
+	for i in 3:
+		var results = []
+		for object in objects:
+			results.append(bump(object))
+		print(results)
+
+	# The int needs to be converted for the typed member of E.
+	for object in objects:
+		assign(object, 3)
+		print(object.describe())
+
+	var vector = Vector2(1, 2)
+	for i in 2:
+		vector.x = vector.y + i
+		vector.y = 3
+		print(vector)
+	vector.x = 7
+	print(vector)
+
+	# Members stored in the Variant itself and behind a pointer.
+	var color = Color(0.5, 0.25, 1)
+	var box = AABB(Vector3(1, 2, 3), Vector3(4, 5, 6))
+	var transform = Transform3D()
+	for i in 2:
+		print(color.r)
+		print(box.position)
+		print(transform.basis)
+
+	var counted = RefCounted.new()
+	for i in 2:
+		print(counted.get_reference_count())
+	print(counted.has_method("get_reference_count"))
@@ -0,0 +1,55 @@
+# Lambdas without captures may reuse a previous callable, but only once nothing else references it.
+
+signal fired
+
+static var fired_count := 0
+
+class Emitter extends Object:
+	var value := 10
+
+	func make() -> Callable:
+		return func(): return value
+
+
+func make_plain() -> Callable:
+	return func(x): return x * 2
+
+
+func make_capturing(n: int) -> Callable:
+	return func(x): return x + n
+
+
+func test():
+	var a := make_plain()
+	var b := make_plain()
+	print(a == b)
+	print(a.call(2), " ", b.call(3))
+
+	a = Callable()
+	b = Callable()
+	print(make_plain().call(4))
+
+	var kept: Array[Callable] = []
+	for i in 3:
+		kept.append(make_plain())
+	print(kept[0] != kept[1] and kept[1] != kept[2])
+
+	var c1 := make_capturing(1)
+	var c2 := make_capturing(2)
+	print(c1.call(10), " ", c2.call(10))
+	print(c1.get_argument_count(), " ", c1 == c2)
+
+	var emitter := Emitter.new()
+	var e1 := emitter.make()
+	var e2 := emitter.make()
+	print(e1 == e2)
+	emitter.value = 20
+	print(e1.call(), " ", e2.call())
+	e1 = Callable()
+	e2 = Callable()
+	emitter.free()
+
+	for i in 3:
+		fired.connect(func(): fired_count += 1)
+	fired.emit()
+	print(fired_count)
@@ -0,0 +1,50 @@
+# Instruction pairs that are fused into superinstructions must behave as if run separately.
+
+func sum_scaled(values: Array[int], k: int) -> int:
+	var total := 0
+	for i in range(values.size()):
+		total += values[i] * k
+	return total
+
+func test():
+	print(sum_scaled([1, 2, 3, 4], 3))
+
+	var n := 0
+	while n < 10:
+		n += 3
+	print(n)
+
+	var evens := 0
+	for i in range(10):
+		if i % 2 == 1:
+			continue
+		evens += i
+	print(evens)
+
+	var countdown := []
+	for i in range(5, 0, -2):
+		countdown.append(i)
+	print(countdown)
+
+	var pairs := 0
+	for i in range(4):
+		for j in range(4):
+			if j > i:
+				break
+			pairs += 1
+	print(pairs)
+
+	var prices := { "apple": 2, "pear": 3 }
+	var cost := 0
+	for fruit in ["apple", "pear", "apple"]:
+		cost += prices[fruit] * 2
+	print(cost)
+
+	var v := Vector3(1, 2, 3)
+	var scaled := 0.0
+	for i in range(3):
+		scaled += v[i] * 2.0
+	print(scaled)
+
+	var total := sum_scaled([5, 5], 2)
+	print("big" if total > 15 else "small")
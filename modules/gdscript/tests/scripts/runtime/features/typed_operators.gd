@@ -0,0 +1,35 @@
+# Operators on values known to be int or float use specialized opcodes,
+# which must give the same results as the generic operators.
+
+func int_ops(a: int, b: int) -> Array:
+	return [a + b, a - b, a * b, a == b, a != b, a < b, a <= b, a > b, a >= b]
+
+func float_ops(a: float, b: float) -> Array:
+	return [a + b, a - b, a * b, a / b, a < b, a <= b, a > b, a >= b]
+
+func test():
+	print(int_ops(7, 3))
+	print(int_ops(-4, -4))
+	print(float_ops(1.5, 2.5))
+	print(float_ops(-2.0, 4.0))
+
+	var not_a_number := NAN
+	print([not_a_number < 1.0, not_a_number <= 1.0, not_a_number > 1.0, not_a_number >= 1.0])
+
+	var i := 0
+	var total := 0
+	while i < 10:
+		var is_even := i % 2 == 0
+		if is_even:
+			total += i * i
+		else:
+			total -= i
+		i += 1
+	print(total)
+
+	var x := 1.0
+	var steps := 0
+	while x < 100.0:
+		x = x * 1.5 + 0.25
+		steps += 1
+	print(steps)
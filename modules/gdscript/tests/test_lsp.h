@@ -319,6 +319,23 @@ void assert_no_errors_in(const String &p_path) {
 	REQUIRE_MESSAGE(err == OK, vformat("Errors while analyzing '%s'", p_path));
 }
 
+Dictionary text_change(const LSP::Range &p_range, const String &p_text) {
+	Dictionary change;
+	change["range"] = p_range.to_json();
+	change["text"] = p_text;
+	return change;
+}
+
+Dictionary did_change_params(const String &p_uri, const Array &p_changes) {
+	Dictionary text_document;
+	text_document["uri"] = p_uri;
+	text_document["version"] = 1;
+	Dictionary params;
+	params["textDocument"] = text_document;
+	params["contentChanges"] = p_changes;
+	return params;
+}
+
 inline LSP::Position lsp_pos(int line, int character) {
 	LSP::Position p;
 	p.line = line;
@@ -534,6 +551,146 @@ func f():
 			REQUIRE(cls.documentation.contains("t3"));
 		}
 
+		memdelete(proto);
+		memdelete(efs);
+		finish_language();
+	}
+	TEST_CASE("[workspace][did_change]") {
+		EditorFileSystem *efs = memnew(EditorFileSystem);
+		GDScriptLanguageProtocol *proto = initialize(root);
+		REQUIRE(proto);
+		Ref<GDScriptWorkspace> workspace = GDScriptLanguageProtocol::get_singleton()->get_workspace();
+
+		const String path = "res://lsp/local_variables.gd";
+		const String uri = workspace->get_file_uri(path);
+		workspace->parse_local_script(path);
+		const Vector<String> original = workspace->get_document_lines(path);
+		REQUIRE(original.size() > 3);
+
+		SUBCASE("Ranged changes are applied in order and parsed when needed") {
+			Array changes;
+			changes.push_back(text_change(range(pos(1, 0), pos(1, 0)), "# first\n"));
+			changes.push_back(text_change(range(pos(1, 2), pos(1, 7)), "second"));
+			proto->get_text_document()->didChange(did_change_params(uri, changes));
+
+			const Vector<String> lines = workspace->get_document_lines(path);
+			REQUIRE(lines.size() == original.size() + 1);
+			CHECK(lines[0] == original[0]);
+			CHECK(lines[1] == "# second");
+			CHECK(lines[2] == original[1]);
+			CHECK(workspace->parse_results[path]->get_lines() == original);
+
+			workspace->flush_document(path);
+			CHECK(workspace->parse_results[path]->get_lines() == lines);
+		}
+
+		SUBCASE("Changes can span lines") {
+			Array changes;
+			changes.push_back(text_change(range(pos(0, 0), pos(2, 0)), ""));
+			proto->get_text_document()->didChange(did_change_params(uri, changes));
+
+			const Vector<String> lines = workspace->get_document_lines(path);
+			REQUIRE(lines.size() == original.size() - 2);
+			CHECK(lines[0] == original[2]);
+		}
+
+		SUBCASE("Changes without a range replace the document") {
+			Dictionary change;
+			change["text"] = "extends Node\n";
+			Array changes;
+			changes.push_back(change);
+			proto->get_text_document()->didChange(did_change_params(uri, changes));
+
+			const Vector<String> lines = workspace->get_document_lines(path);
+			REQUIRE(lines.size() == 2);
+			CHECK(lines[0] == "extends Node");
+		}
+
+		SUBCASE("Changes that cancel out are not parsed again") {
+			const ExtendGDScriptParser *parser = workspace->parse_results[path];
+			Array changes;
+			changes.push_back(text_change(range(pos(1, 0), pos(1, 0)), "x"));
+			changes.push_back(text_change(range(pos(1, 0), pos(1, 1)), ""));
+			proto->get_text_document()->didChange(did_change_params(uri, changes));
+
+			workspace->flush_document(path);
+			CHECK(workspace->parse_results[path] == parser);
+		}
+
+		memdelete(proto);
+		memdelete(efs);
+		finish_language();
+	}
+	TEST_CASE("[Benchmark] Editing a large script" * doctest::skip()) {
+		EditorFileSystem *efs = memnew(EditorFileSystem);
+		GDScriptLanguageProtocol *proto = initialize(root);
+		REQUIRE(proto);
+		Ref<GDScriptWorkspace> workspace = GDScriptLanguageProtocol::get_singleton()->get_workspace();
+
+		// About 5000 lines, in typed functions.
+		constexpr int function_count = 500;
+		String source = "extends Node\n\nvar total := 0\n";
+		for (int i = 0; i < function_count; i++) {
+			source += vformat("\nfunc step_%d(value: int) -> int:\n\t# Step %d.\n\tvar scaled := value * %d\n\tvar label := str(scaled)\n\tif label.length() > 3:\n\t\ttotal += scaled\n\tfor j in range(value):\n\t\tscaled += j\n\treturn scaled\n", i, i, i + 1);
+		}
+		const String path = "res://lsp/benchmark_large_script.gd";
+		const String uri = workspace->get_file_uri(path);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		workspace->parse_script(path, source);
+		const uint64_t full_parse = OS::get_singleton()->get_ticks_usec() - begin;
+		const Vector<String> lines = workspace->get_document_lines(path);
+		MESSAGE(vformat("%d lines, full parse: %d usec.", lines.size(), full_parse));
+
+		// Type in the comment of a function in the middle of the file.
+		const int comment_line = lines.find(vformat("\t# Step %d.", function_count / 2));
+		REQUIRE(comment_line >= 0);
+		constexpr int keystrokes = 20;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < keystrokes; i++) {
+			const int column = lines[comment_line].length() + i;
+			Array changes;
+			changes.push_back(text_change(range(pos(comment_line, column), pos(comment_line, column)), "x"));
+			proto->get_text_document()->didChange(did_change_params(uri, changes));
+		}
+		const uint64_t typing = OS::get_singleton()->get_ticks_usec() - begin;
+		begin = OS::get_singleton()->get_ticks_usec();
+		workspace->flush_document(path);
+		const uint64_t reparse = OS::get_singleton()->get_ticks_usec() - begin;
+		MESSAGE(vformat("%d keystrokes: %d usec per change, then %d usec for the coalesced parse.", keystrokes, typing / keystrokes, reparse));
+
+		// Complete `label.` in the same function.
+		Vector<String> completion_lines = workspace->get_document_lines(path);
+		const int label_line = comment_line + 3;
+		completion_lines.write[label_line] = "\tif label." + String::chr(0xFFFF) + "length() > 3:";
+		const String completion_code = String("\n").join(completion_lines);
+		for (int skip = 0; skip < 2; skip++) {
+			GDScriptAnalyzer::skip_bodies_for_completion = skip;
+			List<ScriptLanguage::CodeCompletionOption> options;
+			bool forced = false;
+			String call_hint;
+			begin = OS::get_singleton()->get_ticks_usec();
+			GDScriptLanguage::get_singleton()->complete_code(completion_code, path, nullptr, &options, forced, call_hint);
+			const uint64_t completion = OS::get_singleton()->get_ticks_usec() - begin;
+			CHECK(options.size() > 0);
+			MESSAGE(vformat("Completion %s: %d usec.", skip ? "analyzing the current function" : "analyzing every function", completion));
+		}
+		GDScriptAnalyzer::skip_bodies_for_completion = true;
+
+		// Smart resolve of a member declared in the script.
+		const int total_line = lines.find("\t\ttotal += scaled");
+		REQUIRE(total_line >= 0);
+		constexpr int lookups = 1000;
+		int related_count = 0;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < lookups; i++) {
+			List<const LSP::DocumentSymbol *> symbols;
+			workspace->resolve_related_symbols(pos_in(uri, pos(total_line, 3)), symbols);
+			related_count = symbols.size();
+		}
+		CHECK(related_count > 0);
+		MESSAGE(vformat("Related symbols: %d usec per lookup.", (OS::get_singleton()->get_ticks_usec() - begin) / lookups));
+
 		memdelete(proto);
 		memdelete(efs);
 		finish_language();
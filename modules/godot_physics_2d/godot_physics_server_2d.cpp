@@ -1296,6 +1296,8 @@ void GodotPhysicsServer2D::init() {
 }
 
 void GodotPhysicsServer2D::step(real_t p_step) {
+	MEMORY_TAG_SCOPE(TAG_PHYSICS);
+
 	if (!active) {
 		return;
 	}
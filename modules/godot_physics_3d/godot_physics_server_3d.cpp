@@ -1680,6 +1680,8 @@ void GodotPhysicsServer3D::init() {
 }
 
 void GodotPhysicsServer3D::step(real_t p_step) {
+	MEMORY_TAG_SCOPE(TAG_PHYSICS);
+
 	if (!active) {
 		return;
 	}
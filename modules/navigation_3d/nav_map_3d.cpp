@@ -435,6 +435,8 @@ void NavMap3D::_sync_iteration() {
 }
 
 void NavMap3D::sync() {
+	MEMORY_TAG_SCOPE(TAG_NAVIGATION);
+
 	// Performance Monitor.
 	performance_data.pm_region_count = regions.size();
 	performance_data.pm_agent_count = agents.size();
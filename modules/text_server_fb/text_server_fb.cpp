@@ -4769,6 +4769,8 @@ int64_t TextServerFallback::_shaped_text_get_ellipsis_glyph_count(const RID &p_s
 }
 
 bool TextServerFallback::_shaped_text_shape(const RID &p_shaped) {
+	MEMORY_TAG_SCOPE(TAG_TEXT);
+
 	ShapedTextDataFallback *sd = shaped_owner.get_or_null(p_shaped);
 	ERR_FAIL_NULL_V(sd, false);
 
@@ -264,6 +264,8 @@ AudioDriver *AudioDriverManager::get_driver(int p_driver) {
 //////////////////////////////////////////////
 
 void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
+	MEMORY_TAG_SCOPE(TAG_AUDIO);
+
 	mix_count++;
 	int todo = p_frames;
 
@@ -222,4 +222,41 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Memory mapped read") {
+	const String path = TestUtils::get_data_path("testdata.csv");
+	const Vector<uint8_t> expected = FileAccess::get_file_as_bytes(path);
+	REQUIRE(!expected.is_empty());
+
+	// Falls back to a regular file on platforms without memory mapping.
+	Error err;
+	Ref<FileAccess> f = FileAccess::open_mapped(path, &err);
+	REQUIRE(f.is_valid());
+	CHECK(err == OK);
+	CHECK(f->get_length() == (uint64_t)expected.size());
+
+	const uint8_t *view = f->get_buffer_view(0, expected.size());
+	if (view) {
+		CHECK(memcmp(view, expected.ptr(), expected.size()) == 0);
+		CHECK(f->get_buffer_view(1, expected.size()) == nullptr);
+		CHECK(f->get_buffer_view(expected.size() + 1, 0) == nullptr);
+	}
+	CHECK(f->get_position() == 0);
+
+	CHECK(f->get_8() == expected[0]);
+	CHECK(f->get_buffer(expected.size()) == expected.slice(1));
+	CHECK(f->eof_reached());
+	CHECK(f->get_error() == ERR_FILE_EOF);
+
+	f->seek(0);
+	CHECK_FALSE(f->eof_reached());
+	CHECK(f->get_as_utf8_string() == String::utf8((const char *)expected.ptr(), expected.size()));
+
+	ERR_PRINT_OFF;
+	CHECK_FALSE(f->store_8(0));
+	ERR_PRINT_ON;
+
+	CHECK(FileAccess::open_mapped(TestUtils::get_data_path("does_not_exist.csv"), &err).is_null());
+	CHECK(err == ERR_FILE_NOT_FOUND);
+}
+
 } // namespace TestFileAccess
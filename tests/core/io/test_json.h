@@ -33,7 +33,9 @@
 #pragma once
 
 #include "core/io/json.h"
+#include "core/os/os.h"
 
+#include "tests/test_utils.h"
 #include "thirdparty/doctest/doctest.h"
 
 namespace TestJSON {
@@ -403,4 +405,247 @@ TEST_CASE("[JSON] Serialization") {
 		}
 	}
 }
+
+TEST_CASE("[JSON] Streaming parser matches parse()") {
+	const String inputs[] = {
+		"null",
+		"  true  ",
+		"-12.5e2",
+		"\"\\u00e9t\\u00e9 \\ud83d\\ude00 \\b\\f\\n\\r\\t\\\"\\\\\\/\"",
+		"\"\\ufeffleading byte order mark\"",
+		"[1, [2, [3, {}]], \"four\", {\"five\": [5]}]",
+		"{\"a\": {\"b\": {\"c\": [true, false, null]}},\n \"d\": \"multi\nline\"}",
+		"[1, 2,]",
+		"[1 2]",
+		"{\"a\" 1}",
+		"{\"a\": 1\n\n\"b\": 2}",
+		"[nope]",
+		"\"unterminated",
+		"\"\\ud800\"",
+		"\"\\udc00\"",
+		"\"\\x\"",
+		"[1]]",
+		"[",
+	};
+
+	for (const String &input : inputs) {
+		JSON json;
+		const Error expected_error = json.parse(input);
+
+		JSON json_stream;
+		const Error error = json_stream.parse_utf8(input.to_utf8_buffer());
+
+		CHECK_MESSAGE(error == expected_error, vformat("Parsing `%s` should return the same error.", input));
+		if (expected_error == OK) {
+			CHECK_MESSAGE(json_stream.get_data() == json.get_data(), vformat("Parsing `%s` should return the same data.", input));
+		} else {
+			CHECK_MESSAGE(json_stream.get_error_line() == json.get_error_line(), vformat("Parsing `%s` should report the same error line.", input));
+			CHECK_MESSAGE(json_stream.get_error_message() == json.get_error_message(), vformat("Parsing `%s` should report the same error message.", input));
+		}
+	}
+
+	// A leading byte order mark is skipped, like `String::utf8()` does.
+	Vector<uint8_t> with_bom = { 0xef, 0xbb, 0xbf };
+	with_bom.append_array(String("{\"bom\": 1}").to_utf8_buffer());
+	JSON json;
+	CHECK(json.parse_utf8(with_bom) == OK);
+	CHECK(json.get_data() == Variant(Dictionary({ { "bom", 1.0 } })));
+
+	CHECK(json.parse_utf8(String("[").repeat(Variant::MAX_RECURSION_DEPTH + 2).to_utf8_buffer()) == ERR_OUT_OF_MEMORY);
+	CHECK(json.get_error_message() == "JSON structure is too deep");
+}
+
+TEST_CASE("[JSON] Streaming parser reads files across chunk boundaries") {
+	Array array;
+	for (int i = 0; i < 20000; i++) {
+		Dictionary entry;
+		entry["index"] = i;
+		entry["name"] = vformat(U"entry \"%d\" \u00e9\u00e8 \U0001F600", i);
+		entry["tags"] = Array({ "a\\b", "\n" });
+		array.push_back(entry);
+	}
+	const String text = JSON::stringify(array, "\t");
+
+	const String path = TestUtils::get_temp_path("stream.json");
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(file.is_valid());
+		file->store_string(text);
+	}
+	Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(file.is_valid());
+	CHECK(file->get_length() > JSONStreamParser::CHUNK_SIZE * 4);
+
+	JSON json_stream;
+	CHECK(json_stream.parse_file(file) == OK);
+	JSON json;
+	CHECK(json.parse(text) == OK);
+	CHECK(json_stream.get_data() == json.get_data());
+}
+
+class JSONEventRecorder : public JSONStreamHandler {
+public:
+	String events;
+
+	virtual Error begin_object() override {
+		events += "{ ";
+		return OK;
+	}
+	virtual Error end_object() override {
+		events += "} ";
+		return OK;
+	}
+	virtual Error begin_array() override {
+		events += "[ ";
+		return OK;
+	}
+	virtual Error end_array() override {
+		events += "] ";
+		return OK;
+	}
+	virtual Error key(const String &p_key) override {
+		events += p_key + ": ";
+		return OK;
+	}
+	virtual Error value(const Variant &p_value) override {
+		events += p_value.stringify() + " ";
+		if (p_value == Variant("stop")) {
+			return ERR_SKIP;
+		}
+		return OK;
+	}
+};
+
+TEST_CASE("[JSON] Streaming parser events") {
+	JSONStreamParser parser;
+	JSONEventRecorder recorder;
+
+	const CharString input = String("{\"a\": [1, \"two\", null], \"b\": {\"c\": false}}").utf8();
+	CHECK(parser.parse((const uint8_t *)input.get_data(), input.length(), &recorder) == OK);
+	CHECK(recorder.events == "{ a: [ 1.0 two <null> ] b: { c: false } } ");
+
+	SUBCASE("Errors returned by the handler stop parsing") {
+		recorder.events = String();
+		const CharString stopping = String("[1, \"stop\", 3]").utf8();
+		CHECK(parser.parse((const uint8_t *)stopping.get_data(), stopping.length(), &recorder) == ERR_SKIP);
+		CHECK(recorder.events == "[ 1.0 stop ");
+	}
+
+	SUBCASE("Syntax errors report the line") {
+		const CharString broken = String("{\n\"a\": [1,\n2,\n}").utf8();
+		CHECK(parser.parse((const uint8_t *)broken.get_data(), broken.length(), &recorder) == ERR_PARSE_ERROR);
+		CHECK(parser.get_error_line() == 3);
+		CHECK(parser.get_error_message() == "Expected value, got '}'");
+	}
+}
+
+TEST_CASE("[JSON] Streaming writer matches stringify()") {
+	Dictionary nested;
+	nested["z"] = Array();
+	nested["y"] = Dictionary();
+	nested["x"] = Array({ 1, 2.5, "three", Variant(), true });
+	Dictionary data;
+	data["b"] = nested;
+	data["a"] = U"\u00e9t\u00e9 \"quoted\"\n";
+	data["c"] = Array({ Array({ nested }), 1.0 / 3.0 });
+
+	const String path = TestUtils::get_temp_path("writer.json");
+	const String indents[] = { "", "\t", "  " };
+	for (const String &indent : indents) {
+		for (int sort_keys = 0; sort_keys < 2; sort_keys++) {
+			{
+				Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+				REQUIRE(file.is_valid());
+				CHECK(JSON::stringify_to_file(file, data, indent, sort_keys, true) == OK);
+			}
+			CHECK(FileAccess::get_file_as_string(path) == JSON::stringify(data, indent, sort_keys, true));
+		}
+	}
+
+	SUBCASE("Writing events") {
+		{
+			Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+			REQUIRE(file.is_valid());
+			JSONStreamWriter writer(file, "\t", false);
+			writer.begin_object();
+			writer.key("b");
+			writer.value(nested);
+			writer.key("a");
+			writer.value(data["a"]);
+			writer.key("c");
+			writer.begin_array();
+			writer.begin_array();
+			writer.begin_object();
+			writer.key("z");
+			writer.begin_array();
+			writer.end_array();
+			writer.key("y");
+			writer.value(Dictionary());
+			writer.key("x");
+			writer.value(nested["x"]);
+			writer.end_object();
+			writer.end_array();
+			writer.value(1.0 / 3.0);
+			writer.end_array();
+			writer.end_object();
+			CHECK(writer.flush() == OK);
+		}
+		CHECK(FileAccess::get_file_as_string(path) == JSON::stringify(data, "\t", false));
+	}
+
+	SUBCASE("Round trip through the streaming parser") {
+		{
+			Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+			REQUIRE(file.is_valid());
+			CHECK(JSON::stringify_to_file(file, data, "\t", true, true) == OK);
+		}
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::READ);
+		REQUIRE(file.is_valid());
+		JSON json;
+		CHECK(json.parse_file(file) == OK);
+		CHECK(JSON::stringify(json.get_data(), "\t", true, true) == JSON::stringify(data, "\t", true, true));
+	}
+}
+
+TEST_CASE("[JSON][Benchmark] Streaming a large file compared to parse() and stringify()" * doctest::skip()) {
+	Array array;
+	for (int i = 0; i < 200000; i++) {
+		Dictionary entry;
+		entry["id"] = i;
+		entry["name"] = vformat("entry %d", i);
+		entry["position"] = Array({ i * 0.5, i * 0.25, i * 0.125 });
+		entry["enabled"] = (i % 2) == 0;
+		array.push_back(entry);
+	}
+	const String path = TestUtils::get_temp_path("benchmark.json");
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		file->store_string(JSON::stringify(array, "\t"));
+	}
+	const uint64_t stringify_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	JSON json;
+	CHECK(json.parse(FileAccess::get_file_as_string(path)) == OK);
+	const uint64_t parse_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	{
+		Ref<FileAccess> file = FileAccess::open(path, FileAccess::WRITE);
+		CHECK(JSON::stringify_to_file(file, array, "\t") == OK);
+	}
+	const uint64_t stream_write_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	JSON json_stream;
+	CHECK(json_stream.parse_file(FileAccess::open(path, FileAccess::READ)) == OK);
+	const uint64_t stream_parse_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(json_stream.get_data() == json.get_data());
+	MESSAGE(vformat("stringify() + store_string(): %d usec, stringify_to_file(): %d usec.", stringify_usec, stream_write_usec));
+	MESSAGE(vformat("get_file_as_string() + parse(): %d usec, parse_file(): %d usec.", parse_usec, stream_parse_usec));
+}
+
 } // namespace TestJSON
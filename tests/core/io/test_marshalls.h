@@ -33,6 +33,7 @@
 #pragma once
 
 #include "core/io/marshalls.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -491,4 +492,180 @@ TEST_CASE("[Marshalls] Typed dictionary decoding") {
 	CHECK(dictionary[Variant(uint64_t(0x0f123456789abcdef))] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+static Vector<uint8_t> _encode_two_pass(const Variant &p_variant, bool p_full_objects = false) {
+	int len;
+	Vector<uint8_t> buffer;
+	if (encode_variant(p_variant, nullptr, len, p_full_objects) != OK) {
+		return buffer;
+	}
+	buffer.resize(len);
+	encode_variant(p_variant, buffer.ptrw(), len, p_full_objects);
+	return buffer;
+}
+
+TEST_CASE("[Marshalls] Appending Variant encoding matches encode_variant()") {
+	Array typed_array;
+	typed_array.set_typed(Variant::STRING, StringName(), Variant());
+	typed_array.push_back("typed");
+
+	Dictionary nested;
+	nested["name"] = String(U"Redot \u00e9");
+	nested[StringName("id")] = 42;
+	nested[Vector2(1, 2)] = PackedInt32Array({ 1, 2, 3 });
+
+	const Vector<Variant> variants = {
+		Variant(),
+		true,
+		int64_t(0x0f123456789abcdef),
+		0.5,
+		"",
+		"abc",
+		"abcd",
+		StringName("name"),
+		NodePath("a/b:c"),
+		Vector3(1, 2, 3),
+		Color(0.1, 0.2, 0.3, 0.4),
+		PackedByteArray({ 1, 2, 3 }),
+		PackedFloat64Array({ 0.25, 0.5 }),
+		PackedStringArray({ "", "a", "ab", "abc", "abcd" }),
+		PackedVector2Array({ Vector2(1, 2) }),
+		typed_array,
+		Array({ 1, "two", Array({ 3.0 }), nested }),
+		nested,
+	};
+
+	for (const Variant &variant : variants) {
+		const Vector<uint8_t> expected = _encode_two_pass(variant);
+
+		Vector<uint8_t> vector_buffer;
+		CHECK(encode_variant_append(variant, vector_buffer) == OK);
+		CHECK_MESSAGE(vector_buffer == expected, Variant::get_type_name(variant.get_type()));
+
+		// Existing bytes are left in place and the encoding follows them.
+		LocalVector<uint8_t> local_buffer;
+		local_buffer.push_back(0xff);
+		CHECK(encode_variant_append(variant, local_buffer) == OK);
+		REQUIRE(local_buffer.size() == uint32_t(expected.size() + 1));
+		CHECK(local_buffer[0] == 0xff);
+		CHECK(memcmp(local_buffer.ptr() + 1, expected.ptr(), expected.size()) == 0);
+
+		Variant decoded;
+		int r_len;
+		CHECK(decode_variant(decoded, vector_buffer.ptr(), vector_buffer.size(), &r_len) == OK);
+		CHECK(r_len == vector_buffer.size());
+		CHECK(decoded == variant);
+	}
+}
+
+TEST_CASE("[Marshalls] Appending encoding stops at the maximum size") {
+	Array array;
+	for (int i = 0; i < 1000; i++) {
+		array.push_back(i);
+	}
+	const Vector<uint8_t> expected = _encode_two_pass(array);
+
+	LocalVector<uint8_t> buffer;
+	CHECK(encode_variant_append(array, buffer, false, 64) == ERR_PARAMETER_RANGE_ERROR);
+	CHECK_MESSAGE(buffer.size() <= 64, "Encoding should stop before going over the maximum size.");
+
+	buffer.clear();
+	CHECK(encode_variant_append(array, buffer, false, expected.size()) == OK);
+	CHECK(buffer.size() == uint32_t(expected.size()));
+}
+
+TEST_CASE("[Marshalls] Packed array decoding reuses the existing storage") {
+	PackedInt64Array source;
+	for (int i = 0; i < 64; i++) {
+		source.push_back(int64_t(i) << 33);
+	}
+	const Vector<uint8_t> encoded = _encode_two_pass(source);
+
+	PackedInt64Array initial;
+	initial.resize(64);
+	Variant variant = initial;
+	initial = PackedInt64Array(); // The variant holds the only reference now.
+	const int64_t *storage = PackedInt64Array(variant).ptr();
+
+	CHECK(decode_variant(variant, encoded.ptr(), encoded.size()) == OK);
+	CHECK(variant == Variant(source));
+	CHECK(PackedInt64Array(variant).ptr() == storage);
+
+	// An array that is referenced elsewhere must be left untouched.
+	const PackedInt64Array shared = variant;
+	const PackedInt64Array other = { 1, 2, 3 };
+	const Vector<uint8_t> encoded_other = _encode_two_pass(other);
+	CHECK(decode_variant(variant, encoded_other.ptr(), encoded_other.size()) == OK);
+	CHECK(variant == Variant(other));
+	CHECK(shared == source);
+}
+
+TEST_CASE("[Marshalls][Benchmark] Appending and two pass Variant encoding" * doctest::skip()) {
+	Dictionary packet;
+	packet["id"] = 17;
+	packet["name"] = "player";
+	packet["position"] = Vector3(1, 2, 3);
+	packet["inputs"] = Array({ true, false, 0.5 });
+
+	Dictionary save;
+	for (int i = 0; i < 20000; i++) {
+		Dictionary entry;
+		entry["name"] = vformat("entry %d", i);
+		entry["tags"] = PackedStringArray({ "a", "bc", "def" });
+		entry["values"] = PackedFloat32Array({ 0.5f, 1.5f, 2.5f, 3.5f });
+		save[i] = entry;
+	}
+	PackedInt32Array samples;
+	samples.resize(1 << 20);
+	save["samples"] = samples;
+
+	struct Payload {
+		const char *name;
+		Variant value;
+		int iterations;
+	};
+	const Payload payloads[] = { { "network", packet, 100000 }, { "save file", save, 10 } };
+
+	for (const Payload &payload : payloads) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < payload.iterations; i++) {
+			_encode_two_pass(payload.value);
+		}
+		const uint64_t two_pass_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		LocalVector<uint8_t> buffer;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < payload.iterations; i++) {
+			buffer.clear();
+			encode_variant_append(payload.value, buffer);
+		}
+		const uint64_t append_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < payload.iterations; i++) {
+			Variant decoded;
+			decode_variant(decoded, buffer.ptr(), buffer.size());
+		}
+		const uint64_t decode_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		MESSAGE(vformat("%s (%d bytes): two pass encoding %d usec, appending encoding %d usec, decoding %d usec.", payload.name, buffer.size(), two_pass_usec, append_usec, decode_usec));
+	}
+
+	const Vector<uint8_t> encoded_samples = _encode_two_pass(samples);
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 100; i++) {
+		Variant decoded;
+		decode_variant(decoded, encoded_samples.ptr(), encoded_samples.size());
+	}
+	const uint64_t fresh_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Variant reused;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < 100; i++) {
+		decode_variant(reused, encoded_samples.ptr(), encoded_samples.size());
+	}
+	const uint64_t reused_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	MESSAGE(vformat("Packed array decoding: %d usec into a new Variant, %d usec into a reused one.", fresh_usec, reused_usec));
+}
+
 } // namespace TestMarshalls
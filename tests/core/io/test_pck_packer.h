@@ -34,6 +34,8 @@
 
 #include "core/io/file_access_pack.h"
 #include "core/io/pck_packer.h"
+#include "core/math/random_pcg.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
 
 #include "tests/test_utils.h"
@@ -63,6 +65,10 @@ TEST_CASE("[PCKPacker] Pack an empty PCK file") {
 	CHECK_MESSAGE(
 			f->get_length() <= 500,
 			"The generated empty PCK file shouldn't be too large.");
+	CHECK(f->get_32() == PACK_HEADER_MAGIC);
+	CHECK_MESSAGE(
+			f->get_32() == PACK_FORMAT_VERSION_V3,
+			"PCK files without compressed files should stay readable by older versions.");
 }
 
 TEST_CASE("[PCKPacker] Pack empty with zero alignment invalid") {
@@ -118,4 +124,239 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+TEST_CASE("[PCKPacker] Read packed files through a shared memory mapping") {
+	const String pack_path = TestUtils::get_temp_path("mapped.pck");
+	Vector<uint8_t> contents;
+	for (int i = 0; i < 10000; i++) {
+		contents.push_back(uint8_t(i * 7));
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(pack_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(contents);
+	}
+
+	PackedData::PackedFile pf;
+	pf.pack = pack_path;
+	pf.offset = 1000;
+	pf.size = 5000;
+	pf.encrypted = false;
+	pf.bundle = false;
+	const Vector<uint8_t> expected = contents.slice(pf.offset, pf.offset + pf.size);
+
+	Ref<FileAccess> mapped_pack = FileAccess::open_mapped(pack_path);
+	REQUIRE(mapped_pack.is_valid());
+	Ref<FileAccess> mapped = memnew(FileAccessPack("res://mapped.bin", pf, mapped_pack));
+	Ref<FileAccess> unmapped = memnew(FileAccessPack("res://mapped.bin", pf));
+
+	CHECK(mapped->get_length() == pf.size);
+	CHECK(mapped->get_buffer(2000) == expected.slice(0, 2000));
+	CHECK(unmapped->get_buffer(2000) == expected.slice(0, 2000));
+	CHECK(mapped->get_32() == unmapped->get_32());
+
+	mapped->seek(4990);
+	CHECK(mapped->get_buffer(100) == expected.slice(4990));
+	CHECK(mapped->eof_reached());
+
+	if (mapped_pack->get_buffer_view(0, contents.size())) {
+		const uint8_t *view = mapped->get_buffer_view(100, 200);
+		REQUIRE(view != nullptr);
+		CHECK(memcmp(view, expected.ptr() + 100, 200) == 0);
+		CHECK(mapped->get_buffer_view(100, pf.size) == nullptr);
+	}
+	// The shared mapping outlives closing a file read from it.
+	mapped->close();
+	CHECK(mapped_pack->is_open());
+}
+
+TEST_CASE("[PCKPacker][Benchmark] Reading packed files with and without a memory mapping" * doctest::skip()) {
+	// Reads hit the page cache after the pack is written. For cold cache numbers,
+	// drop the caches (e.g. `/proc/sys/vm/drop_caches` on Linux) between runs.
+	const int file_count = 4096;
+	const int file_size = 64 * 1024;
+	const String pack_path = TestUtils::get_temp_path("benchmark.pck");
+	{
+		Ref<FileAccess> f = FileAccess::open(pack_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		Vector<uint8_t> chunk;
+		chunk.resize_initialized(file_size);
+		for (int i = 0; i < file_count; i++) {
+			chunk.write[0] = uint8_t(i);
+			f->store_buffer(chunk);
+		}
+	}
+
+	PackedData::PackedFile pf;
+	pf.pack = pack_path;
+	pf.size = file_size;
+	pf.encrypted = false;
+	pf.bundle = false;
+
+	uint64_t checksum = 0;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < file_count; i++) {
+		pf.offset = (uint64_t)i * file_size;
+		Ref<FileAccess> f = memnew(FileAccessPack("res://file.bin", pf));
+		checksum += f->get_buffer(file_size)[0];
+	}
+	const uint64_t unmapped_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Ref<FileAccess> mapped_pack = FileAccess::open_mapped(pack_path);
+	uint64_t mapped_checksum = 0;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < file_count; i++) {
+		pf.offset = (uint64_t)i * file_size;
+		Ref<FileAccess> f = memnew(FileAccessPack("res://file.bin", pf, mapped_pack));
+		mapped_checksum += f->get_buffer(file_size)[0];
+	}
+	const uint64_t mapped_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	CHECK(checksum == mapped_checksum);
+	MESSAGE(vformat("%d files of %d KiB: %d usec unmapped, %d usec mapped.", file_count, file_size / 1024, unmapped_usec, mapped_usec));
+}
+
+TEST_CASE("[PCKPacker] Pack and read a PCK file with compressed blocks") {
+	REQUIRE(PackedData::get_singleton());
+
+	// Text compresses well, random bytes don't and are stored as is.
+	const String text_path = TestUtils::get_temp_path("compressed_text.txt");
+	const String random_path = TestUtils::get_temp_path("compressed_random.bin");
+	Vector<uint8_t> text;
+	for (int i = 0; text.size() < 300000; i++) {
+		text.append_array(vformat("Line %d of a text that compresses well.\n", i).to_utf8_buffer());
+	}
+	Vector<uint8_t> random;
+	RandomPCG rng(42);
+	for (int i = 0; i < 70000; i++) {
+		random.push_back(uint8_t(rng.rand()));
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(text_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(text);
+		f = FileAccess::open(random_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(random);
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_compressed.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	ERR_PRINT_OFF;
+	pck_packer.set_compression_block_size(100);
+	ERR_PRINT_ON;
+	CHECK(pck_packer.get_compression_block_size() == 0);
+	pck_packer.set_compression_block_size(64 * 1024);
+	CHECK(pck_packer.get_compression_block_size() == 64 * 1024);
+	CHECK(pck_packer.add_file("pck_packer_compressed/text.txt", text_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_compressed/random.bin", random_path) == OK);
+	CHECK(pck_packer.flush() == OK);
+
+	CHECK_MESSAGE(
+			FileAccess::get_size(output_pck_path) < text.size() / 2 + random.size() + 4096,
+			"The compressed PCK file should be smaller than its contents.");
+	{
+		Ref<FileAccess> header = FileAccess::open(output_pck_path, FileAccess::READ);
+		REQUIRE(header.is_valid());
+		CHECK(header->get_32() == PACK_HEADER_MAGIC);
+		CHECK_MESSAGE(
+				header->get_32() == PACK_FORMAT_VERSION_V4,
+				"PCK files with compressed files should use a version older readers reject.");
+	}
+
+	REQUIRE(PackedData::get_singleton()->add_pack(output_pck_path, true, 0) == OK);
+
+	Ref<FileAccess> f = FileAccess::open("res://pck_packer_compressed/text.txt", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(f->get_length() == (uint64_t)text.size());
+	CHECK(f->get_buffer(text.size()) == text);
+
+	// Reads across block boundaries only decompress the blocks they need.
+	f->seek(64 * 1024 - 10);
+	CHECK(f->get_buffer(64 * 1024 + 20) == text.slice(64 * 1024 - 10, 128 * 1024 + 10));
+	f->seek(text.size() - 2);
+	CHECK(f->get_buffer(10) == text.slice(text.size() - 2));
+	CHECK(f->eof_reached());
+	CHECK(f->get_buffer_view(0, 1) == nullptr);
+
+	f = FileAccess::open("res://pck_packer_compressed/random.bin", FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(65534);
+	CHECK(f->get_buffer(4) == random.slice(65534, 65538));
+	f->seek(0);
+	CHECK(f->get_buffer(random.size()) == random);
+
+	PackedData::get_singleton()->remove_path("pck_packer_compressed/text.txt");
+	PackedData::get_singleton()->remove_path("pck_packer_compressed/random.bin");
+}
+
+struct BenchmarkLoad {
+	String prefix;
+	int64_t size = 0;
+	std::atomic<int> loaded = { 0 };
+};
+
+static void _benchmark_load_file(void *p_userdata, uint32_t p_index) {
+	BenchmarkLoad *load = static_cast<BenchmarkLoad *>(p_userdata);
+	Ref<FileAccess> f = FileAccess::open("res://" + load->prefix + itos(p_index), FileAccess::READ);
+	if (f.is_valid() && f->get_buffer(f->get_length()).size() == load->size) {
+		load->loaded.fetch_add(1);
+	}
+}
+
+TEST_CASE("[PCKPacker][Benchmark] Loading files from raw and compressed PCK files" * doctest::skip()) {
+	REQUIRE(PackedData::get_singleton());
+
+	const int file_count = 256;
+	const String source_path = TestUtils::get_temp_path("benchmark_source.txt");
+	Vector<uint8_t> contents;
+	for (int i = 0; contents.size() < 1024 * 1024; i++) {
+		contents.append_array(vformat("Resource line %d with some repeated content.\n", i % 5000).to_utf8_buffer());
+	}
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(contents);
+	}
+
+	const char *kinds[] = { "raw", "compressed" };
+	for (int kind = 0; kind < 2; kind++) {
+		const String pck_path = TestUtils::get_temp_path(vformat("benchmark_%s.pck", kinds[kind]));
+		const String prefix = vformat("pck_packer_benchmark_%s/", kinds[kind]);
+
+		PCKPacker pck_packer;
+		REQUIRE(pck_packer.pck_start(pck_path) == OK);
+		pck_packer.set_compression_block_size(kind == 1 ? 64 * 1024 : 0);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			pck_packer.add_file(prefix + itos(i), source_path);
+		}
+		REQUIRE(pck_packer.flush() == OK);
+		const uint64_t pack_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < file_count; i++) {
+			Ref<FileAccess> f = FileAccess::open("res://" + prefix + itos(i), FileAccess::READ);
+			CHECK(f->get_buffer(f->get_length()).size() == contents.size());
+		}
+		const uint64_t load_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		// Blocks are decompressed with a context per thread, so threaded loads don't wait for each other.
+		BenchmarkLoad load;
+		load.prefix = prefix;
+		load.size = contents.size();
+		begin = OS::get_singleton()->get_ticks_usec();
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(_benchmark_load_file, &load, file_count);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		const uint64_t threaded_load_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(load.loaded.load() == file_count);
+
+		for (int i = 0; i < file_count; i++) {
+			PackedData::get_singleton()->remove_path(prefix + itos(i));
+		}
+		MESSAGE(vformat("%s: %d KiB, packed in %d usec, loaded in %d usec, %d usec on %d threads.", kinds[kind], FileAccess::get_size(pck_path) / 1024, pack_usec, load_usec, threaded_load_usec, WorkerThreadPool::get_singleton()->get_thread_count()));
+	}
+}
+
 } // namespace TestPCKPacker
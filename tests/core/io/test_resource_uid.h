@@ -32,11 +32,17 @@
 
 #pragma once
 
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
 #include "core/io/resource_uid.h"
+#include "core/io/stream_peer.h"
+#include "core/os/os.h"
 
 #include "thirdparty/doctest/doctest.h"
 
+#include "tests/core/config/test_project_settings.h"
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestResourceUID {
 
@@ -67,4 +73,192 @@ TEST_CASE("[ResourceUID] Must encode and decode various UIDs correctly") {
 	CHECK_MESSAGE(rid->text_to_id("uid://dm3rdgs30kfci") == 8060368642360689600, "A normal UID must decode correctly.");
 }
 
+struct CacheEntry {
+	ResourceUID::ID id = ResourceUID::INVALID_ID;
+	String path;
+};
+
+static void _put_cache_record(Ref<StreamPeerBuffer> &p_buffer, const CacheEntry &p_entry) {
+	const Vector<uint8_t> path = p_entry.path.to_utf8_buffer();
+	p_buffer->put_64(p_entry.id);
+	p_buffer->put_u32(path.size());
+	p_buffer->put_data(path.ptr(), path.size());
+}
+
+// The cache files are built by hand, so that reading them doesn't depend on the writer.
+static Vector<uint8_t> _make_legacy_cache(const Vector<CacheEntry> &p_entries) {
+	Ref<StreamPeerBuffer> file;
+	file.instantiate();
+	file->put_u32(p_entries.size());
+	for (const CacheEntry &entry : p_entries) {
+		_put_cache_record(file, entry);
+	}
+	return file->get_data_array();
+}
+
+static Vector<uint8_t> _make_table_cache(const Vector<CacheEntry> &p_sorted, const Vector<CacheEntry> &p_appended) {
+	Ref<StreamPeerBuffer> entries;
+	entries.instantiate();
+	Vector<uint8_t> strings;
+	for (const CacheEntry &entry : p_sorted) {
+		const Vector<uint8_t> path = entry.path.to_utf8_buffer();
+		entries->put_64(entry.id);
+		entries->put_u32(strings.size());
+		entries->put_u32(path.size());
+		strings.append_array(path);
+	}
+
+	Ref<StreamPeerBuffer> file;
+	file.instantiate();
+	file->put_u32(0x43444955); // "UIDC"
+	file->put_u32(1); // Version.
+	file->put_u32(p_sorted.size());
+	file->put_u32(p_appended.size());
+	file->put_u64(strings.size());
+	file->put_data(entries->get_data_array().ptr(), entries->get_size());
+	file->put_data(strings.ptr(), strings.size());
+	for (const CacheEntry &entry : p_appended) {
+		_put_cache_record(file, entry);
+	}
+	return file->get_data_array();
+}
+
+// Makes the cache file available at its usual path through a pack, like in exported projects.
+static Error _pack_cache_file(const Vector<uint8_t> &p_data) {
+	const String source_path = TestUtils::get_temp_path("uid_cache.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		ERR_FAIL_COND_V(f.is_null(), ERR_CANT_CREATE);
+		f->store_buffer(p_data);
+	}
+
+	PCKPacker pck_packer;
+	const String pck_path = TestUtils::get_temp_path("uid_cache.pck");
+	Error err = pck_packer.pck_start(pck_path);
+	if (err == OK) {
+		err = pck_packer.add_file(ResourceUID::get_cache_file(), source_path);
+	}
+	if (err == OK) {
+		err = pck_packer.flush();
+	}
+	if (err == OK) {
+		err = PackedData::get_singleton()->add_pack(pck_path, true, 0);
+	}
+	return err;
+}
+
+TEST_CASE("[ResourceUID] Load a sorted cache table") {
+	ResourceUID *rid = ResourceUID::get_singleton();
+	const Vector<uint8_t> data = _make_table_cache(
+			{ { 5, "res://a.tscn" }, { 1000, String(U"res://\u00e9.png") }, { 0x7fffffffffffffff, "res://c.gd" } },
+			{ { 1000, "res://moved.png" }, { 42, "res://new.gd" } });
+	REQUIRE(_pack_cache_file(data) == OK);
+	REQUIRE(rid->load_from_cache(true) == OK);
+
+	CHECK(rid->has_id(5));
+	CHECK(rid->get_id_path(5) == "res://a.tscn");
+	CHECK(rid->get_id_path(0x7fffffffffffffff) == "res://c.gd");
+	CHECK_MESSAGE(rid->get_id_path(1000) == "res://moved.png", "Appended entries must take precedence over the table.");
+	CHECK(rid->get_id_path(42) == "res://new.gd");
+	CHECK_FALSE(rid->has_id(6));
+
+	rid->set_id(5, "res://renamed.tscn");
+	CHECK(rid->get_id_path(5) == "res://renamed.tscn");
+	rid->remove_id(0x7fffffffffffffff);
+	CHECK_FALSE(rid->has_id(0x7fffffffffffffff));
+	rid->add_id(0x7fffffffffffffff, "res://readded.gd");
+	CHECK(rid->get_id_path(0x7fffffffffffffff) == "res://readded.gd");
+
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_temp_path("uid_cache.bin"), FileAccess::READ);
+	REQUIRE(f.is_valid());
+	CHECK(ResourceUID::get_path_from_cache(f, rid->id_to_text(1000)) == "res://moved.png");
+	f->seek(0);
+	CHECK(ResourceUID::get_path_from_cache(f, rid->id_to_text(0x7fffffffffffffff)) == "res://c.gd");
+	f->seek(0);
+	CHECK(ResourceUID::get_path_from_cache(f, rid->id_to_text(6)).is_empty());
+
+	rid->clear();
+	PackedData::get_singleton()->remove_path(ResourceUID::get_cache_file());
+}
+
+TEST_CASE("[ResourceUID] Save over a cache table mapped from disk") {
+	ResourceUID *rid = ResourceUID::get_singleton();
+	const String old_resource_path = TestProjectSettingsInternalsAccessor::resource_path();
+	TestProjectSettingsInternalsAccessor::resource_path() = TestUtils::get_temp_path("uid_cache_project");
+	const String cache_file = ProjectSettings::get_singleton()->globalize_path(ResourceUID::get_cache_file());
+	DirAccess::make_dir_recursive_absolute(cache_file.get_base_dir());
+	{
+		Ref<FileAccess> f = FileAccess::open(cache_file, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(_make_table_cache({ { 5, "res://a.tscn" }, { 1000, "res://b.png" } }, { { 42, "res://c.gd" } }));
+	}
+	REQUIRE(rid->load_from_cache(true) == OK);
+
+	// Without a backup save, the file is truncated in place while the table is read from it.
+	const bool was_backup_save_enabled = FileAccess::is_backup_save_enabled();
+	FileAccess::set_backup_save(false);
+	rid->add_id(7, "res://d.tres");
+	CHECK(rid->save_to_cache() == OK);
+	FileAccess::set_backup_save(was_backup_save_enabled);
+
+	CHECK(rid->get_id_path(5) == "res://a.tscn");
+	CHECK(rid->get_id_path(1000) == "res://b.png");
+
+	REQUIRE(rid->load_from_cache(true) == OK);
+	CHECK(rid->get_id_path(5) == "res://a.tscn");
+	CHECK(rid->get_id_path(7) == "res://d.tres");
+	CHECK(rid->get_id_path(42) == "res://c.gd");
+	CHECK(rid->get_id_path(1000) == "res://b.png");
+
+	rid->clear();
+	TestProjectSettingsInternalsAccessor::resource_path() = old_resource_path;
+}
+
+TEST_CASE("[ResourceUID] Load a legacy cache file") {
+	ResourceUID *rid = ResourceUID::get_singleton();
+	REQUIRE(_pack_cache_file(_make_legacy_cache({ { 7, "res://b.tscn" }, { 3, "res://a.tscn" } })) == OK);
+	REQUIRE(rid->load_from_cache(true) == OK);
+
+	CHECK(rid->get_id_path(3) == "res://a.tscn");
+	CHECK(rid->get_id_path(7) == "res://b.tscn");
+	CHECK_FALSE(rid->has_id(5));
+
+	rid->clear();
+	PackedData::get_singleton()->remove_path(ResourceUID::get_cache_file());
+}
+
+TEST_CASE("[ResourceUID][Benchmark] Loading a large cache file" * doctest::skip()) {
+	ResourceUID *rid = ResourceUID::get_singleton();
+	const int entry_count = 400000;
+	const int lookup_count = 100000;
+
+	Vector<CacheEntry> entries;
+	entries.resize(entry_count);
+	for (int i = 0; i < entry_count; i++) {
+		entries.write[i] = { ResourceUID::ID(i) * 2654435761, vformat("res://assets/level_%d/resource_%d.tres", i / 1000, i) };
+	}
+
+	const char *layouts[] = { "legacy", "table" };
+	for (int layout = 0; layout < 2; layout++) {
+		REQUIRE(_pack_cache_file(layout == 0 ? _make_legacy_cache(entries) : _make_table_cache(entries, Vector<CacheEntry>())) == OK);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		REQUIRE(rid->load_from_cache(true) == OK);
+		const uint64_t load_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		int found = 0;
+		begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < lookup_count; i++) {
+			found += !rid->get_id_path(ResourceUID::ID(i * 3) * 2654435761).is_empty();
+		}
+		const uint64_t lookup_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(found == lookup_count);
+
+		MESSAGE(vformat("%s: loaded %d entries in %d usec, %d lookups in %d usec.", layouts[layout], entry_count, load_usec, lookup_count, lookup_usec));
+	}
+
+	rid->clear();
+	PackedData::get_singleton()->remove_path(ResourceUID::get_cache_file());
+}
+
 } // namespace TestResourceUID
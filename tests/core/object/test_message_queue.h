@@ -0,0 +1,218 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+class CallRecorder : public Object {
+public:
+	LocalVector<int> producers;
+	LocalVector<int> values;
+
+	void record(int p_producer, int p_value) {
+		producers.push_back(p_producer);
+		values.push_back(p_value);
+	}
+};
+
+struct PushState {
+	CallQueue *queue = nullptr;
+	CallRecorder *recorder = nullptr;
+	int calls_per_thread = 0;
+	SafeNumeric<int> next_producer;
+	SafeNumeric<int> push_errors;
+
+	static void thread_loop(void *p_user) {
+		PushState *state = (PushState *)p_user;
+		const int producer = state->next_producer.increment();
+		const Callable callable = callable_mp(state->recorder, &CallRecorder::record);
+		for (int i = 0; i < state->calls_per_thread; i++) {
+			if (state->queue->push_callable(callable, producer, i) != OK) {
+				state->push_errors.increment();
+			}
+		}
+	}
+};
+
+TEST_CASE("[MessageQueue] Calls are flushed in push order") {
+	CallQueue queue;
+	CallRecorder recorder;
+	const Callable callable = callable_mp(&recorder, &CallRecorder::record);
+
+	for (int i = 0; i < 2000; i++) {
+		CHECK(queue.push_callable(callable, 0, i) == OK);
+	}
+	CHECK(queue.has_messages());
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(recorder.values.size() == 2000);
+	bool in_order = true;
+	for (int i = 0; i < 2000; i++) {
+		in_order = in_order && recorder.values[i] == i;
+	}
+	CHECK(in_order);
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from several threads keep their per-thread order") {
+	CallQueue queue;
+	CallRecorder recorder;
+
+	PushState state;
+	state.queue = &queue;
+	state.recorder = &recorder;
+	state.calls_per_thread = 5000;
+
+	const int thread_count = 4;
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].start(&PushState::thread_loop, &state);
+	}
+	// Flushing while the producers are still pushing must not lose or reorder calls.
+	for (int i = 0; i < 100; i++) {
+		CHECK(queue.flush() == OK);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	CHECK(queue.flush() == OK);
+
+	CHECK(state.push_errors.get() == 0);
+	REQUIRE(recorder.values.size() == uint32_t(thread_count * state.calls_per_thread));
+
+	int expected[thread_count + 1] = {};
+	int order_errors = 0;
+	for (uint32_t i = 0; i < recorder.values.size(); i++) {
+		int &next = expected[recorder.producers[i]];
+		if (recorder.values[i] != next) {
+			order_errors++;
+		}
+		next = recorder.values[i] + 1;
+	}
+	CHECK(order_errors == 0);
+	CHECK_FALSE(queue.has_messages());
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from many short-lived threads are all flushed") {
+	CallQueue queue;
+	CallRecorder recorder;
+
+	PushState state;
+	state.queue = &queue;
+	state.recorder = &recorder;
+	state.calls_per_thread = 50;
+
+	// More concurrent producers than the queue keeps buffers for, then a series of threads
+	// that exit one after another and hand their buffers over.
+	const int concurrent_count = 100;
+	const int sequential_count = 100;
+	Thread threads[concurrent_count];
+	for (int i = 0; i < concurrent_count; i++) {
+		threads[i].start(&PushState::thread_loop, &state);
+	}
+	for (int i = 0; i < concurrent_count; i++) {
+		threads[i].wait_to_finish();
+	}
+	for (int i = 0; i < sequential_count; i++) {
+		Thread thread;
+		thread.start(&PushState::thread_loop, &state);
+		thread.wait_to_finish();
+	}
+	CHECK(queue.flush() == OK);
+
+	CHECK(state.push_errors.get() == 0);
+	REQUIRE(recorder.values.size() == uint32_t((concurrent_count + sequential_count) * state.calls_per_thread));
+
+	LocalVector<int> expected;
+	expected.resize_initialized(concurrent_count + sequential_count + 1);
+	int order_errors = 0;
+	for (uint32_t i = 0; i < recorder.values.size(); i++) {
+		int &next = expected[recorder.producers[i]];
+		if (recorder.values[i] != next) {
+			order_errors++;
+		}
+		next = recorder.values[i] + 1;
+	}
+	CHECK(order_errors == 0);
+}
+
+TEST_CASE("[MessageQueue] Clearing drops pending calls") {
+	CallQueue queue;
+	CallRecorder recorder;
+	const Callable callable = callable_mp(&recorder, &CallRecorder::record);
+
+	for (int i = 0; i < 100; i++) {
+		queue.push_callable(callable, 0, i);
+	}
+	queue.clear();
+	CHECK_FALSE(queue.has_messages());
+	CHECK(queue.flush() == OK);
+	CHECK(recorder.values.is_empty());
+}
+
+TEST_CASE("[MessageQueue][Benchmark] Deferred call push throughput versus thread count" * doctest::skip()) {
+	const int max_threads = MAX(1, OS::get_singleton()->get_processor_count());
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		CallQueue queue(nullptr, 1 << 16);
+		CallRecorder recorder;
+
+		PushState state;
+		state.queue = &queue;
+		state.recorder = &recorder;
+		state.calls_per_thread = 100000;
+
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(&PushState::thread_loop, &state);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		uint64_t pushed = OS::get_singleton()->get_ticks_usec();
+		queue.flush();
+		uint64_t flushed = OS::get_singleton()->get_ticks_usec();
+
+		CHECK(state.push_errors.get() == 0);
+		double calls = double(thread_count) * state.calls_per_thread;
+		MESSAGE(vformat("%d threads: %.2f M calls pushed per second, %.2f M calls flushed per second.", thread_count, calls / MAX(uint64_t(1), pushed - begin), calls / MAX(uint64_t(1), flushed - pushed)));
+	}
+}
+
+} // namespace TestMessageQueue
@@ -35,6 +35,8 @@
 #include "core/object/class_db.h"
 #include "core/object/object.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
 
 #include "tests/test_macros.h"
 
@@ -457,6 +459,80 @@ TEST_CASE("[Object] Signals") {
 	}
 }
 
+class SignalReceiver : public Object {
+public:
+	int calls = 0;
+
+	Object *emitter = nullptr;
+	SignalReceiver *to_disconnect = nullptr;
+	SignalReceiver *to_connect = nullptr;
+
+	void receive() {
+		calls++;
+		if (to_disconnect) {
+			emitter->disconnect("my_custom_signal", callable_mp(to_disconnect, &SignalReceiver::receive));
+			to_disconnect = nullptr;
+		}
+		if (to_connect) {
+			emitter->connect("my_custom_signal", callable_mp(to_connect, &SignalReceiver::receive));
+			to_connect = nullptr;
+		}
+	}
+};
+
+TEST_CASE("[Object] Signal emission uses the connections present when it started") {
+	Object emitter;
+	emitter.add_user_signal(MethodInfo("my_custom_signal"));
+
+	SignalReceiver first;
+	SignalReceiver second;
+	SignalReceiver third;
+	first.emitter = &emitter;
+	first.to_disconnect = &second;
+	first.to_connect = &third;
+
+	emitter.connect("my_custom_signal", callable_mp(&first, &SignalReceiver::receive));
+	emitter.connect("my_custom_signal", callable_mp(&second, &SignalReceiver::receive));
+
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(first.calls == 1);
+	CHECK_MESSAGE(second.calls == 1, "A slot disconnected while emitting is still called by that emission.");
+	CHECK_MESSAGE(third.calls == 0, "A slot connected while emitting is only called by later emissions.");
+
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(first.calls == 2);
+	CHECK(second.calls == 1);
+	CHECK(third.calls == 1);
+
+	SignalReceiver one_shot;
+	emitter.connect("my_custom_signal", callable_mp(&one_shot, &SignalReceiver::receive), Object::CONNECT_ONE_SHOT);
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(emitter.emit_signal("my_custom_signal") == OK);
+	CHECK(one_shot.calls == 1);
+	CHECK(first.calls == 4);
+}
+
+TEST_CASE("[Object][Benchmark] Signal emission throughput versus connection count" * doctest::skip()) {
+	for (int connection_count : { 1, 4, 16, 64 }) {
+		Object emitter;
+		emitter.add_user_signal(MethodInfo("my_custom_signal"));
+		SignalReceiver receivers[64];
+		for (int i = 0; i < connection_count; i++) {
+			emitter.connect("my_custom_signal", callable_mp(&receivers[i], &SignalReceiver::receive));
+		}
+
+		const int emissions = 1000000 / connection_count;
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < emissions; i++) {
+			emitter.emit_signal("my_custom_signal");
+		}
+		uint64_t elapsed = MAX(uint64_t(1), OS::get_singleton()->get_ticks_usec() - begin);
+
+		CHECK(receivers[0].calls == emissions);
+		MESSAGE(vformat("%d connections: %.2f M emissions per second, %.2f M calls per second.", connection_count, double(emissions) / elapsed, double(emissions) * connection_count / elapsed));
+	}
+}
+
 class NotificationObjectSuperclass : public Object {
 	GDCLASS(NotificationObjectSuperclass, Object);
 
@@ -596,4 +672,80 @@ TEST_CASE("[Object] Destruction at the end of the call chain is safe") {
 			"Object was tail-deleted without crashes.");
 }
 
+struct ObjectDBChurn {
+	int objects_per_thread = 0;
+	int rounds = 0;
+	SafeNumeric<int> lookup_errors;
+
+	static void thread_loop(void *p_user) {
+		ObjectDBChurn *churn = (ObjectDBChurn *)p_user;
+		LocalVector<Object *> objects;
+		LocalVector<ObjectID> ids;
+		objects.resize(churn->objects_per_thread);
+		ids.resize(churn->objects_per_thread);
+		for (int round = 0; round < churn->rounds; round++) {
+			for (int i = 0; i < churn->objects_per_thread; i++) {
+				objects[i] = memnew(Object);
+				ids[i] = objects[i]->get_instance_id();
+			}
+			for (int i = 0; i < churn->objects_per_thread; i++) {
+				if (ObjectDB::get_instance(ids[i]) != objects[i]) {
+					churn->lookup_errors.increment();
+				}
+				memdelete(objects[i]);
+			}
+			for (int i = 0; i < churn->objects_per_thread; i++) {
+				// Freed IDs must stay invalid even after their slots get reused.
+				if (ObjectDB::get_instance(ids[i]) != nullptr) {
+					churn->lookup_errors.increment();
+				}
+			}
+		}
+	}
+};
+
+TEST_CASE("[Object] ObjectDB lookups stay valid while other threads add and remove instances") {
+	const int object_count_before = ObjectDB::get_object_count();
+
+	ObjectDBChurn churn;
+	churn.objects_per_thread = 1000;
+	churn.rounds = 20;
+
+	const int thread_count = 4;
+	Thread threads[thread_count];
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].start(&ObjectDBChurn::thread_loop, &churn);
+	}
+	for (int i = 0; i < thread_count; i++) {
+		threads[i].wait_to_finish();
+	}
+
+	CHECK(churn.lookup_errors.get() == 0);
+	CHECK(ObjectDB::get_object_count() == object_count_before);
+}
+
+TEST_CASE("[Object][Benchmark] ObjectDB add and remove throughput versus thread count" * doctest::skip()) {
+	const int max_threads = MAX(1, OS::get_singleton()->get_processor_count());
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		ObjectDBChurn churn;
+		churn.objects_per_thread = 10000;
+		churn.rounds = 20;
+
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(&ObjectDBChurn::thread_loop, &churn);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		uint64_t elapsed = MAX(uint64_t(1), OS::get_singleton()->get_ticks_usec() - begin);
+
+		CHECK(churn.lookup_errors.get() == 0);
+		double objects = double(thread_count) * churn.objects_per_thread * churn.rounds;
+		MESSAGE(vformat("%d threads: %.2f M objects created and freed per second.", thread_count, objects / elapsed));
+	}
+}
+
 } // namespace TestObject
@@ -0,0 +1,210 @@
+/**************************************************************************/
+/*  test_memory.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/vector3.h"
+#include "core/os/memory.h"
+#include "core/os/os.h"
+#include "core/templates/local_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMemory {
+
+TEST_CASE("[Memory] Allocations are accounted to the current tag") {
+	if (!Memory::are_tags_enabled()) {
+		return;
+	}
+
+	Memory::TagStats before = Memory::get_tag_stats(Memory::TAG_AUDIO);
+
+	void *mem = nullptr;
+	{
+		MEMORY_TAG_SCOPE(TAG_AUDIO);
+		CHECK(Memory::get_current_tag() == Memory::TAG_AUDIO);
+		mem = memalloc(1000);
+	}
+	CHECK(Memory::get_current_tag() == Memory::TAG_UNTAGGED);
+
+	Memory::TagStats after_alloc = Memory::get_tag_stats(Memory::TAG_AUDIO);
+	CHECK(after_alloc.live_bytes - before.live_bytes == 1000);
+	CHECK(after_alloc.live_allocations - before.live_allocations == 1);
+	CHECK(after_alloc.total_allocations - before.total_allocations == 1);
+
+	// Reallocating outside the scope keeps the original tag.
+	mem = memrealloc(mem, 3000);
+	Memory::TagStats after_realloc = Memory::get_tag_stats(Memory::TAG_AUDIO);
+	CHECK(after_realloc.live_bytes - before.live_bytes == 3000);
+	CHECK(after_realloc.peak_bytes >= after_realloc.live_bytes);
+
+	memfree(mem);
+	Memory::TagStats after_free = Memory::get_tag_stats(Memory::TAG_AUDIO);
+	CHECK(after_free.live_bytes == before.live_bytes);
+	CHECK(after_free.live_allocations == before.live_allocations);
+	CHECK(after_free.total_allocations - before.total_allocations == 1);
+}
+
+TEST_CASE("[Memory][FrameAllocator] Allocations are aligned and don't overlap") {
+	uint8_t *a = (uint8_t *)FrameAllocator::alloc(3);
+	uint8_t *b = (uint8_t *)FrameAllocator::alloc(100);
+	uint8_t *c = (uint8_t *)FrameAllocator::alloc(1);
+
+	CHECK((uintptr_t)a % alignof(max_align_t) == 0);
+	CHECK((uintptr_t)b % alignof(max_align_t) == 0);
+	CHECK((uintptr_t)c % alignof(max_align_t) == 0);
+	CHECK(a + 3 <= b);
+	CHECK(b + 100 <= c);
+
+	memset(a, 1, 3);
+	memset(b, 2, 100);
+	memset(c, 3, 1);
+	CHECK(a[2] == 1);
+	CHECK(b[99] == 2);
+	CHECK(c[0] == 3);
+
+	CHECK(FrameAllocator::get_thread_usage() > 0);
+
+	FrameAllocator::free(a);
+	FrameAllocator::free(b);
+	FrameAllocator::free(c);
+
+	// Everything was freed, so the arena rewound.
+	CHECK(FrameAllocator::get_thread_usage() == 0);
+	CHECK(FrameAllocator::alloc(1) == a);
+	FrameAllocator::free(a);
+}
+
+TEST_CASE("[Memory][FrameAllocator] Reallocation keeps contents") {
+	uint8_t *first = (uint8_t *)FrameAllocator::alloc(16);
+	uint8_t *last = (uint8_t *)FrameAllocator::alloc(16);
+	for (int i = 0; i < 16; i++) {
+		first[i] = i;
+		last[i] = 100 + i;
+	}
+
+	// The most recent allocation grows in place.
+	CHECK(FrameAllocator::realloc(last, 4096) == last);
+
+	// Others move.
+	uint8_t *moved = (uint8_t *)FrameAllocator::realloc(first, 4096);
+	CHECK(moved != first);
+
+	bool contents_kept = true;
+	for (int i = 0; i < 16; i++) {
+		contents_kept &= moved[i] == i;
+		contents_kept &= last[i] == 100 + i;
+	}
+	CHECK(contents_kept);
+
+	// Larger than a chunk.
+	uint8_t *huge = (uint8_t *)FrameAllocator::realloc(moved, 1024 * 1024);
+	CHECK(huge[15] == 15);
+
+	FrameAllocator::free(huge);
+	FrameAllocator::free(last);
+	CHECK(FrameAllocator::get_thread_usage() == 0);
+}
+
+TEST_CASE("[Memory][FrameAllocator] LocalVector storage") {
+	LocalVector<int, uint32_t, false, false, FrameAllocator> vector;
+	for (int i = 0; i < 10000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 10000);
+	CHECK(vector[9999] == 9999);
+	CHECK(FrameAllocator::get_thread_usage() >= 10000 * sizeof(int));
+
+	vector.reset();
+	CHECK(FrameAllocator::get_thread_usage() == 0);
+}
+
+TEST_CASE("[Memory][FrameAllocator] Steady state needs no new chunks") {
+	uint64_t chunks_before = 0;
+	for (int frame = 0; frame < 10; frame++) {
+		if (frame == 2) {
+			chunks_before = FrameAllocator::get_chunk_alloc_count();
+		}
+		LocalVector<Vector3, uint32_t, false, false, FrameAllocator> positions;
+		LocalVector<uint32_t, uint32_t, false, false, FrameAllocator> indices;
+		for (int i = 0; i < 50000; i++) {
+			positions.push_back(Vector3(i, i, i));
+			indices.push_back(i);
+		}
+	}
+	// The first frames coalesce the chunks into one, which then serves every later frame.
+	CHECK(FrameAllocator::get_chunk_alloc_count() == chunks_before);
+}
+
+template <typename A>
+static uint64_t simulate_frames(int p_frames, int p_elements) {
+	uint64_t checksum = 0;
+	for (int frame = 0; frame < p_frames; frame++) {
+		// Mimics the temporaries of a culling pass: a few lists filled and discarded every frame.
+		LocalVector<uint32_t, uint32_t, false, false, A> visible;
+		LocalVector<float, uint32_t, false, false, A> distances;
+		LocalVector<uint64_t, uint32_t, false, false, A> sort_keys;
+		for (int i = 0; i < p_elements; i++) {
+			if ((i * 7 + frame) % 3 == 0) {
+				continue;
+			}
+			visible.push_back(i);
+			distances.push_back(i * 0.5f);
+			sort_keys.push_back(((uint64_t)i << 32) | frame);
+		}
+		checksum += visible.size() + sort_keys[sort_keys.size() - 1];
+	}
+	return checksum;
+}
+
+TEST_CASE("[Memory][FrameAllocator][Benchmark] Per-frame temporaries" * doctest::skip()) {
+	const int frames = 1000;
+	const int elements = 20000;
+
+	uint64_t allocs_before = Memory::get_mem_alloc_count();
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t default_checksum = simulate_frames<DefaultAllocator>(frames, elements);
+	uint64_t default_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	uint64_t default_allocs = Memory::get_mem_alloc_count() - allocs_before;
+
+	allocs_before = Memory::get_mem_alloc_count();
+	begin = OS::get_singleton()->get_ticks_usec();
+	uint64_t frame_checksum = simulate_frames<FrameAllocator>(frames, elements);
+	uint64_t frame_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	uint64_t frame_allocs = Memory::get_mem_alloc_count() - allocs_before;
+
+	CHECK(default_checksum == frame_checksum);
+	MESSAGE(vformat("DefaultAllocator: %d usec, %.1f system allocations per frame.", default_usec, default_allocs / (double)frames));
+	MESSAGE(vformat("FrameAllocator: %d usec, %.1f system allocations per frame.", frame_usec, frame_allocs / (double)frames));
+}
+
+} // namespace TestMemory
@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	StringName a = "test_string_name_interning";
+	StringName b = String("test_string_name_interning");
+	StringName c = "test_string_name_interning_other";
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+	CHECK(StringName().is_empty());
+	CHECK(StringName("").is_empty());
+}
+
+struct InternStress {
+	static const int NAME_COUNT = 512;
+
+	Vector<String> names;
+	// One resolved pointer per thread and name, checked for agreement afterwards.
+	LocalVector<const void *> resolved;
+	int thread_count = 0;
+	int iterations = 0;
+
+	struct Worker {
+		InternStress *stress = nullptr;
+		int index = 0;
+	};
+
+	static void worker_loop(void *p_user) {
+		Worker *worker = (Worker *)p_user;
+		InternStress *stress = worker->stress;
+		StringName keep[NAME_COUNT];
+		for (int i = 0; i < stress->iterations; i++) {
+			for (int j = 0; j < NAME_COUNT; j++) {
+				// Every other pass drops the references, so names are
+				// concurrently freed and interned again by other threads.
+				if (i & 1) {
+					keep[j] = StringName();
+				} else {
+					keep[j] = StringName(stress->names[j]);
+				}
+			}
+		}
+		for (int j = 0; j < NAME_COUNT; j++) {
+			StringName name = stress->names[j];
+			stress->resolved[worker->index * NAME_COUNT + j] = name.data_unique_pointer();
+		}
+	}
+
+	void run(int p_thread_count, int p_iterations) {
+		thread_count = p_thread_count;
+		iterations = p_iterations;
+		resolved.resize(thread_count * NAME_COUNT);
+
+		LocalVector<Thread> threads;
+		LocalVector<Worker> workers;
+		threads.resize(thread_count);
+		workers.resize(thread_count);
+		for (int i = 0; i < thread_count; i++) {
+			workers[i].stress = this;
+			workers[i].index = i;
+			threads[i].start(&InternStress::worker_loop, &workers[i]);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+	}
+
+	InternStress() {
+		for (int i = 0; i < NAME_COUNT; i++) {
+			names.push_back(vformat("intern_stress_%d", i));
+		}
+	}
+};
+
+TEST_CASE("[StringName] Concurrent interning resolves to a single entry") {
+	InternStress stress;
+	// Hold one reference to half of the names, so both live and freed entries get raced on.
+	Vector<StringName> held;
+	for (int i = 0; i < InternStress::NAME_COUNT; i += 2) {
+		held.push_back(StringName(stress.names[i]));
+	}
+
+	stress.run(4, 50);
+
+	int mismatches = 0;
+	for (int j = 0; j < InternStress::NAME_COUNT; j++) {
+		// Threads finish at different times, so only names held throughout must agree across threads.
+		if (j % 2 == 0) {
+			for (int t = 0; t < stress.thread_count; t++) {
+				if (stress.resolved[t * InternStress::NAME_COUNT + j] != held[j / 2].data_unique_pointer()) {
+					mismatches++;
+				}
+			}
+		}
+		StringName name = stress.names[j];
+		CHECK(name == stress.names[j]);
+	}
+	CHECK_MESSAGE(mismatches == 0, "Every thread should resolve a held name to the same entry.");
+}
+
+struct InternBenchmark {
+	Vector<String> names;
+	int iterations = 0;
+
+	static void worker_loop(void *p_user) {
+		InternBenchmark *bench = (InternBenchmark *)p_user;
+		for (int i = 0; i < bench->iterations; i++) {
+			for (const String &name : bench->names) {
+				StringName interned = name;
+			}
+		}
+	}
+};
+
+TEST_CASE("[StringName][Benchmark] Interning throughput versus thread count" * doctest::skip()) {
+	InternBenchmark bench;
+	bench.iterations = 200;
+	Vector<StringName> held;
+	for (int i = 0; i < 4096; i++) {
+		bench.names.push_back(vformat("intern_benchmark_%d", i));
+		held.push_back(bench.names[i]);
+	}
+
+	const int max_threads = MAX(1, OS::get_singleton()->get_processor_count());
+	for (int thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+		LocalVector<Thread> threads;
+		threads.resize(thread_count);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].start(&InternBenchmark::worker_loop, &bench);
+		}
+		for (int i = 0; i < thread_count; i++) {
+			threads[i].wait_to_finish();
+		}
+		uint64_t elapsed = MAX(uint64_t(1), OS::get_singleton()->get_ticks_usec() - begin);
+
+		double lookups = double(thread_count) * bench.iterations * bench.names.size();
+		MESSAGE(vformat("%d threads: %.2f M lookups/s.", thread_count, lookups / elapsed));
+	}
+}
+
+} // namespace TestStringName
@@ -562,4 +562,129 @@ TEST_CASE("[CommandQueue] Test Parameter Passing Semantics") {
 
 	sts.destroy_threads();
 }
+
+struct OrderingState {
+	static const int PRODUCER_COUNT = 2;
+
+	CommandQueueMT command_queue;
+	int64_t last_seen[PRODUCER_COUNT] = { -1, -1 };
+	int64_t received = 0;
+	int order_errors = 0;
+	SafeNumeric<int> ret_errors;
+	int64_t per_producer = 0;
+	SafeFlag exit_reader;
+
+	void record(int p_producer, int64_t p_value, Transform3D p_payload) {
+		if (p_value != last_seen[p_producer] + 1) {
+			order_errors++;
+		}
+		last_seen[p_producer] = p_value;
+		received++;
+	}
+
+	int64_t doubled(int64_t p_value) {
+		return p_value * 2;
+	}
+
+	static void reader_loop(void *p_user) {
+		OrderingState *state = (OrderingState *)p_user;
+		while (!state->exit_reader.is_set()) {
+			state->command_queue.flush_all();
+		}
+		state->command_queue.flush_all();
+	}
+
+	struct Producer {
+		OrderingState *state = nullptr;
+		int index = 0;
+	};
+
+	static void writer_loop(void *p_user) {
+		OrderingState *state = ((Producer *)p_user)->state;
+		int producer = ((Producer *)p_user)->index;
+		for (int64_t i = 0; i < state->per_producer; i++) {
+			state->command_queue.push(state, &OrderingState::record, producer, i, Transform3D());
+			if (i % 1000 == 0) {
+				int64_t ret = 0;
+				state->command_queue.push_and_ret(state, &OrderingState::doubled, &ret, i);
+				if (ret != i * 2) {
+					state->ret_errors.increment();
+				}
+			}
+		}
+	}
+};
+
+TEST_CASE("[CommandQueue] Concurrent producers keep per-producer order") {
+	OrderingState state;
+	// Enough commands to span many chunks.
+	state.per_producer = 50000;
+
+	Thread reader;
+	reader.start(&OrderingState::reader_loop, &state);
+
+	Thread writers[OrderingState::PRODUCER_COUNT];
+	OrderingState::Producer producers[OrderingState::PRODUCER_COUNT];
+	for (int i = 0; i < OrderingState::PRODUCER_COUNT; i++) {
+		producers[i].state = &state;
+		producers[i].index = i;
+		writers[i].start(&OrderingState::writer_loop, &producers[i]);
+	}
+	for (int i = 0; i < OrderingState::PRODUCER_COUNT; i++) {
+		writers[i].wait_to_finish();
+	}
+
+	state.command_queue.sync();
+	CHECK_MESSAGE(state.received == state.per_producer * OrderingState::PRODUCER_COUNT,
+			"All commands pushed before a sync should have run.");
+
+	state.exit_reader.set();
+	reader.wait_to_finish();
+
+	CHECK_MESSAGE(state.order_errors == 0,
+			"Commands from each producer should run in push order.");
+	CHECK_MESSAGE(state.ret_errors.get() == 0,
+			"Commands with return values should hand back their own result.");
+}
+
+struct PushBenchmarkState {
+	CommandQueueMT command_queue;
+	uint64_t calls = 0;
+	SafeFlag exit_reader;
+
+	void sink(Transform3D p_transform, float p_value) {
+		calls++;
+	}
+
+	static void reader_loop(void *p_user) {
+		PushBenchmarkState *state = (PushBenchmarkState *)p_user;
+		while (!state->exit_reader.is_set()) {
+			state->command_queue.flush_all();
+		}
+		state->command_queue.flush_all();
+	}
+};
+
+TEST_CASE("[CommandQueue][Benchmark] Push throughput with a concurrent consumer" * doctest::skip()) {
+	const uint32_t command_count = 1000000;
+
+	PushBenchmarkState state;
+	Thread reader;
+	reader.start(&PushBenchmarkState::reader_loop, &state);
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < command_count; i++) {
+		state.command_queue.push(&state, &PushBenchmarkState::sink, Transform3D(), 1.0f);
+	}
+	uint64_t pushed = OS::get_singleton()->get_ticks_usec();
+	state.command_queue.sync();
+	uint64_t drained = OS::get_singleton()->get_ticks_usec();
+
+	state.exit_reader.set();
+	reader.wait_to_finish();
+
+	CHECK(state.calls == command_count);
+	MESSAGE(vformat("%d commands: push %.1f ns/cmd, push+drain %.1f ns/cmd.", command_count,
+			double(pushed - begin) * 1000.0 / command_count, double(drained - begin) * 1000.0 / command_count));
+}
 } // namespace TestCommandQueue
@@ -0,0 +1,240 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/os.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/rb_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert, overwrite and erase") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+
+	map.insert(42, 1234);
+	CHECK(map[42] == 1234);
+	CHECK(map.size() == 1);
+
+	map.remove(map.find(42));
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+	CHECK(map.is_empty());
+
+	map.insert(7, 14);
+	CHECK(map.erase(7));
+	CHECK(!map.erase(7));
+	CHECK(map.getptr(7) == nullptr);
+}
+
+TEST_CASE("[SwissHashMap] Iteration visits every element once") {
+	SwissHashMap<int, int> map;
+	const int count = 1000;
+	for (int i = 0; i < count; i++) {
+		map.insert(i, i * 2);
+	}
+
+	Vector<bool> seen;
+	seen.resize(count);
+	seen.fill(false);
+	int visited = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(E.value == E.key * 2);
+		CHECK(!seen[E.key]);
+		seen.write[E.key] = true;
+		visited++;
+	}
+	CHECK(visited == count);
+
+	const SwissHashMap<int, int> &const_map = map;
+	visited = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(const_map[E.key] == E.value);
+		visited++;
+	}
+	CHECK(visited == count);
+}
+
+TEST_CASE("[SwissHashMap] Insert and remove many strings") {
+	const int elem_max = 5000;
+	SwissHashMap<String, String> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(itos(i), itos(i));
+	}
+	CHECK(map.size() == elem_max);
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 3) == 0) {
+			CHECK(map.erase(itos(i)));
+		}
+	}
+
+	int expected = 0;
+	for (int i = 0; i < elem_max; i++) {
+		bool kept = (i % 3) != 0;
+		CHECK(map.has(itos(i)) == kept);
+		expected += kept ? 1 : 0;
+	}
+	CHECK(map.size() == (uint32_t)expected);
+
+	// Reinsert into slots freed by erasure.
+	for (int i = 0; i < elem_max; i += 3) {
+		map.insert(itos(i), "again");
+	}
+	CHECK(map.size() == elem_max);
+	CHECK(map["0"] == "again");
+	CHECK(map["1"] == "1");
+}
+
+TEST_CASE("[SwissHashMap] Tombstones do not make the table grow forever") {
+	SwissHashMap<int, int> map;
+	map.reserve(64);
+	for (int i = 0; i < 64; i++) {
+		map.insert(i, i);
+	}
+	const uint32_t capacity = map.get_capacity();
+
+	// Churn keeps the size constant, so rehashing should reclaim deleted slots in place.
+	for (int i = 64; i < 100000; i++) {
+		map.erase(i - 64);
+		map.insert(i, i);
+	}
+	CHECK(map.size() == 64);
+	CHECK(map.get_capacity() == capacity);
+	for (int i = 100000 - 64; i < 100000; i++) {
+		CHECK(map.has(i));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Clear, copy and assignment") {
+	SwissHashMap<int, String> map0;
+	for (int i = 0; i < 100; i++) {
+		map0.insert(i, itos(i));
+	}
+
+	SwissHashMap<int, String> map1(map0);
+	CHECK(map1.size() == map0.size());
+	CHECK(map1.get_capacity() == map0.get_capacity());
+	CHECK(map1[50] == "50");
+
+	SwissHashMap<int, String> map2;
+	map2.insert(1234, "x");
+	map2 = map0;
+	CHECK(map2.size() == map0.size());
+	CHECK(!map2.has(1234));
+	CHECK(map2[99] == "99");
+
+	map0.clear();
+	CHECK(map0.is_empty());
+	CHECK(!map0.has(50));
+	CHECK(map0.begin() == map0.end());
+	CHECK(map1[50] == "50");
+}
+
+template <typename M>
+static void benchmark_map(const char *p_name, const LocalVector<uint32_t> &p_hits, const LocalVector<uint32_t> &p_misses) {
+	const uint32_t count = p_hits.size();
+	M map;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (uint32_t i = 0; i < count; i++) {
+		map.insert(p_hits[i], i);
+	}
+	uint64_t inserted = OS::get_singleton()->get_ticks_usec();
+
+	uint64_t found = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		found += map.has(p_hits[i]) ? 1 : 0;
+	}
+	uint64_t hit = OS::get_singleton()->get_ticks_usec();
+
+	for (uint32_t i = 0; i < count; i++) {
+		found += map.has(p_misses[i]) ? 1 : 0;
+	}
+	uint64_t miss = OS::get_singleton()->get_ticks_usec();
+
+	uint64_t sum = 0;
+	for (const KeyValue<uint32_t, uint32_t> &E : map) {
+		sum += E.value;
+	}
+	uint64_t iterated = OS::get_singleton()->get_ticks_usec();
+
+	CHECK(found == count);
+	CHECK(sum == uint64_t(count) * (count - 1) / 2);
+
+	const double scale = 1000.0 / count;
+	MESSAGE(vformat("%s x %d: insert %.1f ns, hit %.1f ns, miss %.1f ns, iterate %.1f ns per element.", p_name, count,
+			(inserted - begin) * scale, (hit - inserted) * scale, (miss - hit) * scale, (iterated - miss) * scale));
+}
+
+TEST_CASE("[SwissHashMap][Benchmark] Compare with HashMap, AHashMap and RBMap" * doctest::skip()) {
+	for (uint32_t count = 1000; count <= 10000000; count *= 10) {
+		// Disjoint, well scattered key sets for hits and misses.
+		LocalVector<uint32_t> hits;
+		LocalVector<uint32_t> misses;
+		hits.resize(count);
+		misses.resize(count);
+		for (uint32_t i = 0; i < count; i++) {
+			hits[i] = hash_fmix32(i * 2);
+			misses[i] = hash_fmix32(i * 2 + 1);
+		}
+
+		benchmark_map<SwissHashMap<uint32_t, uint32_t>>("SwissHashMap", hits, misses);
+		benchmark_map<AHashMap<uint32_t, uint32_t>>("AHashMap", hits, misses);
+		benchmark_map<HashMap<uint32_t, uint32_t>>("HashMap", hits, misses);
+		benchmark_map<RBMap<uint32_t, uint32_t>>("RBMap", hits, misses);
+	}
+}
+
+} // namespace TestSwissHashMap
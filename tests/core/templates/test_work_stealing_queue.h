@@ -0,0 +1,153 @@
+/**************************************************************************/
+/*  test_work_stealing_queue.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingQueue {
+
+TEST_CASE("[WorkStealingQueue] Owner pops in LIFO order, thieves steal in FIFO order") {
+	WorkStealingQueue<int, 8> queue;
+	int values[4] = { 0, 1, 2, 3 };
+
+	CHECK(queue.is_empty());
+	CHECK(queue.pop() == nullptr);
+	int *stolen = nullptr;
+	CHECK(queue.steal(stolen) == WorkStealingQueue<int, 8>::STEAL_EMPTY);
+
+	for (int &value : values) {
+		CHECK(queue.push(&value));
+	}
+	CHECK_FALSE(queue.is_empty());
+
+	CHECK(queue.steal(stolen) == WorkStealingQueue<int, 8>::STEAL_OK);
+	CHECK(stolen == &values[0]);
+	CHECK(queue.pop() == &values[3]);
+	CHECK(queue.pop() == &values[2]);
+	CHECK(queue.steal(stolen) == WorkStealingQueue<int, 8>::STEAL_OK);
+	CHECK(stolen == &values[1]);
+
+	CHECK(queue.is_empty());
+	CHECK(queue.pop() == nullptr);
+}
+
+TEST_CASE("[WorkStealingQueue] Push fails when full") {
+	WorkStealingQueue<int, 4> queue;
+	int values[5] = {};
+
+	for (int i = 0; i < 4; i++) {
+		CHECK(queue.push(&values[i]));
+	}
+	CHECK_FALSE(queue.push(&values[4]));
+
+	// Room is made by either end.
+	CHECK(queue.pop() == &values[3]);
+	CHECK(queue.push(&values[4]));
+	int *stolen = nullptr;
+	CHECK(queue.steal(stolen) == WorkStealingQueue<int, 4>::STEAL_OK);
+	CHECK(stolen == &values[0]);
+	CHECK(queue.push(&values[3]));
+	CHECK_FALSE(queue.push(&values[3]));
+}
+
+struct StealState {
+	WorkStealingQueue<uint32_t, 64> queue;
+	LocalVector<uint32_t> items;
+	LocalVector<SafeNumeric<uint32_t>> taken;
+	SafeFlag producing;
+
+	static void thief_loop(void *p_user) {
+		StealState *state = (StealState *)p_user;
+		while (state->producing.is_set() || !state->queue.is_empty()) {
+			uint32_t *item = nullptr;
+			if (state->queue.steal(item) == WorkStealingQueue<uint32_t, 64>::STEAL_OK) {
+				state->taken[*item].increment();
+			}
+		}
+	}
+};
+
+TEST_CASE("[WorkStealingQueue] Every item is taken exactly once under contention") {
+	const uint32_t item_count = 100000;
+	const int thief_count = 3;
+
+	StealState state;
+	state.items.resize(item_count);
+	state.taken.resize(item_count);
+	for (uint32_t i = 0; i < item_count; i++) {
+		state.items[i] = i;
+	}
+	state.producing.set();
+
+	Thread thieves[thief_count];
+	for (Thread &thief : thieves) {
+		thief.start(&StealState::thief_loop, &state);
+	}
+
+	for (uint32_t i = 0; i < item_count; i++) {
+		while (!state.queue.push(&state.items[i])) {
+			uint32_t *item = state.queue.pop();
+			if (item) {
+				state.taken[*item].increment();
+			}
+		}
+		if (i % 3 == 0) {
+			uint32_t *item = state.queue.pop();
+			if (item) {
+				state.taken[*item].increment();
+			}
+		}
+	}
+	while (uint32_t *item = state.queue.pop()) {
+		state.taken[*item].increment();
+	}
+	state.producing.clear();
+
+	for (Thread &thief : thieves) {
+		thief.wait_to_finish();
+	}
+
+	bool all_taken_once = true;
+	for (uint32_t i = 0; i < item_count; i++) {
+		// Reduce number of check messages.
+		all_taken_once &= state.taken[i].get() == 1;
+	}
+	CHECK(all_taken_once);
+}
+
+} // namespace TestWorkStealingQueue
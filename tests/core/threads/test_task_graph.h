@@ -0,0 +1,149 @@
+/**************************************************************************/
+/*  test_task_graph.h                                                     */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             REDOT ENGINE                               */
+/*                        https://redotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2024-present Redot Engine contributors                   */
+/*                                          (see REDOT_AUTHORS.md)        */
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/task_graph.h"
+
+#include "tests/test_macros.h"
+
+namespace TestTaskGraph {
+
+struct Stamps {
+	SafeNumeric<uint32_t> clock;
+	uint32_t stamps[8] = {};
+	SafeNumeric<uint32_t> elements_done;
+	uint32_t elements_done_seen = 0;
+
+	void stamp(uint32_t p_slot) {
+		stamps[p_slot] = clock.increment();
+	}
+};
+
+struct StampArg {
+	Stamps *stamps = nullptr;
+	uint32_t slot = 0;
+};
+
+static void stamp_task(void *p_arg) {
+	StampArg *arg = (StampArg *)p_arg;
+	arg->stamps->stamp(arg->slot);
+}
+
+static void element_task(void *p_arg, uint32_t p_index) {
+	((Stamps *)p_arg)->elements_done.increment();
+}
+
+static void check_elements_task(void *p_arg) {
+	Stamps *stamps = (Stamps *)p_arg;
+	stamps->elements_done_seen = stamps->elements_done.get();
+}
+
+TEST_CASE("[TaskGraph] Nodes run after their predecessors") {
+	Stamps stamps;
+	StampArg args[4];
+	for (uint32_t i = 0; i < 4; i++) {
+		args[i].stamps = &stamps;
+		args[i].slot = i;
+	}
+
+	// Diamond: 0 -> (1, 2) -> 3.
+	TaskGraph graph;
+	TaskGraph::NodeID a = graph.add_native_task(stamp_task, &args[0]);
+	TaskGraph::NodeID b = graph.add_native_task(stamp_task, &args[1], { a });
+	TaskGraph::NodeID c = graph.add_native_task(stamp_task, &args[2], { a }, true);
+	graph.add_native_task(stamp_task, &args[3], { b, c });
+	CHECK(graph.get_node_count() == 4);
+
+	for (int iteration = 0; iteration < 100; iteration++) {
+		graph.run();
+		graph.wait();
+
+		CHECK(graph.is_completed());
+		CHECK(stamps.stamps[0] < stamps.stamps[1]);
+		CHECK(stamps.stamps[0] < stamps.stamps[2]);
+		CHECK(stamps.stamps[1] < stamps.stamps[3]);
+		CHECK(stamps.stamps[2] < stamps.stamps[3]);
+	}
+}
+
+TEST_CASE("[TaskGraph] Group tasks complete before their successors run") {
+	for (int elements : { 0, 1, 7, 1000 }) {
+		Stamps stamps;
+
+		TaskGraph graph;
+		TaskGraph::NodeID group = graph.add_native_group_task(element_task, &stamps, elements);
+		graph.add_native_task(check_elements_task, &stamps, { group });
+		graph.run();
+		graph.wait();
+
+		CHECK(stamps.elements_done_seen == (uint32_t)elements);
+	}
+}
+
+TEST_CASE("[TaskGraph] Dependencies added later and invalid dependencies") {
+	Stamps stamps;
+	StampArg args[3];
+	for (uint32_t i = 0; i < 3; i++) {
+		args[i].stamps = &stamps;
+		args[i].slot = i;
+	}
+
+	TaskGraph graph;
+	TaskGraph::NodeID a = graph.add_native_task(stamp_task, &args[0]);
+	TaskGraph::NodeID b = graph.add_native_task(stamp_task, &args[1]);
+	TaskGraph::NodeID c = graph.add_native_task(stamp_task, &args[2]);
+	graph.add_dependency(c, b);
+	graph.add_dependency(b, a);
+	graph.add_dependency(b, a); // Duplicates are ignored.
+
+	ERR_PRINT_OFF;
+	graph.add_dependency(a, c); // Would make a cycle.
+	graph.add_dependency(a, a);
+	ERR_PRINT_ON;
+
+	graph.run();
+	graph.wait();
+
+	CHECK(stamps.stamps[0] < stamps.stamps[1]);
+	CHECK(stamps.stamps[1] < stamps.stamps[2]);
+}
+
+TEST_CASE("[TaskGraph] Empty graph") {
+	TaskGraph graph;
+	graph.run();
+	graph.wait();
+	CHECK(graph.is_completed());
+	CHECK_FALSE(graph.is_running());
+}
+
+} // namespace TestTaskGraph
@@ -33,6 +33,7 @@
 #pragma once
 
 #include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 
 #include "tests/test_macros.h"
 
@@ -174,4 +175,77 @@ TEST_CASE("[WorkerThreadPool] Run a yielding daemon as the only hope for other t
 	CHECK_MESSAGE(all_needed_yield, "All legit tasks should have needed the daemon yielding to run.");
 }
 
+struct FanOutBenchmark {
+	WorkerThreadPool *pool = nullptr;
+	uint32_t children_per_root = 0;
+	SafeNumeric<uint64_t> leaves_done;
+
+	static void leaf_task(void *p_user) {
+		((FanOutBenchmark *)p_user)->leaves_done.increment();
+	}
+
+	static void leaf_group_task(void *p_user, uint32_t p_index) {
+		((FanOutBenchmark *)p_user)->leaves_done.increment();
+	}
+
+	// Posting from pool threads is what puts the per-thread queues and stealing to work.
+	static void root_task(void *p_user) {
+		FanOutBenchmark *bench = (FanOutBenchmark *)p_user;
+		LocalVector<WorkerThreadPool::TaskID> children;
+		children.resize(bench->children_per_root);
+		for (uint32_t i = 0; i < bench->children_per_root; i++) {
+			children[i] = bench->pool->add_native_task(leaf_task, bench, true);
+		}
+		for (uint32_t i = 0; i < bench->children_per_root; i++) {
+			bench->pool->wait_for_task_completion(children[i]);
+		}
+	}
+
+	static void root_group_task(void *p_user) {
+		FanOutBenchmark *bench = (FanOutBenchmark *)p_user;
+		WorkerThreadPool::GroupID group = bench->pool->add_native_group_task(leaf_group_task, bench, bench->children_per_root, -1, true);
+		bench->pool->wait_for_group_task_completion(group);
+	}
+};
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Task throughput versus thread count" * doctest::skip()) {
+	const uint32_t root_count = 256;
+	const uint32_t children_per_root = 64;
+	const int max_threads = MAX(1, OS::get_singleton()->get_default_thread_pool_size());
+
+	LocalVector<int> thread_counts;
+	for (int thread_count = 1; thread_count < max_threads; thread_count *= 2) {
+		thread_counts.push_back(thread_count);
+	}
+	thread_counts.push_back(max_threads);
+
+	for (int thread_count : thread_counts) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		for (int use_groups = 0; use_groups < 2; use_groups++) {
+			FanOutBenchmark bench;
+			bench.pool = pool;
+			bench.children_per_root = children_per_root;
+
+			LocalVector<WorkerThreadPool::TaskID> roots;
+			roots.resize(root_count);
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < root_count; i++) {
+				roots[i] = pool->add_native_task(use_groups ? FanOutBenchmark::root_group_task : FanOutBenchmark::root_task, &bench, true);
+			}
+			for (uint32_t i = 0; i < root_count; i++) {
+				pool->wait_for_task_completion(roots[i]);
+			}
+			uint64_t elapsed = MAX<uint64_t>(1, OS::get_singleton()->get_ticks_usec() - begin);
+
+			CHECK(bench.leaves_done.get() == (uint64_t)root_count * children_per_root);
+			MESSAGE(vformat("%s, %d threads: %d leaf tasks in %d usec (%.1f tasks/ms).", use_groups ? "Group tasks" : "Individual tasks", thread_count, bench.leaves_done.get(), elapsed, bench.leaves_done.get() * 1000.0 / elapsed));
+		}
+
+		memdelete(pool);
+	}
+}
+
 } // namespace TestWorkerThreadPool
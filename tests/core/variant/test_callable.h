@@ -196,4 +196,66 @@ TEST_CASE("[Callable] Bound and unbound argument count") {
 	memdelete(test_instance);
 }
 
+class TestRepeatedCallable : public CallableCustom {
+	class Prepared : public RepeatedCall {
+	public:
+		TestRepeatedCallable *owner = nullptr;
+
+		void call(const Variant **p_arguments, Variant &r_return_value, Callable::CallError &r_call_error) override {
+			owner->prepared_calls++;
+			r_return_value = int(*p_arguments[0]) * 2;
+			r_call_error.error = Callable::CallError::CALL_OK;
+		}
+	};
+
+public:
+	bool can_prepare = true;
+	mutable int prepares = 0;
+	int prepared_calls = 0;
+	mutable int plain_calls = 0;
+
+	static bool compare_equal(const CallableCustom *p_a, const CallableCustom *p_b) { return p_a == p_b; }
+	static bool compare_less(const CallableCustom *p_a, const CallableCustom *p_b) { return p_a < p_b; }
+
+	uint32_t hash() const override { return 0; }
+	String get_as_text() const override { return "TestRepeatedCallable"; }
+	CompareEqualFunc get_compare_equal_func() const override { return compare_equal; }
+	CompareLessFunc get_compare_less_func() const override { return compare_less; }
+	ObjectID get_object() const override { return ObjectID(); }
+	bool is_valid() const override { return true; }
+
+	void call(const Variant **p_arguments, int p_argcount, Variant &r_return_value, Callable::CallError &r_call_error) const override {
+		plain_calls++;
+		r_return_value = int(*p_arguments[0]) * 2;
+		r_call_error.error = Callable::CallError::CALL_OK;
+	}
+
+	RepeatedCall *create_repeated_call(int p_argcount) const override {
+		if (!can_prepare) {
+			return nullptr;
+		}
+		prepares++;
+		Prepared *prepared = memnew(Prepared);
+		prepared->owner = const_cast<TestRepeatedCallable *>(this);
+		return prepared;
+	}
+};
+
+TEST_CASE("[Callable] Repeated calls") {
+	TestRepeatedCallable *custom = memnew(TestRepeatedCallable);
+	const Callable callable(custom);
+	const Array values = { 1, 2, 3 };
+
+	CHECK(values.map(callable) == Array({ 2, 4, 6 }));
+	CHECK(custom->prepares == 1);
+	CHECK(custom->prepared_calls == 3);
+	CHECK(custom->plain_calls == 0);
+
+	// Callables that don't prepare anything are called as usual.
+	custom->can_prepare = false;
+	CHECK(values.map(callable) == Array({ 2, 4, 6 }));
+	CHECK(custom->plain_calls == 3);
+	CHECK(custom->prepared_calls == 3);
+}
+
 } // namespace TestCallable